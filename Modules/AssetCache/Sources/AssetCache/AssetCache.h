@@ -5,3 +5,4 @@
 #include "AssetCache/CachedItemValue.h"
 #include "AssetCache/ClientNetProxy.h"
 #include "AssetCache/ServerNetProxy.h"
+#include "AssetCache/ServerStatus.h"
@@ -18,6 +18,8 @@ public:
         String ip = AssetCache::GetLocalHost();
         uint16 port = AssetCache::ASSET_SERVER_PORT;
         uint64 timeoutms = 60u * 1000u;
+        uint32 pipelineDepth = 16u; // max number of chunks sent or requested without waiting for response
+        bool compressTraffic = false; // send and request chunks compressed with LZ4
     };
 
     AssetCacheClient();
@@ -29,7 +31,17 @@ public:
     AssetCache::Error AddToCacheSynchronously(const AssetCache::CacheItemKey& key, const AssetCache::CachedItemValue& value);
     AssetCache::Error RequestFromCacheSynchronously(const AssetCache::CacheItemKey& key, AssetCache::CachedItemValue* value);
     AssetCache::Error RemoveFromCacheSynchronously(const AssetCache::CacheItemKey& key);
+
+    // Batched requests: chunks of all items are pipelined over one connection. results[i] corresponds to keys[i]
+    // If latenciesUs is set, it receives time from sending of first chunk of every item till its completion
+    void AddToCacheSynchronously(const Vector<AssetCache::CacheItemKey>& keys, const Vector<const AssetCache::CachedItemValue*>& values, Vector<AssetCache::Error>& results, Vector<uint64>* latenciesUs = nullptr);
+    void RequestFromCacheSynchronously(const Vector<AssetCache::CacheItemKey>& keys, Vector<AssetCache::CachedItemValue>& values, Vector<AssetCache::Error>& results, Vector<uint64>* latenciesUs = nullptr);
+
+    // Received chunks are streamed into temporary file and files of item are exported into folder one by one
+    AssetCache::Error RequestFromCacheToFolderSynchronously(const AssetCache::CacheItemKey& key, const FilePath& folder);
+
     AssetCache::Error ClearCacheSynchronously();
+    AssetCache::Error RequestServerStatusSynchronously(AssetCache::ServerStatus& status);
 
     uint64 GetTimeoutMs() const;
     bool IsConnected() const;
@@ -38,16 +50,27 @@ public:
     void DumpStats() const;
 
 private:
+    struct AddTask;
+    struct GetTask;
+
     AssetCache::Error WaitRequest();
     AssetCache::Error CheckStatusSynchronously();
     void ProcessNetwork();
 
+    void RequestFromCacheInternal(const Vector<AssetCache::CacheItemKey>& keys, Vector<AssetCache::CachedItemValue>* values, const FilePath& folder, Vector<AssetCache::Error>& results, Vector<uint64>* latenciesUs);
+    AssetCache::Error FinishGetTask(GetTask& task, AssetCache::CachedItemValue* value, const FilePath& folder);
+    AssetCache::Error GetInterruptError(); // connection is lost or server doesn't respond for timeoutMs
+    void FailActiveTasks(AssetCache::Error error);
+
+    void UpdateAddStats(AssetCache::Error resultCode);
+    void UpdateGetStats(AssetCache::Error resultCode);
+
     //ClientNetProxyListener
     void OnAddedToCache(const AssetCache::CacheItemKey& key, bool added) override;
     void OnReceivedFromCache(const AssetCache::CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData) override;
     void OnRemovedFromCache(const AssetCache::CacheItemKey& key, bool removed) override;
     void OnCacheCleared(bool cleared) override;
-    void OnServerStatusReceived() override;
+    void OnServerStatusReceived(const AssetCache::ServerStatus& status) override;
     void OnIncorrectPacketReceived(AssetCache::IncorrectPacketType) override;
     void OnClientProxyStateChanged() override;
 
@@ -89,41 +112,38 @@ private:
 
     Dispatcher<Function<void()>> dispatcher;
 
-    struct GetFilesRequest
+    struct AddTask
     {
-        Vector<uint8> receivedData;
-        size_t bytesReceived = 0;
-        size_t bytesRemaining = 0;
-        uint32 chunksReceived = 0;
+        size_t index = 0;
+        AssetCache::CacheItemKey key;
+        ScopedPtr<DynamicMemoryFile> serializedData;
+        uint64 dataSize = 0;
         uint32 chunksOverall = 0;
+        uint32 chunksSent = 0;
+        uint32 chunksAcknowledged = 0;
+        uint64 startTimeUs = 0;
+        AssetCache::Error result = AssetCache::Error::NO_ERRORS;
 
-        void Reset()
-        {
-            receivedData.clear();
-            bytesReceived = 0;
-            bytesRemaining = 0;
-            chunksReceived = 0;
-        }
+        uint32 GetChunksInFlight() const;
+        bool IsFinished() const;
     };
 
-    struct AddFilesRequest
+    struct GetTask
     {
-        AddFilesRequest()
-        {
-            serializedData = DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ);
-            Reset();
-        }
-
-        void Reset()
-        {
-            serializedData->Truncate(0);
-            chunksSent = 0;
-            chunksOverall = 0;
-        }
-
-        ScopedPtr<DynamicMemoryFile> serializedData;
-        uint32 chunksSent = 0;
+        size_t index = 0;
+        AssetCache::CacheItemKey key;
+        ScopedPtr<File> receivedData; // in memory or temporary file on disk
+        FilePath receivedDataPath;
+        uint64 bytesReceived = 0;
+        uint64 bytesOverall = 0;
         uint32 chunksOverall = 0;
+        uint32 chunksRequested = 0;
+        uint32 chunksReceived = 0;
+        uint64 startTimeUs = 0;
+        AssetCache::Error result = AssetCache::Error::NO_ERRORS;
+        bool finished = false;
+
+        uint32 GetChunksInFlight() const;
     };
 
     struct Stats
@@ -145,12 +165,15 @@ private:
     AssetCache::ClientNetProxy client;
 
     uint64 timeoutMs = 60u * 1000u;
+    uint32 pipelineDepth = 16u;
 
     Mutex requestLocker;
     Mutex connectEstablishLocker;
     Request request;
-    GetFilesRequest getFilesRequest;
-    AddFilesRequest addFilesRequest;
+    AssetCache::ServerStatus serverStatus;
+    List<AddTask> addTasks;
+    List<GetTask> getTasks;
+    uint64 lastResponseTime = 0; // tasks time out when server doesn't respond for timeoutMs
 
     Stats stats;
     std::atomic<bool> isActive;
@@ -50,6 +50,7 @@ enum class Error : int32
     UNSUPPORTED_VERSION,
     UNEXPECTED_PACKET,
     WRONG_CHUNK,
+    BENCHMARK_THRESHOLD_FAILED,
 
     ERRORS_COUNT,
 };
@@ -3,6 +3,7 @@
 #include "AssetCache/CacheItemKey.h"
 #include "AssetCache/CachedItemValue.h"
 #include "AssetCache/AssetCacheConstants.h"
+#include "AssetCache/ServerStatus.h"
 
 #include <FileSystem/DynamicMemoryFile.h>
 
@@ -77,8 +78,15 @@ private:
 class DataChunkPacket : public CachePacket
 {
 public:
+    enum eChunkCompression : uint8
+    {
+        CHUNK_UNCOMPRESSED = 0,
+        CHUNK_LZ4
+    };
+
     DataChunkPacket(ePacketID packetId);
-    DataChunkPacket(ePacketID packetId, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+    //chunk data is compressed with LZ4 when compress is true and compression makes it smaller
+    DataChunkPacket(ePacketID packetId, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData, bool compress);
 
 protected:
     bool DeserializeFromBuffer(File* file) override;
@@ -88,7 +96,8 @@ public:
     uint64 dataSize = 0;
     uint32 numOfChunks = 0;
     uint32 chunkNumber = 0;
-    Vector<uint8> chunkData;
+    Vector<uint8> chunkData; // always uncompressed after deserialization
+    bool wasCompressed = false;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -96,7 +105,7 @@ class AddChunkRequestPacket : public DataChunkPacket
 {
 public:
     AddChunkRequestPacket();
-    AddChunkRequestPacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+    AddChunkRequestPacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData, bool compress);
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -119,7 +128,7 @@ class GetChunkRequestPacket : public CachePacket
 {
 public:
     GetChunkRequestPacket();
-    GetChunkRequestPacket(const CacheItemKey& key, uint32 chunkNumber);
+    GetChunkRequestPacket(const CacheItemKey& key, uint32 chunkNumber, bool acceptCompressed);
 
 protected:
     bool DeserializeFromBuffer(File* file) override;
@@ -127,6 +136,7 @@ protected:
 public:
     CacheItemKey key;
     uint32 chunkNumber = 0;
+    bool acceptCompressed = false; // response chunk may be compressed with LZ4
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -134,7 +144,7 @@ class GetChunkResponsePacket : public DataChunkPacket
 {
 public:
     GetChunkResponsePacket();
-    GetChunkResponsePacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+    GetChunkResponsePacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData, bool compress);
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -164,9 +174,13 @@ protected:
 struct StatusResponsePacket : public CachePacket
 {
     StatusResponsePacket();
+    StatusResponsePacket(const ServerStatus& status);
 
 protected:
     bool DeserializeFromBuffer(File* file) override;
+
+public:
+    ServerStatus status;
 };
 
 //////////////////////////////////////////////////////////////////////////
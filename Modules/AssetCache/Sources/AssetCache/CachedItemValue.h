@@ -4,6 +4,7 @@
 #include "Base/BaseTypes.h"
 #include "Base/Data.h"
 #include "FileSystem/FilePath.h"
+#include "Functional/Function.h"
 #include "Utils/MD5.h"
 
 namespace DAVA
@@ -16,10 +17,11 @@ namespace AssetCache
 {
 class CachedItemValue final
 {
+public:
     using ValueData = std::shared_ptr<Vector<uint8>>;
     using ValueDataContainer = Map<String, ValueData>;
+    using FilePathResolver = Function<FilePath(const String& name)>;
 
-public:
     struct Description
     {
         String machineName;
@@ -55,19 +57,24 @@ public:
     void Serialize(KeyedArchive* archieve, bool serializeData) const;
     void Deserialize(KeyedArchive* archieve);
 
-    bool Serialize(File* file) const;
+    bool Serialize(File* file, bool serializeData = true) const;
     bool Deserialize(File* file);
 
     bool operator==(const CachedItemValue& right) const;
 
     bool Fetch(const FilePath& folder);
+    bool Fetch(const FilePathResolver& resolver); //resolver is called for files in order of data container
     void Free();
 
     size_type GetItemCount() const;
+    const ValueDataContainer& GetDataContainer() const;
 
     bool ExportToFolder(const FilePath& folder) const;
     bool ExportToFile(const FilePath& filePath) const;
 
+    // reads value serialized into file and writes its files into folder one by one, without loading of whole value into memory
+    static bool ExportToFolder(File* serializedValue, const FilePath& folder, Description* description = nullptr);
+
     void SetDescription(const Description& description);
     const Description& GetDescription() const;
 
@@ -110,6 +117,11 @@ inline uint64 CachedItemValue::GetSize() const
     return size;
 }
 
+inline const CachedItemValue::ValueDataContainer& CachedItemValue::GetDataContainer() const
+{
+    return dataContainer;
+}
+
 inline const CachedItemValue::Description& CachedItemValue::GetDescription() const
 {
     return description;
@@ -2,6 +2,7 @@
 
 #include "AssetCache/Connection.h"
 #include "AssetCache/CacheItemKey.h"
+#include "AssetCache/ServerStatus.h"
 
 #include <Base/BaseTypes.h>
 #include <Network/IChannel.h>
@@ -30,7 +31,7 @@ public:
     virtual void OnReceivedFromCache(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData){};
     virtual void OnRemovedFromCache(const CacheItemKey& key, bool removed){};
     virtual void OnCacheCleared(bool cleared){};
-    virtual void OnServerStatusReceived(){};
+    virtual void OnServerStatusReceived(const ServerStatus& status){};
     virtual void OnIncorrectPacketReceived(IncorrectPacketType){};
 };
 
@@ -49,6 +50,10 @@ public:
 
     bool ChannelIsOpened() const;
 
+    // chunks are sent and requested compressed with LZ4
+    void SetCompressionEnabled(bool enabled);
+    bool IsCompressionEnabled() const;
+
     // requests to sent on server
     bool RequestServerStatus();
     bool RequestAddNextChunk(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
@@ -82,6 +87,7 @@ private:
     std::shared_ptr<Net::IChannel> openedChannel;
 
     Set<ClientNetProxyListener*> listeners;
+    bool compressionEnabled = false;
 };
 
 inline bool ClientNetProxy::ChannelIsOpened() const
@@ -89,6 +95,16 @@ inline bool ClientNetProxy::ChannelIsOpened() const
     return (openedChannel != nullptr);
 }
 
+inline void ClientNetProxy::SetCompressionEnabled(bool enabled)
+{
+    compressionEnabled = enabled;
+}
+
+inline bool ClientNetProxy::IsCompressionEnabled() const
+{
+    return compressionEnabled;
+}
+
 inline Connection* ClientNetProxy::GetConnection() const
 {
     return netClient.get();
@@ -34,6 +34,8 @@ AssetCache::Error AssetCacheClient::ConnectSynchronously(const ConnectionParams&
 {
     isActive = true;
     timeoutMs = connectionParams.timeoutms;
+    pipelineDepth = std::max(connectionParams.pipelineDepth, 1u);
+    client.SetCompressionEnabled(connectionParams.compressTraffic);
 
     client.Connect(connectionParams.ip, AssetCache::ASSET_SERVER_PORT);
 
@@ -62,6 +64,17 @@ AssetCache::Error AssetCacheClient::ConnectSynchronously(const ConnectionParams&
     return CheckStatusSynchronously();
 }
 
+AssetCache::Error AssetCacheClient::RequestServerStatusSynchronously(AssetCache::ServerStatus& status)
+{
+    AssetCache::Error resultCode = CheckStatusSynchronously();
+    if (resultCode == AssetCache::Error::NO_ERRORS)
+    {
+        LockGuard<Mutex> guard(requestLocker);
+        status = serverStatus;
+    }
+    return resultCode;
+}
+
 void AssetCacheClient::Disconnect()
 {
     isActive = false;
@@ -97,172 +110,471 @@ AssetCache::Error AssetCacheClient::CheckStatusSynchronously()
     return resultCode;
 }
 
+uint32 AssetCacheClient::AddTask::GetChunksInFlight() const
+{
+    return chunksSent - chunksAcknowledged;
+}
+
+bool AssetCacheClient::AddTask::IsFinished() const
+{
+    bool allChunksSent = (chunksSent == chunksOverall) || (result != AssetCache::Error::NO_ERRORS);
+    return allChunksSent && (GetChunksInFlight() == 0);
+}
+
+uint32 AssetCacheClient::GetTask::GetChunksInFlight() const
+{
+    return chunksRequested - chunksReceived;
+}
+
 AssetCache::Error AssetCacheClient::AddToCacheSynchronously(const AssetCache::CacheItemKey& key, const AssetCache::CachedItemValue& value)
 {
-    uint64 dataSizeOverall = 0;
-    uint32 chunksOverall = 0;
+    Vector<AssetCache::Error> results;
+    AddToCacheSynchronously(Vector<AssetCache::CacheItemKey>(1, key), Vector<const AssetCache::CachedItemValue*>(1, &value), results);
+    return results.front();
+}
+
+void AssetCacheClient::AddToCacheSynchronously(const Vector<AssetCache::CacheItemKey>& keys, const Vector<const AssetCache::CachedItemValue*>& values, Vector<AssetCache::Error>& results, Vector<uint64>* latenciesUs)
+{
+    DVASSERT(keys.size() == values.size());
+
+    results.assign(keys.size(), AssetCache::Error::CODE_NOT_INITIALIZED);
+    if (latenciesUs != nullptr)
     {
-        LockGuard<Mutex> guard(requestLocker);
-        request = Request(AssetCache::PACKET_ADD_CHUNK_REQUEST, key);
-        addFilesRequest.Reset();
-        value.Serialize(addFilesRequest.serializedData);
-        dataSizeOverall = addFilesRequest.serializedData->GetSize();
-        chunksOverall = AssetCache::ChunkSplitter::GetNumberOfChunks(dataSizeOverall);
-        addFilesRequest.chunksSent = 0;
+        latenciesUs->assign(keys.size(), 0);
     }
 
-    AssetCache::Error resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
+    {
+        LockGuard<Mutex> guard(requestLocker);
+        addTasks.clear();
+        lastResponseTime = SystemTimer::GetMs();
+    }
 
-    for (uint32 currentChunk = 0; currentChunk < chunksOverall; ++currentChunk)
+    auto SendNextChunk = [this](AddTask& task)
     {
-        Vector<uint8> chunkData;
+        Vector<uint8> chunkData = AssetCache::ChunkSplitter::GetChunk(task.serializedData->GetDataVector(), task.chunksSent);
+        if (client.RequestAddNextChunk(task.key, task.dataSize, task.chunksOverall, task.chunksSent, chunkData))
         {
-            LockGuard<Mutex> guard(requestLocker);
-            request = Request(AssetCache::PACKET_ADD_CHUNK_REQUEST, key);
-            chunkData = AssetCache::ChunkSplitter::GetChunk(addFilesRequest.serializedData->GetDataVector(), currentChunk);
+            ++task.chunksSent;
+            return true;
         }
 
-        resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
+        task.result = AssetCache::Error::CANNOT_SEND_REQUEST;
+        return false;
+    };
 
-        bool requestSent = client.RequestAddNextChunk(key, dataSizeOverall, chunksOverall, currentChunk, chunkData);
-        if (requestSent)
+    size_t nextItem = 0;
+    while (true)
+    {
         {
-            resultCode = WaitRequest();
+            LockGuard<Mutex> guard(requestLocker);
+
+            uint32 chunksInFlight = 0;
+            for (const AddTask& task : addTasks)
+            {
+                chunksInFlight += task.GetChunksInFlight();
+            }
+
+            // start new items in order of keys. Items with the same key are sent one after another
+            while ((nextItem < keys.size()) && (chunksInFlight < pipelineDepth))
+            {
+                const AssetCache::CacheItemKey& key = keys[nextItem];
+                bool keyIsBusy = std::any_of(addTasks.begin(), addTasks.end(), [&key](const AddTask& task) { return task.key == key; });
+                if (keyIsBusy)
+                {
+                    break;
+                }
+
+                AddTask& task = *addTasks.emplace(addTasks.end());
+                task.index = nextItem++;
+                task.key = key;
+                task.startTimeUs = static_cast<uint64>(SystemTimer::GetUs());
+                task.serializedData = DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ);
+                values[task.index]->Serialize(task.serializedData);
+                task.dataSize = task.serializedData->GetSize();
+                task.chunksOverall = AssetCache::ChunkSplitter::GetNumberOfChunks(task.dataSize);
+                if (task.chunksOverall == 0)
+                {
+                    task.result = AssetCache::Error::READ_FILES_ERROR;
+                }
+                else if (SendNextChunk(task))
+                {
+                    ++chunksInFlight;
+                }
+            }
+
+            for (AddTask& task : addTasks)
+            {
+                while ((task.result == AssetCache::Error::NO_ERRORS) && (task.chunksSent < task.chunksOverall) && (chunksInFlight < pipelineDepth) && SendNextChunk(task))
+                {
+                    ++chunksInFlight;
+                }
+            }
+
+            for (auto it = addTasks.begin(); it != addTasks.end();)
+            {
+                if (it->IsFinished())
+                {
+                    results[it->index] = it->result;
+                    if (latenciesUs != nullptr)
+                    {
+                        (*latenciesUs)[it->index] = static_cast<uint64>(SystemTimer::GetUs()) - it->startTimeUs;
+                    }
+                    UpdateAddStats(it->result);
+                    it = addTasks.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            if (nextItem == keys.size() && addTasks.empty())
+            {
+                break;
+            }
         }
 
+        ProcessNetwork();
+
+        AssetCache::Error interruptError = GetInterruptError();
+        if (interruptError != AssetCache::Error::NO_ERRORS)
         {
+            FailActiveTasks(interruptError);
+
             LockGuard<Mutex> guard(requestLocker);
-            request.Reset();
-        }
+            for (AddTask& task : addTasks)
+            {
+                results[task.index] = task.result;
+                if (latenciesUs != nullptr)
+                {
+                    (*latenciesUs)[task.index] = static_cast<uint64>(SystemTimer::GetUs()) - task.startTimeUs;
+                }
+                UpdateAddStats(task.result);
+            }
+            addTasks.clear();
 
-        if (resultCode != AssetCache::Error::NO_ERRORS)
-        {
+            for (; nextItem < keys.size(); ++nextItem)
+            {
+                results[nextItem] = interruptError;
+                UpdateAddStats(interruptError);
+            }
             break;
         }
     }
+}
 
-    { //process stats
-        ++stats.addRequestsCount;
-        switch (resultCode)
-        {
-        case AssetCache::Error::NO_ERRORS:
-            ++stats.addRequestsSucceedCount;
-            break;
-        case AssetCache::Error::OPERATION_TIMEOUT:
-            ++stats.addRequestsTimeoutCount;
-            break;
+void AssetCacheClient::UpdateAddStats(AssetCache::Error resultCode)
+{
+    ++stats.addRequestsCount;
+    switch (resultCode)
+    {
+    case AssetCache::Error::NO_ERRORS:
+        ++stats.addRequestsSucceedCount;
+        break;
+    case AssetCache::Error::OPERATION_TIMEOUT:
+        ++stats.addRequestsTimeoutCount;
+        break;
 
-        default:
-            ++stats.addRequestsFailedCount;
-            break;
-        }
+    default:
+        ++stats.addRequestsFailedCount;
+        break;
     }
-
-    return resultCode;
 }
 
 AssetCache::Error AssetCacheClient::RequestFromCacheSynchronously(const AssetCache::CacheItemKey& key, AssetCache::CachedItemValue* value)
 {
     DVASSERT(value != nullptr);
 
+    Vector<AssetCache::CachedItemValue> values;
+    Vector<AssetCache::Error> results;
+    RequestFromCacheInternal(Vector<AssetCache::CacheItemKey>(1, key), &values, FilePath(), results, nullptr);
+    if (results.front() == AssetCache::Error::NO_ERRORS)
     {
-        LockGuard<Mutex> guard(requestLocker);
-        request = Request(AssetCache::PACKET_GET_CHUNK_REQUEST, key);
-        getFilesRequest.Reset();
+        *value = std::move(values.front());
     }
+    return results.front();
+}
 
-    AssetCache::Error resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
+void AssetCacheClient::RequestFromCacheSynchronously(const Vector<AssetCache::CacheItemKey>& keys, Vector<AssetCache::CachedItemValue>& values, Vector<AssetCache::Error>& results, Vector<uint64>* latenciesUs)
+{
+    RequestFromCacheInternal(keys, &values, FilePath(), results, latenciesUs);
+}
 
-    bool requestSent = client.RequestGetNextChunk(key, 0);
-    if (requestSent)
+AssetCache::Error AssetCacheClient::RequestFromCacheToFolderSynchronously(const AssetCache::CacheItemKey& key, const FilePath& folder)
+{
+    DVASSERT(folder.IsDirectoryPathname());
+
+    Vector<AssetCache::Error> results;
+    RequestFromCacheInternal(Vector<AssetCache::CacheItemKey>(1, key), nullptr, folder, results, nullptr);
+    return results.front();
+}
+
+void AssetCacheClient::RequestFromCacheInternal(const Vector<AssetCache::CacheItemKey>& keys, Vector<AssetCache::CachedItemValue>* values, const FilePath& folder, Vector<AssetCache::Error>& results, Vector<uint64>* latenciesUs)
+{
+    DVASSERT((values != nullptr) != (folder.IsEmpty() == false));
+
+    results.assign(keys.size(), AssetCache::Error::CODE_NOT_INITIALIZED);
+    if (latenciesUs != nullptr)
     {
-        resultCode = WaitRequest();
+        latenciesUs->assign(keys.size(), 0);
+    }
+    if (values != nullptr)
+    {
+        values->clear();
+        values->resize(keys.size());
     }
 
-    uint32 chunksOverall = 0;
     {
         LockGuard<Mutex> guard(requestLocker);
-        request.Reset();
-        chunksOverall = getFilesRequest.chunksOverall;
+        getTasks.clear();
+        lastResponseTime = SystemTimer::GetMs();
     }
 
-    if (resultCode == AssetCache::Error::NO_ERRORS)
+    size_t nextItem = 0;
+    while (true)
     {
-        DVASSERT(chunksOverall > 0);
-        for (uint32 currentChunk = 1; currentChunk < chunksOverall; ++currentChunk)
+        List<GetTask> finishedTasks;
+        bool allItemsProcessed = false;
         {
+            LockGuard<Mutex> guard(requestLocker);
+
+            uint32 chunksInFlight = 0;
+            for (const GetTask& task : getTasks)
             {
-                LockGuard<Mutex> guard(requestLocker);
-                request = Request(AssetCache::PACKET_GET_CHUNK_REQUEST, key);
+                chunksInFlight += task.GetChunksInFlight();
             }
 
-            resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
+            // request first chunks of new items. Items with the same key are requested one after another
+            while ((nextItem < keys.size()) && (chunksInFlight < pipelineDepth))
+            {
+                const AssetCache::CacheItemKey& key = keys[nextItem];
+                bool keyIsBusy = std::any_of(getTasks.begin(), getTasks.end(), [&key](const GetTask& task) { return task.key == key; });
+                if (keyIsBusy)
+                {
+                    break;
+                }
+
+                GetTask& task = *getTasks.emplace(getTasks.end());
+                task.index = nextItem++;
+                task.key = key;
+                task.startTimeUs = static_cast<uint64>(SystemTimer::GetUs());
+                if (values != nullptr)
+                {
+                    task.receivedData = DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ);
+                }
+                else
+                {
+                    task.receivedDataPath = FileSystem::Instance()->GetTempDirectoryPath() + (key.ToString() + ".cacheitem");
+                    task.receivedData = File::Create(task.receivedDataPath, File::CREATE | File::WRITE | File::READ);
+                }
+
+                if (!task.receivedData)
+                {
+                    task.result = AssetCache::Error::READ_FILES_ERROR;
+                    task.finished = true;
+                }
+                else if (client.RequestGetNextChunk(key, 0))
+                {
+                    task.chunksRequested = 1;
+                    ++chunksInFlight;
+                }
+                else
+                {
+                    task.result = AssetCache::Error::CANNOT_SEND_REQUEST;
+                    task.finished = true;
+                }
+            }
 
-            bool requestSent = client.RequestGetNextChunk(key, currentChunk);
-            if (requestSent)
+            // request next chunks as soon as number of chunks is known
+            for (GetTask& task : getTasks)
             {
-                resultCode = WaitRequest();
+                while ((task.finished == false) && (task.chunksReceived > 0) && (task.chunksRequested < task.chunksOverall) && (chunksInFlight < pipelineDepth))
+                {
+                    if (client.RequestGetNextChunk(task.key, task.chunksRequested))
+                    {
+                        ++task.chunksRequested;
+                        ++chunksInFlight;
+                    }
+                    else
+                    {
+                        task.result = AssetCache::Error::CANNOT_SEND_REQUEST;
+                        task.finished = true;
+                    }
+                }
             }
 
+            for (auto it = getTasks.begin(); it != getTasks.end();)
             {
-                LockGuard<Mutex> guard(requestLocker);
-                request.Reset();
+                auto itNext = std::next(it);
+                if (it->finished)
+                {
+                    finishedTasks.splice(finishedTasks.end(), getTasks, it);
+                }
+                it = itNext;
             }
 
-            if (resultCode != AssetCache::Error::NO_ERRORS)
+            allItemsProcessed = (nextItem == keys.size()) && getTasks.empty();
+        }
+
+        // heavy deserialization is done out of lock
+        for (GetTask& task : finishedTasks)
+        {
+            AssetCache::CachedItemValue* value = (values != nullptr) ? &(*values)[task.index] : nullptr;
+            results[task.index] = FinishGetTask(task, value, folder);
+            if (latenciesUs != nullptr)
             {
-                break;
+                (*latenciesUs)[task.index] = static_cast<uint64>(SystemTimer::GetUs()) - task.startTimeUs;
             }
+            UpdateGetStats(results[task.index]);
         }
 
-        if (resultCode == AssetCache::Error::NO_ERRORS)
+        if (allItemsProcessed)
         {
-            LockGuard<Mutex> guard(requestLocker);
-            if (getFilesRequest.chunksReceived == getFilesRequest.chunksOverall && getFilesRequest.bytesRemaining == 0)
+            break;
+        }
+
+        ProcessNetwork();
+
+        AssetCache::Error interruptError = GetInterruptError();
+        if (interruptError != AssetCache::Error::NO_ERRORS)
+        {
+            FailActiveTasks(interruptError);
+
+            List<GetTask> canceledTasks;
+            {
+                LockGuard<Mutex> guard(requestLocker);
+                canceledTasks.swap(getTasks);
+            }
+
+            for (GetTask& task : canceledTasks)
             {
-                ScopedPtr<DynamicMemoryFile> f(DynamicMemoryFile::Create(std::move(getFilesRequest.receivedData), File::OPEN | File::READ, "receivedData"));
-                value->Deserialize(f);
-
-                const AssetCache::CachedItemValue::Description& description = value->GetDescription();
-                Logger::Info("Data got from cache. Generated %s on machine %s (%s)",
-                             description.creationDate.c_str(),
-                             description.machineName.c_str(),
-                             description.comment.c_str());
+                results[task.index] = FinishGetTask(task, nullptr, FilePath());
+                if (latenciesUs != nullptr)
+                {
+                    (*latenciesUs)[task.index] = static_cast<uint64>(SystemTimer::GetUs()) - task.startTimeUs;
+                }
+                UpdateGetStats(results[task.index]);
             }
-            else
+
+            for (; nextItem < keys.size(); ++nextItem)
             {
-                Logger::Error("Packet was not completely transferred. Chunks %u/%u, bytes remaining: %u",
-                              getFilesRequest.chunksReceived,
-                              getFilesRequest.chunksOverall,
-                              getFilesRequest.bytesRemaining);
-                resultCode = AssetCache::Error::CORRUPTED_DATA;
+                results[nextItem] = interruptError;
+                UpdateGetStats(interruptError);
             }
+            break;
         }
     }
+}
+
+AssetCache::Error AssetCacheClient::FinishGetTask(GetTask& task, AssetCache::CachedItemValue* value, const FilePath& folder)
+{
+    AssetCache::Error resultCode = task.result;
+    if (resultCode == AssetCache::Error::NO_ERRORS && (task.chunksReceived != task.chunksOverall || task.bytesReceived != task.bytesOverall))
+    {
+        Logger::Error("Packet was not completely transferred. Chunks %u/%u, bytes remaining: %llu",
+                      task.chunksReceived,
+                      task.chunksOverall,
+                      task.bytesOverall - task.bytesReceived);
+        resultCode = AssetCache::Error::CORRUPTED_DATA;
+    }
 
-    { //process stats
-        ++stats.getRequestsCount;
-        switch (resultCode)
+    if (resultCode == AssetCache::Error::NO_ERRORS && (value != nullptr || folder.IsEmpty() == false))
+    {
+        task.receivedData->Seek(0, File::SEEK_FROM_START);
+
+        AssetCache::CachedItemValue::Description description;
+        bool loaded = false;
+        if (value != nullptr)
         {
-        case AssetCache::Error::NO_ERRORS:
-            ++stats.getRequestsSucceedCount;
-            break;
-        case AssetCache::Error::OPERATION_TIMEOUT:
-            ++stats.getRequestsTimeoutCount;
-            break;
-        case AssetCache::Error::NOT_FOUND_ON_SERVER:
-            ++stats.getRequestsNotFoundCount;
-            break;
+            loaded = value->Deserialize(task.receivedData);
+            description = value->GetDescription();
+        }
+        else
+        {
+            loaded = AssetCache::CachedItemValue::ExportToFolder(task.receivedData, folder, &description);
+        }
 
-        default:
-            ++stats.getRequestsFailedCount;
-            break;
+        if (loaded)
+        {
+            Logger::Info("Data got from cache. Generated %s on machine %s (%s)",
+                         description.creationDate.c_str(),
+                         description.machineName.c_str(),
+                         description.comment.c_str());
+        }
+        else
+        {
+            resultCode = AssetCache::Error::CORRUPTED_DATA;
         }
     }
 
+    task.receivedData.reset();
+    if (task.receivedDataPath.IsEmpty() == false)
+    {
+        FileSystem::Instance()->DeleteFile(task.receivedDataPath);
+    }
+
     return resultCode;
 }
 
+void AssetCacheClient::UpdateGetStats(AssetCache::Error resultCode)
+{
+    ++stats.getRequestsCount;
+    switch (resultCode)
+    {
+    case AssetCache::Error::NO_ERRORS:
+        ++stats.getRequestsSucceedCount;
+        break;
+    case AssetCache::Error::OPERATION_TIMEOUT:
+        ++stats.getRequestsTimeoutCount;
+        break;
+    case AssetCache::Error::NOT_FOUND_ON_SERVER:
+        ++stats.getRequestsNotFoundCount;
+        break;
+
+    default:
+        ++stats.getRequestsFailedCount;
+        break;
+    }
+}
+
+AssetCache::Error AssetCacheClient::GetInterruptError()
+{
+    if (!isActive)
+    {
+        return AssetCache::Error::CANNOT_CONNECT;
+    }
+
+    LockGuard<Mutex> guard(requestLocker);
+    if ((timeoutMs > 0) && (SystemTimer::GetMs() - lastResponseTime > timeoutMs))
+    {
+        Logger::FrameworkDebug("Operation timeout: (%lld ms)", timeoutMs);
+        return AssetCache::Error::OPERATION_TIMEOUT;
+    }
+
+    return AssetCache::Error::NO_ERRORS;
+}
+
+void AssetCacheClient::FailActiveTasks(AssetCache::Error error)
+{
+    LockGuard<Mutex> guard(requestLocker);
+    for (AddTask& task : addTasks)
+    {
+        if (task.result == AssetCache::Error::NO_ERRORS)
+        {
+            task.result = error;
+        }
+    }
+
+    for (GetTask& task : getTasks)
+    {
+        if (task.finished == false)
+        {
+            task.result = error;
+            task.finished = true;
+        }
+    }
+}
+
 AssetCache::Error AssetCacheClient::RemoveFromCacheSynchronously(const AssetCache::CacheItemKey& key)
 {
     {
@@ -354,11 +666,12 @@ AssetCache::Error AssetCacheClient::WaitRequest()
     return currentRequest.result;
 }
 
-void AssetCacheClient::OnServerStatusReceived()
+void AssetCacheClient::OnServerStatusReceived(const AssetCache::ServerStatus& status)
 {
     LockGuard<Mutex> guard(requestLocker);
     if (request.requestID == AssetCache::PACKET_STATUS_REQUEST)
     {
+        serverStatus = status;
         request.result = AssetCache::Error::NO_ERRORS;
         request.recieved = true;
         request.processingRequest = false;
@@ -372,12 +685,17 @@ void AssetCacheClient::OnServerStatusReceived()
 void AssetCacheClient::OnAddedToCache(const AssetCache::CacheItemKey& key, bool added)
 {
     LockGuard<Mutex> guard(requestLocker);
+    lastResponseTime = SystemTimer::GetMs();
 
-    if ((request.requestID == AssetCache::PACKET_ADD_CHUNK_REQUEST) && request.key == key)
+    auto it = std::find_if(addTasks.begin(), addTasks.end(), [&key](const AddTask& task) { return task.key == key; });
+    if (it != addTasks.end() && it->GetChunksInFlight() > 0)
     {
-        request.result = (added) ? AssetCache::Error::NO_ERRORS : AssetCache::Error::SERVER_ERROR;
-        request.recieved = true;
-        request.processingRequest = false;
+        AddTask& task = *it;
+        ++task.chunksAcknowledged;
+        if (!added && task.result == AssetCache::Error::NO_ERRORS)
+        {
+            task.result = AssetCache::Error::SERVER_ERROR;
+        }
     }
     else
     {
@@ -388,59 +706,62 @@ void AssetCacheClient::OnAddedToCache(const AssetCache::CacheItemKey& key, bool
 void AssetCacheClient::OnReceivedFromCache(const AssetCache::CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData)
 {
     LockGuard<Mutex> guard(requestLocker);
+    lastResponseTime = SystemTimer::GetMs();
 
-    if (request.requestID == AssetCache::PACKET_GET_CHUNK_REQUEST && request.key == key)
+    auto it = std::find_if(getTasks.begin(), getTasks.end(), [&key](const GetTask& task) { return task.key == key && task.finished == false; });
+    if (it == getTasks.end())
     {
-        if (getFilesRequest.chunksReceived == 0)
-        {
-            if (dataSize == 0 || numOfChunks == 0)
-            {
-                request.result = AssetCache::Error::NOT_FOUND_ON_SERVER;
-                request.recieved = true;
-                request.processingRequest = false;
-                return;
-            }
-            else
-            {
-                request.result = AssetCache::Error::NO_ERRORS;
-                getFilesRequest.chunksOverall = numOfChunks;
-                getFilesRequest.bytesRemaining = static_cast<size_t>(dataSize);
-                getFilesRequest.receivedData.resize(getFilesRequest.bytesRemaining);
-                Logger::FrameworkDebug("Received info: %u bytes, %u chunks", dataSize, numOfChunks);
-            }
-        }
+        //skip this request, because it was canceled by timeout
+        return;
+    }
 
-        if (chunkData.empty())
-        {
-            request.result = AssetCache::Error::NOT_FOUND_ON_SERVER;
-        }
-        else if (chunkNumber != getFilesRequest.chunksReceived)
+    GetTask& task = *it;
+    if (task.chunksReceived == 0)
+    {
+        if (dataSize == 0 || numOfChunks == 0)
         {
-            Logger::Error("Wrong chunk: expected #%u, received #%u", getFilesRequest.chunksReceived, chunkNumber);
-            request.result = AssetCache::Error::WRONG_CHUNK;
+            task.result = AssetCache::Error::NOT_FOUND_ON_SERVER;
+            task.finished = true;
+            return;
         }
-        else if (getFilesRequest.bytesRemaining < chunkData.size())
+
+        task.chunksOverall = numOfChunks;
+        task.bytesOverall = dataSize;
+        Logger::FrameworkDebug("Received info: %llu bytes, %u chunks", dataSize, numOfChunks);
+    }
+
+    uint64 bytesRemaining = task.bytesOverall - task.bytesReceived;
+    if (chunkData.empty())
+    {
+        task.result = AssetCache::Error::NOT_FOUND_ON_SERVER;
+    }
+    else if (chunkNumber != task.chunksReceived)
+    {
+        Logger::Error("Wrong chunk: expected #%u, received #%u", task.chunksReceived, chunkNumber);
+        task.result = AssetCache::Error::WRONG_CHUNK;
+    }
+    else if (bytesRemaining < chunkData.size())
+    {
+        Logger::Error("Chunk #%u size is too big. Remaining bytes: %llu, received chunk size: %u", chunkNumber, bytesRemaining, static_cast<uint32>(chunkData.size()));
+        task.result = AssetCache::Error::WRONG_CHUNK;
+    }
+    else
+    {
+        uint32 chunkSize = static_cast<uint32>(chunkData.size());
+        if (task.receivedData->Write(chunkData.data(), chunkSize) == chunkSize)
         {
-            Logger::Error("Chunk #%u size is too big. Remaining bytes: %u, received chunk size: ", chunkNumber, getFilesRequest.bytesRemaining, chunkData.size());
-            request.result = AssetCache::Error::WRONG_CHUNK;
+            task.bytesReceived += chunkSize;
+            ++task.chunksReceived;
+            Logger::FrameworkDebug("Chunk #%u received: %u bytes. Overall received %llu, remaining %llu", chunkNumber, chunkSize, task.bytesReceived, task.bytesOverall - task.bytesReceived);
         }
         else
         {
-            request.result = AssetCache::Error::NO_ERRORS;
-            Memcpy(getFilesRequest.receivedData.data() + getFilesRequest.bytesReceived, chunkData.data(), chunkData.size());
-            getFilesRequest.bytesReceived += chunkData.size();
-            getFilesRequest.bytesRemaining -= chunkData.size();
-            ++(getFilesRequest.chunksReceived);
-            Logger::FrameworkDebug("Chunk #%u received: %u bytes. Overall received %u, remaining %u", chunkNumber, chunkData.size(), getFilesRequest.bytesReceived, getFilesRequest.bytesRemaining);
+            Logger::Error("Can't write %u bytes of chunk #%u", chunkSize, chunkNumber);
+            task.result = AssetCache::Error::READ_FILES_ERROR;
         }
-
-        request.recieved = true;
-        request.processingRequest = false;
-    }
-    else
-    {
-        //skip this request, because it was canceled by timeout
     }
+
+    task.finished = (task.result != AssetCache::Error::NO_ERRORS) || (task.chunksReceived == task.chunksOverall);
 }
 
 void AssetCacheClient::OnRemovedFromCache(const AssetCache::CacheItemKey& key, bool removed)
@@ -475,27 +796,32 @@ void AssetCacheClient::OnCacheCleared(bool cleared)
 
 void AssetCacheClient::OnIncorrectPacketReceived(AssetCache::IncorrectPacketType type)
 {
-    LockGuard<Mutex> guard(requestLocker);
-    ++stats.incorrectPacketsCount;
-    request.recieved = true;
-    request.processingRequest = false;
-
+    AssetCache::Error error = AssetCache::Error::CORRUPTED_DATA;
     switch (type)
     {
     case AssetCache::IncorrectPacketType::UNDEFINED_DATA:
-        request.result = AssetCache::Error::CORRUPTED_DATA;
+        error = AssetCache::Error::CORRUPTED_DATA;
         break;
     case AssetCache::IncorrectPacketType::UNSUPPORTED_VERSION:
-        request.result = AssetCache::Error::UNSUPPORTED_VERSION;
+        error = AssetCache::Error::UNSUPPORTED_VERSION;
         break;
     case AssetCache::IncorrectPacketType::UNEXPECTED_PACKET:
-        request.result = AssetCache::Error::UNEXPECTED_PACKET;
+        error = AssetCache::Error::UNEXPECTED_PACKET;
         break;
     default:
         DVASSERT(false, Format("Unexpected incorrect packet type: %d", type).c_str());
-        request.result = AssetCache::Error::CORRUPTED_DATA;
         break;
     }
+
+    { // we cannot know which of pipelined requests the packet belongs to
+        LockGuard<Mutex> guard(requestLocker);
+        ++stats.incorrectPacketsCount;
+        request.recieved = true;
+        request.processingRequest = false;
+        request.result = error;
+    }
+
+    FailActiveTasks(error);
 }
 
 void AssetCacheClient::OnClientProxyStateChanged()
@@ -504,10 +830,14 @@ void AssetCacheClient::OnClientProxyStateChanged()
     {
         isActive = false;
 
-        LockGuard<Mutex> guard(requestLocker);
-        request.recieved = true;
-        request.processingRequest = false;
-        request.result = AssetCache::Error::CANNOT_CONNECT;
+        {
+            LockGuard<Mutex> guard(requestLocker);
+            request.recieved = true;
+            request.processingRequest = false;
+            request.result = AssetCache::Error::CANNOT_CONNECT;
+        }
+
+        FailActiveTasks(AssetCache::Error::CANNOT_CONNECT);
     }
 }
 
@@ -58,7 +58,8 @@ String ErrorToString(Error error)
     { Error::CORRUPTED_DATA, "CORRUPTED_DATA" },
     { Error::UNSUPPORTED_VERSION, "UNSUPPORTED_VERSION" },
     { Error::UNEXPECTED_PACKET, "UNEXPECTED_PACKET" },
-    { Error::WRONG_CHUNK, "WRONG_CHUNK" }
+    { Error::WRONG_CHUNK, "WRONG_CHUNK" },
+    { Error::BENCHMARK_THRESHOLD_FAILED, "BENCHMARK_THRESHOLD_FAILED" }
     } };
 
     DVASSERT(static_cast<uint32>(Error::ERRORS_COUNT) == errorStrings.size());
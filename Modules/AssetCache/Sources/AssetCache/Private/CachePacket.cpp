@@ -3,13 +3,16 @@
 #include <FileSystem/DynamicMemoryFile.h>
 #include <Network/IChannel.h>
 #include <Logger/Logger.h>
+#include <Compression/LZ4Compressor.h>
+
+#include <lz4/lz4.h>
 
 namespace DAVA
 {
 namespace AssetCache
 {
 const uint16 PACKET_HEADER = 0xACCA;
-const uint8 PACKET_VERSION = 3;
+const uint8 PACKET_VERSION = 5;
 
 Map<const uint8*, ScopedPtr<DynamicMemoryFile>> CachePacket::sendingPackets;
 
@@ -39,6 +42,46 @@ bool ReadFromBuffer(File* buffer, Vector<uint8>& data, uint32 dataSize)
         return true;
     }
 };
+
+bool CompressChunk(const Vector<uint8>& chunkData, Vector<uint8>& compressedData)
+{
+    if (chunkData.empty())
+    {
+        return false;
+    }
+
+    LZ4Compressor compressor;
+    if (compressor.Compress(chunkData, compressedData) == false)
+    {
+        return false;
+    }
+
+    // incompressible data is sent as is
+    return (compressedData.size() < chunkData.size());
+}
+
+bool ReadCompressedFromBuffer(File* buffer, Vector<uint8>& data, uint32 dataSize, uint32 compressedSize)
+{
+    // lz4 can't expand data more than 255 times, so bigger sizes are malformed and aren't allocated
+    const uint64 maxDataSize = static_cast<uint64>(compressedSize) * 255 + 16;
+    Vector<uint8> compressedData;
+    if (compressedSize == 0 || compressedSize >= dataSize || dataSize > maxDataSize || !ReadFromBuffer(buffer, compressedData, compressedSize))
+    {
+        return false;
+    }
+
+    // sizes come from peer, so chunk is decoded with bounds checks and should fill data exactly
+    data.resize(dataSize);
+    int decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char*>(compressedData.data()), reinterpret_cast<char*>(data.data()),
+                                               static_cast<int>(compressedData.size()), static_cast<int>(data.size()));
+    if (decompressedSize < 0 || static_cast<uint32>(decompressedSize) != dataSize)
+    {
+        Logger::Error("[CachePacket::%s] Cannot decompress chunk of %u bytes into %u bytes", __FUNCTION__, compressedSize, dataSize);
+        return false;
+    }
+
+    return true;
+}
 }
 
 bool CachePacket::SendTo(std::shared_ptr<Net::IChannel> channel)
@@ -155,7 +198,7 @@ void CachePacket::WriteHeader(File* file) const
 }
 
 //////////////////////////////////////////////////////////////////////////
-DataChunkPacket::DataChunkPacket(ePacketID packetId, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData)
+DataChunkPacket::DataChunkPacket(ePacketID packetId, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData, bool compress)
     : CachePacket(packetId, CREATE_SENDING_BUFFER)
 {
     WriteHeader(serializationBuffer);
@@ -163,12 +206,23 @@ DataChunkPacket::DataChunkPacket(ePacketID packetId, const CacheItemKey& key, ui
     uint32 keySize = static_cast<uint32>(key.size());
     uint32 chunkDataSize = static_cast<uint32>(chunkData.size());
 
+    Vector<uint8> compressedData;
+    wasCompressed = compress && CachePacketDetails::CompressChunk(chunkData, compressedData);
+    uint8 compression = wasCompressed ? CHUNK_LZ4 : CHUNK_UNCOMPRESSED;
+
     serializationBuffer->Write(key.data(), keySize);
     serializationBuffer->Write(&dataSize, sizeof(dataSize));
     serializationBuffer->Write(&numOfChunks, sizeof(numOfChunks));
     serializationBuffer->Write(&chunkNumber, sizeof(chunkNumber));
     serializationBuffer->Write(&chunkDataSize, sizeof(chunkDataSize));
-    if (chunkDataSize > 0)
+    serializationBuffer->Write(&compression, sizeof(compression));
+    if (wasCompressed)
+    {
+        uint32 compressedSize = static_cast<uint32>(compressedData.size());
+        serializationBuffer->Write(&compressedSize, sizeof(compressedSize));
+        serializationBuffer->Write(compressedData.data(), compressedSize);
+    }
+    else if (chunkDataSize > 0)
     {
         serializationBuffer->Write(chunkData.data(), chunkDataSize);
     }
@@ -184,17 +238,38 @@ bool DataChunkPacket::DeserializeFromBuffer(File* buffer)
     using namespace CachePacketDetails;
 
     uint32 chunkDataSize = 0;
-    return (ReadFromBuffer(buffer, key)
-            && ReadFromBuffer(buffer, dataSize)
-            && ReadFromBuffer(buffer, numOfChunks)
-            && ReadFromBuffer(buffer, chunkNumber)
-            && ReadFromBuffer(buffer, chunkDataSize)
-            && ReadFromBuffer(buffer, chunkData, chunkDataSize));
+    uint8 compression = CHUNK_UNCOMPRESSED;
+    bool headerRead = (ReadFromBuffer(buffer, key)
+                       && ReadFromBuffer(buffer, dataSize)
+                       && ReadFromBuffer(buffer, numOfChunks)
+                       && ReadFromBuffer(buffer, chunkNumber)
+                       && ReadFromBuffer(buffer, chunkDataSize)
+                       && ReadFromBuffer(buffer, compression));
+    if (!headerRead)
+    {
+        return false;
+    }
+
+    switch (compression)
+    {
+    case CHUNK_UNCOMPRESSED:
+        wasCompressed = false;
+        return ReadFromBuffer(buffer, chunkData, chunkDataSize);
+    case CHUNK_LZ4:
+    {
+        wasCompressed = true;
+        uint32 compressedSize = 0;
+        return ReadFromBuffer(buffer, compressedSize) && ReadCompressedFromBuffer(buffer, chunkData, chunkDataSize, compressedSize);
+    }
+    default:
+        Logger::Error("[DataChunkPacket::%s] Unknown chunk compression: %u", __FUNCTION__, compression);
+        return false;
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////
-AddChunkRequestPacket::AddChunkRequestPacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData)
-    : DataChunkPacket(PACKET_ADD_CHUNK_REQUEST, key, dataSize, numOfChunks, chunkNumber, chunkData)
+AddChunkRequestPacket::AddChunkRequestPacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData, bool compress)
+    : DataChunkPacket(PACKET_ADD_CHUNK_REQUEST, key, dataSize, numOfChunks, chunkNumber, chunkData, compress)
 {
 }
 
@@ -225,13 +300,14 @@ bool AddResponsePacket::DeserializeFromBuffer(File* file)
 }
 
 //////////////////////////////////////////////////////////////////////////
-GetChunkRequestPacket::GetChunkRequestPacket(const CacheItemKey& key_, uint32 chunkNumber)
+GetChunkRequestPacket::GetChunkRequestPacket(const CacheItemKey& key_, uint32 chunkNumber, bool acceptCompressed)
     : CachePacket(PACKET_GET_CHUNK_REQUEST, CREATE_SENDING_BUFFER)
 {
     WriteHeader(serializationBuffer);
 
     serializationBuffer->Write(key_.data(), static_cast<uint32>(key_.size()));
     serializationBuffer->Write(&chunkNumber, sizeof(chunkNumber));
+    serializationBuffer->Write(&acceptCompressed, sizeof(acceptCompressed));
 }
 
 GetChunkRequestPacket::GetChunkRequestPacket()
@@ -242,12 +318,12 @@ GetChunkRequestPacket::GetChunkRequestPacket()
 bool GetChunkRequestPacket::DeserializeFromBuffer(File* buffer)
 {
     using namespace CachePacketDetails;
-    return ReadFromBuffer(buffer, key) && ReadFromBuffer(buffer, chunkNumber);
+    return ReadFromBuffer(buffer, key) && ReadFromBuffer(buffer, chunkNumber) && ReadFromBuffer(buffer, acceptCompressed);
 }
 
 //////////////////////////////////////////////////////////////////////////
-GetChunkResponsePacket::GetChunkResponsePacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData)
-    : DataChunkPacket(PACKET_GET_CHUNK_RESPONSE, key, dataSize, numOfChunks, chunkNumber, chunkData)
+GetChunkResponsePacket::GetChunkResponsePacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData, bool compress)
+    : DataChunkPacket(PACKET_GET_CHUNK_RESPONSE, key, dataSize, numOfChunks, chunkNumber, chunkData, compress)
 {
 }
 
@@ -289,15 +365,33 @@ bool StatusRequestPacket::DeserializeFromBuffer(File* file)
 }
 
 //////////////////////////////////////////////////////////////////////////
-StatusResponsePacket::StatusResponsePacket()
+StatusResponsePacket::StatusResponsePacket(const ServerStatus& status_)
     : CachePacket(PACKET_STATUS_RESPONSE, CREATE_SENDING_BUFFER)
 {
     WriteHeader(serializationBuffer);
+
+    serializationBuffer->Write(&status_.itemsCount, sizeof(status_.itemsCount));
+    serializationBuffer->Write(&status_.itemsInMemoryCount, sizeof(status_.itemsInMemoryCount));
+    serializationBuffer->Write(&status_.dataInMemorySize, sizeof(status_.dataInMemorySize));
+    serializationBuffer->Write(&status_.indexMemorySize, sizeof(status_.indexMemorySize));
+    serializationBuffer->Write(&status_.occupiedSize, sizeof(status_.occupiedSize));
+    serializationBuffer->Write(&status_.storageSize, sizeof(status_.storageSize));
+}
+
+StatusResponsePacket::StatusResponsePacket()
+    : CachePacket(PACKET_STATUS_RESPONSE, DO_NOT_CREATE_SENDING_BUFFER)
+{
 }
 
-bool StatusResponsePacket::DeserializeFromBuffer(File* file)
+bool StatusResponsePacket::DeserializeFromBuffer(File* buffer)
 {
-    return true;
+    using namespace CachePacketDetails;
+    return (ReadFromBuffer(buffer, status.itemsCount)
+            && ReadFromBuffer(buffer, status.itemsInMemoryCount)
+            && ReadFromBuffer(buffer, status.dataInMemorySize)
+            && ReadFromBuffer(buffer, status.indexMemorySize)
+            && ReadFromBuffer(buffer, status.occupiedSize)
+            && ReadFromBuffer(buffer, status.storageSize));
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -5,6 +5,7 @@
 #include <FileSystem/DynamicMemoryFile.h>
 #include <FileSystem/File.h>
 #include <FileSystem/FileList.h>
+#include <FileSystem/FileSystem.h>
 #include <Debug/DVAssert.h>
 #include <Utils/StringFormat.h>
 #include <Logger/Logger.h>
@@ -150,7 +151,7 @@ void CachedItemValue::Deserialize(KeyedArchive* archieve)
     validationDetails.filesDataSize = archieve->GetUInt64("ValidationDetails.filesDataSize");
 }
 
-bool CachedItemValue::Serialize(File* buffer) const
+bool CachedItemValue::Serialize(File* buffer, bool serializeData) const
 {
     DVASSERT(buffer);
 
@@ -169,7 +170,7 @@ bool CachedItemValue::Serialize(File* buffer) const
         uint32 dataSize = 0;
         const uint8* data = nullptr;
 
-        if (IsDataLoaded(entry.second))
+        if (IsDataLoaded(entry.second) && serializeData)
         {
             data = entry.second->data();
             dataSize = static_cast<uint32>(entry.second->size());
@@ -324,13 +325,21 @@ CachedItemValue& CachedItemValue::operator=(CachedItemValue&& right)
 bool CachedItemValue::Fetch(const FilePath& folder)
 {
     DVASSERT(folder.IsDirectoryPathname());
+
+    return Fetch([&folder](const String& name) {
+        return folder + name;
+    });
+}
+
+bool CachedItemValue::Fetch(const FilePathResolver& resolver)
+{
     DVASSERT(isFetched == false);
 
     isFetched = true;
     for (auto& dc : dataContainer)
     {
         DVASSERT(IsDataLoaded(dc.second) == false);
-        dc.second = LoadFile(folder + dc.first);
+        dc.second = LoadFile(resolver(dc.first));
         if (false == IsDataLoaded(dc.second))
         {
             Free();
@@ -387,6 +396,91 @@ bool CachedItemValue::ExportToFolder(const FilePath& folder) const
     return exportResult;
 }
 
+bool CachedItemValue::ExportToFolder(File* serializedValue, const FilePath& folder, Description* description)
+{
+    DVASSERT(serializedValue != nullptr);
+    DVASSERT(folder.IsDirectoryPathname());
+
+    FileSystem::Instance()->CreateDirectory(folder, true);
+
+    uint64 size = 0;
+    if (serializedValue->Read(&size) != sizeof(size))
+        return false;
+
+    uint64 count = 0;
+    if (serializedValue->Read(&count) != sizeof(count))
+        return false;
+
+    const uint32 COPY_BUFFER_SIZE = 64 * 1024;
+    Vector<uint8> copyBuffer(COPY_BUFFER_SIZE);
+
+    ValidationDetails exportedDetails;
+    for (; count > 0; --count)
+    {
+        String name;
+        if (!serializedValue->ReadString(name))
+            return false;
+
+        uint32 dataSize = 0;
+        if (serializedValue->Read(&dataSize) != sizeof(dataSize))
+            return false;
+
+        FilePath savedPath = folder + name;
+        ScopedPtr<File> file(File::Create(savedPath, File::CREATE | File::WRITE));
+        if (!file)
+        {
+            Logger::Error("[CachedItemValue::%s] Cannot create file %s", __FUNCTION__, savedPath.GetStringValue().c_str());
+            return false;
+        }
+
+        for (uint32 bytesRemaining = dataSize; bytesRemaining > 0;)
+        {
+            uint32 blockSize = std::min(bytesRemaining, COPY_BUFFER_SIZE);
+            if (serializedValue->Read(copyBuffer.data(), blockSize) != blockSize || file->Write(copyBuffer.data(), blockSize) != blockSize)
+            {
+                Logger::Error("[CachedItemValue::%s] Cannot copy data of %s", __FUNCTION__, name.c_str());
+                return false;
+            }
+            bytesRemaining -= blockSize;
+        }
+
+        ++exportedDetails.filesCount;
+        exportedDetails.filesDataSize += dataSize;
+    }
+
+    Description readDescription;
+    if (serializedValue->ReadString(readDescription.machineName) == false)
+        return false;
+    if (serializedValue->ReadString(readDescription.creationDate) == false)
+        return false;
+    if (serializedValue->ReadString(readDescription.addingChain) == false)
+        return false;
+    if (serializedValue->ReadString(readDescription.receivingChain) == false)
+        return false;
+    if (serializedValue->ReadString(readDescription.comment) == false)
+        return false;
+
+    ValidationDetails storedDetails;
+    if (serializedValue->Read(&storedDetails.filesCount) != sizeof(storedDetails.filesCount))
+        return false;
+    if (serializedValue->Read(&storedDetails.filesDataSize) != sizeof(storedDetails.filesDataSize))
+        return false;
+
+    if (!(storedDetails == exportedDetails))
+    {
+        Logger::Error("[CachedItemValue::%s] Exported %u files (%llu bytes), expected %u files (%llu bytes)", __FUNCTION__,
+                      exportedDetails.filesCount, exportedDetails.filesDataSize, storedDetails.filesCount, storedDetails.filesDataSize);
+        return false;
+    }
+
+    if (description != nullptr)
+    {
+        *description = std::move(readDescription);
+    }
+
+    return true;
+}
+
 size_type CachedItemValue::GetItemCount() const
 {
     return dataContainer.size();
@@ -101,7 +101,7 @@ bool ClientNetProxy::RequestAddNextChunk(const CacheItemKey& key, uint64 dataSiz
     if (openedChannel)
     {
         //Logger::FrameworkDebug("Requesting to add next chunk");
-        AddChunkRequestPacket packet(key, dataSize, numOfChunks, chunkNumber, chunkData);
+        AddChunkRequestPacket packet(key, dataSize, numOfChunks, chunkNumber, chunkData, compressionEnabled);
         return packet.SendTo(openedChannel);
     }
 
@@ -113,7 +113,7 @@ bool ClientNetProxy::RequestGetNextChunk(const CacheItemKey& key, uint32 chunkNu
     //Logger::FrameworkDebug("Requesting chunk #%u", chunkNumber);
     if (openedChannel)
     {
-        GetChunkRequestPacket packet(key, chunkNumber);
+        GetChunkRequestPacket packet(key, chunkNumber, compressionEnabled);
         return packet.SendTo(openedChannel);
     }
 
@@ -219,9 +219,10 @@ void ClientNetProxy::OnPacketReceived(const std::shared_ptr<DAVA::Net::IChannel>
             }
             case PACKET_STATUS_RESPONSE:
             {
+                StatusResponsePacket* p = static_cast<StatusResponsePacket*>(packet.get());
                 //Logger::FrameworkDebug("Response is received: server status is OK");
                 for (ClientNetProxyListener* listener : listeners)
-                    listener->OnServerStatusReceived();
+                    listener->OnServerStatusReceived(p->status);
                 return;
             }
             case PACKET_REMOVE_RESPONSE:
@@ -36,15 +36,19 @@ class ControllersHolder : public StaticSingleton<ControllersHolder>
 public:
     void AddController(Net::NetCore::TrackId controllerId, std::shared_ptr<Net::ChannelListenerDispatched>& controller)
     {
+        LockGuard<Mutex> lock(controllersMutex);
         controllers.emplace(controllerId, controller);
     }
 
+    // Invoked in thread of IOLoop the controller was working on
     void RemoveController(Net::NetCore::TrackId controllerId)
     {
+        LockGuard<Mutex> lock(controllersMutex);
         controllers.erase(controllerId);
     }
 
 private:
+    Mutex controllersMutex;
     UnorderedMap<Net::NetCore::TrackId, std::shared_ptr<Net::ChannelListenerDispatched>> controllers;
 };
 }
@@ -64,6 +64,14 @@ void ServerNetProxy::OnPacketReceived(const std::shared_ptr<Net::IChannel>& chan
             case PACKET_GET_CHUNK_REQUEST:
             {
                 GetChunkRequestPacket* p = static_cast<GetChunkRequestPacket*>(packet.get());
+                if (p->acceptCompressed)
+                {
+                    compressingChannels.insert(channel.get());
+                }
+                else
+                {
+                    compressingChannels.erase(channel.get());
+                }
                 listener->OnChunkRequestedFromCache(channel, p->key, p->chunkNumber);
                 return;
             }
@@ -110,6 +118,7 @@ void ServerNetProxy::OnPacketSent(const std::shared_ptr<Net::IChannel>& channel,
 
 void ServerNetProxy::OnChannelClosed(const std::shared_ptr<Net::IChannel>& channel, const char8* message)
 {
+    compressingChannels.erase(channel.get());
     if (listener)
     {
         listener->OnChannelClosed(channel, message);
@@ -153,18 +162,19 @@ bool ServerNetProxy::SendChunk(const std::shared_ptr<Net::IChannel>& channel, co
 {
     if (channel)
     {
-        GetChunkResponsePacket packet(key, dataSize, numOfChunks, chunkNumber, chunkData);
+        bool compress = (compressingChannels.count(channel.get()) > 0);
+        GetChunkResponsePacket packet(key, dataSize, numOfChunks, chunkNumber, chunkData, compress);
         return packet.SendTo(channel);
     }
 
     return false;
 }
 
-bool ServerNetProxy::SendStatus(const std::shared_ptr<Net::IChannel>& channel)
+bool ServerNetProxy::SendStatus(const std::shared_ptr<Net::IChannel>& channel, const ServerStatus& status)
 {
     if (channel)
     {
-        StatusResponsePacket packet;
+        StatusResponsePacket packet(status);
         return packet.SendTo(channel);
     }
 
@@ -4,6 +4,7 @@
 
 #include "AssetCache/Connection.h"
 #include "AssetCache/CacheItemKey.h"
+#include "AssetCache/ServerStatus.h"
 
 #include <Base/BaseTypes.h>
 #include <Network/IChannel.h>
@@ -47,7 +48,7 @@ public:
     bool SendRemovedFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, bool removed);
     bool SendCleared(const std::shared_ptr<Net::IChannel>& channel, bool cleared);
     bool SendChunk(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
-    bool SendStatus(const std::shared_ptr<Net::IChannel>& channel);
+    bool SendStatus(const std::shared_ptr<Net::IChannel>& channel, const ServerStatus& status);
 
     //Net::IChannelListener
     // Channel is open (underlying transport has connection) and can receive and send data through IChannel interface
@@ -66,6 +67,7 @@ private:
     uint16 listenPort = 0;
     std::shared_ptr<Connection> netServer;
     ServerNetProxyListener* listener = nullptr;
+    Set<Net::IChannel*> compressingChannels; // channels which accept LZ4 compressed chunks
 };
 
 inline uint16 ServerNetProxy::GetListenPort() const
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+
+namespace DAVA
+{
+namespace AssetCache
+{
+/**
+    State of cache server that is sent in response to status request.
+    Memory sizes are estimations made by server.
+*/
+struct ServerStatus
+{
+    uint64 itemsCount = 0; // items in cache database
+    uint64 itemsInMemoryCount = 0; // items with loaded data
+    uint64 dataInMemorySize = 0; // bytes of item files loaded into memory
+    uint64 indexMemorySize = 0; // bytes used by index of database
+    uint64 occupiedSize = 0; // bytes occupied on disk
+    uint64 storageSize = 0; // max size of storage
+};
+
+} // end of namespace AssetCache
+} // end of namespace DAVA
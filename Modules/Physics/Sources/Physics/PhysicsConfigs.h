@@ -4,10 +4,17 @@
 
 namespace DAVA
 {
+enum class PhysicsCpuDispatcherType
+{
+    PhysXThreadPool, //dedicated PhysX threads created by PxDefaultCpuDispatcher
+    JobManager //engine worker threads shared with JobManager jobs
+};
+
 struct PhysicsSceneConfig
 {
     Vector3 gravity = { 0, 0, -9.81f }; //physics gravity
     //uint32 simulationBlockSize = 16 * 1024 * 512; //must be 16K multiplier
-    uint32 threadCount = 2; //number of threads created for physics task dispatcher
+    uint32 threadCount = 2; //number of threads created for physics task dispatcher (max number of busy workers for JobManager dispatcher)
+    PhysicsCpuDispatcherType cpuDispatcherType = PhysicsCpuDispatcherType::PhysXThreadPool;
 };
 }
\ No newline at end of file
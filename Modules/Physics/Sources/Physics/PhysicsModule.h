@@ -18,9 +18,11 @@ class PxPhysics;
 class PxCooking;
 class PxScene;
 class PxActor;
+class PxBase;
 class PxShape;
 class PxMaterial;
 class PxSimulationEventCallback;
+class PxCpuDispatcher;
 class PxDefaultCpuDispatcher;
 class PxAllocatorCallback;
 }
@@ -31,6 +33,9 @@ class PolygonGroup;
 class Landscape;
 class PhysicsGeometryCache;
 class PhysicsVehiclesSubsystem;
+class PhysicsJobDispatcher;
+class PhysicsCookedMeshCache;
+class FilePath;
 struct Matrix4;
 
 class PhysicsModule : public IModule
@@ -58,6 +63,14 @@ public:
     physx::PxShape* CreateConvexHullShape(Vector<PolygonGroup*>&& polygons, const Vector3& scale, const FastName& materialName, PhysicsGeometryCache* cache) const;
     physx::PxShape* CreateHeightField(Landscape* landscape, const FastName& materialName, Matrix4& localPose) const;
 
+    /**
+        Load persistent cache of cooked mesh and convex hull shapes. Meshes cooked after that are added to the cache
+        and can be written back with `SaveCookedMeshCache`.
+        Cache is loaded automatically on module init from path specified in "physics.cookedMeshCache" engine option.
+    */
+    bool LoadCookedMeshCache(const FilePath& path);
+    bool SaveCookedMeshCache(const FilePath& path);
+
     physx::PxMaterial* GetMaterial(const FastName& materialName) const;
     Vector<FastName> GetMaterialNames() const;
     void ReleaseMaterials();
@@ -71,14 +84,19 @@ public:
 
 private:
     void LazyLoadMaterials() const;
+    physx::PxCpuDispatcher* GetCpuDispatcher(PhysicsCpuDispatcherType type, uint32 threadCount) const;
+    physx::PxBase* CreateCookedMesh(const Vector<PolygonGroup*>& polygons, bool convexHull) const;
     void LoadMaterials();
 
 private:
     physx::PxFoundation* foundation = nullptr;
     physx::PxPhysics* physics = nullptr;
     physx::PxCooking* cooking = nullptr;
+    PhysicsCookedMeshCache* cookedMeshCache = nullptr;
 
-    mutable physx::PxDefaultCpuDispatcher* cpuDispatcher = nullptr;
+    // Dispatchers are shared between scenes with the same threads count
+    mutable UnorderedMap<uint32, physx::PxDefaultCpuDispatcher*> cpuDispatchers;
+    mutable UnorderedMap<uint32, PhysicsJobDispatcher*> jobDispatchers;
     physx::PxMaterial* defaultMaterial = nullptr;
     UnorderedMap<FastName, physx::PxMaterial*> materials;
 
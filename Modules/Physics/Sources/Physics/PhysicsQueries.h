@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <Math/Vector.h>
+
+namespace DAVA
+{
+class PhysicsComponent;
+class CollisionShapeComponent;
+
+/** Ray for PhysicsSystem::RaycastBatch. `direction` is not required to be normalized. */
+struct PhysicsRaycastQuery
+{
+    Vector3 origin;
+    Vector3 direction;
+    float32 distance = 0.0f;
+};
+
+/** Sphere moved along direction, for PhysicsSystem::SweepSphereBatch. */
+struct PhysicsSphereSweepQuery
+{
+    Vector3 origin;
+    Vector3 direction;
+    float32 distance = 0.0f;
+    float32 radius = 0.0f;
+};
+
+/** Sphere for PhysicsSystem::OverlapSphereBatch. */
+struct PhysicsSphereOverlapQuery
+{
+    Vector3 center;
+    float32 radius = 0.0f;
+};
+
+/**
+    Result of single query in batch.
+    Raycasts and sweeps report closest blocking hit, overlaps report any overlapped shape without position, normal and distance.
+*/
+struct PhysicsQueryHit
+{
+    bool hasHit = false;
+    PhysicsComponent* body = nullptr; // can be nullptr even if hit is found, e.g. for character controllers
+    CollisionShapeComponent* shape = nullptr;
+    Vector3 position;
+    Vector3 normal;
+    float32 distance = 0.0f;
+};
+} // namespace DAVA
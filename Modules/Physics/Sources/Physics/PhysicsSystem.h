@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Physics/PhysicsQueries.h"
+
 #include <Entity/SceneSystem.h>
 #include <Math/Vector.h>
 #include <Base/BaseTypes.h>
@@ -7,6 +9,7 @@
 #include <physx/PxQueryReport.h>
 #include <physx/PxSimulationEventCallback.h>
 #include <physx/PxForceMode.h>
+#include <PxShared/foundation/PxTransform.h>
 
 namespace physx
 {
@@ -27,6 +30,7 @@ class CollisionShapeComponent;
 class PhysicsGeometryCache;
 class PhysicsVehiclesSubsystem;
 class CharacterControllerComponent;
+class PhysicsJobDispatcher;
 
 class PhysicsSystem final : public SceneSystem
 {
@@ -50,17 +54,43 @@ public:
     void SetDebugDrawEnabled(bool drawDebugInfo);
     bool IsDebugDrawEnabled() const;
 
+    /**
+        In async mode simulation step is launched at the end of the frame and its results are fetched at the beginning of the next one,
+        so simulation runs in parallel with rendering. Simulation is advanced with fixed time steps and rendered transforms
+        are interpolated between two last simulated states. If frame takes more than one step, extra steps are simulated
+        synchronously at the end of the frame.
+    */
+    void SetAsyncSimulationEnabled(bool isEnabled);
+    bool IsAsyncSimulationEnabled() const;
+
+    /** Called by scene after all systems were processed. Launches simulation step in async mode. */
+    void OnFrameEnd();
+
     void ScheduleUpdate(PhysicsComponent* component);
     void ScheduleUpdate(CollisionShapeComponent* component);
     void ScheduleUpdate(CharacterControllerComponent* component);
 
     bool Raycast(const Vector3& origin, const Vector3& direction, float32 distance, physx::PxRaycastCallback& callback);
+
+    /**
+        Batched scene queries. Queries are split into chunks which are executed in parallel on JobManager workers
+        and calling thread, `results[i]` is filled for `queries[i]`. Calling thread is blocked until all queries are done.
+    */
+    void RaycastBatch(const Vector<PhysicsRaycastQuery>& queries, Vector<PhysicsQueryHit>& results);
+    void SweepSphereBatch(const Vector<PhysicsSphereSweepQuery>& queries, Vector<PhysicsQueryHit>& results);
+    void OverlapSphereBatch(const Vector<PhysicsSphereOverlapQuery>& queries, Vector<PhysicsQueryHit>& results);
     void AddForce(DynamicBodyComponent* component, const Vector3& force, physx::PxForceMode::Enum mode);
 
     PhysicsVehiclesSubsystem* GetVehiclesSystem();
 
 private:
     bool FetchResults(bool waitForFetchFinish);
+    void ProcessAsync(float32 timeElapsed);
+    void WaitSimulationFinish();
+
+    void UpdateEntityTransform(PhysicsComponent* component, const physx::PxTransform& pose);
+    void StoreInterpolationStates(physx::PxActor** activeActors, physx::PxU32 activeActorsCount);
+    void ApplyInterpolatedTransforms(float32 factor);
 
     void DrawDebugInfo();
 
@@ -102,7 +132,12 @@ private:
 
     bool isSimulationEnabled = true;
     bool isSimulationRunning = false;
+    bool isAsyncSimulation = false;
+    float32 fixedTimeStep = 1.0f / 60.0f;
+    uint32 maxSubStepsCount = 4;
+    float32 accumulatedTime = 0.0f;
     physx::PxScene* physicsScene = nullptr;
+    PhysicsJobDispatcher* jobDispatcher = nullptr; // not null if scene tasks are executed by JobManager workers
     physx::PxControllerManager* controllerManager = nullptr;
     PhysicsGeometryCache* geometryCache = nullptr;
 
@@ -131,6 +166,16 @@ private:
     };
 
     Vector<PendingForce> forces;
+
+    struct InterpolationState
+    {
+        physx::PxTransform previousPose;
+        physx::PxTransform currentPose;
+        bool movedByLastStep = false;
+    };
+
+    // Dynamic bodies moved by last simulated step, used only in async mode
+    UnorderedMap<PhysicsComponent*, InterpolationState> interpolationStates;
     SimulationEventCallback simulationEventCallback;
 
     bool drawDebugInfo = false;
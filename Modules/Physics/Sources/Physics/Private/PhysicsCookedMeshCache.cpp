@@ -0,0 +1,244 @@
+#include "Physics/Private/PhysicsCookedMeshCache.h"
+
+#include <Base/ScopedPtr.h>
+#include <Debug/DVAssert.h>
+#include <Engine/Engine.h>
+#include <Engine/EngineContext.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+#include <Render/3D/PolygonGroup.h>
+
+#include <physx/PxPhysicsVersion.h>
+#include <physx/cooking/PxCooking.h>
+
+namespace DAVA
+{
+namespace PhysicsCookedMeshCacheDetails
+{
+const uint32 CACHE_FILE_MAGIC = 0x43435850; // "PXCC"
+const uint32 CACHE_FILE_VERSION = 1;
+
+struct FileHeader
+{
+    uint32 magic = CACHE_FILE_MAGIC;
+    uint32 version = CACHE_FILE_VERSION;
+    uint32 physxVersion = PX_PHYSICS_VERSION;
+    uint32 entriesCount = 0;
+};
+
+struct FileEntry
+{
+    PhysicsCookedMeshCache::Key key;
+    uint32 offset = 0; // offset from the beginning of blob
+    uint32 size = 0;
+};
+
+template <typename T>
+void UpdateHash(MD5& md5, const T& value)
+{
+    md5.Update(reinterpret_cast<const uint8*>(&value), sizeof(T));
+}
+} // namespace PhysicsCookedMeshCacheDetails
+
+PhysicsCookedMeshCache::Key PhysicsCookedMeshCache::MakeKey(eMeshType type, const physx::PxCookingParams& params, uint32 meshFlags, const Vector<PolygonGroup*>& polygons)
+{
+    using namespace PhysicsCookedMeshCacheDetails;
+
+    Vector<Key> polygonKeys;
+    polygonKeys.reserve(polygons.size());
+    for (PolygonGroup* polygon : polygons)
+    {
+        MD5 polygonMD5;
+        polygonMD5.Init();
+
+        UpdateHash(polygonMD5, polygon->vertexCount);
+        for (int32 i = 0; i < polygon->vertexCount; ++i)
+        {
+            Vector3 coord;
+            polygon->GetCoord(i, coord);
+            UpdateHash(polygonMD5, coord);
+        }
+
+        UpdateHash(polygonMD5, polygon->indexCount);
+        for (int32 i = 0; i < polygon->indexCount; ++i)
+        {
+            int32 index = 0;
+            polygon->GetIndex(i, index);
+            UpdateHash(polygonMD5, index);
+        }
+
+        polygonMD5.Final();
+        polygonKeys.push_back(polygonMD5.GetDigest().digest);
+    }
+    std::sort(polygonKeys.begin(), polygonKeys.end());
+
+    MD5 md5;
+    md5.Init();
+
+    UpdateHash(md5, type);
+    UpdateHash(md5, meshFlags);
+
+    // Params are hashed field by field, struct itself contains padding
+    UpdateHash(md5, static_cast<uint32>(params.targetPlatform));
+    UpdateHash(md5, params.areaTestEpsilon);
+    UpdateHash(md5, params.planeTolerance);
+    UpdateHash(md5, static_cast<uint32>(params.convexMeshCookingType));
+    UpdateHash(md5, static_cast<uint8>(params.suppressTriangleMeshRemapTable));
+    UpdateHash(md5, static_cast<uint8>(params.buildTriangleAdjacencies));
+    UpdateHash(md5, static_cast<uint8>(params.buildGPUData));
+    UpdateHash(md5, params.scale.length);
+    UpdateHash(md5, params.scale.speed);
+    UpdateHash(md5, static_cast<uint32>(params.meshPreprocessParams));
+    UpdateHash(md5, params.meshWeldTolerance);
+
+    for (const Key& polygonKey : polygonKeys)
+    {
+        md5.Update(polygonKey.data(), static_cast<uint32>(polygonKey.size()));
+    }
+
+    md5.Final();
+    return md5.GetDigest().digest;
+}
+
+bool PhysicsCookedMeshCache::Load(const FilePath& path)
+{
+    using namespace PhysicsCookedMeshCacheDetails;
+
+    entries.clear();
+    data.clear();
+    isChanged = false;
+
+    Vector<uint8> fileData;
+    if (GetEngineContext()->fileSystem->ReadFileContents(path, fileData) == false)
+    {
+        Logger::Error("[PhysicsCookedMeshCache] Can't read %s", path.GetStringValue().c_str());
+        return false;
+    }
+
+    FileHeader header;
+    if (fileData.size() < sizeof(FileHeader))
+    {
+        Logger::Error("[PhysicsCookedMeshCache] %s is corrupted", path.GetStringValue().c_str());
+        return false;
+    }
+    Memcpy(&header, fileData.data(), sizeof(FileHeader));
+
+    if (header.magic != CACHE_FILE_MAGIC || header.version != CACHE_FILE_VERSION || header.physxVersion != PX_PHYSICS_VERSION)
+    {
+        Logger::Warning("[PhysicsCookedMeshCache] %s was created by other version and will be ignored", path.GetStringValue().c_str());
+        return false;
+    }
+
+    uint64 tableSize = static_cast<uint64>(header.entriesCount) * sizeof(FileEntry);
+    uint64 blobOffset = sizeof(FileHeader) + tableSize;
+    if (fileData.size() < blobOffset)
+    {
+        Logger::Error("[PhysicsCookedMeshCache] %s is corrupted", path.GetStringValue().c_str());
+        return false;
+    }
+
+    uint64 blobSize = fileData.size() - blobOffset;
+    for (uint32 i = 0; i < header.entriesCount; ++i)
+    {
+        FileEntry fileEntry;
+        Memcpy(&fileEntry, fileData.data() + sizeof(FileHeader) + i * sizeof(FileEntry), sizeof(FileEntry));
+        if (static_cast<uint64>(fileEntry.offset) + fileEntry.size > blobSize)
+        {
+            Logger::Error("[PhysicsCookedMeshCache] %s is corrupted", path.GetStringValue().c_str());
+            entries.clear();
+            return false;
+        }
+
+        Entry& entry = entries[fileEntry.key];
+        entry.offset = static_cast<uint32>(blobOffset + fileEntry.offset);
+        entry.size = fileEntry.size;
+    }
+
+    // Entries reference cooked streams right inside of loaded file
+    data = std::move(fileData);
+    return true;
+}
+
+bool PhysicsCookedMeshCache::Save(const FilePath& path)
+{
+    using namespace PhysicsCookedMeshCacheDetails;
+
+    FileHeader header;
+    header.entriesCount = static_cast<uint32>(entries.size());
+
+    Vector<FileEntry> table;
+    table.reserve(entries.size());
+    uint32 blobSize = 0;
+    for (const auto& node : entries)
+    {
+        FileEntry fileEntry;
+        fileEntry.key = node.first;
+        fileEntry.offset = blobSize;
+        fileEntry.size = node.second.size;
+        table.push_back(fileEntry);
+
+        blobSize += node.second.size;
+    }
+
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Error("[PhysicsCookedMeshCache] Can't create %s", path.GetStringValue().c_str());
+        return false;
+    }
+
+    bool written = file->Write(&header, sizeof(FileHeader)) == sizeof(FileHeader);
+    uint32 tableSize = static_cast<uint32>(table.size() * sizeof(FileEntry));
+    written = written && file->Write(table.data(), tableSize) == tableSize;
+    for (const auto& node : entries)
+    {
+        written = written && file->Write(data.data() + node.second.offset, node.second.size) == node.second.size;
+    }
+
+    if (written == false)
+    {
+        Logger::Error("[PhysicsCookedMeshCache] Can't write %s", path.GetStringValue().c_str());
+        return false;
+    }
+
+    isChanged = false;
+    Logger::Info("[PhysicsCookedMeshCache] %u cooked meshes (%u bytes) are saved to %s", header.entriesCount, blobSize, path.GetStringValue().c_str());
+    return true;
+}
+
+bool PhysicsCookedMeshCache::Find(const Key& key, const uint8*& cookedData, uint32& cookedDataSize) const
+{
+    auto iter = entries.find(key);
+    if (iter == entries.end())
+    {
+        return false;
+    }
+
+    cookedData = data.data() + iter->second.offset;
+    cookedDataSize = iter->second.size;
+    return true;
+}
+
+void PhysicsCookedMeshCache::Add(const Key& key, const uint8* cookedData, uint32 cookedDataSize)
+{
+    DVASSERT(cookedData != nullptr && cookedDataSize > 0);
+
+    Entry& entry = entries[key];
+    entry.offset = static_cast<uint32>(data.size());
+    entry.size = cookedDataSize;
+    data.insert(data.end(), cookedData, cookedData + cookedDataSize);
+
+    isChanged = true;
+}
+
+uint32 PhysicsCookedMeshCache::GetEntriesCount() const
+{
+    return static_cast<uint32>(entries.size());
+}
+
+bool PhysicsCookedMeshCache::IsChanged() const
+{
+    return isChanged;
+}
+} // namespace DAVA
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <Base/Array.h>
+#include <FileSystem/FilePath.h>
+#include <Utils/MD5.h>
+
+namespace physx
+{
+struct PxCookingParams;
+}
+
+namespace DAVA
+{
+class PolygonGroup;
+
+/**
+    Persistent storage of PhysX cooking results.
+    Entries are keyed by hash of mesh content and cooking parameters, so cache file stays valid while source geometry
+    and cooking setup are the same. Whole file is read with one call and cooked streams are passed to PhysX directly
+    from the loaded buffer.
+
+    File layout: header, table of {key, offset, size} entries sorted by key, blob with cooked streams.
+*/
+class PhysicsCookedMeshCache final
+{
+public:
+    enum class eMeshType : uint8
+    {
+        TriangleMesh,
+        ConvexMesh
+    };
+
+    using Key = Array<uint8, MD5::MD5Digest::DIGEST_SIZE>;
+
+    /** Key doesn't depend on order of `polygons`, as it is not stable between runs. */
+    static Key MakeKey(eMeshType type, const physx::PxCookingParams& params, uint32 meshFlags, const Vector<PolygonGroup*>& polygons);
+
+    bool Load(const FilePath& path);
+    bool Save(const FilePath& path);
+
+    /** Return pointer to cooked stream. Pointer is valid until next `Add` or `Load` call. */
+    bool Find(const Key& key, const uint8*& cookedData, uint32& cookedDataSize) const;
+    void Add(const Key& key, const uint8* cookedData, uint32 cookedDataSize);
+
+    uint32 GetEntriesCount() const;
+    bool IsChanged() const;
+
+private:
+    struct Entry
+    {
+        uint32 offset = 0; // offset in `data`
+        uint32 size = 0;
+    };
+
+    Map<Key, Entry> entries;
+    Vector<uint8> data;
+    bool isChanged = false;
+};
+} // namespace DAVA
@@ -0,0 +1,174 @@
+#include "UnitTests/UnitTests.h"
+#include "Physics/PhysicsModule.h"
+#include "Physics/PhysicsGeometryCache.h"
+#include "Physics/Private/PhysicsCookedMeshCache.h"
+
+#include <Engine/Engine.h>
+#include <Engine/EngineContext.h>
+#include <FileSystem/FileSystem.h>
+#include <ModuleManager/ModuleManager.h>
+#include <Render/3D/PolygonGroup.h>
+
+#include <physx/PxShape.h>
+#include <physx/cooking/PxCooking.h>
+#include <physx/geometry/PxConvexMesh.h>
+#include <physx/geometry/PxConvexMeshGeometry.h>
+
+using namespace DAVA;
+
+namespace PhysicsCookedMeshCacheTestDetails
+{
+const FilePath CACHE_FOLDER("~doc:/UnitTests/PhysicsCookedMeshCacheTest/");
+
+PolygonGroup* CreateBox(const Vector3& halfSize)
+{
+    const int16 indices[] = {
+        0, 1, 2, 0, 2, 3, 4, 6, 5, 4, 7, 6,
+        0, 4, 5, 0, 5, 1, 1, 5, 6, 1, 6, 2,
+        2, 6, 7, 2, 7, 3, 3, 7, 4, 3, 4, 0
+    };
+
+    PolygonGroup* polygon = new PolygonGroup();
+    polygon->AllocateData(EVF_VERTEX, 8, 36);
+    for (int32 i = 0; i < 8; ++i)
+    {
+        Vector3 corner(((i & 1) == (i >> 1 & 1)) ? -halfSize.x : halfSize.x, (i & 2) ? halfSize.y : -halfSize.y, (i & 4) ? halfSize.z : -halfSize.z);
+        polygon->SetCoord(i, corner);
+    }
+    for (int32 i = 0; i < 36; ++i)
+    {
+        polygon->SetIndex(i, indices[i]);
+    }
+
+    return polygon;
+}
+
+// Returns max x of bounds of convex hull cooked by module, or -1 if shape can't be created
+float32 CreateConvexHullExtent(PhysicsModule* module, PolygonGroup* polygon)
+{
+    PhysicsGeometryCache geometryCache;
+    physx::PxShape* shape = module->CreateConvexHullShape(Vector<PolygonGroup*>{ polygon }, Vector3(1.0f, 1.0f, 1.0f), FastName(), &geometryCache);
+    if (shape == nullptr)
+    {
+        return -1.0f;
+    }
+
+    physx::PxConvexMeshGeometry geometry;
+    bool isConvex = shape->getConvexMeshGeometry(geometry);
+    float32 extent = isConvex ? geometry.convexMesh->getLocalBounds().maximum.x : -1.0f;
+    shape->release();
+    return extent;
+}
+} // namespace PhysicsCookedMeshCacheTestDetails
+
+DAVA_TESTCLASS (PhysicsCookedMeshCacheTest)
+{
+    PhysicsCookedMeshCacheTest()
+    {
+        GetEngineContext()->fileSystem->CreateDirectory(PhysicsCookedMeshCacheTestDetails::CACHE_FOLDER, true);
+    }
+
+    ~PhysicsCookedMeshCacheTest()
+    {
+        GetEngineContext()->fileSystem->DeleteDirectory(PhysicsCookedMeshCacheTestDetails::CACHE_FOLDER, true);
+    }
+
+    DAVA_TEST (SaveLoadRoundTripTest)
+    {
+        using namespace PhysicsCookedMeshCacheTestDetails;
+        using Cache = PhysicsCookedMeshCache;
+
+        ScopedPtr<PolygonGroup> box(CreateBox(Vector3(1.0f, 2.0f, 3.0f)));
+        physx::PxCookingParams params{ physx::PxTolerancesScale() };
+        Cache::Key triangleKey = Cache::MakeKey(Cache::eMeshType::TriangleMesh, params, 0, { box.get() });
+        Cache::Key convexKey = Cache::MakeKey(Cache::eMeshType::ConvexMesh, params, 0, { box.get() });
+        TEST_VERIFY(triangleKey != convexKey);
+
+        const Vector<uint8> triangleData = { 1, 2, 3, 4, 5 };
+        const Vector<uint8> convexData = { 6, 7, 8 };
+
+        Cache cache;
+        cache.Add(triangleKey, triangleData.data(), static_cast<uint32>(triangleData.size()));
+        cache.Add(convexKey, convexData.data(), static_cast<uint32>(convexData.size()));
+        TEST_VERIFY(cache.IsChanged() == true);
+
+        FilePath cachePath = CACHE_FOLDER + "roundTrip.cache";
+        TEST_VERIFY(cache.Save(cachePath) == true);
+        TEST_VERIFY(cache.IsChanged() == false);
+
+        Cache loadedCache;
+        TEST_VERIFY(loadedCache.Load(cachePath) == true);
+        TEST_VERIFY(loadedCache.GetEntriesCount() == 2);
+        TEST_VERIFY(loadedCache.IsChanged() == false);
+
+        const uint8* cookedData = nullptr;
+        uint32 cookedDataSize = 0;
+        TEST_VERIFY(loadedCache.Find(triangleKey, cookedData, cookedDataSize) == true);
+        TEST_VERIFY(Vector<uint8>(cookedData, cookedData + cookedDataSize) == triangleData);
+        TEST_VERIFY(loadedCache.Find(convexKey, cookedData, cookedDataSize) == true);
+        TEST_VERIFY(Vector<uint8>(cookedData, cookedData + cookedDataSize) == convexData);
+    }
+
+    DAVA_TEST (StaleEntryTest)
+    {
+        using namespace PhysicsCookedMeshCacheTestDetails;
+        using Cache = PhysicsCookedMeshCache;
+
+        ScopedPtr<PolygonGroup> box(CreateBox(Vector3(1.0f, 1.0f, 1.0f)));
+        physx::PxCookingParams params{ physx::PxTolerancesScale() };
+        Cache::Key key = Cache::MakeKey(Cache::eMeshType::ConvexMesh, params, 0, { box.get() });
+
+        const uint8 cookedStub = 1;
+        Cache cache;
+        cache.Add(key, &cookedStub, 1);
+
+        // Changed geometry or cooking setup gives other key, so old entry is not used for them
+        box->SetCoord(0, Vector3(-2.0f, -1.0f, -1.0f));
+        Cache::Key changedGeometryKey = Cache::MakeKey(Cache::eMeshType::ConvexMesh, params, 0, { box.get() });
+        params.meshWeldTolerance += 0.1f;
+        Cache::Key changedParamsKey = Cache::MakeKey(Cache::eMeshType::ConvexMesh, params, 0, { box.get() });
+
+        const uint8* cookedData = nullptr;
+        uint32 cookedDataSize = 0;
+        TEST_VERIFY(changedGeometryKey != key);
+        TEST_VERIFY(changedParamsKey != changedGeometryKey);
+        TEST_VERIFY(cache.Find(changedGeometryKey, cookedData, cookedDataSize) == false);
+        TEST_VERIFY(cache.Find(changedParamsKey, cookedData, cookedDataSize) == false);
+
+        // File of other format version is ignored as a whole
+        FilePath cachePath = CACHE_FOLDER + "stale.cache";
+        TEST_VERIFY(cache.Save(cachePath) == true);
+
+        Vector<uint8> fileData;
+        TEST_VERIFY(GetEngineContext()->fileSystem->ReadFileContents(cachePath, fileData) == true);
+        fileData[sizeof(uint32)] += 1; // version follows magic in header
+        ScopedPtr<File> file(File::Create(cachePath, File::CREATE | File::WRITE));
+        TEST_VERIFY(file->Write(fileData.data(), static_cast<uint32>(fileData.size())) == fileData.size());
+        file.reset();
+
+        Cache staleCache;
+        TEST_VERIFY(staleCache.Load(cachePath) == false);
+        TEST_VERIFY(staleCache.GetEntriesCount() == 0);
+    }
+
+    DAVA_TEST (ModuleCookedMeshRoundTripTest)
+    {
+        using namespace PhysicsCookedMeshCacheTestDetails;
+
+        PhysicsModule* module = GetEngineContext()->moduleManager->GetModule<PhysicsModule>();
+        FilePath cachePath = CACHE_FOLDER + "module.cache";
+
+        ScopedPtr<PolygonGroup> box(CreateBox(Vector3(1.0f, 1.0f, 1.0f)));
+        float32 cookedExtent = CreateConvexHullExtent(module, box);
+        TEST_VERIFY(FLOAT_EQUAL(cookedExtent, 1.0f));
+        TEST_VERIFY(module->SaveCookedMeshCache(cachePath) == true);
+
+        // Mesh created from loaded cooked stream is the same as cooked one
+        TEST_VERIFY(module->LoadCookedMeshCache(cachePath) == true);
+        TEST_VERIFY(FLOAT_EQUAL(CreateConvexHullExtent(module, box), cookedExtent));
+
+        // Entry of old geometry is not reused after geometry is changed, mesh is cooked again
+        ScopedPtr<PolygonGroup> changedBox(CreateBox(Vector3(2.0f, 1.0f, 1.0f)));
+        TEST_VERIFY(FLOAT_EQUAL(CreateConvexHullExtent(module, changedBox), 2.0f));
+    }
+};
@@ -0,0 +1,148 @@
+#include "UnitTests/UnitTests.h"
+#include "Physics/PhysicsModule.h"
+#include "Physics/PhysicsConfigs.h"
+#include "Physics/Private/PhysicsJobDispatcher.h"
+
+#include <Engine/Engine.h>
+#include <Engine/EngineContext.h>
+#include <Job/JobManager.h>
+#include <Logger/Logger.h>
+#include <Time/SystemTimer.h>
+
+#include <physx/PxPhysicsAPI.h>
+
+using namespace DAVA;
+
+namespace PhysicsDispatcherBenchmarkDetails
+{
+const uint32 PILES_SIDE_COUNT = 12;
+const uint32 BOXES_IN_PILE = 16;
+const uint32 WARMUP_FRAMES = 10;
+const uint32 MEASURED_FRAMES = 60;
+const float32 FRAME_DELTA = 1.0f / 60.0f;
+
+struct BenchmarkScene
+{
+    physx::PxScene* scene = nullptr;
+    Vector<physx::PxActor*> actors;
+};
+
+BenchmarkScene CreateBenchmarkScene(PhysicsModule* module, const PhysicsSceneConfig& config)
+{
+    BenchmarkScene result;
+    result.scene = module->CreateScene(config, physx::PxDefaultSimulationFilterShader, nullptr);
+
+    physx::PxActor* ground = module->CreateStaticActor();
+    physx::PxShape* groundShape = module->CreateBoxShape(Vector3(100.0f, 100.0f, 1.0f), FastName());
+    physx::PxRigidStatic* groundBody = ground->is<physx::PxRigidStatic>();
+    groundBody->attachShape(*groundShape);
+    groundShape->release();
+    groundBody->setGlobalPose(physx::PxTransform(physx::PxVec3(0.0f, 0.0f, -1.0f)));
+    result.scene->addActor(*ground);
+    result.actors.push_back(ground);
+
+    // Piles of boxes keep a lot of contacting islands awake, which is what splits into parallel tasks
+    const float32 step = 2.5f;
+    const float32 offset = -0.5f * step * (PILES_SIDE_COUNT - 1);
+    for (uint32 x = 0; x < PILES_SIDE_COUNT; ++x)
+    {
+        for (uint32 y = 0; y < PILES_SIDE_COUNT; ++y)
+        {
+            for (uint32 z = 0; z < BOXES_IN_PILE; ++z)
+            {
+                physx::PxActor* box = module->CreateDynamicActor();
+                physx::PxShape* boxShape = module->CreateBoxShape(Vector3(0.5f, 0.5f, 0.5f), FastName());
+                physx::PxRigidDynamic* boxBody = box->is<physx::PxRigidDynamic>();
+                boxBody->attachShape(*boxShape);
+                boxShape->release();
+                physx::PxVec3 position(offset + x * step, offset + y * step, 0.5f + z * 1.05f);
+                boxBody->setGlobalPose(physx::PxTransform(position));
+                physx::PxRigidBodyExt::updateMassAndInertia(*boxBody, 1.0f);
+                result.scene->addActor(*box);
+                result.actors.push_back(box);
+            }
+        }
+    }
+
+    return result;
+}
+
+void ReleaseBenchmarkScene(BenchmarkScene& benchmarkScene)
+{
+    for (physx::PxActor* actor : benchmarkScene.actors)
+    {
+        benchmarkScene.scene->removeActor(*actor);
+        actor->release();
+    }
+    benchmarkScene.actors.clear();
+
+    benchmarkScene.scene->release();
+    benchmarkScene.scene = nullptr;
+}
+
+void SimulateFrame(physx::PxScene* scene)
+{
+    scene->simulate(FRAME_DELTA);
+
+    // Same waiting strategy as PhysicsSystem uses
+    PhysicsJobDispatcher* jobDispatcher = dynamic_cast<PhysicsJobDispatcher*>(scene->getCpuDispatcher());
+    if (jobDispatcher != nullptr)
+    {
+        while (scene->checkResults(false) == false && jobDispatcher->ExecutePendingTask() == true)
+        {
+        }
+    }
+
+    scene->fetchResults(true);
+}
+
+float32 MeasureFrameTime(PhysicsModule* module, const PhysicsSceneConfig& config)
+{
+    BenchmarkScene benchmarkScene = CreateBenchmarkScene(module, config);
+
+    for (uint32 i = 0; i < WARMUP_FRAMES; ++i)
+    {
+        SimulateFrame(benchmarkScene.scene);
+    }
+
+    int64 startUs = SystemTimer::GetUs();
+    for (uint32 i = 0; i < MEASURED_FRAMES; ++i)
+    {
+        SimulateFrame(benchmarkScene.scene);
+    }
+    int64 elapsedUs = SystemTimer::GetUs() - startUs;
+
+    ReleaseBenchmarkScene(benchmarkScene);
+    return static_cast<float32>(elapsedUs) / (1000.0f * MEASURED_FRAMES);
+}
+} // namespace PhysicsDispatcherBenchmarkDetails
+
+DAVA_TESTCLASS (PhysicsDispatcherBenchmark)
+{
+    DAVA_TEST (CompareDispatchers)
+    {
+        using namespace PhysicsDispatcherBenchmarkDetails;
+
+        PhysicsModule* module = GetEngineContext()->moduleManager->GetModule<PhysicsModule>();
+        TEST_VERIFY(module->IsInitialized());
+
+        uint32 boxesCount = PILES_SIDE_COUNT * PILES_SIDE_COUNT * BOXES_IN_PILE;
+        uint32 workersCount = GetEngineContext()->jobManager->GetWorkersCount();
+        Logger::Info("[PhysicsDispatcherBenchmark] %u boxes, %u frames, %u job workers", boxesCount, MEASURED_FRAMES, workersCount);
+
+        const uint32 threadCounts[] = { 0, 1, 2, 4 };
+        for (uint32 threadCount : threadCounts)
+        {
+            PhysicsSceneConfig config;
+            config.threadCount = threadCount;
+
+            config.cpuDispatcherType = PhysicsCpuDispatcherType::PhysXThreadPool;
+            float32 physxFrameMs = MeasureFrameTime(module, config);
+
+            config.cpuDispatcherType = PhysicsCpuDispatcherType::JobManager;
+            float32 jobsFrameMs = MeasureFrameTime(module, config);
+
+            Logger::Info("[PhysicsDispatcherBenchmark] threads %u: PhysX pool %.2f ms/frame, JobManager %.2f ms/frame", threadCount, physxFrameMs, jobsFrameMs);
+        }
+    }
+};
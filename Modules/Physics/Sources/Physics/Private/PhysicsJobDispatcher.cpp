@@ -0,0 +1,117 @@
+#include "Physics/Private/PhysicsJobDispatcher.h"
+
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/Thread.h>
+#include <Debug/DVAssert.h>
+#include <Debug/ProfilerCPU.h>
+#include <Job/JobManager.h>
+
+#include <PxShared/task/PxTask.h>
+
+namespace DAVA
+{
+PhysicsJobDispatcher::PhysicsJobDispatcher(JobManager* jobManager_, uint32 maxWorkersCount_)
+    : jobManager(jobManager_)
+    , maxWorkersCount(maxWorkersCount_)
+{
+    DVASSERT(jobManager != nullptr || maxWorkersCount == 0);
+}
+
+PhysicsJobDispatcher::~PhysicsJobDispatcher()
+{
+    // Worker jobs hold pointer to dispatcher, so wait until all of them leave DrainTasks
+    while (true)
+    {
+        {
+            LockGuard<Mutex> lock(queueMutex);
+            if (activeWorkersCount == 0)
+            {
+                DVASSERT(pendingTasks.empty());
+                break;
+            }
+        }
+        Thread::Yield();
+    }
+}
+
+void PhysicsJobDispatcher::submitTask(physx::PxBaseTask& task)
+{
+    if (maxWorkersCount == 0)
+    {
+        RunTask(&task);
+        return;
+    }
+
+    bool needNewWorker = false;
+    {
+        LockGuard<Mutex> lock(queueMutex);
+        pendingTasks.push_back(&task);
+
+        // Running worker always rechecks queue under the same lock before leaving,
+        // so task pushed here can't be missed when no new worker is started
+        if (activeWorkersCount < maxWorkersCount)
+        {
+            ++activeWorkersCount;
+            needNewWorker = true;
+        }
+    }
+
+    if (needNewWorker)
+    {
+        jobManager->CreateWorkerJob([this]() { DrainTasks(); });
+    }
+}
+
+physx::PxU32 PhysicsJobDispatcher::getWorkerCount() const
+{
+    return maxWorkersCount;
+}
+
+bool PhysicsJobDispatcher::ExecutePendingTask()
+{
+    physx::PxBaseTask* task = nullptr;
+    {
+        LockGuard<Mutex> lock(queueMutex);
+        if (pendingTasks.empty())
+        {
+            return false;
+        }
+
+        task = pendingTasks.front();
+        pendingTasks.pop_front();
+    }
+
+    RunTask(task);
+    return true;
+}
+
+void PhysicsJobDispatcher::DrainTasks()
+{
+    while (true)
+    {
+        physx::PxBaseTask* task = nullptr;
+        {
+            LockGuard<Mutex> lock(queueMutex);
+            if (pendingTasks.empty())
+            {
+                DVASSERT(activeWorkersCount > 0);
+                --activeWorkersCount;
+                return;
+            }
+
+            task = pendingTasks.front();
+            pendingTasks.pop_front();
+        }
+
+        RunTask(task);
+    }
+}
+
+void PhysicsJobDispatcher::RunTask(physx::PxBaseTask* task)
+{
+    DAVA_PROFILER_CPU_SCOPE(task->getName());
+
+    task->run();
+    task->release();
+}
+} // namespace DAVA
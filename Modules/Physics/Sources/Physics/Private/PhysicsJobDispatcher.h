@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <Concurrency/Mutex.h>
+
+#include <PxShared/task/PxCpuDispatcher.h>
+
+namespace physx
+{
+class PxBaseTask;
+}
+
+namespace DAVA
+{
+class JobManager;
+
+/**
+    PhysX cpu dispatcher that executes simulation tasks on engine worker threads instead of
+    a separate PhysX thread pool, so physics doesn't oversubscribe cores already used by JobManager.
+
+    Tasks are kept in dispatcher's own queue and drained by at most `maxWorkersCount` worker jobs
+    at a time, which leaves the rest of workers free for other engine jobs.
+    Thread waiting for simulation results can help draining queue via `ExecutePendingTask`.
+    If `maxWorkersCount` is zero, tasks are executed immediately in the submitting thread.
+*/
+class PhysicsJobDispatcher final : public physx::PxCpuDispatcher
+{
+public:
+    PhysicsJobDispatcher(JobManager* jobManager, uint32 maxWorkersCount);
+    ~PhysicsJobDispatcher();
+
+    void submitTask(physx::PxBaseTask& task) override;
+    physx::PxU32 getWorkerCount() const override;
+
+    /** Execute one pending task in the calling thread. Return false if there were no pending tasks. */
+    bool ExecutePendingTask();
+
+private:
+    void DrainTasks();
+    void RunTask(physx::PxBaseTask* task);
+
+    JobManager* jobManager = nullptr;
+    uint32 maxWorkersCount = 0;
+
+    Mutex queueMutex;
+    Deque<physx::PxBaseTask*> pendingTasks;
+    uint32 activeWorkersCount = 0;
+};
+} // namespace DAVA
@@ -17,6 +17,8 @@
 #include "Physics/WASDPhysicsControllerComponent.h"
 #include "Physics/PhysicsGeometryCache.h"
 #include "Physics/Private/PhysicsMath.h"
+#include "Physics/Private/PhysicsJobDispatcher.h"
+#include "Physics/Private/PhysicsCookedMeshCache.h"
 
 #include <Engine/Engine.h>
 #include <Engine/EngineContext.h>
@@ -24,6 +26,7 @@
 #include <FileSystem/YamlParser.h>
 #include <FileSystem/YamlNode.h>
 #include <FileSystem/FileSystem.h>
+#include <FileSystem/KeyedArchive.h>
 #include <Logger/Logger.h>
 #include <Render/3D/PolygonGroup.h>
 #include <Render/Highlevel/Landscape.h>
@@ -218,6 +221,14 @@ void PhysicsModule::Init()
     cooking = PxCreateCooking(PX_PHYSICS_VERSION, *foundation, cookingParams);
     DVASSERT(cooking);
 
+    cookedMeshCache = new PhysicsCookedMeshCache();
+    const KeyedArchive* options = Engine::Instance()->GetOptions();
+    String cookedMeshCachePath = options->GetString("physics.cookedMeshCache");
+    if (cookedMeshCachePath.empty() == false && GetEngineContext()->fileSystem->Exists(cookedMeshCachePath) == true)
+    {
+        cookedMeshCache->Load(cookedMeshCachePath);
+    }
+
     PxInitVehicleSDK(*physics);
     PxVehicleSetBasisVectors(PxVec3(0.0f, 0.0f, 1.0f), PxVec3(1.0f, 0.0f, 0.0f));
     PxVehicleSetUpdateMode(PxVehicleUpdateMode::eVELOCITY_CHANGE);
@@ -252,10 +263,25 @@ void PhysicsModule::Shutdown()
     physx::PxCloseVehicleSDK();
 
     ReleaseMaterials();
-    if (cpuDispatcher != nullptr)
+    for (auto& node : cpuDispatchers)
+    {
+        node.second->release();
+    }
+    cpuDispatchers.clear();
+
+    for (auto& node : jobDispatchers)
+    {
+        SafeDelete(node.second);
+    }
+    jobDispatchers.clear();
+
+    const KeyedArchive* options = Engine::Instance()->GetOptions();
+    String cookedMeshCachePath = options->GetString("physics.cookedMeshCache");
+    if (cookedMeshCachePath.empty() == false && options->GetBool("physics.updateCookedMeshCache", false) == true && cookedMeshCache->IsChanged() == true)
     {
-        cpuDispatcher->release();
+        cookedMeshCache->Save(cookedMeshCachePath);
     }
+    SafeDelete(cookedMeshCache);
 
     cooking->release();
     physics->release();
@@ -293,12 +319,8 @@ physx::PxScene* PhysicsModule::CreateScene(const PhysicsSceneConfig& config, phy
     sceneDesc.filterShader = filterShader;
     sceneDesc.simulationEventCallback = callback;
 
-    if (cpuDispatcher == nullptr)
-    {
-        cpuDispatcher = PxDefaultCpuDispatcherCreate(config.threadCount);
-    }
-    DVASSERT(cpuDispatcher);
-    sceneDesc.cpuDispatcher = cpuDispatcher;
+    sceneDesc.cpuDispatcher = GetCpuDispatcher(config.cpuDispatcherType, config.threadCount);
+    DVASSERT(sceneDesc.cpuDispatcher);
 
     PxScene* scene = physics->createScene(sceneDesc);
     DVASSERT(scene);
@@ -306,6 +328,26 @@ physx::PxScene* PhysicsModule::CreateScene(const PhysicsSceneConfig& config, phy
     return scene;
 }
 
+physx::PxCpuDispatcher* PhysicsModule::GetCpuDispatcher(PhysicsCpuDispatcherType type, uint32 threadCount) const
+{
+    if (type == PhysicsCpuDispatcherType::JobManager)
+    {
+        PhysicsJobDispatcher*& dispatcher = jobDispatchers[threadCount];
+        if (dispatcher == nullptr)
+        {
+            dispatcher = new PhysicsJobDispatcher(GetEngineContext()->jobManager, threadCount);
+        }
+        return dispatcher;
+    }
+
+    physx::PxDefaultCpuDispatcher*& dispatcher = cpuDispatchers[threadCount];
+    if (dispatcher == nullptr)
+    {
+        dispatcher = physx::PxDefaultCpuDispatcherCreate(threadCount);
+    }
+    return dispatcher;
+}
+
 physx::PxActor* PhysicsModule::CreateStaticActor() const
 {
     return physics->createRigidStatic(physx::PxTransform(physx::PxIDENTITY::PxIdentity));
@@ -347,30 +389,11 @@ physx::PxShape* PhysicsModule::CreateMeshShape(Vector<PolygonGroup*>&& polygons,
     PxBase* mesh = cache->GetTriangleMeshEntry(polygons);
     if (mesh == nullptr)
     {
-        Vector<PxVec3> vertices;
-        Vector<PxU32> indices;
-        PhysicsModuleDetail::BuildPhysxMeshInfo(polygons, vertices, indices);
-
-        PxTriangleMeshDesc desc;
-        desc.points.count = static_cast<PxU32>(vertices.size());
-        desc.points.stride = sizeof(PxVec3);
-        desc.points.data = vertices.data();
-        desc.triangles.count = static_cast<PxU32>(indices.size() / 3);
-        desc.triangles.stride = 3 * sizeof(PxU32);
-        desc.triangles.data = indices.data();
-        desc.flags = PxMeshFlags(0);
-
-        physx::PxTriangleMeshCookingResult::Enum condition;
-        PxDefaultMemoryOutputStream outStream;
-        if (cooking->cookTriangleMesh(desc, outStream, &condition) == false)
+        mesh = CreateCookedMesh(polygons, false);
+        if (mesh == nullptr)
         {
-            Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
             return nullptr;
         }
-
-        physx::PxDefaultMemoryInputData inputStream(outStream.getData(), outStream.getSize());
-        mesh = physics->createTriangleMesh(inputStream);
-        DVASSERT(mesh != nullptr);
         cache->AddEntry(polygons, mesh);
     }
     PxTriangleMesh* triangleMesh = mesh->is<PxTriangleMesh>();
@@ -394,30 +417,11 @@ physx::PxShape* PhysicsModule::CreateConvexHullShape(Vector<PolygonGroup*>&& pol
     PxBase* mesh = cache->GetConvexHullEntry(polygons);
     if (mesh == nullptr)
     {
-        Vector<PxVec3> vertices;
-        Vector<PxU32> indices;
-        PhysicsModuleDetail::BuildPhysxMeshInfo(polygons, vertices, indices);
-
-        PxConvexMeshDesc desc;
-        desc.points.count = static_cast<PxU32>(vertices.size());
-        desc.points.stride = sizeof(PxVec3);
-        desc.points.data = vertices.data();
-        desc.indices.count = static_cast<PxU32>(indices.size());
-        desc.indices.stride = sizeof(PxU32);
-        desc.indices.data = indices.data();
-        desc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
-
-        PxConvexMeshCookingResult::Enum condition;
-        PxDefaultMemoryOutputStream outStream;
-        if (cooking->cookConvexMesh(desc, outStream, &condition) == false)
+        mesh = CreateCookedMesh(polygons, true);
+        if (mesh == nullptr)
         {
-            Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
             return nullptr;
         }
-
-        physx::PxDefaultMemoryInputData inputStream(outStream.getData(), outStream.getSize());
-        mesh = physics->createConvexMesh(inputStream);
-        DVASSERT(mesh != nullptr);
         cache->AddEntry(polygons, mesh);
     }
 
@@ -430,6 +434,100 @@ physx::PxShape* PhysicsModule::CreateConvexHullShape(Vector<PolygonGroup*>&& pol
     return shape;
 }
 
+physx::PxBase* PhysicsModule::CreateCookedMesh(const Vector<PolygonGroup*>& polygons, bool convexHull) const
+{
+    using namespace physx;
+
+    Vector<PxVec3> vertices;
+    Vector<PxU32> indices;
+    PhysicsModuleDetail::BuildPhysxMeshInfo(polygons, vertices, indices);
+
+    PxTriangleMeshDesc triangleMeshDesc;
+    PxConvexMeshDesc convexMeshDesc;
+    uint32 meshFlags = 0;
+    if (convexHull == true)
+    {
+        convexMeshDesc.points.count = static_cast<PxU32>(vertices.size());
+        convexMeshDesc.points.stride = sizeof(PxVec3);
+        convexMeshDesc.points.data = vertices.data();
+        convexMeshDesc.indices.count = static_cast<PxU32>(indices.size());
+        convexMeshDesc.indices.stride = sizeof(PxU32);
+        convexMeshDesc.indices.data = indices.data();
+        convexMeshDesc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
+        meshFlags = static_cast<uint32>(convexMeshDesc.flags);
+    }
+    else
+    {
+        triangleMeshDesc.points.count = static_cast<PxU32>(vertices.size());
+        triangleMeshDesc.points.stride = sizeof(PxVec3);
+        triangleMeshDesc.points.data = vertices.data();
+        triangleMeshDesc.triangles.count = static_cast<PxU32>(indices.size() / 3);
+        triangleMeshDesc.triangles.stride = 3 * sizeof(PxU32);
+        triangleMeshDesc.triangles.data = indices.data();
+        triangleMeshDesc.flags = PxMeshFlags(0);
+        meshFlags = static_cast<uint32>(triangleMeshDesc.flags);
+    }
+
+    PhysicsCookedMeshCache::eMeshType meshType = convexHull ? PhysicsCookedMeshCache::eMeshType::ConvexMesh : PhysicsCookedMeshCache::eMeshType::TriangleMesh;
+    PhysicsCookedMeshCache::Key key = PhysicsCookedMeshCache::MakeKey(meshType, cooking->getParams(), meshFlags, polygons);
+
+    const uint8* cookedData = nullptr;
+    uint32 cookedDataSize = 0;
+    if (cookedMeshCache->Find(key, cookedData, cookedDataSize) == false)
+    {
+        PxDefaultMemoryOutputStream outStream;
+        if (convexHull == true)
+        {
+            PxConvexMeshCookingResult::Enum condition;
+            if (cooking->cookConvexMesh(convexMeshDesc, outStream, &condition) == false)
+            {
+                Logger::Error("[Physics::CreateConvexHullShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
+                return nullptr;
+            }
+        }
+        else
+        {
+            PxTriangleMeshCookingResult::Enum condition;
+            if (cooking->cookTriangleMesh(triangleMeshDesc, outStream, &condition) == false)
+            {
+                Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
+                return nullptr;
+            }
+        }
+
+        cookedMeshCache->Add(key, outStream.getData(), outStream.getSize());
+        bool found = cookedMeshCache->Find(key, cookedData, cookedDataSize);
+        DVASSERT(found == true);
+    }
+
+    // PhysX reads cooked stream without modifying it
+    PxDefaultMemoryInputData inputStream(const_cast<uint8*>(cookedData), cookedDataSize);
+    PxBase* mesh = nullptr;
+    if (convexHull == true)
+    {
+        mesh = physics->createConvexMesh(inputStream);
+    }
+    else
+    {
+        mesh = physics->createTriangleMesh(inputStream);
+    }
+    DVASSERT(mesh != nullptr);
+
+    return mesh;
+}
+
+bool PhysicsModule::LoadCookedMeshCache(const FilePath& path)
+{
+    DVASSERT(cookedMeshCache != nullptr);
+    return cookedMeshCache->Load(path);
+}
+
+bool PhysicsModule::SaveCookedMeshCache(const FilePath& path)
+{
+    DVASSERT(cookedMeshCache != nullptr);
+    return cookedMeshCache->Save(path);
+}
+
 physx::PxShape* PhysicsModule::CreateHeightField(Landscape* landscape, const FastName& materialName, Matrix4& localPose) const
 {
     using namespace physx;
@@ -0,0 +1,135 @@
+#include "UnitTests/UnitTests.h"
+#include "Physics/PhysicsSystem.h"
+#include "Physics/PhysicsQueries.h"
+#include "Physics/StaticBodyComponent.h"
+#include "Physics/HeightFieldShapeComponent.h"
+#include "Physics/Private/PhysicsSystemPrivate.h"
+
+#include <Base/ScopedPtr.h>
+#include <Concurrency/Thread.h>
+#include <Engine/Engine.h>
+#include <Engine/EngineContext.h>
+#include <Job/JobManager.h>
+#include <Logger/Logger.h>
+#include <Render/Highlevel/Heightmap.h>
+#include <Render/Highlevel/Landscape.h>
+#include <Scene3D/Components/RenderComponent.h>
+#include <Scene3D/Scene.h>
+#include <Time/SystemTimer.h>
+#include <Utils/Random.h>
+
+#include <physx/PxQueryReport.h>
+
+using namespace DAVA;
+
+namespace PhysicsQueriesBenchmarkDetails
+{
+const int32 HEIGHTMAP_SIZE = 257;
+const float32 LANDSCAPE_SIZE = 512.0f;
+const float32 LANDSCAPE_HEIGHT = 50.0f;
+const uint32 RAYS_COUNT = 10000;
+const uint32 MEASURED_RUNS = 5;
+
+Landscape* CreateLandscape()
+{
+    ScopedPtr<Heightmap> heightmap(new Heightmap(HEIGHTMAP_SIZE));
+    uint16* data = heightmap->Data();
+    for (int32 y = 0; y < HEIGHTMAP_SIZE; ++y)
+    {
+        for (int32 x = 0; x < HEIGHTMAP_SIZE; ++x)
+        {
+            float32 wave = 0.5f + 0.25f * (std::sin(x * 0.1f) + std::cos(y * 0.07f));
+            data[y * HEIGHTMAP_SIZE + x] = static_cast<uint16>(wave * 65535.0f);
+        }
+    }
+
+    Landscape* landscape = new Landscape();
+    landscape->SetHeightmap(heightmap);
+    landscape->SetLandscapeSize(LANDSCAPE_SIZE);
+    landscape->SetLandscapeHeight(LANDSCAPE_HEIGHT);
+    return landscape;
+}
+
+Vector<PhysicsRaycastQuery> CreateDownwardRays()
+{
+    // Fixed seed keeps rays the same between runs
+    Random random(42);
+
+    Vector<PhysicsRaycastQuery> queries(RAYS_COUNT);
+    const float32 halfSize = 0.5f * LANDSCAPE_SIZE * 0.95f;
+    for (PhysicsRaycastQuery& query : queries)
+    {
+        float32 x = random.RandFloat32InBounds(-halfSize, halfSize);
+        float32 y = random.RandFloat32InBounds(-halfSize, halfSize);
+        query.origin = Vector3(x, y, 2.0f * LANDSCAPE_HEIGHT);
+        query.direction = Vector3(0.0f, 0.0f, -1.0f);
+        query.distance = 4.0f * LANDSCAPE_HEIGHT;
+    }
+
+    return queries;
+}
+} // namespace PhysicsQueriesBenchmarkDetails
+
+DAVA_TESTCLASS (PhysicsQueriesBenchmark)
+{
+    DAVA_TEST (RaycastLandscape)
+    {
+        using namespace PhysicsQueriesBenchmarkDetails;
+
+        ScopedPtr<Scene> scene(new Scene());
+        ScopedPtr<Entity> entity(new Entity());
+        ScopedPtr<Landscape> landscape(CreateLandscape());
+        entity->AddComponent(new RenderComponent(landscape));
+        entity->AddComponent(new StaticBodyComponent());
+        entity->AddComponent(new HeightFieldShapeComponent());
+        scene->AddNode(entity);
+
+        PhysicsSystem* physicsSystem = scene->physicsSystem;
+        scene->Update(0.16f);
+        while (PhysicsSystemPrivate::HasPendingComponents(physicsSystem))
+        {
+            Thread::Sleep(16);
+            scene->Update(0.16f);
+        }
+
+        Vector<PhysicsRaycastQuery> queries = CreateDownwardRays();
+        Vector<PhysicsQueryHit> singleResults(queries.size());
+        Vector<PhysicsQueryHit> batchResults;
+
+        int64 singleUs = 0;
+        int64 batchUs = 0;
+        for (uint32 run = 0; run < MEASURED_RUNS; ++run)
+        {
+            int64 startUs = SystemTimer::GetUs();
+            for (size_t i = 0; i < queries.size(); ++i)
+            {
+                physx::PxRaycastBuffer buffer;
+                physicsSystem->Raycast(queries[i].origin, queries[i].direction, queries[i].distance, buffer);
+                singleResults[i].hasHit = buffer.hasBlock;
+                singleResults[i].distance = buffer.block.distance;
+            }
+            singleUs += SystemTimer::GetUs() - startUs;
+
+            startUs = SystemTimer::GetUs();
+            physicsSystem->RaycastBatch(queries, batchResults);
+            batchUs += SystemTimer::GetUs() - startUs;
+        }
+
+        TEST_VERIFY(batchResults.size() == queries.size());
+        uint32 hitsCount = 0;
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            TEST_VERIFY(batchResults[i].hasHit == singleResults[i].hasHit);
+            if (batchResults[i].hasHit)
+            {
+                TEST_VERIFY(FLOAT_EQUAL_EPS(batchResults[i].distance, singleResults[i].distance, 0.001f));
+                ++hitsCount;
+            }
+        }
+        TEST_VERIFY(hitsCount == queries.size());
+
+        uint32 workersCount = GetEngineContext()->jobManager->GetWorkersCount();
+        Logger::Info("[PhysicsQueriesBenchmark] %u rays, %u job workers: sequential %.2f ms, batch %.2f ms", RAYS_COUNT, workersCount,
+                     singleUs / (1000.0f * MEASURED_RUNS), batchUs / (1000.0f * MEASURED_RUNS));
+    }
+};
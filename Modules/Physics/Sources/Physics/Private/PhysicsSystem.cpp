@@ -23,6 +23,7 @@
 #include "Physics/HeightFieldShapeComponent.h"
 
 #include "Physics/Private/PhysicsMath.h"
+#include "Physics/Private/PhysicsJobDispatcher.h"
 #include "Physics/PhysicsVehiclesSubsystem.h"
 
 #include <Scene3D/Entity.h>
@@ -44,8 +45,11 @@
 #include <Render/RenderHelper.h>
 #include <FileSystem/KeyedArchive.h>
 #include <Utils/Utils.h>
+#include <Job/JobManager.h>
 
 #include <physx/PxScene.h>
+#include <physx/PxQueryFiltering.h>
+#include <physx/geometry/PxSphereGeometry.h>
 #include <physx/PxRigidActor.h>
 #include <physx/PxRigidDynamic.h>
 #include <physx/common/PxRenderBuffer.h>
@@ -84,6 +88,40 @@ void UpdateGlobalPose(physx::PxRigidActor* actor, const Matrix4& m, Vector3& sca
     actor->setGlobalPose(physx::PxTransform(PhysicsMath::Vector3ToPxVec3(position), PhysicsMath::QuaternionToPxQuat(rotation)));
 }
 
+const uint32 QUERIES_CHUNK_SIZE = 64;
+
+// Calling thread takes part in processing and returns as soon as all chunks are done
+void ExecuteQueriesParallel(uint32 queriesCount, const Function<void(uint32, uint32)>& processRange)
+{
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr)
+    {
+        jobManager->ParallelFor(queriesCount, QUERIES_CHUNK_SIZE, processRange);
+    }
+    else if (queriesCount > 0)
+    {
+        processRange(0, queriesCount);
+    }
+}
+
+void FillQueryHit(const physx::PxLocationHit& pxHit, PhysicsQueryHit& hit)
+{
+    hit.hasHit = true;
+    hit.body = PhysicsComponent::GetComponent(pxHit.actor);
+    hit.shape = CollisionShapeComponent::GetComponent(pxHit.shape);
+    hit.position = PhysicsMath::PxVec3ToVector3(pxHit.position);
+    hit.normal = PhysicsMath::PxVec3ToVector3(pxHit.normal);
+    hit.distance = pxHit.distance;
+}
+
+physx::PxTransform InterpolatePose(const physx::PxTransform& from, const physx::PxTransform& to, float32 factor)
+{
+    // nlerp is accurate enough for angles passed by body during one simulation step
+    physx::PxQuat toRotation = from.q.dot(to.q) < 0.0f ? -to.q : to.q;
+    physx::PxQuat rotation = (from.q * (1.0f - factor) + toRotation * factor).getNormalized();
+    return physx::PxTransform(from.p * (1.0f - factor) + to.p * factor, rotation);
+}
+
 void UpdateShapeLocalPose(physx::PxShape* shape, const Matrix4& m)
 {
     Vector3 position;
@@ -294,6 +332,8 @@ PhysicsSystem::PhysicsSystem(Scene* scene)
 {
     Engine* engine = Engine::Instance();
     uint32 threadCount = 2;
+    bool useJobManager = false;
+    bool asyncSimulation = false;
     Vector3 gravity(0.0, 0.0, -9.81f);
     simulationBlockSize = PhysicsSystemDetail::DEFAULT_SIMULATION_BLOCK_SIZE;
     if (engine != nullptr)
@@ -305,6 +345,11 @@ PhysicsSystem::PhysicsSystem(Scene* scene)
 
         gravity = options->GetVector3("physics.gravity", gravity);
         threadCount = options->GetUInt32("physics.threadCount", threadCount);
+        useJobManager = options->GetBool("physics.useJobManagerDispatcher", useJobManager);
+        asyncSimulation = options->GetBool("physics.asyncSimulation", asyncSimulation);
+        fixedTimeStep = options->GetFloat("physics.fixedTimeStep", fixedTimeStep);
+        maxSubStepsCount = options->GetUInt32("physics.maxSubStepsCount", maxSubStepsCount);
+        DVASSERT(fixedTimeStep > 0.0f && maxSubStepsCount > 0);
     }
 
     const EngineContext* ctx = GetEngineContext();
@@ -314,13 +359,17 @@ PhysicsSystem::PhysicsSystem(Scene* scene)
     PhysicsSceneConfig sceneConfig;
     sceneConfig.gravity = gravity;
     sceneConfig.threadCount = threadCount;
+    sceneConfig.cpuDispatcherType = useJobManager ? PhysicsCpuDispatcherType::JobManager : PhysicsCpuDispatcherType::PhysXThreadPool;
 
     geometryCache = new PhysicsGeometryCache();
 
     physicsScene = physics->CreateScene(sceneConfig, FilterShader, &simulationEventCallback);
+    jobDispatcher = dynamic_cast<PhysicsJobDispatcher*>(physicsScene->getCpuDispatcher());
 
     vehiclesSubsystem = new PhysicsVehiclesSubsystem(scene, physicsScene);
     controllerManager = PxCreateControllerManager(*physicsScene);
+
+    SetAsyncSimulationEnabled(asyncSimulation);
 }
 
 PhysicsSystem::~PhysicsSystem()
@@ -448,11 +497,14 @@ void PhysicsSystem::RegisterComponent(Entity* entity, Component* component)
 
 void PhysicsSystem::UnregisterComponent(Entity* entity, Component* component)
 {
+    WaitSimulationFinish();
+
     const Type* componentType = component->GetType();
     if (componentType->Is<StaticBodyComponent>() || componentType->Is<DynamicBodyComponent>())
     {
         PhysicsComponent* physicsComponent = static_cast<PhysicsComponent*>(component);
         PhysicsSystemDetail::EraseComponent(physicsComponent, pendingAddPhysicsComponents, physicsComponents);
+        interpolationStates.erase(physicsComponent);
 
         physx::PxActor* actor = physicsComponent->GetPxActor();
         if (actor != nullptr)
@@ -553,6 +605,9 @@ void PhysicsSystem::UnregisterComponent(Entity* entity, Component* component)
 
 void PhysicsSystem::PrepareForRemove()
 {
+    WaitSimulationFinish();
+
+    interpolationStates.clear();
     waitRenderInfoComponents.clear();
     physicsComponensUpdatePending.clear();
     collisionComponentsUpdatePending.clear();
@@ -593,6 +648,12 @@ void PhysicsSystem::PrepareForRemove()
 
 void PhysicsSystem::Process(float32 timeElapsed)
 {
+    if (isAsyncSimulation == true)
+    {
+        ProcessAsync(timeElapsed);
+        return;
+    }
+
     if (isSimulationRunning == true)
     {
         FetchResults(false);
@@ -621,6 +682,110 @@ void PhysicsSystem::Process(float32 timeElapsed)
     }
 }
 
+void PhysicsSystem::ProcessAsync(float32 timeElapsed)
+{
+    // Step launched at the end of previous frame had whole rendering time to complete
+    WaitSimulationFinish();
+
+    InitNewObjects();
+    UpdateComponents();
+
+    if (isSimulationEnabled == false)
+    {
+        SyncTransformToPhysx();
+    }
+    else
+    {
+        MoveCharacterControllers(timeElapsed);
+
+        accumulatedTime += timeElapsed;
+        ApplyInterpolatedTransforms(Min(accumulatedTime / fixedTimeStep, 1.0f));
+    }
+}
+
+void PhysicsSystem::OnFrameEnd()
+{
+    if (isAsyncSimulation == false || isSimulationEnabled == false || isSimulationRunning == true)
+    {
+        return;
+    }
+
+    uint32 stepsCount = static_cast<uint32>(accumulatedTime / fixedTimeStep);
+    if (stepsCount == 0)
+    {
+        return;
+    }
+
+    if (stepsCount > maxSubStepsCount)
+    {
+        // Don't try to catch up after long frames, drop the time instead
+        stepsCount = maxSubStepsCount;
+        accumulatedTime = fixedTimeStep * maxSubStepsCount;
+    }
+
+    // Time left after whole steps is carried to the next frame and used as interpolation factor in ProcessAsync
+    accumulatedTime -= fixedTimeStep * stepsCount;
+
+    // Continuous forces act during every step, impulses and velocity changes are applied by the first step only
+    Vector<PendingForce> continuousForces;
+    for (const PendingForce& force : forces)
+    {
+        if (force.mode == physx::PxForceMode::eFORCE || force.mode == physx::PxForceMode::eACCELERATION)
+        {
+            continuousForces.push_back(force);
+        }
+    }
+
+    DrawDebugInfo();
+
+    // Every step has fixed length to keep simulation stable at any frame rate.
+    // All steps but the last one are completed right here, the last one runs while the frame is rendered
+    for (uint32 step = 0; step < stepsCount; ++step)
+    {
+        if (step > 0)
+        {
+            bool success = FetchResults(true);
+            DVASSERT(success == true);
+            forces = continuousForces;
+        }
+
+        // Forces and updates scheduled during the frame are applied here, after that they are queued until next launch
+        ApplyForces();
+
+        vehiclesSubsystem->Simulate(fixedTimeStep);
+        physicsScene->simulate(fixedTimeStep, nullptr, simulationBlock, simulationBlockSize);
+
+        isSimulationRunning = true;
+    }
+}
+
+void PhysicsSystem::WaitSimulationFinish()
+{
+    if (isSimulationRunning == true)
+    {
+        bool success = FetchResults(true);
+        DVASSERT(success == true);
+    }
+}
+
+void PhysicsSystem::SetAsyncSimulationEnabled(bool isEnabled)
+{
+    if (isAsyncSimulation != isEnabled)
+    {
+        WaitSimulationFinish();
+
+        isAsyncSimulation = isEnabled;
+        accumulatedTime = 0.0f;
+        ApplyInterpolatedTransforms(1.0f);
+        interpolationStates.clear();
+    }
+}
+
+bool PhysicsSystem::IsAsyncSimulationEnabled() const
+{
+    return isAsyncSimulation;
+}
+
 void PhysicsSystem::SetSimulationEnabled(bool isEnabled)
 {
     if (isSimulationEnabled != isEnabled)
@@ -659,6 +824,14 @@ bool PhysicsSystem::IsDebugDrawEnabled() const
 bool PhysicsSystem::FetchResults(bool waitForFetchFinish)
 {
     DVASSERT(isSimulationRunning);
+    if (waitForFetchFinish == true && jobDispatcher != nullptr)
+    {
+        // Help workers instead of blocking: physics tasks go ahead of anything else this thread could do
+        while (physicsScene->checkResults(false) == false && jobDispatcher->ExecutePendingTask() == true)
+        {
+        }
+    }
+
     bool isFetched = physicsScene->fetchResults(waitForFetchFinish);
     if (isFetched == true)
     {
@@ -666,49 +839,120 @@ bool PhysicsSystem::FetchResults(bool waitForFetchFinish)
         physx::PxU32 actorsCount = 0;
         physx::PxActor** actors = physicsScene->getActiveActors(actorsCount);
 
-        for (physx::PxU32 i = 0; i < actorsCount; ++i)
+        if (isAsyncSimulation == true)
         {
-            physx::PxActor* actor = actors[i];
-            PhysicsComponent* component = PhysicsComponent::GetComponent(actor);
-
-            // When character controller is created, actor is created by physx implicitly
-            // In this case there is no PhysicsComponent attached to this entity
-            if (component != nullptr)
+            // Entities are moved with interpolation during the next frames
+            StoreInterpolationStates(actors, actorsCount);
+        }
+        else
+        {
+            for (physx::PxU32 i = 0; i < actorsCount; ++i)
             {
-                Entity* entity = component->GetEntity();
+                physx::PxActor* actor = actors[i];
+                PhysicsComponent* component = PhysicsComponent::GetComponent(actor);
 
-                physx::PxRigidActor* rigidActor = actor->is<physx::PxRigidActor>();
-                DVASSERT(rigidActor != nullptr);
+                // When character controller is created, actor is created by physx implicitly
+                // In this case there is no PhysicsComponent attached to this entity
+                if (component != nullptr)
+                {
+                    physx::PxRigidActor* rigidActor = actor->is<physx::PxRigidActor>();
+                    DVASSERT(rigidActor != nullptr);
 
-                // Update entity's transform and its shapes down the hierarchy recursively
+                    UpdateEntityTransform(component, rigidActor->getGlobalPose());
+                }
+            }
+        }
+    }
 
-                Matrix4 scaleMatrix = Matrix4::MakeScale(component->currentScale);
-                TransformComponent* entityTransform = entity->GetComponent<TransformComponent>();
-                entityTransform->SetWorldMatrix(scaleMatrix * PhysicsMath::PxMat44ToMatrix4(rigidActor->getGlobalPose()));
+    return isFetched;
+}
 
-                Vector<Entity*> children;
-                entity->GetChildEntitiesWithCondition(children, [component](Entity* e) { return PhysicsSystemDetail::GetParentPhysicsComponent(e) == component; });
+void PhysicsSystem::UpdateEntityTransform(PhysicsComponent* component, const physx::PxTransform& pose)
+{
+    Entity* entity = component->GetEntity();
 
-                for (Entity* child : children)
-                {
-                    DVASSERT(child != nullptr);
+    // Update entity's transform and its shapes down the hierarchy recursively
 
-                    Vector<CollisionShapeComponent*> shapes = PhysicsUtils::GetShapeComponents(child);
-                    if (shapes.size() > 0)
-                    {
-                        // Update entity using just first shape for now
-                        CollisionShapeComponent* shape = shapes[0];
+    Matrix4 scaleMatrix = Matrix4::MakeScale(component->currentScale);
+    TransformComponent* entityTransform = entity->GetComponent<TransformComponent>();
+    entityTransform->SetWorldMatrix(scaleMatrix * PhysicsMath::PxMat44ToMatrix4(physx::PxMat44(pose)));
 
-                        Matrix4 scaleMatrix = Matrix4::MakeScale(shape->scale);
-                        TransformComponent* childTransform = child->GetComponent<TransformComponent>();
-                        childTransform->SetLocalMatrix(scaleMatrix * PhysicsMath::PxMat44ToMatrix4(shape->GetPxShape()->getLocalPose()));
-                    }
-                }
-            }
+    Vector<Entity*> children;
+    entity->GetChildEntitiesWithCondition(children, [component](Entity* e) { return PhysicsSystemDetail::GetParentPhysicsComponent(e) == component; });
+
+    for (Entity* child : children)
+    {
+        DVASSERT(child != nullptr);
+
+        Vector<CollisionShapeComponent*> shapes = PhysicsUtils::GetShapeComponents(child);
+        if (shapes.size() > 0)
+        {
+            // Update entity using just first shape for now
+            CollisionShapeComponent* shape = shapes[0];
+
+            Matrix4 scaleMatrix = Matrix4::MakeScale(shape->scale);
+            TransformComponent* childTransform = child->GetComponent<TransformComponent>();
+            childTransform->SetLocalMatrix(scaleMatrix * PhysicsMath::PxMat44ToMatrix4(shape->GetPxShape()->getLocalPose()));
         }
     }
+}
 
-    return isFetched;
+void PhysicsSystem::StoreInterpolationStates(physx::PxActor** activeActors, physx::PxU32 activeActorsCount)
+{
+    // Bodies which weren't moved by this step stay at their current pose
+    for (auto& node : interpolationStates)
+    {
+        node.second.previousPose = node.second.currentPose;
+        node.second.movedByLastStep = false;
+    }
+
+    for (physx::PxU32 i = 0; i < activeActorsCount; ++i)
+    {
+        physx::PxActor* actor = activeActors[i];
+        PhysicsComponent* component = PhysicsComponent::GetComponent(actor);
+        if (component == nullptr)
+        {
+            continue;
+        }
+
+        physx::PxRigidActor* rigidActor = actor->is<physx::PxRigidActor>();
+        DVASSERT(rigidActor != nullptr);
+
+        physx::PxTransform pose = rigidActor->getGlobalPose();
+        auto iter = interpolationStates.find(component);
+        if (iter == interpolationStates.end())
+        {
+            InterpolationState& state = interpolationStates[component];
+            state.previousPose = pose;
+            state.currentPose = pose;
+            state.movedByLastStep = true;
+        }
+        else
+        {
+            iter->second.currentPose = pose;
+            iter->second.movedByLastStep = true;
+        }
+    }
+}
+
+void PhysicsSystem::ApplyInterpolatedTransforms(float32 factor)
+{
+    auto iter = interpolationStates.begin();
+    while (iter != interpolationStates.end())
+    {
+        const InterpolationState& state = iter->second;
+        if (state.movedByLastStep == false)
+        {
+            // Body has come to its final pose, no need to track it any more
+            UpdateEntityTransform(iter->first, state.currentPose);
+            iter = interpolationStates.erase(iter);
+        }
+        else
+        {
+            UpdateEntityTransform(iter->first, PhysicsSystemDetail::InterpolatePose(state.previousPose, state.currentPose, factor));
+            ++iter;
+        }
+    }
 }
 
 void PhysicsSystem::DrawDebugInfo()
@@ -1132,6 +1376,72 @@ bool PhysicsSystem::Raycast(const Vector3& origin, const Vector3& direction, flo
                                  static_cast<PxReal>(distance), callback);
 }
 
+void PhysicsSystem::RaycastBatch(const Vector<PhysicsRaycastQuery>& queries, Vector<PhysicsQueryHit>& results)
+{
+    results.assign(queries.size(), PhysicsQueryHit());
+
+    physx::PxScene* scene = physicsScene;
+    PhysicsSystemDetail::ExecuteQueriesParallel(static_cast<uint32>(queries.size()), [&queries, &results, scene](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            const PhysicsRaycastQuery& query = queries[i];
+            physx::PxRaycastBuffer buffer;
+            scene->raycast(PhysicsMath::Vector3ToPxVec3(query.origin), PhysicsMath::Vector3ToPxVec3(Normalize(query.direction)),
+                           static_cast<physx::PxReal>(query.distance), buffer);
+            if (buffer.hasBlock)
+            {
+                PhysicsSystemDetail::FillQueryHit(buffer.block, results[i]);
+            }
+        }
+    });
+}
+
+void PhysicsSystem::SweepSphereBatch(const Vector<PhysicsSphereSweepQuery>& queries, Vector<PhysicsQueryHit>& results)
+{
+    results.assign(queries.size(), PhysicsQueryHit());
+
+    physx::PxScene* scene = physicsScene;
+    PhysicsSystemDetail::ExecuteQueriesParallel(static_cast<uint32>(queries.size()), [&queries, &results, scene](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            const PhysicsSphereSweepQuery& query = queries[i];
+            physx::PxSweepBuffer buffer;
+            physx::PxTransform pose(PhysicsMath::Vector3ToPxVec3(query.origin));
+            scene->sweep(physx::PxSphereGeometry(query.radius), pose, PhysicsMath::Vector3ToPxVec3(Normalize(query.direction)),
+                         static_cast<physx::PxReal>(query.distance), buffer);
+            if (buffer.hasBlock)
+            {
+                PhysicsSystemDetail::FillQueryHit(buffer.block, results[i]);
+            }
+        }
+    });
+}
+
+void PhysicsSystem::OverlapSphereBatch(const Vector<PhysicsSphereOverlapQuery>& queries, Vector<PhysicsQueryHit>& results)
+{
+    results.assign(queries.size(), PhysicsQueryHit());
+
+    physx::PxScene* scene = physicsScene;
+    PhysicsSystemDetail::ExecuteQueriesParallel(static_cast<uint32>(queries.size()), [&queries, &results, scene](uint32 begin, uint32 end) {
+        // Overlap queries support only "any hit" mode when there is no touch buffer
+        physx::PxQueryFilterData filterData(physx::PxQueryFlag::eSTATIC | physx::PxQueryFlag::eDYNAMIC | physx::PxQueryFlag::eANY_HIT);
+        for (uint32 i = begin; i < end; ++i)
+        {
+            const PhysicsSphereOverlapQuery& query = queries[i];
+            physx::PxOverlapBuffer buffer;
+            physx::PxTransform pose(PhysicsMath::Vector3ToPxVec3(query.center));
+            scene->overlap(physx::PxSphereGeometry(query.radius), pose, buffer, filterData);
+            if (buffer.hasBlock)
+            {
+                PhysicsQueryHit& hit = results[i];
+                hit.hasHit = true;
+                hit.body = PhysicsComponent::GetComponent(buffer.block.actor);
+                hit.shape = CollisionShapeComponent::GetComponent(buffer.block.shape);
+            }
+        }
+    });
+}
+
 PhysicsVehiclesSubsystem* PhysicsSystem::GetVehiclesSystem()
 {
     return vehiclesSubsystem;
@@ -179,6 +179,36 @@ DAVA_TESTCLASS (PhysicsTest)
         TEST_VERIFY(dynamicActor->getNbShapes() == 1);
     }
 
+    DAVA_TEST (AsyncSimulationTest)
+    {
+        using namespace PhysicsTestDetils;
+        SceneInfo info = CreateScene();
+        PhysicsSystem* system = info.scene->physicsSystem;
+        system->SetAsyncSimulationEnabled(true);
+        TEST_VERIFY(system->IsAsyncSimulationEnabled() == true);
+
+        Component* body = AttachComponent<DynamicBodyComponent>(info);
+        AttachComponent<BoxShapeComponent>(info);
+        Frame(info);
+
+        TransformComponent* transform = info.entity->GetComponent<TransformComponent>();
+        float32 startHeight = transform->GetWorldTransform().GetTranslation().z;
+        for (uint32 i = 0; i < 4; ++i)
+        {
+            info.scene->Update(0.16f);
+        }
+        TEST_VERIFY(transform->GetWorldTransform().GetTranslation().z < startHeight);
+
+        // Body is removed while step launched by last frame is still running
+        RemoveComponent(info, body);
+        physx::PxScene* pxScene = ExtractPxScene(info);
+        TEST_VERIFY(pxScene->getNbActors(physx::PxActorTypeFlag::eRIGID_DYNAMIC) == 0);
+
+        Frame(info);
+        system->SetAsyncSimulationEnabled(false);
+        TEST_VERIFY(system->IsAsyncSimulationEnabled() == false);
+    }
+
     DAVA_TEST (ReplaceBodyComponent)
     {
         using namespace PhysicsTestDetils;
@@ -19,15 +19,22 @@
 #include <Logger/Logger.h>
 #include <Engine/Engine.h>
 #include <Job/JobManager.h>
+#include <Concurrency/ConditionVariable.h>
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/Mutex.h>
+#include <Concurrency/UniqueLock.h>
+#include <Time/SystemTimer.h>
 
 #include <sqlite_modern_cpp.h>
 #include <algorithm>
+#include <queue>
 
 ENUM_DECLARE(DAVA::Compressor::Type)
 {
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::Lz4), "lz4");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::Lz4HC), "lz4hc");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::RFC1951), "rfc1951");
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::Lz4Dictionary), "lz4dict");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::None), "none");
 };
 
@@ -442,11 +449,251 @@ const Compressor* GetCompressor(Compressor::Type compressorType)
     }
 }
 
+const uint64 DICTIONARY_SAMPLES_MAX_SIZE = 32 * 1024 * 1024;
+const uint32 DICTIONARY_MIN_SAMPLES = 8;
+const uint32 DICTIONARY_SEGMENT_SIZE = 64;
+const uint32 DICTIONARY_KMER_SIZE = 8;
+const uint32 DICTIONARY_HASH_BITS = 20;
+
+uint32 HashDictionaryKmer(const uint8* data)
+{
+    uint64 kmer = 0;
+    std::memcpy(&kmer, data, DICTIONARY_KMER_SIZE);
+    return static_cast<uint32>((kmer * 0x9E3779B97F4A7C15ull) >> (64 - DICTIONARY_HASH_BITS));
+}
+
+/**
+    Train shared dictionary on small files: split samples into segments, score each segment by number
+    of files containing its 8-byte substrings, and greedily take the best segments, so content repeated
+    across many files gets into dictionary once. Return empty dictionary if there are too few small files.
+*/
+Vector<uint8> TrainDictionary(const Vector<CollectedFile>& collectedFiles, uint32 maxFileSize)
+{
+    FileSystem* fs = FileSystem::Instance();
+
+    Vector<const CollectedFile*> smallFiles;
+    uint64 smallFilesSize = 0;
+    for (const CollectedFile& collectedFile : collectedFiles)
+    {
+        uint64 fileSize = 0;
+        if (fs->GetFileSize(collectedFile.absPath, fileSize) && fileSize >= DICTIONARY_SEGMENT_SIZE && fileSize <= maxFileSize)
+        {
+            smallFiles.push_back(&collectedFile);
+            smallFilesSize += fileSize;
+        }
+    }
+
+    // take evenly spaced samples if all small files are too big to train on
+    const size_t sampleStep = static_cast<size_t>(smallFilesSize / DICTIONARY_SAMPLES_MAX_SIZE + 1);
+    Vector<Vector<uint8>> samples;
+    for (size_t i = 0; i < smallFiles.size(); i += sampleStep)
+    {
+        Vector<uint8> sample;
+        if (fs->ReadFileContents(smallFiles[i]->absPath, sample) && sample.size() >= DICTIONARY_SEGMENT_SIZE)
+        {
+            samples.push_back(std::move(sample));
+        }
+    }
+
+    if (samples.size() < DICTIONARY_MIN_SAMPLES)
+    {
+        return Vector<uint8>();
+    }
+
+    // count number of samples containing each k-mer
+    Vector<uint32> kmerSamples(1 << DICTIONARY_HASH_BITS, 0);
+    Vector<uint32> kmerLastSample(1 << DICTIONARY_HASH_BITS, 0);
+    for (uint32 sampleIndex = 0; sampleIndex < samples.size(); ++sampleIndex)
+    {
+        const Vector<uint8>& sample = samples[sampleIndex];
+        for (size_t pos = 0; pos + DICTIONARY_KMER_SIZE <= sample.size(); ++pos)
+        {
+            const uint32 hash = HashDictionaryKmer(&sample[pos]);
+            if (kmerLastSample[hash] != sampleIndex + 1)
+            {
+                kmerLastSample[hash] = sampleIndex + 1;
+                ++kmerSamples[hash];
+            }
+        }
+    }
+
+    struct Segment
+    {
+        uint32 score;
+        uint32 sampleIndex;
+        uint32 offset;
+
+        bool operator<(const Segment& other) const
+        {
+            return score < other.score;
+        }
+    };
+
+    auto scoreSegment = [&](uint32 sampleIndex, uint32 offset)
+    {
+        uint32 score = 0;
+        const uint8* segment = &samples[sampleIndex][offset];
+        for (uint32 pos = 0; pos + DICTIONARY_KMER_SIZE <= DICTIONARY_SEGMENT_SIZE; ++pos)
+        {
+            const uint32 count = kmerSamples[HashDictionaryKmer(segment + pos)];
+            score += (count > 1) ? count - 1 : 0;
+        }
+        return score;
+    };
+
+    std::priority_queue<Segment> segments;
+    for (uint32 sampleIndex = 0; sampleIndex < samples.size(); ++sampleIndex)
+    {
+        const uint32 sampleSize = static_cast<uint32>(samples[sampleIndex].size());
+        for (uint32 offset = 0; offset + DICTIONARY_SEGMENT_SIZE <= sampleSize; offset += DICTIONARY_SEGMENT_SIZE)
+        {
+            const uint32 score = scoreSegment(sampleIndex, offset);
+            if (score > 0)
+            {
+                segments.push(Segment{ score, sampleIndex, offset });
+            }
+        }
+    }
+
+    // lazy greedy selection: scores only decrease as k-mers of selected segments are zeroed
+    Vector<Segment> selected;
+    const size_t maxSegments = LZ4DictionaryCompressor::MAX_DICTIONARY_SIZE / DICTIONARY_SEGMENT_SIZE;
+    while (!segments.empty() && selected.size() < maxSegments)
+    {
+        Segment segment = segments.top();
+        segments.pop();
+
+        segment.score = scoreSegment(segment.sampleIndex, segment.offset);
+        if (segment.score == 0)
+        {
+            continue;
+        }
+        if (!segments.empty() && segment.score < segments.top().score)
+        {
+            segments.push(segment);
+            continue;
+        }
+
+        selected.push_back(segment);
+        const uint8* data = &samples[segment.sampleIndex][segment.offset];
+        for (uint32 pos = 0; pos + DICTIONARY_KMER_SIZE <= DICTIONARY_SEGMENT_SIZE; ++pos)
+        {
+            kmerSamples[HashDictionaryKmer(data + pos)] = 0;
+        }
+    }
+
+    // best segments go last, closest to compressed data
+    Vector<uint8> dictionary;
+    dictionary.reserve(selected.size() * DICTIONARY_SEGMENT_SIZE);
+    for (auto it = selected.rbegin(); it != selected.rend(); ++it)
+    {
+        const uint8* data = &samples[it->sampleIndex][it->offset];
+        dictionary.insert(dictionary.end(), data, data + DICTIONARY_SEGMENT_SIZE);
+    }
+
+    Logger::Info("trained dictionary: %u bytes from %u of %u small files", static_cast<uint32>(dictionary.size()), static_cast<uint32>(samples.size()), static_cast<uint32>(smallFiles.size()));
+    return dictionary;
+}
+
+enum class FilePackState : uint8
+{
+    Pending,
+    Packed,
+    Failed
+};
+
+bool PackFileData(const CollectedFile& collectedFile,
+                  const Compressor::Type compressionType,
+                  const Compressor* compressor,
+                  const LZ4DictionaryCompressor* dictionaryCompressor,
+                  uint32 dictionaryMaxFileSize,
+                  bool dummyFileData,
+                  uint32 metaIndex,
+                  PackFormat::FileTableEntry& fileEntry,
+                  Vector<uint8>& outBuffer)
+{
+    Vector<uint8> origFileBuffer;
+    Vector<uint8> compressedFileBuffer;
+
+    bool useCompressedBuffer = (compressionType != Compressor::Type::None);
+    Compressor::Type useCompression = compressionType;
+
+    if (dummyFileData)
+    {
+        origFileBuffer.resize(1);
+        origFileBuffer[0] = 0;
+
+        useCompressedBuffer = false;
+        useCompression = Compressor::Type::None;
+    }
+    else
+    {
+        if (!FileSystem::Instance()->ReadFileContents(collectedFile.absPath, origFileBuffer))
+        {
+            Logger::Error("Can't read contents of: %s", collectedFile.absPath.GetAbsolutePathname().c_str());
+            return false;
+        }
+
+        if (origFileBuffer.empty())
+        {
+            useCompressedBuffer = false;
+            useCompression = Compressor::Type::None;
+        }
+
+        if (useCompressedBuffer)
+        {
+            if (!compressor->Compress(origFileBuffer, compressedFileBuffer))
+            {
+                Logger::Error("Can't compress contents of: %s", collectedFile.absPath.GetAbsolutePathname().c_str());
+                return false;
+            }
+
+            if (compressedFileBuffer.size() < origFileBuffer.size())
+            {
+                useCompressedBuffer = true;
+            }
+            else
+            {
+                useCompressedBuffer = false;
+                useCompression = Compressor::Type::None;
+            }
+        }
+
+        // small files are compressed with shared dictionary too, smaller result is used
+        if (dictionaryCompressor != nullptr && !origFileBuffer.empty() && origFileBuffer.size() <= dictionaryMaxFileSize)
+        {
+            Vector<uint8> dictionaryCompressedBuffer;
+            const size_t bestSize = useCompressedBuffer ? compressedFileBuffer.size() : origFileBuffer.size();
+            if (dictionaryCompressor->Compress(origFileBuffer, dictionaryCompressedBuffer) && dictionaryCompressedBuffer.size() < bestSize)
+            {
+                compressedFileBuffer = std::move(dictionaryCompressedBuffer);
+                useCompressedBuffer = true;
+                useCompression = Compressor::Type::Lz4Dictionary;
+            }
+        }
+    }
+
+    Vector<uint8>& useBuffer = (useCompressedBuffer ? compressedFileBuffer : origFileBuffer);
+
+    fileEntry.startPosition = 0; // later fill this field
+    fileEntry.originalSize = static_cast<uint32>(origFileBuffer.size());
+    fileEntry.compressedSize = static_cast<uint32>(useBuffer.size());
+    fileEntry.type = useCompression;
+    fileEntry.compressedCrc32 = CRC32::ForBuffer(useBuffer.data(), useBuffer.size());
+    fileEntry.originalCrc32 = CRC32::ForBuffer(origFileBuffer.data(), origFileBuffer.size());
+    fileEntry.metaIndex = metaIndex;
+
+    outBuffer = std::move(useBuffer);
+    return true;
+}
+
 bool Pack(const Vector<CollectedFile>& collectedFiles,
           const DAVA::Compressor::Type compressionType,
           const FilePath& metaDb,
           File* outputFile,
-          bool dummyFileData)
+          bool dummyFileData,
+          uint32 dictionaryMaxFileSize,
+          uint32 maxFilesInFlight)
 {
     // validate input params
     if (collectedFiles.empty())
@@ -466,10 +713,22 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
         }
     }
 
-    if (!metaDb.Exists())
+    // metaDb is optional, pack without it can't be used as superpack for DLC
+    if (!metaDb.IsEmpty())
     {
-        Logger::Error("metaDB not exist");
-        return false;
+        if (!metaDb.Exists())
+        {
+            Logger::Error("metaDB not exist");
+            return false;
+        }
+
+        if (dictionaryMaxFileSize > 0)
+        {
+            // pack with metaDb is superpack for DLC, its files are downloaded one by one into *.dvpl
+            // and can't reference shared dictionary stored in superpack
+            Logger::Error("shared dictionary can't be used for superpack with metaDb");
+            return false;
+        }
     }
 
     if (outputFile == nullptr)
@@ -483,14 +742,27 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
     // CREATE TABLE IF NOT EXISTS packs(index INTEGER PRIMARY KEY, name TEXT UNIQUE, dependency TEXT NOT NULL);
     std::unique_ptr<PackMetaData> meta;
 
-    try
+    if (!metaDb.IsEmpty())
     {
-        meta.reset(new PackMetaData(metaDb));
+        try
+        {
+            meta.reset(new PackMetaData(metaDb));
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Error("can't open or parse metaDb: %s", ex.what());
+            return false;
+        }
     }
-    catch (std::exception& ex)
+
+    std::unique_ptr<LZ4DictionaryCompressor> dictionaryCompressor;
+    if (dictionaryMaxFileSize > 0 && compressionType != Compressor::Type::None && !dummyFileData)
     {
-        Logger::Error("can't open or parse metaDb: %s", ex.what());
-        return false;
+        Vector<uint8> dictionary = TrainDictionary(collectedFiles, dictionaryMaxFileSize);
+        if (!dictionary.empty())
+        {
+            dictionaryCompressor.reset(new LZ4DictionaryCompressor(dictionary));
+        }
     }
 
     const size_t numOfFiles = collectedFiles.size();
@@ -498,133 +770,111 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
     packFile.filesTable.data.files.resize(numOfFiles);
     Vector<Vector<uint8>> useBuffers;
     useBuffers.resize(numOfFiles);
+    Vector<FilePackState> fileStates(numOfFiles, FilePackState::Pending);
 
-    FileSystem* fs = FileSystem::Instance();
     JobManager* jobManager = GetEngineContext()->jobManager;
     DVASSERT(jobManager != nullptr);
 
-    std::atomic<uint32> countLoadedFiles{ 0 };
-
-    for (uint32 fileIndex = 0; fileIndex < numOfFiles; ++fileIndex)
+    // files are read and compressed by worker jobs in a window ahead of writer,
+    // and written in order of collectedFiles as soon as next file is ready,
+    // so output is the same as serial packing and only window of buffers is kept in memory
+    if (maxFilesInFlight == 0)
     {
-        jobManager->CreateWorkerJob([&, fileIndex]()
-                                    {
-                                        const CollectedFile& collectedFile = collectedFiles[fileIndex];
-                                        PackFormat::FileTableEntry& fileEntry = packFile.filesTable.data.files[fileIndex];
+        maxFilesInFlight = std::min(std::max(jobManager->GetWorkersCount(), 1u) * 16u, 512u);
+    }
 
-                                        Vector<uint8> origFileBuffer;
-                                        Vector<uint8> compressedFileBuffer;
+    Mutex statesMutex;
+    ConditionVariable fileIsPacked;
 
-                                        bool useCompressedBuffer = (compressionType != Compressor::Type::None);
-                                        Compressor::Type useCompression = compressionType;
+    const int64 startTime = SystemTimer::GetMs();
+    uint64 originalDataSize = 0;
+    uint64 dataOffset = 0;
+    uint32 dictionaryFilesCount = 0;
 
-                                        if (dummyFileData)
+    for (size_t fileIndex = 0, nextJobIndex = 0; fileIndex < numOfFiles; ++fileIndex)
+    {
+        for (; nextJobIndex < numOfFiles && nextJobIndex - fileIndex < maxFilesInFlight; ++nextJobIndex)
+        {
+            // we have PackArchive with vector of FileInfo's
+            // from PackArchive we can get fileIndex
+            // with fileIndex from PackMetaData we can get packIndex
+            // and later use metaIndex(packIndex) directly from FileInfo
+            // files table example
+            //|--------------------------------------|
+            //|file_path(sorted)----------|pack_index|
+            //|3d/gfx/uber_file.pvr       |         0|
+            //|--------------------------------------|
+            // packs table example
+            //|--------------------------------------|
+            //|pack_index|pack_name-----|pack_dep----|
+            //|         0|group_pack_1  |group_pack_0|
+            //|--------------------------------------|
+            // so packIndex(metaIndex) is duplicated in FileInfo's for now.
+            // without meta set 0, or your crc32 randomly change on same files
+            const uint32 metaIndex = meta ? meta->GetPackIndexForFile(static_cast<uint32>(nextJobIndex)) : 0;
+
+            jobManager->CreateWorkerJob([&, metaIndex, jobIndex = nextJobIndex]()
                                         {
-                                            origFileBuffer.resize(1);
-                                            origFileBuffer[0] = 0;
+                                            PackFormat::FileTableEntry& fileEntry = packFile.filesTable.data.files[jobIndex];
+                                            const bool packed = PackFileData(collectedFiles[jobIndex], compressionType, compressor, dictionaryCompressor.get(), dictionaryMaxFileSize, dummyFileData, metaIndex, fileEntry, useBuffers[jobIndex]);
 
-                                            useCompressedBuffer = false;
-                                            useCompression = Compressor::Type::None;
-                                        }
-                                        else
-                                        {
-                                            if (!fs->ReadFileContents(collectedFile.absPath, origFileBuffer))
-                                            {
-                                                Logger::Error("Can't read contents of: ", collectedFile.absPath.GetAbsolutePathname().c_str());
-                                                return;
-                                            }
-
-                                            if (origFileBuffer.empty())
-                                            {
-                                                useCompressedBuffer = false;
-                                                useCompression = Compressor::Type::None;
-                                            }
-
-                                            if (useCompressedBuffer)
-                                            {
-                                                if (!compressor->Compress(origFileBuffer, compressedFileBuffer))
-                                                {
-                                                    Logger::Error("Can't compress contents of: %s", collectedFile.absPath.GetAbsolutePathname().c_str());
-                                                    return;
-                                                }
-
-                                                if (compressedFileBuffer.size() < origFileBuffer.size())
-                                                {
-                                                    useCompressedBuffer = true;
-                                                }
-                                                else
-                                                {
-                                                    useCompressedBuffer = false;
-                                                    useCompression = Compressor::Type::None;
-                                                }
-                                            }
-                                        }
-
-                                        Vector<uint8>& useBuffer = (useCompressedBuffer ? compressedFileBuffer : origFileBuffer);
-
-                                        fileEntry.startPosition = 0; // later fill this field
-                                        fileEntry.originalSize = static_cast<uint32>(origFileBuffer.size());
-                                        fileEntry.compressedSize = static_cast<uint32>(useBuffer.size());
-                                        fileEntry.type = useCompression;
-                                        fileEntry.compressedCrc32 = CRC32::ForBuffer(useBuffer.data(), useBuffer.size());
-                                        fileEntry.originalCrc32 = CRC32::ForBuffer(origFileBuffer.data(), origFileBuffer.size());
-                                        if (!meta)
-                                        {
-                                            fileEntry.metaIndex = 0; // do it or your crc32 randomly change on same files
-                                        }
-                                        else
-                                        {
-                                            // we have PackArchive with vector of FileInfo's
-                                            // from PackArchive we can get fileIndex
-                                            // with fileIndex from PackMetaData we can get packIndex
-                                            // and later use metaIndex(packIndex) directly from FileInfo
-                                            // files table example
-                                            //|--------------------------------------|
-                                            //|file_path(sorted)----------|pack_index|
-                                            //|3d/gfx/uber_file.pvr       |         0|
-                                            //|--------------------------------------|
-                                            // packs table example
-                                            //|--------------------------------------|
-                                            //|pack_index|pack_name-----|pack_dep----|
-                                            //|         0|group_pack_1  |group_pack_0|
-                                            //|--------------------------------------|
-                                            // so packIndex(metaIndex) is duplicated in FileInfo's for now.
-                                            fileEntry.metaIndex = meta->GetPackIndexForFile(fileIndex);
-                                        }
-                                        useBuffers[fileIndex] = std::move(useBuffer);
-                                        ++countLoadedFiles;
-                                    });
-
-        //HACK wait jobs executed (internaly 1024 max jobs)
-        if (fileIndex > 0 && fileIndex % 1000 == 0)
-        {
-            jobManager->WaitWorkerJobs();
+                                            LockGuard<Mutex> lock(statesMutex);
+                                            fileStates[jobIndex] = packed ? FilePackState::Packed : FilePackState::Failed;
+                                            fileIsPacked.NotifyAll();
+                                        });
         }
-    } // end for fileIndex
 
-    jobManager->WaitWorkerJobs();
+        FilePackState state = FilePackState::Pending;
+        {
+            UniqueLock<Mutex> lock(statesMutex);
+            fileIsPacked.Wait(lock, [&]() { return fileStates[fileIndex] != FilePackState::Pending; });
+            state = fileStates[fileIndex];
+        }
 
-    if (numOfFiles != countLoadedFiles)
-    {
-        return false;
-    }
+        if (state == FilePackState::Failed)
+        {
+            jobManager->WaitWorkerJobs();
+            return false;
+        }
 
-    // write all compressed content to output file and set startPosition fileEntry
-    for (size_t fileIndex = 0, dataOffset = 0; fileIndex < numOfFiles; ++fileIndex)
-    {
+        // write compressed content to output file and set startPosition fileEntry
         PackFormat::FileTableEntry& fileEntry = packFile.filesTable.data.files[fileIndex];
         fileEntry.startPosition = dataOffset;
 
-        const Vector<uint8>& useBuffer = useBuffers[fileIndex];
+        Vector<uint8>& useBuffer = useBuffers[fileIndex];
         if (!WriteRawData(outputFile, useBuffer))
         {
             Logger::Error("can't write buffer to output file");
+            jobManager->WaitWorkerJobs();
             return false;
         }
         dataOffset += useBuffer.size();
+        originalDataSize += fileEntry.originalSize;
+        if (fileEntry.type == Compressor::Type::Lz4Dictionary)
+        {
+            ++dictionaryFilesCount;
+        }
+
+        Vector<uint8>().swap(useBuffer); // free memory
+    } // end for fileIndex
+
+    const float64 seconds = std::max(SystemTimer::GetMs() - startTime, int64(1)) / 1000.0;
+    const float64 originalMb = originalDataSize / (1024.0 * 1024.0);
+    Logger::Info("packed %u files: %.1f Mb -> %.1f Mb for %.2f sec (%.1f Mb/s) with %u workers",
+                 static_cast<uint32>(numOfFiles), originalMb, dataOffset / (1024.0 * 1024.0), seconds, originalMb / seconds, jobManager->GetWorkersCount());
+
+    if (dictionaryCompressor)
+    {
+        const Vector<uint8>& dictionary = dictionaryCompressor->GetDictionary();
+        if (!WriteRawData(outputFile, dictionary))
+        {
+            Logger::Error("Can't write dictionary block");
+            return false;
+        }
+        packFile.footer.dictionarySize = static_cast<uint32>(dictionary.size());
+        packFile.footer.dictionaryCrc32 = CRC32::ForBuffer(dictionary.data(), dictionary.size());
+        Logger::Info("%u files are compressed with shared dictionary", dictionaryFilesCount);
     }
-    useBuffers.clear();
-    useBuffers.shrink_to_fit(); // free memory
 
     Vector<uint8> metaBytes;
     if (meta)
@@ -718,7 +968,7 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
     return true;
 }
 
-bool Pack(const Vector<CollectedFile>& collectedFiles, DAVA::Compressor::Type compressionType, const FilePath& archivePath, const FilePath& metaDb, bool dummyFileData)
+bool Pack(const Vector<CollectedFile>& collectedFiles, DAVA::Compressor::Type compressionType, const FilePath& archivePath, const FilePath& metaDb, bool dummyFileData, uint32 dictionaryMaxFileSize, uint32 maxFilesInFlight)
 {
     ScopedPtr<File> outputFile(File::Create(archivePath, File::CREATE | File::WRITE));
     if (!outputFile)
@@ -727,7 +977,7 @@ bool Pack(const Vector<CollectedFile>& collectedFiles, DAVA::Compressor::Type co
         return false;
     }
 
-    if (!Pack(collectedFiles, compressionType, metaDb, outputFile, dummyFileData))
+    if (!Pack(collectedFiles, compressionType, metaDb, outputFile, dummyFileData, dictionaryMaxFileSize, maxFilesInFlight))
     {
         outputFile.reset();
         if (!FileSystem::Instance()->DeleteFile(archivePath))
@@ -750,13 +1000,22 @@ bool CreateArchive(const Params& params)
 
     Vector<CollectedFile> collectedFiles;
 
-    if (!CollectFilesFromDB(params.baseDirPath, params.metaDbPath, collectedFiles))
+    if (params.metaDbPath.IsEmpty())
+    {
+        // without metaDb all files of base dir are packed in order of their paths
+        CollectAllFilesInDirectory(params.baseDirPath, "", false, collectedFiles);
+        std::stable_sort(collectedFiles.begin(), collectedFiles.end(), [](const CollectedFile& left, const CollectedFile& right) -> bool
+                         {
+                             return left.archivePath < right.archivePath;
+                         });
+    }
+    else if (!CollectFilesFromDB(params.baseDirPath, params.metaDbPath, collectedFiles))
     {
         Logger::Error("Collecting files error");
         return false;
     }
 
-    if (Pack(collectedFiles, params.compressionType, params.archivePath, params.metaDbPath, params.dummyFileData))
+    if (Pack(collectedFiles, params.compressionType, params.archivePath, params.metaDbPath, params.dummyFileData, params.dictionaryMaxFileSize, params.maxFilesInFlight))
     {
         return true;
     }
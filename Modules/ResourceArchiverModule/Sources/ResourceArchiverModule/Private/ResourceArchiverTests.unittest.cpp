@@ -0,0 +1,161 @@
+#include "UnitTests/UnitTests.h"
+#include "ResourceArchiverModule/ResourceArchiver.h"
+
+#include <Engine/Engine.h>
+#include <Engine/EngineContext.h>
+#include <FileSystem/FileSystem.h>
+#include <FileSystem/Private/PackArchive.h>
+#include <FileSystem/Private/PackFormatSpec.h>
+#include <Logger/Logger.h>
+#include <Utils/CRC32.h>
+#include <Utils/StringFormat.h>
+
+using namespace DAVA;
+
+namespace ResourceArchiverTestDetails
+{
+const FilePath TEST_FOLDER("~doc:/UnitTests/ResourceArchiverTest/");
+const FilePath SOURCES_FOLDER = TEST_FOLDER + "sources/";
+
+bool WriteTextFile(const FilePath& path, const String& text)
+{
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    return file && file->Write(text.data(), static_cast<uint32>(text.size())) == text.size();
+}
+
+// Writes a lot of small similar descriptors, few big files and empty file into SOURCES_FOLDER
+bool WriteSourceFiles(Vector<String>& relativePaths)
+{
+    FileSystem* fs = GetEngineContext()->fileSystem;
+    fs->DeleteDirectory(SOURCES_FOLDER, true);
+    fs->CreateDirectory(SOURCES_FOLDER + "Gfx/", true);
+    fs->CreateDirectory(SOURCES_FOLDER + "Maps/", true);
+
+    Map<String, String> files;
+    for (uint32 i = 0; i < 64; ++i)
+    {
+        files[Format("Gfx/texture_%02u.tex", i)] = Format("format: tex\nsize: %u %u\nmipmaps: %s\ncompression: PVR\npath: Gfx/texture_%02u.png\n", 64 << (i % 4), 32 << (i % 3), (i % 2) ? "true" : "false", i);
+    }
+    for (uint32 i = 0; i < 2; ++i)
+    {
+        String& text = files[Format("Maps/map_%u.txt", i)];
+        for (uint32 line = 0; line < 1000; ++line)
+        {
+            text += Format("map %u object %u at position %u %u\n", i, line, line * 7 % 1000, line * 13 % 1000);
+        }
+    }
+    files["empty.txt"] = String();
+
+    relativePaths.clear();
+    for (const auto& nameAndText : files)
+    {
+        if (!WriteTextFile(SOURCES_FOLDER + nameAndText.first, nameAndText.second))
+        {
+            return false;
+        }
+        relativePaths.push_back(nameAndText.first);
+    }
+    return true;
+}
+} // namespace ResourceArchiverTestDetails
+
+DAVA_TESTCLASS (ResourceArchiverTest)
+{
+    ResourceArchiverTest()
+    {
+        GetEngineContext()->fileSystem->CreateDirectory(ResourceArchiverTestDetails::TEST_FOLDER, true);
+    }
+
+    ~ResourceArchiverTest()
+    {
+        GetEngineContext()->fileSystem->DeleteDirectory(ResourceArchiverTestDetails::TEST_FOLDER, true);
+    }
+
+    DAVA_TEST (DictionaryPackTest)
+    {
+        using namespace ResourceArchiverTestDetails;
+
+        Vector<String> relativePaths;
+        TEST_VERIFY(WriteSourceFiles(relativePaths));
+
+        ResourceArchiver::Params params;
+        params.compressionType = Compressor::Type::Lz4HC;
+        params.archivePath = TEST_FOLDER + "dictionary.dvpk";
+        params.baseDirPath = SOURCES_FOLDER;
+        params.dictionaryMaxFileSize = 4096;
+        TEST_VERIFY(ResourceArchiver::CreateArchive(params));
+
+        // dictionary block is placed before meta block and its size is stored in footer
+        ScopedPtr<File> packFile(File::Create(params.archivePath, File::OPEN | File::READ));
+        TEST_VERIFY(packFile);
+        const uint64 packSize = packFile->GetSize();
+        PackFormat::PackFile::FooterBlock footer;
+        TEST_VERIFY(packFile->Seek(packSize - sizeof(footer), File::SEEK_FROM_START));
+        TEST_VERIFY(packFile->Read(&footer, sizeof(footer)) == sizeof(footer));
+        TEST_VERIFY(footer.metaDataSize == 0);
+        TEST_VERIFY(footer.dictionarySize > 0);
+
+        Vector<uint8> dictionary(footer.dictionarySize);
+        const uint64 dictionaryStart = packSize - sizeof(footer) - footer.info.filesTableSize - footer.metaDataSize - footer.dictionarySize;
+        TEST_VERIFY(packFile->Seek(dictionaryStart, File::SEEK_FROM_START));
+        TEST_VERIFY(packFile->Read(dictionary.data(), footer.dictionarySize) == footer.dictionarySize);
+        TEST_VERIFY(CRC32::ForBuffer(dictionary) == footer.dictionaryCrc32);
+        packFile.reset();
+
+        try
+        {
+            RefPtr<File> file(File::Create(params.archivePath, File::OPEN | File::READ));
+            PackArchive archive(file, params.archivePath);
+            TEST_VERIFY(archive.GetFilesInfo().size() == relativePaths.size());
+
+            uint32 dictionaryFilesCount = 0;
+            for (const String& relativePath : relativePaths)
+            {
+                Vector<uint8> fromArchive;
+                Vector<uint8> fromSources;
+                TEST_VERIFY(archive.LoadFile(relativePath, fromArchive));
+                TEST_VERIFY(GetEngineContext()->fileSystem->ReadFileContents(SOURCES_FOLDER + relativePath, fromSources));
+                TEST_VERIFY(fromArchive == fromSources);
+
+                const ResourceArchive::FileInfo* info = archive.GetFileInfo(relativePath);
+                if (info->compressionType == Compressor::Type::Lz4Dictionary)
+                {
+                    TEST_VERIFY(info->originalSize <= params.dictionaryMaxFileSize);
+                    ++dictionaryFilesCount;
+                }
+            }
+            TEST_VERIFY(dictionaryFilesCount > 0);
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Error("%s", ex.what());
+            TEST_VERIFY(false && "can't open pack with dictionary");
+        }
+    }
+
+    DAVA_TEST (PipelinedPackTest)
+    {
+        using namespace ResourceArchiverTestDetails;
+
+        Vector<String> relativePaths;
+        TEST_VERIFY(WriteSourceFiles(relativePaths));
+
+        // files packed one at a time and in window of worker jobs give the same archive
+        Vector<uint8> archives[2];
+        const uint32 windows[2] = { 1, 0 };
+        for (uint32 i = 0; i < 2; ++i)
+        {
+            ResourceArchiver::Params params;
+            params.compressionType = Compressor::Type::Lz4HC;
+            params.archivePath = TEST_FOLDER + Format("window_%u.dvpk", windows[i]);
+            params.baseDirPath = SOURCES_FOLDER;
+            params.dictionaryMaxFileSize = 4096;
+            params.maxFilesInFlight = windows[i];
+            TEST_VERIFY(ResourceArchiver::CreateArchive(params));
+            TEST_VERIFY(GetEngineContext()->fileSystem->ReadFileContents(params.archivePath, archives[i]));
+        }
+
+        TEST_VERIFY(!archives[0].empty());
+        TEST_VERIFY(archives[0] == archives[1]);
+    }
+};
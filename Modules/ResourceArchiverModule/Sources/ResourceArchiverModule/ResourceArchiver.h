@@ -12,8 +12,10 @@ struct Params
     Compressor::Type compressionType = Compressor::Type::Lz4HC;
     FilePath archivePath;
     FilePath baseDirPath;
-    FilePath metaDbPath;
+    FilePath metaDbPath; // files and packs of DLC superpack, empty - all files of baseDirPath are packed without meta
     bool dummyFileData = false;
+    uint32 dictionaryMaxFileSize = 0; // train shared dictionary for files not bigger than this size, 0 - no dictionary, only for pack without metaDb
+    uint32 maxFilesInFlight = 0; // files read and compressed by worker jobs ahead of writer, 0 - chosen by workers count
 };
 
 bool CreateArchive(const Params& params);
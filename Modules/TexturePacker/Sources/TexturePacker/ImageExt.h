@@ -18,7 +18,7 @@ public:
     bool Read(const FilePath& filename);
     void Write(const FilePath& filename, ImageQuality quality = DEFAULT_IMAGE_QUALITY);
 
-    void DrawImage(const SpriteBoundsRect& drawRect, const Rect2i& imageOffsetRect, ImageExt* image);
+    void DrawImage(const SpriteBoundsRect& drawRect, const Rect2i& imageOffsetRect, ImageExt* image, bool withAlpha);
     void DrawImage(int32 sx, int32 sy, ImageExt* image, const Rect2i& srcRect);
 
     void DrawRect(const Rect2i& rect, uint32 color);
@@ -1,6 +1,5 @@
 #include "TexturePacker/ImageExt.h"
 
-#include <CommandLine/CommandLineParser.h>
 #include <Render/Image/ImageSystem.h>
 #include <Render/Image/ImageConvert.h>
 #include <Render/Texture.h>
@@ -112,14 +111,12 @@ void ImageExt::DrawImage(int32 sx, int32 sy, ImageExt* image, const Rect2i& srcR
     }
 }
 
-void ImageExt::DrawImage(const SpriteBoundsRect& packedCell, const Rect2i& alphaOffsetRect, ImageExt* image)
+void ImageExt::DrawImage(const SpriteBoundsRect& packedCell, const Rect2i& alphaOffsetRect, ImageExt* image, bool withAlpha)
 {
     uint32* destData32 = reinterpret_cast<uint32*>(GetData());
     uint32* srcData32 = reinterpret_cast<uint32*>(image->GetData());
     const Rect2i& img = packedCell.spriteRect;
 
-    bool withAlpha = CommandLineParser::Instance()->IsFlagSet("--disableCropAlpha");
-
     int32 sx = img.x;
     int32 sy = img.y;
 
@@ -3,7 +3,9 @@
 #include "TexturePacker/TexturePacker.h"
 
 #include <CommandLine/CommandLineParser.h>
+#include <Concurrency/LockGuard.h>
 #include <Engine/Engine.h>
+#include <Engine/EngineContext.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/FileList.h>
 #include <Utils/StringUtils.h>
@@ -15,6 +17,7 @@
 #include <Utils/UTF8Utils.h>
 #include <Render/GPUFamilyDescriptor.h>
 #include <Platform/Process.h>
+#include <Job/JobManager.h>
 #include <Render/TextureDescriptor.h>
 #include <Logger/Logger.h>
 
@@ -79,6 +82,18 @@ String GetBasenameWithoutTag(const String& basename, const String& tag)
     return result;
 }
 
+struct PickedFile
+{
+    String name;
+    String basename;
+    String ext;
+    FilePath path;
+    uint64 size = 0;
+    bool tagged = false;
+    String outName;
+    String outBasename;
+};
+
 bool IsBasenameContainsTag(const String& basename, const String& tag)
 {
     const String::size_type tagPos = basename.find(tag);
@@ -94,6 +109,19 @@ bool IsBasenameContainsTag(const String& basename, const String& tag)
 }
 } // namespace ResourcePacker2DDetails
 
+struct ResourcePacker2D::DirectoryTask
+{
+    FilePath inputDir;
+    FilePath outputDir;
+    FilePath processDir;
+    Vector<String> flags;
+    String mergedFlags;
+    List<ResourcePacker2DDetails::PickedFile> pickedFiles;
+    AssetCache::CacheItemKey cacheKey;
+    bool retrievedFromCache = false;
+    bool packed = false;
+};
+
 String ResourcePacker2D::GetProcessFolderName()
 {
     return "$process/";
@@ -104,6 +132,11 @@ void ResourcePacker2D::SetConvertQuality(const TextureConverter::eConvertQuality
     quality = arg;
 }
 
+void ResourcePacker2D::SetMaxConcurrentTasks(uint32 count)
+{
+    maxConcurrentTasks = count;
+}
+
 void ResourcePacker2D::SetCanceled(bool arg)
 {
     cancelled = arg;
@@ -227,7 +260,32 @@ void ResourcePacker2D::PackResources(const Vector<eGPUFamily>& forGPUs)
         }
     }
 
-    PackRecursively(inputGfxDirectory, outputGfxDirectory, packAlgorithms);
+    // Folders are scanned serially (flags are inherited from parent folders), then changed folders are requested from cache
+    // and the rest of them are packed in parallel
+    uint64 scanTime = SystemTimer::GetMs();
+    Vector<DirectoryTask> tasks;
+    CollectDirectories(inputGfxDirectory, outputGfxDirectory, packAlgorithms, Vector<String>(), tasks);
+    scanTime = SystemTimer::GetMs() - scanTime;
+
+    uint64 cacheRequestTime = SystemTimer::GetMs();
+    RequestDirectoriesFromCache(tasks);
+    cacheRequestTime = SystemTimer::GetMs() - cacheRequestTime;
+
+    uint64 packTime = SystemTimer::GetMs();
+    uint32 threadsCount = PackDirectories(tasks, packAlgorithms);
+    packTime = SystemTimer::GetMs() - packTime;
+
+    uint64 cacheAddTime = SystemTimer::GetMs();
+    AddDirectoriesToCache(tasks);
+    cacheAddTime = SystemTimer::GetMs() - cacheAddTime;
+
+    uint32 retrievedCount = static_cast<uint32>(std::count_if(tasks.begin(), tasks.end(), [](const DirectoryTask& task) { return task.retrievedFromCache; }));
+    uint32 packedCount = static_cast<uint32>(std::count_if(tasks.begin(), tasks.end(), [](const DirectoryTask& task) { return task.packed; }));
+    Logger::Info("[Scan - %.2lf secs, cache request - %.2lf secs (%u of %u folders retrieved), pack - %.2lf secs (%u folders in %u threads), cache add - %.2lf secs]",
+                 static_cast<float64>(scanTime) / 1000.0,
+                 static_cast<float64>(cacheRequestTime) / 1000.0, retrievedCount, static_cast<uint32>(tasks.size()),
+                 static_cast<float64>(packTime) / 1000.0, packedCount, threadsCount,
+                 static_cast<float64>(cacheAddTime) / 1000.0);
 
     // Put latest md5 after convertation
     RecalculateDirMD5(outputGfxDirectory, processDirectoryPath + gfxDirName + ".md5", true);
@@ -343,10 +401,10 @@ Vector<String> ResourcePacker2D::FetchFlags(const FilePath& flagsPathname)
     return tokens;
 }
 
-uint32 ResourcePacker2D::GetMaxTextureSize() const
+uint32 ResourcePacker2D::GetMaxTextureSize(const CommandLineFlags& flags) const
 {
     uint32 maxTextureSize = TexturePacker::DEFAULT_TEXTURE_SIZE;
-    String tsizeValue = CommandLineParser::Instance()->GetParamForFlag("--tsize");
+    String tsizeValue = flags.GetParamForFlag("--tsize");
     if (!tsizeValue.empty())
     {
         uint32 fetchedValue;
@@ -364,7 +422,7 @@ uint32 ResourcePacker2D::GetMaxTextureSize() const
     return maxTextureSize;
 }
 
-void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath& outputDir, const Vector<PackingAlgorithm>& packAlgorithms, const Vector<String>& passedFlags)
+void ResourcePacker2D::CollectDirectories(const FilePath& inputDir, const FilePath& outputDir, const Vector<PackingAlgorithm>& packAlgorithms, const Vector<String>& passedFlags, Vector<DirectoryTask>& tasks)
 {
     using namespace ResourcePacker2DDetails;
 
@@ -375,8 +433,6 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
         return;
     }
 
-    uint64 packTime = SystemTimer::GetMs();
-
     String inputRelativePath = inputDir.GetRelativePathname(rootDirectory);
     FilePath processDir = rootDirectory + GetProcessFolderName() + inputRelativePath;
     FileSystem::Instance()->CreateDirectory(processDir, true);
@@ -400,7 +456,6 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
         currentFlags = passedFlags;
     }
 
-    CommandLineParser::Instance()->SetFlags(currentFlags);
     String mergedFlags;
     Merge(currentFlags, ' ', mergedFlags);
 
@@ -428,16 +483,6 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
 
     uint64 allFilesSize = 0;
 
-    struct PickedFile
-    {
-        String name;
-        String basename;
-        String ext;
-        uint32 index = 0;
-        bool tagged = false;
-        String outName;
-        String outBasename;
-    };
     List<PickedFile> pickedFiles;
     List<PickedFile*> taggedFiles;
 
@@ -456,7 +501,8 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
 
         PickedFile file;
         file.name = std::move(filename);
-        file.index = fi;
+        file.path = fileList->GetPathname(fi);
+        file.size = fileList->GetFileSize(fi);
         SplitFileName(file.name, file.basename, file.ext);
         file.tagged = IsBasenameContainsTag(file.basename, tag);
 
@@ -505,7 +551,7 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
     for (const PickedFile& file : pickedFiles)
     {
         packingParams += file.name;
-        allFilesSize += fileList->GetFileSize(file.index);
+        allFilesSize += file.size;
     }
 
     packingParams += Format("FilesSize = %llu", allFilesSize);
@@ -520,146 +566,26 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
     {
         if (pickedFiles.empty() == false)
         {
-            AssetCache::CacheItemKey cacheKey;
+            DirectoryTask task;
+            task.inputDir = inputDir;
+            task.outputDir = outputDir;
+            task.processDir = processDir;
+            task.flags = currentFlags;
+            task.mergedFlags = mergedFlags;
+            task.pickedFiles = std::move(pickedFiles);
+
             if (IsUsingCache())
             {
                 MD5::MD5Digest digest;
 
                 ReadMD5FromFile(processDir + "dir.md5", digest);
-                cacheKey.SetPrimaryKey(digest);
+                task.cacheKey.SetPrimaryKey(digest);
 
                 ReadMD5FromFile(processDir + "params.md5", digest);
-                cacheKey.SetSecondaryKey(digest);
+                task.cacheKey.SetSecondaryKey(digest);
             }
 
-            bool needRepack = (false == GetFilesFromCache(cacheKey, inputDir, outputDir));
-            if (needRepack)
-            {
-                // read textures margins settings
-                bool useTwoSideMargin = CommandLineParser::Instance()->IsFlagSet("--add2sidepixel");
-                uint32 marginInPixels = useTwoSideMargin ? 0 : 1;
-                if (CommandLineParser::Instance()->IsFlagSet("--add0pixel"))
-                    marginInPixels = 0;
-                else if (CommandLineParser::Instance()->IsFlagSet("--add1pixel"))
-                    marginInPixels = 1;
-                else if (CommandLineParser::Instance()->IsFlagSet("--add2pixel"))
-                    marginInPixels = 2;
-                else if (CommandLineParser::Instance()->IsFlagSet("--add4pixel"))
-                    marginInPixels = 4;
-
-                uint32 maxTextureSize = GetMaxTextureSize();
-
-                bool withAlpha = CommandLineParser::Instance()->IsFlagSet("--disableCropAlpha");
-                bool useLayerNames = CommandLineParser::Instance()->IsFlagSet("--useLayerNames");
-                bool verbose = CommandLineParser::Instance()->GetVerbose();
-
-                if (clearOutputDirectory)
-                {
-                    FileSystem::Instance()->DeleteDirectoryFiles(outputDir, false);
-                }
-
-                DefinitionFile::Collection definitionFileList;
-                Vector<PickedFile*> justCopyList;
-                definitionFileList.reserve(pickedFiles.size());
-                for (PickedFile& file : pickedFiles)
-                {
-                    if (cancelled)
-                    {
-                        break;
-                    }
-
-                    DAVA::RefPtr<DefinitionFile> defFile(new DefinitionFile());
-
-                    bool shouldAcceptFile = false;
-
-                    FilePath path = fileList->GetPathname(file.index);
-                    if (CompareCaseInsensitive(file.ext, ".psd") == 0)
-                    {
-                        shouldAcceptFile = defFile->LoadPSD(path, processDir, maxTextureSize,
-                                                            withAlpha, useLayerNames, verbose, file.outBasename);
-                    }
-                    else if (CompareCaseInsensitive(file.ext, ".pngdef") == 0)
-                    {
-                        shouldAcceptFile = defFile->LoadPNGDef(path, processDir, file.outBasename);
-                    }
-                    else if (TextureDescriptor::IsSupportedTextureExtension(file.ext) == true)
-                    {
-                        shouldAcceptFile = defFile->LoadImage(path, processDir, file.outBasename);
-                    }
-                    else
-                    {
-                        justCopyList.push_back(&file);
-                    }
-
-                    if (shouldAcceptFile)
-                    {
-                        definitionFileList.push_back(defFile);
-                    }
-                }
-
-                if (!definitionFileList.empty())
-                {
-                    TexturePacker packer;
-                    packer.SetConvertQuality(quality);
-
-                    if (isLightmapsPacking)
-                    {
-                        packer.SetUseOnlySquareTextures();
-                        packer.SetMaxTextureSize(2048);
-                    }
-                    else
-                    {
-                        if (CommandLineParser::Instance()->IsFlagSet("--square"))
-                        {
-                            packer.SetUseOnlySquareTextures();
-                        }
-                        packer.SetMaxTextureSize(maxTextureSize);
-                    }
-
-                    packer.SetTwoSideMargin(useTwoSideMargin);
-                    packer.SetTexturesMargin(marginInPixels);
-                    packer.SetAlgorithms(packAlgorithms);
-                    packer.SetTexturePostfix(texturePostfix);
-
-                    if (CommandLineParser::Instance()->IsFlagSet("--split"))
-                    {
-                        packer.PackToTexturesSeparate(outputDir, definitionFileList, requestedGPUs);
-                    }
-                    else
-                    {
-                        packer.PackToTextures(outputDir, definitionFileList, requestedGPUs);
-                    }
-
-                    Set<String> currentErrors = packer.GetErrors();
-                    if (!currentErrors.empty())
-                    {
-                        errors.insert(currentErrors.begin(), currentErrors.end());
-                    }
-                }
-
-                for (const PickedFile* file : justCopyList)
-                {
-                    FilePath srcPath = inputDir + file->name;
-                    FilePath destPath = outputDir + file->outName;
-                    if (!FileSystem::Instance()->CopyFile(srcPath, destPath))
-                    {
-                        Logger::Error("Can't copy %s to %s", srcPath.GetStringValue().c_str(), destPath.GetStringValue().c_str());
-                    }
-                }
-
-                packTime = SystemTimer::GetMs() - packTime;
-
-                if (Engine::Instance()->IsConsoleMode())
-                {
-                    Logger::Info("[%u files packed with flags: %s]", static_cast<uint32>(definitionFileList.size()), mergedFlags.c_str());
-                }
-
-                const char* result = definitionFileList.empty() ? "[unchanged]" : "[REPACKED]";
-                Logger::Info("[%s - %.2lf secs] - %s", inputDir.GetAbsolutePathname().c_str(),
-                             static_cast<float64>(packTime) / 1000.0, result);
-
-                AddFilesToCache(cacheKey, inputDir, outputDir);
-            }
+            tasks.push_back(std::move(task));
         }
         else if (outputDirModified || inputDirModified)
         {
@@ -672,7 +598,7 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
         Logger::Info("[%s] - unchanged", inputDir.GetAbsolutePathname().c_str());
     }
 
-    const auto& flagsToPass = CommandLineParser::Instance()->IsFlagSet("--recursive") ? currentFlags : passedFlags;
+    const auto& flagsToPass = CommandLineFlags(currentFlags).IsFlagSet("--recursive") ? currentFlags : passedFlags;
 
     for (uint32 fi = 0; fi < fileList->GetCount(); ++fi)
     {
@@ -689,13 +615,191 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
                     FilePath output = outputDir + filename;
                     output.MakeDirectoryPathname();
 
-                    PackRecursively(input, output, packAlgorithms, flagsToPass);
+                    CollectDirectories(input, output, packAlgorithms, flagsToPass, tasks);
                 }
             }
         }
     }
 }
 
+uint32 ResourcePacker2D::PackDirectories(Vector<DirectoryTask>& tasks, const Vector<PackingAlgorithm>& packAlgorithms)
+{
+    Vector<DirectoryTask*> tasksToPack;
+    for (DirectoryTask& task : tasks)
+    {
+        if (task.retrievedFromCache == false)
+        {
+            tasksToPack.push_back(&task);
+        }
+    }
+
+    if (tasksToPack.empty())
+    {
+        return 0;
+    }
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 maxTasks = (maxConcurrentTasks > 0) ? maxConcurrentTasks : (jobManager != nullptr ? jobManager->GetWorkersCount() + 1 : 1);
+    uint32 jobsCount = (jobManager != nullptr) ? Min(maxTasks, static_cast<uint32>(tasksToPack.size())) - 1 : 0;
+
+    // Folders are independent, so each job (and calling thread) takes next folder until all of them are packed
+    std::atomic<size_t> nextTask(0);
+    auto packTasks = [&]() {
+        for (size_t i = nextTask++; i < tasksToPack.size() && !cancelled; i = nextTask++)
+        {
+            PackDirectory(*tasksToPack[i], packAlgorithms);
+        }
+    };
+
+    for (uint32 i = 0; i < jobsCount; ++i)
+    {
+        jobManager->CreateWorkerJob(packTasks);
+    }
+
+    packTasks();
+
+    if (jobsCount > 0)
+    {
+        jobManager->WaitWorkerJobs();
+    }
+
+    return jobsCount + 1;
+}
+
+void ResourcePacker2D::PackDirectory(DirectoryTask& task, const Vector<PackingAlgorithm>& packAlgorithms)
+{
+    using namespace ResourcePacker2DDetails;
+
+    uint64 packTime = SystemTimer::GetMs();
+
+    const CommandLineFlags flags(task.flags);
+
+    // read textures margins settings
+    bool useTwoSideMargin = flags.IsFlagSet("--add2sidepixel");
+    uint32 marginInPixels = useTwoSideMargin ? 0 : 1;
+    if (flags.IsFlagSet("--add0pixel"))
+        marginInPixels = 0;
+    else if (flags.IsFlagSet("--add1pixel"))
+        marginInPixels = 1;
+    else if (flags.IsFlagSet("--add2pixel"))
+        marginInPixels = 2;
+    else if (flags.IsFlagSet("--add4pixel"))
+        marginInPixels = 4;
+
+    uint32 maxTextureSize = GetMaxTextureSize(flags);
+
+    bool withAlpha = flags.IsFlagSet("--disableCropAlpha");
+    bool useLayerNames = flags.IsFlagSet("--useLayerNames");
+    bool verbose = CommandLineParser::Instance()->GetVerbose();
+
+    if (clearOutputDirectory)
+    {
+        FileSystem::Instance()->DeleteDirectoryFiles(task.outputDir, false);
+    }
+
+    DefinitionFile::Collection definitionFileList;
+    Vector<PickedFile*> justCopyList;
+    definitionFileList.reserve(task.pickedFiles.size());
+    for (PickedFile& file : task.pickedFiles)
+    {
+        if (cancelled)
+        {
+            break;
+        }
+
+        DAVA::RefPtr<DefinitionFile> defFile(new DefinitionFile());
+
+        bool shouldAcceptFile = false;
+
+        if (CompareCaseInsensitive(file.ext, ".psd") == 0)
+        {
+            shouldAcceptFile = defFile->LoadPSD(file.path, task.processDir, maxTextureSize,
+                                                withAlpha, useLayerNames, verbose, file.outBasename);
+        }
+        else if (CompareCaseInsensitive(file.ext, ".pngdef") == 0)
+        {
+            shouldAcceptFile = defFile->LoadPNGDef(file.path, task.processDir, file.outBasename);
+        }
+        else if (TextureDescriptor::IsSupportedTextureExtension(file.ext) == true)
+        {
+            shouldAcceptFile = defFile->LoadImage(file.path, task.processDir, file.outBasename);
+        }
+        else
+        {
+            justCopyList.push_back(&file);
+        }
+
+        if (shouldAcceptFile)
+        {
+            definitionFileList.push_back(defFile);
+        }
+    }
+
+    if (!definitionFileList.empty())
+    {
+        TexturePacker packer(flags);
+        packer.SetConvertQuality(quality);
+
+        if (isLightmapsPacking)
+        {
+            packer.SetUseOnlySquareTextures();
+            packer.SetMaxTextureSize(2048);
+        }
+        else
+        {
+            if (flags.IsFlagSet("--square"))
+            {
+                packer.SetUseOnlySquareTextures();
+            }
+            packer.SetMaxTextureSize(maxTextureSize);
+        }
+
+        packer.SetTwoSideMargin(useTwoSideMargin);
+        packer.SetTexturesMargin(marginInPixels);
+        packer.SetAlgorithms(packAlgorithms);
+        packer.SetTexturePostfix(texturePostfix);
+
+        if (flags.IsFlagSet("--split"))
+        {
+            packer.PackToTexturesSeparate(task.outputDir, definitionFileList, requestedGPUs);
+        }
+        else
+        {
+            packer.PackToTextures(task.outputDir, definitionFileList, requestedGPUs);
+        }
+
+        const Set<String>& currentErrors = packer.GetErrors();
+        if (!currentErrors.empty())
+        {
+            LockGuard<Mutex> guard(errorsMutex);
+            errors.insert(currentErrors.begin(), currentErrors.end());
+        }
+    }
+
+    for (const PickedFile* file : justCopyList)
+    {
+        FilePath srcPath = task.inputDir + file->name;
+        FilePath destPath = task.outputDir + file->outName;
+        if (!FileSystem::Instance()->CopyFile(srcPath, destPath))
+        {
+            Logger::Error("Can't copy %s to %s", srcPath.GetStringValue().c_str(), destPath.GetStringValue().c_str());
+        }
+    }
+
+    packTime = SystemTimer::GetMs() - packTime;
+
+    if (Engine::Instance()->IsConsoleMode())
+    {
+        Logger::Info("[%u files packed with flags: %s]", static_cast<uint32>(definitionFileList.size()), task.mergedFlags.c_str());
+    }
+
+    const char* result = definitionFileList.empty() ? "[unchanged]" : "[REPACKED]";
+    Logger::Info("[%s - %.2lf secs] - %s", task.inputDir.GetAbsolutePathname().c_str(),
+                 static_cast<float64>(packTime) / 1000.0, result);
+
+    task.packed = true;
+}
+
 void ResourcePacker2D::SetCacheClient(AssetCacheClient* cacheClient_, const String& comment)
 {
     cacheClient = cacheClient_;
@@ -728,96 +832,157 @@ void ResourcePacker2D::SetIgnoresFile(const String& ignoresPath)
     ignoresListPath = ignoresPath;
 }
 
-bool ResourcePacker2D::GetFilesFromCache(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath)
+void ResourcePacker2D::RequestDirectoriesFromCache(Vector<DirectoryTask>& tasks)
 {
 #ifdef __DAVAENGINE_WIN_UAP__
     //no cache client in win uap
-    return false;
+    return;
 #else
 
     if (!IsUsingCache())
     {
-        return false;
+        return;
     }
 
-    String requestedDataRelativePath = "..." + inputPath.GetRelativePathname(dataSourceDirectory);
-
-    AssetCache::CachedItemValue retrievedData;
-    AssetCache::Error requestError = cacheClient->RequestFromCacheSynchronously(key, &retrievedData);
-    if (requestError == AssetCache::Error::NO_ERRORS)
-    {
-        Logger::Info("%s - retrieved from cache", requestedDataRelativePath.c_str());
-        retrievedData.ExportToFolder(outputPath);
-        return true;
-    }
-    else
+    // Requests of a batch are pipelined over cache connection, batches limit memory used by retrieved files
+    for (size_t batchStart = 0; batchStart < tasks.size() && !cancelled; batchStart += CACHE_BATCH_SIZE)
     {
-        String errorInfo = AssetCache::ErrorToString(requestError);
-        if (requestError == AssetCache::Error::OPERATION_TIMEOUT)
+        const size_t batchEnd = std::min(batchStart + CACHE_BATCH_SIZE, tasks.size());
+
+        Vector<AssetCache::CacheItemKey> keys;
+        keys.reserve(batchEnd - batchStart);
+        for (size_t i = batchStart; i < batchEnd; ++i)
         {
-            errorInfo.append(Format(" (%u ms)", cacheClient->GetTimeoutMs()));
+            keys.push_back(tasks[i].cacheKey);
         }
 
-        Logger::Info("%s - can't retrieve from cache: %s", requestedDataRelativePath.c_str(), errorInfo.c_str());
-    }
+        Vector<AssetCache::CachedItemValue> retrievedData;
+        Vector<AssetCache::Error> requestErrors;
+        cacheClient->RequestFromCacheSynchronously(keys, retrievedData, requestErrors);
 
-    return false;
+        for (size_t i = batchStart; i < batchEnd; ++i)
+        {
+            DirectoryTask& task = tasks[i];
+            String requestedDataRelativePath = "..." + task.inputDir.GetRelativePathname(dataSourceDirectory);
+
+            AssetCache::Error requestError = requestErrors[i - batchStart];
+            if (requestError == AssetCache::Error::NO_ERRORS)
+            {
+                Logger::Info("%s - retrieved from cache", requestedDataRelativePath.c_str());
+                retrievedData[i - batchStart].ExportToFolder(task.outputDir);
+                task.retrievedFromCache = true;
+            }
+            else
+            {
+                String errorInfo = AssetCache::ErrorToString(requestError);
+                if (requestError == AssetCache::Error::OPERATION_TIMEOUT)
+                {
+                    errorInfo.append(Format(" (%u ms)", cacheClient->GetTimeoutMs()));
+                }
+
+                Logger::Info("%s - can't retrieve from cache: %s", requestedDataRelativePath.c_str(), errorInfo.c_str());
+            }
+        }
+    }
 #endif
 }
 
-bool ResourcePacker2D::AddFilesToCache(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath)
+void ResourcePacker2D::AddDirectoriesToCache(const Vector<DirectoryTask>& tasks)
 {
 #ifdef __DAVAENGINE_WIN_UAP__
     //no cache client in win uap
-    return false;
+    return;
 #else
     if (!IsUsingCache())
     {
-        return false;
+        return;
     }
 
-    AssetCache::CachedItemValue value;
-
-    ScopedPtr<FileList> outFilesList(new FileList(outputPath));
-    for (uint32 fi = 0; fi < outFilesList->GetCount(); ++fi)
+    Vector<const DirectoryTask*> packedTasks;
+    for (const DirectoryTask& task : tasks)
     {
-        if (!outFilesList->IsDirectory(fi))
+        if (task.packed)
         {
-            value.Add(outFilesList->GetPathname(fi));
+            packedTasks.push_back(&task);
         }
     }
 
-    String addedDataRelativePath = "..." + inputPath.GetRelativePathname(dataSourceDirectory);
-
-    if (!value.IsEmpty())
+    for (size_t batchStart = 0; batchStart < packedTasks.size(); batchStart += CACHE_BATCH_SIZE)
     {
-        value.UpdateValidationData();
-        value.SetDescription(cacheItemDescription);
+        const size_t batchEnd = std::min(batchStart + CACHE_BATCH_SIZE, packedTasks.size());
+
+        Vector<const DirectoryTask*> addedTasks;
+        Vector<AssetCache::CacheItemKey> keys;
+        Vector<AssetCache::CachedItemValue> values;
+        values.reserve(batchEnd - batchStart);
+
+        for (size_t i = batchStart; i < batchEnd; ++i)
+        {
+            const DirectoryTask& task = *packedTasks[i];
+
+            AssetCache::CachedItemValue value;
+
+            ScopedPtr<FileList> outFilesList(new FileList(task.outputDir));
+            for (uint32 fi = 0; fi < outFilesList->GetCount(); ++fi)
+            {
+                if (!outFilesList->IsDirectory(fi))
+                {
+                    value.Add(outFilesList->GetPathname(fi));
+                }
+            }
+
+            if (!value.IsEmpty())
+            {
+                value.UpdateValidationData();
+                value.SetDescription(cacheItemDescription);
+
+                addedTasks.push_back(&task);
+                keys.push_back(task.cacheKey);
+                values.push_back(std::move(value));
+            }
+            else
+            {
+                String addedDataRelativePath = "..." + task.inputDir.GetRelativePathname(dataSourceDirectory);
+                Logger::Info("%s - empty folder", addedDataRelativePath.c_str());
+            }
+        }
 
-        AssetCache::Error addError = cacheClient->AddToCacheSynchronously(key, value);
-        if (addError == AssetCache::Error::NO_ERRORS)
+        if (keys.empty())
         {
-            Logger::Info("%s - added to cache", addedDataRelativePath.c_str());
-            return true;
+            continue;
         }
-        else
+
+        Vector<const AssetCache::CachedItemValue*> valuePointers;
+        valuePointers.reserve(values.size());
+        for (const AssetCache::CachedItemValue& value : values)
+        {
+            valuePointers.push_back(&value);
+        }
+
+        Vector<AssetCache::Error> addErrors;
+        cacheClient->AddToCacheSynchronously(keys, valuePointers, addErrors);
+
+        for (size_t i = 0; i < addedTasks.size(); ++i)
         {
-            String errorInfo = AssetCache::ErrorToString(addError);
-            if (addError == AssetCache::Error::OPERATION_TIMEOUT)
+            String addedDataRelativePath = "..." + addedTasks[i]->inputDir.GetRelativePathname(dataSourceDirectory);
+
+            AssetCache::Error addError = addErrors[i];
+            if (addError == AssetCache::Error::NO_ERRORS)
             {
-                errorInfo.append(Format(" (%u ms)", cacheClient->GetTimeoutMs()));
+                Logger::Info("%s - added to cache", addedDataRelativePath.c_str());
             }
+            else
+            {
+                String errorInfo = AssetCache::ErrorToString(addError);
+                if (addError == AssetCache::Error::OPERATION_TIMEOUT)
+                {
+                    errorInfo.append(Format(" (%u ms)", cacheClient->GetTimeoutMs()));
+                }
 
-            Logger::Info("%s - can't add to cache: %s", addedDataRelativePath.c_str(), errorInfo.c_str());
+                Logger::Info("%s - can't add to cache: %s", addedDataRelativePath.c_str(), errorInfo.c_str());
+            }
         }
     }
-    else
-    {
-        Logger::Info("%s - empty folder", addedDataRelativePath.c_str());
-    }
-
-    return false;
-
 #endif
 }
 
@@ -829,6 +994,8 @@ const Set<String>& ResourcePacker2D::GetErrors() const
 void ResourcePacker2D::AddError(const String& errorMsg)
 {
     Logger::Error(errorMsg.c_str());
+
+    LockGuard<Mutex> guard(errorsMutex);
     errors.insert(errorMsg);
 }
 
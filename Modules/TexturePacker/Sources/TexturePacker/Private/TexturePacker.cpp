@@ -53,11 +53,17 @@ static Set<PixelFormat> InitPixelFormatsWithCompression()
 const Set<PixelFormat> TexturePacker::PIXEL_FORMATS_WITH_COMPRESSION = InitPixelFormatsWithCompression();
 
 TexturePacker::TexturePacker()
+    : TexturePacker(CommandLineParser::Instance()->GetFlags())
+{
+}
+
+TexturePacker::TexturePacker(const CommandLineFlags& flags_)
+    : flags(flags_)
 {
     quality = TextureConverter::ECQ_VERY_HIGH;
-    if (CommandLineParser::Instance()->IsFlagSet("--quality"))
+    if (flags.IsFlagSet("--quality"))
     {
-        String qualityName = CommandLineParser::Instance()->GetParamForFlag("--quality");
+        String qualityName = flags.GetParamForFlag("--quality");
         int32 q = atoi(qualityName.c_str());
         if ((q >= TextureConverter::ECQ_FASTEST) && (q <= TextureConverter::ECQ_VERY_HIGH))
         {
@@ -307,13 +313,13 @@ uint8 GetImageParametersAt(const Vector<String>& gpuParams, uint8 gpuParamPositi
     return paramsRead;
 }
 
-bool GetGpuParameters(eGPUFamily forGPU, PixelFormat& pixelFormat, ImageFormat& imageFormat,
+bool GetGpuParameters(const CommandLineFlags& flags, eGPUFamily forGPU, PixelFormat& pixelFormat, ImageFormat& imageFormat,
                       ImageQuality& imageQuality)
 {
     const String gpuNameFlag = "--" + GPUFamilyDescriptor::GetGPUName(forGPU);
     // gpu flag has at least one additional parameter: pixel format or image format, or both of them
     // these params may follow in arbitrary order
-    Vector<String> gpuParams = CommandLineParser::Instance()->GetParamsForFlag(gpuNameFlag);
+    Vector<String> gpuParams = flags.GetParamsForFlag(gpuNameFlag);
 
     // suppose pixel parameter is at first position and read it
     uint8 gpuParamPosition = 0;
@@ -374,9 +380,9 @@ Vector<TexturePacker::ImageExportKeys> TexturePacker::GetExportKeys(const Vector
             { // read GPU parameters
                 const String gpuNameFlag = "--" + GPUFamilyDescriptor::GetGPUName(keys.forGPU);
                 bool gpuParametersRead = false;
-                if (CommandLineParser::Instance()->IsFlagSet(gpuNameFlag))
+                if (flags.IsFlagSet(gpuNameFlag))
                 {
-                    gpuParametersRead = GetGpuParameters(keys.forGPU, keys.pixelFormat, keys.imageFormat, keys.imageQuality);
+                    gpuParametersRead = GetGpuParameters(flags, keys.forGPU, keys.pixelFormat, keys.imageFormat, keys.imageQuality);
                 }
 
                 if (!gpuParametersRead)
@@ -458,7 +464,7 @@ void TexturePacker::ExportImage(const ImageExt& image, const Vector<ImageExportK
 
     { // prepare general info for sprite drawing
         descriptor->drawSettings.wrapModeS = descriptor->drawSettings.wrapModeT = GetDescriptorWrapMode();
-        descriptor->SetGenerateMipmaps(CommandLineParser::Instance()->IsFlagSet(String("--generateMipMaps")));
+        descriptor->SetGenerateMipmaps(flags.IsFlagSet(String("--generateMipMaps")));
 
         TexturePacker::FilterItem ftItem = GetDescriptorFilter(descriptor->GetGenerateMipMaps());
         descriptor->drawSettings.minFilter = ftItem.minFilter;
@@ -525,15 +531,15 @@ void TexturePacker::ExportImage(const ImageExt& image, const Vector<ImageExportK
 
 rhi::TextureAddrMode TexturePacker::GetDescriptorWrapMode()
 {
-    if (CommandLineParser::Instance()->IsFlagSet("--wrapClampToEdge"))
+    if (flags.IsFlagSet("--wrapClampToEdge"))
     {
         return rhi::TEXADDR_CLAMP;
     }
-    else if (CommandLineParser::Instance()->IsFlagSet("--wrapRepeat"))
+    else if (flags.IsFlagSet("--wrapRepeat"))
     {
         return rhi::TEXADDR_WRAP;
     }
-    else if (CommandLineParser::Instance()->IsFlagSet("--wrapMirror"))
+    else if (flags.IsFlagSet("--wrapMirror"))
     {
         return rhi::TEXADDR_MIRROR;
     }
@@ -547,38 +553,38 @@ TexturePacker::FilterItem TexturePacker::GetDescriptorFilter(bool generateMipMap
     // Default filter
     TexturePacker::FilterItem filterItem(rhi::TEXFILTER_LINEAR, rhi::TEXFILTER_LINEAR, generateMipMaps ? rhi::TEXMIPFILTER_LINEAR : rhi::TEXMIPFILTER_NONE);
 
-    if (CommandLineParser::Instance()->IsFlagSet("--magFilterNearest"))
+    if (flags.IsFlagSet("--magFilterNearest"))
     {
         filterItem.magFilter = rhi::TEXFILTER_NEAREST;
     }
-    if (CommandLineParser::Instance()->IsFlagSet("--magFilterLinear"))
+    if (flags.IsFlagSet("--magFilterLinear"))
     {
         filterItem.magFilter = rhi::TEXFILTER_LINEAR;
     }
-    if (CommandLineParser::Instance()->IsFlagSet("--minFilterNearest"))
+    if (flags.IsFlagSet("--minFilterNearest"))
     {
         filterItem.minFilter = rhi::TEXFILTER_NEAREST;
     }
-    else if (CommandLineParser::Instance()->IsFlagSet("--minFilterLinear"))
+    else if (flags.IsFlagSet("--minFilterLinear"))
     {
         filterItem.minFilter = rhi::TEXFILTER_LINEAR;
     }
-    else if (CommandLineParser::Instance()->IsFlagSet("--minFilterNearestMipmapNearest"))
+    else if (flags.IsFlagSet("--minFilterNearestMipmapNearest"))
     {
         filterItem.minFilter = rhi::TEXFILTER_NEAREST;
         filterItem.mipFilter = rhi::TEXMIPFILTER_NEAREST;
     }
-    else if (CommandLineParser::Instance()->IsFlagSet("--minFilterLinearMipmapNearest"))
+    else if (flags.IsFlagSet("--minFilterLinearMipmapNearest"))
     {
         filterItem.minFilter = rhi::TEXFILTER_LINEAR;
         filterItem.mipFilter = rhi::TEXMIPFILTER_NEAREST;
     }
-    else if (CommandLineParser::Instance()->IsFlagSet("--minFilterNearestMipmapLinear"))
+    else if (flags.IsFlagSet("--minFilterNearestMipmapLinear"))
     {
         filterItem.minFilter = rhi::TEXFILTER_NEAREST;
         filterItem.mipFilter = rhi::TEXMIPFILTER_LINEAR;
     }
-    else if (CommandLineParser::Instance()->IsFlagSet("--minFilterLinearMipmapLinear"))
+    else if (flags.IsFlagSet("--minFilterLinearMipmapLinear"))
     {
         filterItem.minFilter = rhi::TEXFILTER_LINEAR;
         filterItem.mipFilter = rhi::TEXMIPFILTER_LINEAR;
@@ -610,9 +616,9 @@ bool TexturePacker::CheckFrameSize(const Size2i& spriteSize, const Size2i& frame
 
 void TexturePacker::DrawToFinalImage(ImageExt& finalImage, ImageExt& drawedImage, const SpriteBoundsRect& packedCell, const Rect2i& alphaOffsetRect)
 {
-    finalImage.DrawImage(packedCell, alphaOffsetRect, &drawedImage);
+    finalImage.DrawImage(packedCell, alphaOffsetRect, &drawedImage, flags.IsFlagSet("--disableCropAlpha"));
 
-    if (CommandLineParser::Instance()->IsFlagSet("--debug"))
+    if (flags.IsFlagSet("--debug"))
     {
         finalImage.DrawRect(packedCell.marginsRect, 0xFF0000FF);
     }
@@ -620,7 +626,7 @@ void TexturePacker::DrawToFinalImage(ImageExt& finalImage, ImageExt& drawedImage
 
 void TexturePacker::WriteDefinitionString(FILE* fp, const Rect2i& writeRect, const Rect2i& originRect, int textureIndex, const String& frameName)
 {
-    if (CommandLineParser::Instance()->IsFlagSet("--disableCropAlpha"))
+    if (flags.IsFlagSet("--disableCropAlpha"))
     {
         fprintf(fp, "%d %d %d %d %d %d %d %s\n", writeRect.x, writeRect.y, writeRect.dx, writeRect.dy, 0, 0, textureIndex, frameName.c_str());
     }
@@ -6,6 +6,7 @@
 #include "AssetCache/AssetCacheClient.h"
 
 #include <Base/BaseTypes.h>
+#include <Concurrency/Mutex.h>
 #include <Render/RenderBase.h>
 #include <FileSystem/FilePath.h>
 
@@ -16,6 +17,7 @@ namespace DAVA
 class DefinitionFile;
 class YamlNode;
 class AssetCacheClient;
+class CommandLineFlags;
 
 class ResourcePacker2D
 {
@@ -39,6 +41,8 @@ public:
     void SetTag(const String& tag);
     void SetAllTags(const Vector<String>& tags);
     void SetIgnoresFile(const String& ignoresPath);
+    // Max number of folders packed in parallel, 0 - calling thread and all worker threads of JobManager
+    void SetMaxConcurrentTasks(uint32 count);
 
     void PackResources(const Vector<eGPUFamily>& forGPUs);
 
@@ -51,16 +55,21 @@ private:
     bool ReadMD5FromFile(const FilePath& md5file, MD5::MD5Digest& digest) const;
     void WriteMD5ToFile(const FilePath& md5file, const MD5::MD5Digest& digest) const;
 
-    uint32 GetMaxTextureSize() const;
+    uint32 GetMaxTextureSize(const CommandLineFlags& flags) const;
     Vector<String> FetchFlags(const FilePath& flagsPathname);
     static String GetProcessFolderName();
 
     void AddError(const String& errorMsg);
 
-    void PackRecursively(const FilePath& inputPath, const FilePath& outputPath, const Vector<PackingAlgorithm>& packAlgorithms, const Vector<String>& flags = Vector<String>());
+    struct DirectoryTask;
+    static const size_t CACHE_BATCH_SIZE = 32;
 
-    bool GetFilesFromCache(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath);
-    bool AddFilesToCache(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath);
+    void CollectDirectories(const FilePath& inputPath, const FilePath& outputPath, const Vector<PackingAlgorithm>& packAlgorithms, const Vector<String>& flags, Vector<DirectoryTask>& tasks);
+    uint32 PackDirectories(Vector<DirectoryTask>& tasks, const Vector<PackingAlgorithm>& packAlgorithms);
+    void PackDirectory(DirectoryTask& task, const Vector<PackingAlgorithm>& packAlgorithms);
+
+    void RequestDirectoriesFromCache(Vector<DirectoryTask>& tasks);
+    void AddDirectoriesToCache(const Vector<DirectoryTask>& tasks);
 
 public:
     FilePath inputGfxDirectory;
@@ -88,7 +97,9 @@ private:
     Vector<String> allTags;
 
     Set<String> errors;
+    Mutex errorsMutex;
 
+    uint32 maxConcurrentTasks = 0;
     std::atomic<bool> cancelled = { false };
 };
 
@@ -6,6 +6,7 @@
 #include "Math/RectanglePacker/RectanglePacker.h"
 
 #include <Base/BaseTypes.h>
+#include <CommandLine/CommandLineParser.h>
 #include <Functional/Function.h>
 #include <Render/RenderBase.h>
 #include <Render/Texture.h>
@@ -39,7 +40,9 @@ public:
     };
 
 public:
+    // packing options are read from command line flags
     TexturePacker();
+    explicit TexturePacker(const CommandLineFlags& flags);
 
     // pack textures to single texture
     void PackToTextures(const FilePath& outputPath, const DefinitionFile::Collection& defsList, const Vector<eGPUFamily>& forGPUs);
@@ -91,6 +94,7 @@ private:
 
     bool NeedSquareTextureForCompression(const Vector<ImageExportKeys>& keys);
 
+    CommandLineFlags flags;
     TextureConverter::eConvertQuality quality;
 
     String texturePostfix;
@@ -0,0 +1,474 @@
+#include "BenchmarkRequest.h"
+
+#include <AssetCache/AssetCacheClient.h>
+
+#include <FileSystem/File.h>
+#include <Logger/Logger.h>
+#include <Time/SystemTimer.h>
+#include <Utils/MD5.h>
+#include <Utils/StringFormat.h>
+#include <Utils/Utils.h>
+
+using namespace DAVA;
+
+namespace BenchmarkRequestDetails
+{
+const char* OPERATION_NAMES[] = { "add", "get", "remove" };
+
+uint64 GetPercentile(const Vector<uint64>& sortedValues, float32 percentile)
+{
+    if (sortedValues.empty())
+    {
+        return 0;
+    }
+
+    size_t index = static_cast<size_t>(percentile * static_cast<float32>(sortedValues.size() - 1) + 0.5f);
+    return sortedValues[std::min(index, sortedValues.size() - 1)];
+}
+
+float64 ToMs(uint64 us)
+{
+    return static_cast<float64>(us) / 1000.0;
+}
+
+float64 ToMb(uint64 bytes)
+{
+    return static_cast<float64>(bytes) / (1024.0 * 1024.0);
+}
+}
+
+BenchmarkRequest::BenchmarkRequest()
+    : CacheRequest("benchmark")
+{
+    options.AddOption("-n", VariantType(static_cast<uint32>(1000)), "Number of operations in generated workload");
+    options.AddOption("-c", VariantType(static_cast<uint32>(16)), "Concurrency: number of operations pipelined in one batch");
+    options.AddOption("-mix", VariantType(String("50:45:5")), "Percentage of add:get:remove operations in generated workload");
+    options.AddOption("-keys", VariantType(static_cast<uint32>(500)), "Number of distinct keys in generated workload");
+    options.AddOption("-smin", VariantType(static_cast<uint32>(1024)), "Min size of generated item in bytes");
+    options.AddOption("-smax", VariantType(static_cast<uint32>(1024 * 1024)), "Max size of generated item in bytes");
+    options.AddOption("-dist", VariantType(String("log")), "Distribution of item sizes: uniform or log (log-uniform, most items are small)");
+    options.AddOption("-seed", VariantType(static_cast<uint32>(0)), "Seed of workload generator");
+    options.AddOption("-replay", VariantType(String("")), "Replay workload from file instead of generating it");
+    options.AddOption("-record", VariantType(String("")), "Save workload to file to replay it later");
+    options.AddOption("-minops", VariantType(static_cast<uint32>(0)), "Fail if throughput is less than given operations per second");
+    options.AddOption("-maxp99", VariantType(static_cast<uint32>(0)), "Fail if 99th percentile of latency of any operation is bigger than given milliseconds");
+}
+
+AssetCache::Error BenchmarkRequest::SendRequest(AssetCacheClient& cacheClient)
+{
+    Vector<Operation> workload;
+
+    const String replayPath = options.GetOption("-replay").AsString();
+    bool workloadIsReady = replayPath.empty() ? GenerateWorkload(workload) : LoadWorkload(replayPath, workload);
+    if (!workloadIsReady)
+    {
+        return AssetCache::Error::READ_FILES_ERROR;
+    }
+
+    const String recordPath = options.GetOption("-record").AsString();
+    if (!recordPath.empty() && !SaveWorkload(recordPath, workload))
+    {
+        return AssetCache::Error::READ_FILES_ERROR;
+    }
+
+    AssetCache::ServerStatus statusBefore;
+    AssetCache::Error statusResult = cacheClient.RequestServerStatusSynchronously(statusBefore);
+    if (statusResult != AssetCache::Error::NO_ERRORS)
+    {
+        return statusResult;
+    }
+
+    for (OperationStats& operationStats : stats)
+    {
+        operationStats = OperationStats();
+    }
+
+    const size_t batchSize = options.GetOption("-c").AsUInt32();
+    Logger::Info("Running %u operations, %u in batch", static_cast<uint32>(workload.size()), static_cast<uint32>(batchSize));
+
+    uint64 startTime = static_cast<uint64>(SystemTimer::GetUs());
+    for (size_t first = 0; first < workload.size();)
+    {
+        // batch contains successive operations of the same type
+        size_t count = 1;
+        while ((first + count < workload.size()) && (count < batchSize) && (workload[first + count].type == workload[first].type))
+        {
+            ++count;
+        }
+
+        RunBatch(cacheClient, workload, first, count);
+        first += count;
+
+        if (!cacheClient.IsConnected())
+        {
+            Logger::Error("Connection to server is lost");
+            return AssetCache::Error::CANNOT_CONNECT;
+        }
+    }
+    uint64 elapsedUs = static_cast<uint64>(SystemTimer::GetUs()) - startTime;
+
+    AssetCache::ServerStatus statusAfter;
+    statusResult = cacheClient.RequestServerStatusSynchronously(statusAfter);
+    if (statusResult != AssetCache::Error::NO_ERRORS)
+    {
+        return statusResult;
+    }
+
+    return PrintReport(elapsedUs, statusBefore, statusAfter);
+}
+
+void BenchmarkRequest::RunBatch(AssetCacheClient& cacheClient, const Vector<Operation>& workload, size_t first, size_t count)
+{
+    eOperation type = workload[first].type;
+
+    Vector<AssetCache::CacheItemKey> keys;
+    keys.reserve(count);
+    for (size_t i = first; i < first + count; ++i)
+    {
+        keys.push_back(CreateKey(workload[i].keyIndex));
+    }
+
+    Vector<AssetCache::Error> results;
+    Vector<uint64> latenciesUs;
+
+    switch (type)
+    {
+    case OPERATION_ADD:
+    {
+        Vector<AssetCache::CachedItemValue> values(count);
+        Vector<const AssetCache::CachedItemValue*> valuePointers(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            CreateValue(workload[first + i], values[i]);
+            valuePointers[i] = &values[i];
+        }
+
+        cacheClient.AddToCacheSynchronously(keys, valuePointers, results, &latenciesUs);
+        break;
+    }
+    case OPERATION_GET:
+    {
+        Vector<AssetCache::CachedItemValue> values;
+        cacheClient.RequestFromCacheSynchronously(keys, values, results, &latenciesUs);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (results[i] == AssetCache::Error::NO_ERRORS)
+            {
+                stats[OPERATION_GET].bytes += values[i].GetSize();
+            }
+        }
+        break;
+    }
+    case OPERATION_REMOVE:
+    { // there is no pipelining for remove, so every operation has its own latency
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64 startTime = static_cast<uint64>(SystemTimer::GetUs());
+            AssetCache::Error result = cacheClient.RemoveFromCacheSynchronously(keys[i]);
+            AccountResult(workload[first + i], result, static_cast<uint64>(SystemTimer::GetUs()) - startTime);
+        }
+        return;
+    }
+    default:
+        DVASSERT(false, Format("Unexpected operation type: %u", type).c_str());
+        return;
+    }
+
+    // latency of pipelined operation is measured by client from sending of its first chunk till its completion
+    for (size_t i = 0; i < count; ++i)
+    {
+        AccountResult(workload[first + i], results[i], latenciesUs[i]);
+    }
+}
+
+void BenchmarkRequest::AccountResult(const Operation& operation, AssetCache::Error result, uint64 latencyUs)
+{
+    OperationStats& operationStats = stats[operation.type];
+    operationStats.latenciesUs.push_back(latencyUs);
+
+    if (result == AssetCache::Error::NO_ERRORS)
+    {
+        ++operationStats.succeeded;
+        if (operation.type == OPERATION_ADD)
+        {
+            operationStats.bytes += operation.size;
+        }
+    }
+    else if (result == AssetCache::Error::NOT_FOUND_ON_SERVER || (operation.type == OPERATION_REMOVE && result == AssetCache::Error::SERVER_ERROR))
+    { // server responds with error on removing of absent item
+        ++operationStats.notFound;
+    }
+    else
+    {
+        ++operationStats.failed;
+    }
+}
+
+AssetCache::Error BenchmarkRequest::PrintReport(uint64 elapsedUs, const AssetCache::ServerStatus& statusBefore, const AssetCache::ServerStatus& statusAfter) const
+{
+    using namespace BenchmarkRequestDetails;
+
+    AssetCache::Error result = AssetCache::Error::NO_ERRORS;
+
+    uint32 operationsCount = 0;
+    uint64 bytesCount = 0;
+    for (const OperationStats& operationStats : stats)
+    {
+        operationsCount += static_cast<uint32>(operationStats.latenciesUs.size());
+        bytesCount += operationStats.bytes;
+    }
+
+    const float64 elapsedSeconds = std::max(static_cast<float64>(elapsedUs) / 1000000.0, 0.000001);
+    const float64 opsPerSecond = static_cast<float64>(operationsCount) / elapsedSeconds;
+
+    Logger::Info("======== BENCHMARK ========");
+    Logger::Info("operations: %u in %.3f s", operationsCount, elapsedSeconds);
+    Logger::Info("throughput: %.1f ops/s, %.2f MB/s", opsPerSecond, ToMb(bytesCount) / elapsedSeconds);
+
+    const uint32 maxP99Ms = options.GetOption("-maxp99").AsUInt32();
+    for (uint32 type = 0; type < OPERATION_COUNT; ++type)
+    {
+        const OperationStats& operationStats = stats[type];
+        if (operationStats.latenciesUs.empty())
+        {
+            continue;
+        }
+
+        Vector<uint64> sortedLatencies = operationStats.latenciesUs;
+        std::sort(sortedLatencies.begin(), sortedLatencies.end());
+
+        const uint64 p99 = GetPercentile(sortedLatencies, 0.99f);
+        Logger::Info("%s: %u ops (ok %u, not found %u, failed %u), %.2f MB",
+                     OPERATION_NAMES[type], static_cast<uint32>(sortedLatencies.size()),
+                     operationStats.succeeded, operationStats.notFound, operationStats.failed, ToMb(operationStats.bytes));
+        Logger::Info("  latency ms: p50 %.2f, p90 %.2f, p99 %.2f, max %.2f",
+                     ToMs(GetPercentile(sortedLatencies, 0.5f)), ToMs(GetPercentile(sortedLatencies, 0.9f)),
+                     ToMs(p99), ToMs(sortedLatencies.back()));
+
+        if (operationStats.failed > 0)
+        {
+            result = AssetCache::Error::SERVER_ERROR;
+        }
+
+        if (maxP99Ms > 0 && ToMs(p99) > static_cast<float64>(maxP99Ms))
+        {
+            Logger::Error("%s: p99 latency %.2f ms exceeds %u ms", OPERATION_NAMES[type], ToMs(p99), maxP99Ms);
+            result = AssetCache::Error::BENCHMARK_THRESHOLD_FAILED;
+        }
+    }
+
+    Logger::Info("server items: %llu -> %llu, in memory %llu -> %llu",
+                 statusBefore.itemsCount, statusAfter.itemsCount,
+                 statusBefore.itemsInMemoryCount, statusAfter.itemsInMemoryCount);
+    Logger::Info("server memory MB: data %.2f -> %.2f, index %.2f -> %.2f",
+                 ToMb(statusBefore.dataInMemorySize), ToMb(statusAfter.dataInMemorySize),
+                 ToMb(statusBefore.indexMemorySize), ToMb(statusAfter.indexMemorySize));
+    Logger::Info("server storage MB: %.2f -> %.2f of %.2f",
+                 ToMb(statusBefore.occupiedSize), ToMb(statusAfter.occupiedSize), ToMb(statusAfter.storageSize));
+    Logger::Info("===========================");
+
+    const uint32 minOps = options.GetOption("-minops").AsUInt32();
+    if (minOps > 0 && opsPerSecond < static_cast<float64>(minOps))
+    {
+        Logger::Error("Throughput %.1f ops/s is less than %u ops/s", opsPerSecond, minOps);
+        result = AssetCache::Error::BENCHMARK_THRESHOLD_FAILED;
+    }
+
+    return result;
+}
+
+bool BenchmarkRequest::GenerateWorkload(Vector<Operation>& workload) const
+{
+    Vector<String> mixTokens;
+    Split(options.GetOption("-mix").AsString(), ":", mixTokens);
+    if (mixTokens.size() != OPERATION_COUNT)
+    {
+        Logger::Error("[BenchmarkRequest::%s] Wrong mix: %s", __FUNCTION__, options.GetOption("-mix").AsString().c_str());
+        return false;
+    }
+
+    uint32 mix[OPERATION_COUNT] = {};
+    uint32 mixSum = 0;
+    for (uint32 type = 0; type < OPERATION_COUNT; ++type)
+    {
+        mix[type] = static_cast<uint32>(atoi(mixTokens[type].c_str()));
+        mixSum += mix[type];
+    }
+
+    if (mixSum == 0)
+    {
+        Logger::Error("[BenchmarkRequest::%s] Sum of mix is zero", __FUNCTION__);
+        return false;
+    }
+
+    const uint32 operationsCount = options.GetOption("-n").AsUInt32();
+    const uint32 keysCount = std::max(options.GetOption("-keys").AsUInt32(), 1u);
+
+    std::mt19937 generator(options.GetOption("-seed").AsUInt32());
+    std::uniform_int_distribution<uint32> mixDistribution(0, mixSum - 1);
+    std::uniform_int_distribution<uint32> keyDistribution(0, keysCount - 1);
+
+    // every key keeps one size, so that repeated add of the same key sends the same data
+    Vector<uint32> keySizes(keysCount);
+    for (uint32& size : keySizes)
+    {
+        size = GenerateItemSize(generator);
+    }
+
+    workload.resize(operationsCount);
+    for (Operation& operation : workload)
+    {
+        uint32 roll = mixDistribution(generator);
+        uint32 type = 0;
+        while (roll >= mix[type])
+        {
+            roll -= mix[type];
+            ++type;
+        }
+
+        operation.type = static_cast<eOperation>(type);
+        operation.keyIndex = keyDistribution(generator);
+        operation.size = keySizes[operation.keyIndex];
+    }
+
+    return true;
+}
+
+uint32 BenchmarkRequest::GenerateItemSize(std::mt19937& generator) const
+{
+    const uint32 minSize = std::max(options.GetOption("-smin").AsUInt32(), 1u);
+    const uint32 maxSize = std::max(options.GetOption("-smax").AsUInt32(), minSize);
+
+    if (options.GetOption("-dist").AsString() == "uniform")
+    {
+        return std::uniform_int_distribution<uint32>(minSize, maxSize)(generator);
+    }
+
+    std::uniform_real_distribution<float64> logDistribution(std::log(static_cast<float64>(minSize)), std::log(static_cast<float64>(maxSize)));
+    uint32 size = static_cast<uint32>(std::exp(logDistribution(generator)));
+    return Clamp(size, minSize, maxSize);
+}
+
+bool BenchmarkRequest::LoadWorkload(const FilePath& path, Vector<Operation>& workload) const
+{
+    using namespace BenchmarkRequestDetails;
+
+    ScopedPtr<File> file(File::Create(path, File::OPEN | File::READ));
+    if (!file)
+    {
+        Logger::Error("[BenchmarkRequest::%s] Cannot open %s", __FUNCTION__, path.GetStringValue().c_str());
+        return false;
+    }
+
+    workload.clear();
+    while (!file->IsEof())
+    {
+        String line = file->ReadLine();
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        Vector<String> tokens;
+        Split(line, " \t", tokens);
+
+        Operation operation;
+        auto found = std::find_if(std::begin(OPERATION_NAMES), std::end(OPERATION_NAMES), [&tokens](const char* name) { return tokens.empty() == false && tokens[0] == name; });
+        if (found == std::end(OPERATION_NAMES) || tokens.size() < 2 || (*found == OPERATION_NAMES[OPERATION_ADD] && tokens.size() < 3))
+        {
+            Logger::Error("[BenchmarkRequest::%s] Wrong line in workload: %s", __FUNCTION__, line.c_str());
+            return false;
+        }
+
+        operation.type = static_cast<eOperation>(std::distance(std::begin(OPERATION_NAMES), found));
+        operation.keyIndex = static_cast<uint32>(atoi(tokens[1].c_str()));
+        operation.size = (tokens.size() > 2) ? static_cast<uint32>(atoi(tokens[2].c_str())) : 0;
+        workload.push_back(operation);
+    }
+
+    return true;
+}
+
+bool BenchmarkRequest::SaveWorkload(const FilePath& path, const Vector<Operation>& workload) const
+{
+    using namespace BenchmarkRequestDetails;
+
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Error("[BenchmarkRequest::%s] Cannot create %s", __FUNCTION__, path.GetStringValue().c_str());
+        return false;
+    }
+
+    file->WriteLine("# operation keyIndex [size]");
+    for (const Operation& operation : workload)
+    {
+        if (operation.type == OPERATION_ADD)
+        {
+            file->WriteLine(Format("%s %u %u", OPERATION_NAMES[operation.type], operation.keyIndex, operation.size));
+        }
+        else
+        {
+            file->WriteLine(Format("%s %u", OPERATION_NAMES[operation.type], operation.keyIndex));
+        }
+    }
+
+    return true;
+}
+
+AssetCache::CacheItemKey BenchmarkRequest::CreateKey(uint32 keyIndex) const
+{
+    const String primary = Format("AssetCacheBenchmark/%u", keyIndex);
+
+    MD5::MD5Digest digest;
+    MD5::ForData(reinterpret_cast<const uint8*>(primary.data()), static_cast<uint32>(primary.size()), digest);
+
+    AssetCache::CacheItemKey key;
+    key.SetPrimaryKey(digest);
+    key.SetSecondaryKey(digest);
+    return key;
+}
+
+void BenchmarkRequest::CreateValue(const Operation& operation, AssetCache::CachedItemValue& value) const
+{
+    // data is deterministic for key and half of every byte is random, so it is partially compressible
+    std::mt19937 generator(operation.keyIndex);
+    std::shared_ptr<Vector<uint8>> data = std::make_shared<Vector<uint8>>(std::max(operation.size, 1u));
+    for (uint8& byte : *data)
+    {
+        byte = static_cast<uint8>(generator() & 0x0F);
+    }
+
+    value.Add(Format("item_%u.bin", operation.keyIndex), data);
+
+    AssetCache::CachedItemValue::Description description;
+    description.machineName = "benchmark";
+    description.comment = "Asset Cache Client benchmark";
+    value.SetDescription(description);
+    value.UpdateValidationData();
+}
+
+AssetCache::Error BenchmarkRequest::CheckOptionsInternal() const
+{
+    if (options.GetOption("-c").AsUInt32() == 0)
+    {
+        Logger::Error("[BenchmarkRequest::%s] Concurrency should be positive", __FUNCTION__);
+        return AssetCache::Error::WRONG_COMMAND_LINE;
+    }
+
+    const String distribution = options.GetOption("-dist").AsString();
+    if (distribution != "uniform" && distribution != "log")
+    {
+        Logger::Error("[BenchmarkRequest::%s] Unknown size distribution: %s", __FUNCTION__, distribution.c_str());
+        return AssetCache::Error::WRONG_COMMAND_LINE;
+    }
+
+    if (options.GetOption("-replay").AsString().empty() && options.GetOption("-n").AsUInt32() == 0)
+    {
+        Logger::Error("[BenchmarkRequest::%s] Number of operations should be positive", __FUNCTION__);
+        return AssetCache::Error::WRONG_COMMAND_LINE;
+    }
+
+    return AssetCache::Error::NO_ERRORS;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CacheRequest.h"
+
+#include <random>
+
+namespace DAVA
+{
+class AssetCacheClient;
+}
+
+/**
+    Load generator for asset cache server.
+    Replays synthetic or recorded workload of add/get/remove operations and reports
+    throughput, latency percentiles and memory used by cache database of server.
+    Operations of the same type are sent in batches of `-c` items, that are pipelined over one connection.
+*/
+class BenchmarkRequest : public CacheRequest
+{
+public:
+    BenchmarkRequest();
+
+protected:
+    DAVA::AssetCache::Error SendRequest(DAVA::AssetCacheClient& cacheClient) override;
+    DAVA::AssetCache::Error CheckOptionsInternal() const override;
+
+private:
+    enum eOperation : DAVA::uint32
+    {
+        OPERATION_ADD = 0,
+        OPERATION_GET,
+        OPERATION_REMOVE,
+        OPERATION_COUNT
+    };
+
+    struct Operation
+    {
+        eOperation type = OPERATION_GET;
+        DAVA::uint32 keyIndex = 0;
+        DAVA::uint32 size = 0;
+    };
+
+    struct OperationStats
+    {
+        DAVA::Vector<DAVA::uint64> latenciesUs;
+        DAVA::uint64 bytes = 0;
+        DAVA::uint32 succeeded = 0;
+        DAVA::uint32 notFound = 0;
+        DAVA::uint32 failed = 0;
+    };
+
+    bool GenerateWorkload(DAVA::Vector<Operation>& workload) const;
+    bool LoadWorkload(const DAVA::FilePath& path, DAVA::Vector<Operation>& workload) const;
+    bool SaveWorkload(const DAVA::FilePath& path, const DAVA::Vector<Operation>& workload) const;
+
+    DAVA::uint32 GenerateItemSize(std::mt19937& generator) const;
+    DAVA::AssetCache::CacheItemKey CreateKey(DAVA::uint32 keyIndex) const;
+    void CreateValue(const Operation& operation, DAVA::AssetCache::CachedItemValue& value) const;
+
+    void RunBatch(DAVA::AssetCacheClient& cacheClient, const DAVA::Vector<Operation>& workload, size_t first, size_t count);
+    void AccountResult(const Operation& operation, DAVA::AssetCache::Error result, DAVA::uint64 latencyUs);
+
+    DAVA::AssetCache::Error PrintReport(DAVA::uint64 elapsedUs, const DAVA::AssetCache::ServerStatus& statusBefore, const DAVA::AssetCache::ServerStatus& statusAfter) const;
+
+private:
+    OperationStats stats[OPERATION_COUNT];
+};
@@ -16,6 +16,7 @@ CacheRequest::CacheRequest(const String& commandLineOptionName)
     options.AddOption("-p", VariantType(static_cast<uint32>(AssetCache::ASSET_SERVER_PORT)), "Set port of Asset Cache Server.");
     options.AddOption("-t", VariantType(static_cast<uint64>(5)), "Connection timeout seconds.");
     options.AddOption("-v", VariantType(false), "Verbose output.");
+    options.AddOption("-z", VariantType(false), "Compress transferred data with LZ4.");
 }
 
 AssetCache::Error CacheRequest::Process(AssetCacheClient& cacheClient)
@@ -29,6 +30,7 @@ AssetCache::Error CacheRequest::Process(AssetCacheClient& cacheClient)
     params.ip = options.GetOption("-ip").AsString();
     params.port = static_cast<uint16>(options.GetOption("-p").AsUInt32());
     params.timeoutms = options.GetOption("-t").AsUInt64() * 1000; // convert to ms
+    params.compressTraffic = options.GetOption("-z").AsBool();
 
     AssetCache::Error exitCode = cacheClient.ConnectSynchronously(params);
     if (AssetCache::Error::NO_ERRORS == exitCode)
@@ -23,13 +23,7 @@ AssetCache::Error GetRequest::SendRequest(AssetCacheClient& cacheClient)
     FilePath folder = options.GetOption("-f").AsString();
     folder.MakeDirectoryPathname();
 
-    AssetCache::CachedItemValue data;
-    AssetCache::Error resultOfRequest = cacheClient.RequestFromCacheSynchronously(key, &data);
-    if (resultOfRequest == AssetCache::Error::NO_ERRORS)
-    {
-        data.ExportToFolder(folder);
-    }
-    return resultOfRequest;
+    return cacheClient.RequestFromCacheToFolderSynchronously(key, folder);
 }
 
 AssetCache::Error GetRequest::CheckOptionsInternal() const
@@ -0,0 +1,152 @@
+#include "BlobStorage.h"
+
+#include <Debug/DVAssert.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+
+#include <algorithm>
+
+DAVA::float32 BlobStorage::Statistics::GetDedupRatio() const
+{
+    if (storedSize == 0)
+    {
+        return 1.0f;
+    }
+
+    return static_cast<DAVA::float32>(static_cast<DAVA::float64>(referencedSize) / static_cast<DAVA::float64>(storedSize));
+}
+
+void BlobStorage::SetRootFolder(const DAVA::FilePath& folder)
+{
+    DVASSERT(blobs.empty());
+
+    rootFolder = folder;
+    rootFolder.MakeDirectoryPathname();
+}
+
+void BlobStorage::Clear()
+{
+    blobs.clear();
+    statistics = Statistics();
+}
+
+bool BlobStorage::Add(const DAVA::Vector<DAVA::uint8>& data, BlobID& blobID)
+{
+    DAVA::MD5::ForData(data.data(), static_cast<DAVA::uint32>(data.size()), blobID);
+
+    BlobInfo& info = blobs[blobID];
+    if (info.refCount == 0)
+    {
+        DAVA::FilePath blobPath = GetBlobPath(blobID);
+        DAVA::FileSystem::Instance()->CreateDirectory(blobPath.GetDirectory(), true);
+
+        DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(blobPath, DAVA::File::CREATE | DAVA::File::WRITE));
+        DAVA::uint32 dataSize = static_cast<DAVA::uint32>(data.size());
+        if (!file || file->Write(data.data(), dataSize) != dataSize)
+        {
+            DAVA::Logger::Error("[BlobStorage::%s] Cannot write blob %s", __FUNCTION__, blobPath.GetStringValue().c_str());
+            blobs.erase(blobID);
+            return false;
+        }
+
+        info.size = data.size();
+        statistics.blobsCount++;
+        statistics.storedSize += info.size;
+    }
+
+    info.refCount++;
+    statistics.referencesCount++;
+    statistics.referencedSize += info.size;
+    return true;
+}
+
+void BlobStorage::AddReference(const BlobID& blobID, DAVA::uint64 size)
+{
+    BlobInfo& info = blobs[blobID];
+    if (info.refCount == 0)
+    {
+        info.size = size;
+        statistics.blobsCount++;
+        statistics.storedSize += info.size;
+    }
+
+    info.refCount++;
+    statistics.referencesCount++;
+    statistics.referencedSize += info.size;
+}
+
+void BlobStorage::Release(const BlobID& blobID)
+{
+    auto found = blobs.find(blobID);
+    if (found == blobs.end())
+    {
+        DVASSERT(false, "Releasing unknown blob");
+        return;
+    }
+
+    BlobInfo& info = found->second;
+    DVASSERT(info.refCount > 0);
+
+    info.refCount--;
+    statistics.referencesCount--;
+    statistics.referencedSize -= info.size;
+
+    if (info.refCount == 0)
+    {
+        DAVA::FileSystem::Instance()->DeleteFile(GetBlobPath(blobID));
+
+        statistics.blobsCount--;
+        statistics.storedSize -= info.size;
+        blobs.erase(found);
+    }
+}
+
+DAVA::uint64 BlobStorage::RemoveUnreferencedBlobs()
+{
+    DAVA::FileSystem* fs = DAVA::FileSystem::Instance();
+    if (!fs->IsDirectory(rootFolder))
+    {
+        return 0;
+    }
+
+    DAVA::uint64 removedCount = 0;
+    DAVA::uint64 removedSize = 0;
+    DAVA::Vector<DAVA::FilePath> files = fs->EnumerateFilesInDirectory(rootFolder);
+    for (const DAVA::FilePath& path : files)
+    {
+        DAVA::String blobName = path.GetRelativePathname(rootFolder);
+        blobName.erase(std::remove(blobName.begin(), blobName.end(), '/'), blobName.end());
+
+        if (blobName.size() == static_cast<size_t>(BlobID::DIGEST_SIZE * 2))
+        {
+            BlobID blobID;
+            DAVA::MD5::CharToHash(blobName.c_str(), blobID);
+            if (blobs.count(blobID) != 0 && GetBlobPath(blobID) == path)
+            {
+                continue;
+            }
+        }
+
+        DAVA::uint64 fileSize = 0;
+        fs->GetFileSize(path, fileSize);
+        if (fs->DeleteFile(path))
+        {
+            removedCount++;
+            removedSize += fileSize;
+        }
+    }
+
+    if (removedCount > 0)
+    {
+        DAVA::Logger::Info("[BlobStorage::%s] Removed %llu unreferenced blobs of %llu bytes", __FUNCTION__, removedCount, removedSize);
+    }
+
+    return removedSize;
+}
+
+DAVA::FilePath BlobStorage::GetBlobPath(const BlobID& blobID) const
+{
+    DAVA::String blobName = DAVA::MD5::HashToString(blobID);
+    return rootFolder + (blobName.substr(0, 2) + "/" + blobName.substr(2));
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <Base/Hash.h>
+#include <FileSystem/FilePath.h>
+#include <Utils/MD5.h>
+
+namespace std
+{
+template <>
+struct hash<DAVA::MD5::MD5Digest>
+{
+    size_t operator()(const DAVA::MD5::MD5Digest& digest) const DAVA_NOEXCEPT
+    {
+        return DAVA::BufferHash(digest.digest.data(), static_cast<DAVA::uint32>(digest.digest.size()));
+    }
+};
+}
+
+/**
+    Content-addressed storage of cached files.
+    Every file is stored once under name derived from hash of its content, cache entries only reference
+    blobs. Blob is deleted from disk when last reference to it is released.
+    Reference counts are not stored on disk: they are restored from cache entries by AddReference() on load,
+    after that RemoveUnreferencedBlobs() sweeps blobs left on disk by entries that weren't saved.
+*/
+class BlobStorage final
+{
+public:
+    using BlobID = DAVA::MD5::MD5Digest;
+
+    struct Statistics
+    {
+        DAVA::uint64 blobsCount = 0; //unique blobs stored on disk
+        DAVA::uint64 storedSize = 0; //size of unique blobs stored on disk
+        DAVA::uint64 referencesCount = 0; //references from cache entries
+        DAVA::uint64 referencedSize = 0; //size of data as if every reference was stored separately
+
+        DAVA::float32 GetDedupRatio() const;
+    };
+
+    void SetRootFolder(const DAVA::FilePath& folder);
+    void Clear();
+
+    /**
+        Stores `data` if there is no blob with the same content, increments reference count of blob and returns its ID.
+        Returns false if data can't be written to disk
+    */
+    bool Add(const DAVA::Vector<DAVA::uint8>& data, BlobID& blobID);
+
+    /** Increments reference count of blob, that is already stored on disk */
+    void AddReference(const BlobID& blobID, DAVA::uint64 size);
+
+    /** Decrements reference count of blob and deletes it from disk if it isn't referenced any more */
+    void Release(const BlobID& blobID);
+
+    /**
+        Deletes files from root folder, that aren't referenced blobs.
+        Should be called once all references are restored. Returns size of deleted files
+    */
+    DAVA::uint64 RemoveUnreferencedBlobs();
+
+    DAVA::FilePath GetBlobPath(const BlobID& blobID) const;
+    const Statistics& GetStatistics() const;
+
+private:
+    struct BlobInfo
+    {
+        DAVA::uint32 refCount = 0;
+        DAVA::uint64 size = 0;
+    };
+
+    DAVA::FilePath rootFolder;
+    DAVA::UnorderedMap<BlobID, BlobInfo> blobs;
+    Statistics statistics;
+};
+
+inline const BlobStorage::Statistics& BlobStorage::GetStatistics() const
+{
+    return statistics;
+}
@@ -4,6 +4,7 @@
 
 #include <AssetCache/CachedItemValue.h>
 
+#include <FileSystem/DynamicMemoryFile.h>
 #include <FileSystem/File.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/KeyedArchive.h>
@@ -13,7 +14,29 @@
 #include <Logger/Logger.h>
 
 const DAVA::String CacheDB::DB_FILE_NAME = "cache.dat";
-const DAVA::uint32 CacheDB::VERSION = 1;
+const DAVA::String CacheDB::JOURNAL_FILE_NAME = "cache.journal";
+const DAVA::String CacheDB::BLOBS_FOLDER_NAME = "blobs/";
+const DAVA::uint32 CacheDB::VERSION = 3;
+const DAVA::uint64 CacheDB::MIN_JOURNAL_RECORDS_TO_COMPACT = 4096;
+
+namespace CacheDBDetails
+{
+const DAVA::uint32 LEGACY_VERSION = 1;
+const DAVA::uint32 NO_BLOBS_VERSION = 2;
+const DAVA::uint32 JOURNAL_SIGNATURE = 0x4E524A43; //"CJRN"
+// every node of hash map or list is counted with two pointers of overhead in memory usage
+const DAVA::uint64 NODE_OVERHEAD = 2 * sizeof(void*);
+
+bool WriteKey(DAVA::File* file, const DAVA::AssetCache::CacheItemKey& key)
+{
+    return file->Write(key.data(), static_cast<DAVA::uint32>(key.size())) == key.size();
+}
+
+bool ReadKey(DAVA::File* file, DAVA::AssetCache::CacheItemKey& key)
+{
+    return file->Read(key.data(), static_cast<DAVA::uint32>(key.size())) == key.size();
+}
+}
 
 CacheDB::CacheDB(CacheDBOwner& _owner)
     : owner(_owner)
@@ -87,10 +110,38 @@ void CacheDB::Load()
     DVASSERT(fastCache.empty());
     DVASSERT(fullCache.empty());
 
+    occupiedSize = 0;
+    journalRecordsCount = 0;
+    journalID = 0;
+    snapshotVersion = VERSION;
+    pendingJournal.clear();
+
+    cacheJournal = cacheRootFolder + JOURNAL_FILE_NAME;
+    blobStorage.SetRootFolder(cacheRootFolder + BLOBS_FOLDER_NAME);
+
+    needSnapshot = false;
+    if (LoadSnapshot())
+    {
+        LoadJournal();
+    }
+    else
+    {
+        needSnapshot = true;
+    }
+
+    RebuildLRU();
+    RestoreBlobReferences();
+
+    NotifySizeChanged();
+    dbStateChanged = needSnapshot && !fullCache.empty();
+}
+
+bool CacheDB::LoadSnapshot()
+{
     DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheSettings, DAVA::File::OPEN | DAVA::File::READ));
     if (!file)
     {
-        return;
+        return false;
     }
 
     DAVA::ScopedPtr<DAVA::KeyedArchive> header(new DAVA::KeyedArchive());
@@ -99,26 +150,56 @@ void CacheDB::Load()
     if (header->GetString("signature") != "cache")
     {
         DAVA::Logger::Error("[CacheDB::%s] Wrong signature %s", __FUNCTION__, header->GetString("signature").c_str());
-        return;
+        return false;
     }
 
-    if (header->GetUInt32("version") != VERSION)
+    DAVA::uint64 cacheSize = header->GetUInt64("itemsCount");
+    fullCache.reserve(static_cast<size_t>(cacheSize));
+
+    DAVA::uint32 version = header->GetUInt32("version");
+    if (version == CacheDBDetails::LEGACY_VERSION)
+    {
+        DAVA::Logger::Info("[CacheDB::%s] Cache of version %u will be converted to version %u", __FUNCTION__, version, VERSION);
+        LoadLegacySnapshot(file, cacheSize);
+        return false;
+    }
+    else if (version != VERSION && version != CacheDBDetails::NO_BLOBS_VERSION)
     {
         DVASSERT(false, "cachedb file version is changed. Versions load functions should be implemented");
-        return;
+        return false;
     }
 
-    DAVA::uint64 cacheSize = header->GetUInt64("itemsCount");
-    fullCache.reserve(static_cast<size_t>(cacheSize));
+    journalID = header->GetUInt64("journalID");
+    snapshotVersion = version;
+    bool withBlobs = (version != CacheDBDetails::NO_BLOBS_VERSION);
+
+    for (DAVA::uint64 index = 0; index < cacheSize; ++index)
+    {
+        DAVA::AssetCache::CacheItemKey key;
+        ServerCacheEntry entry;
+        if (!CacheDBDetails::ReadKey(file, key) || !entry.Deserialize(file, withBlobs))
+        {
+            DAVA::Logger::Error("[CacheDB::%s] Can't load item %llu from cache file", __FUNCTION__, index);
+            break;
+        }
+
+        InsertInFullCache(key, std::move(entry));
+    }
+
+    // entries of old version will be saved with new version of snapshot
+    needSnapshot = (version != VERSION);
+    return true;
+}
 
+bool CacheDB::LoadLegacySnapshot(DAVA::File* file, DAVA::uint64 cacheSize)
+{
     DAVA::ScopedPtr<DAVA::KeyedArchive> cache(new DAVA::KeyedArchive());
     if (!cache->Load(file))
     {
         DAVA::Logger::Error("[%s] Can't load cache file", __FUNCTION__);
-        return;
+        return false;
     }
 
-    occupiedSize = 0;
     for (DAVA::uint64 index = 0; index < cacheSize; ++index)
     {
         DAVA::KeyedArchive* itemArchieve = cache->GetArchive(DAVA::Format("item_%d", index));
@@ -130,12 +211,149 @@ void CacheDB::Load()
         ServerCacheEntry entry;
         entry.Deserialize(itemArchieve);
 
-        occupiedSize += entry.GetValue().GetSize();
-        fullCache[key] = std::move(entry);
+        InsertInFullCache(key, std::move(entry));
     }
 
-    NotifySizeChanged();
-    dbStateChanged = false;
+    return true;
+}
+
+void CacheDB::LoadJournal()
+{
+    DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheJournal, DAVA::File::OPEN | DAVA::File::READ));
+    if (!file)
+    {
+        return;
+    }
+
+    DAVA::uint32 signature = 0;
+    DAVA::uint64 id = 0;
+    if (file->Read(&signature) != sizeof(signature) || file->Read(&id) != sizeof(id) || signature != CacheDBDetails::JOURNAL_SIGNATURE)
+    {
+        DAVA::Logger::Error("[CacheDB::%s] Wrong journal header", __FUNCTION__);
+        needSnapshot = true;
+        return;
+    }
+
+    if (id != journalID)
+    {
+        // journal was left from another snapshot, all its changes are already in snapshot or lost
+        DAVA::Logger::Warning("[CacheDB::%s] Journal %llu doesn't match snapshot %llu and will be ignored", __FUNCTION__, id, journalID);
+        needSnapshot = true;
+        return;
+    }
+
+    DAVA::uint8 operation = 0;
+    while (file->Read(&operation) == sizeof(operation))
+    {
+        DAVA::AssetCache::CacheItemKey key;
+        if (!CacheDBDetails::ReadKey(file, key))
+        {
+            break;
+        }
+
+        bool recordIsValid = true;
+        switch (operation)
+        {
+        case JOURNAL_INSERT:
+        {
+            ServerCacheEntry entry;
+            recordIsValid = entry.Deserialize(file, snapshotVersion != CacheDBDetails::NO_BLOBS_VERSION);
+            if (recordIsValid)
+            {
+                InsertInFullCache(key, std::move(entry));
+            }
+            break;
+        }
+        case JOURNAL_TOUCH:
+        {
+            DAVA::uint64 timestamp = 0;
+            recordIsValid = (file->Read(&timestamp) == sizeof(timestamp));
+            ServerCacheEntry* entry = FindInFullCache(key);
+            if (recordIsValid && entry != nullptr)
+            {
+                entry->SetAccessTimestamp(timestamp);
+            }
+            break;
+        }
+        case JOURNAL_REMOVE:
+        {
+            auto found = fullCache.find(key);
+            if (found != fullCache.end())
+            {
+                entriesIndexSize -= GetEntryIndexSize(found->second);
+                fullCache.erase(found);
+            }
+            break;
+        }
+        default:
+            recordIsValid = false;
+            break;
+        }
+
+        if (recordIsValid == false)
+        {
+            // tail of journal can be broken if server was stopped while writing
+            DAVA::Logger::Warning("[CacheDB::%s] Journal is broken after %llu records", __FUNCTION__, journalRecordsCount);
+            needSnapshot = true;
+            break;
+        }
+
+        ++journalRecordsCount;
+    }
+}
+
+void CacheDB::InsertInFullCache(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry&& entry)
+{
+    ServerCacheEntry& insertedEntry = fullCache[key];
+    entriesIndexSize -= GetEntryIndexSize(insertedEntry);
+    insertedEntry = std::move(entry);
+    entriesIndexSize += GetEntryIndexSize(insertedEntry);
+}
+
+void CacheDB::RestoreBlobReferences()
+{
+    blobStorage.Clear();
+
+    DAVA::uint64 ownFoldersSize = 0;
+    for (const auto& item : fullCache)
+    {
+        if (item.second.HasBlobs())
+        {
+            item.second.RestoreBlobReferences(blobStorage);
+        }
+        else
+        {
+            ownFoldersSize += item.second.GetValue().GetSize();
+        }
+    }
+
+    // blobs, that were added or released after last saved snapshot and journal, aren't referenced by restored entries
+    blobStorage.RemoveUnreferencedBlobs();
+
+    occupiedSize = ownFoldersSize + blobStorage.GetStatistics().storedSize;
+}
+
+void CacheDB::RebuildLRU()
+{
+    DVASSERT(fastCache.empty());
+
+    DAVA::Vector<CacheMap::value_type*> sortedItems;
+    sortedItems.reserve(fullCache.size());
+    for (auto& item : fullCache)
+    {
+        sortedItems.push_back(&item);
+    }
+
+    std::sort(sortedItems.begin(), sortedItems.end(), [](const CacheMap::value_type* left, const CacheMap::value_type* right) {
+        return left->second.GetTimestamp() < right->second.GetTimestamp();
+    });
+
+    fullCacheLRU.clear();
+    fastCacheLRU.clear();
+    for (CacheMap::value_type* item : sortedItems)
+    {
+        item->second.fullCachePosition = fullCacheLRU.insert(fullCacheLRU.end(), item->first);
+    }
 }
 
 void CacheDB::Unload()
@@ -149,53 +367,164 @@ void CacheDB::Unload()
 
     fastCache.clear();
     fullCache.clear();
+    fastCacheLRU.clear();
+    fullCacheLRU.clear();
+    pendingJournal.clear();
+    blobStorage.Clear();
     occupiedSize = 0;
+    entriesIndexSize = 0;
+    fastCacheDataSize = 0;
     NotifySizeChanged();
 }
 
 void CacheDB::Save()
 {
-    DAVA::FileSystem::Instance()->CreateDirectory(cacheRootFolder, true);
+    if (cacheRootFolder.IsEmpty())
+    {
+        return;
+    }
 
-    DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheSettings, DAVA::File::CREATE | DAVA::File::WRITE));
-    if (!file)
+    bool journalIsBig = (journalRecordsCount + pendingJournal.size()) > std::max<DAVA::uint64>(fullCache.size(), MIN_JOURNAL_RECORDS_TO_COMPACT);
+    if (needSnapshot || journalIsBig)
     {
-        DAVA::Logger::Error("[CacheDB::%s] Cannot create file %s", __FUNCTION__, cacheSettings.GetStringValue().c_str());
+        SaveSnapshot();
+    }
+    else
+    {
+        AppendJournal();
+    }
+
+    const BlobStorage::Statistics& blobStatistics = blobStorage.GetStatistics();
+    DAVA::Logger::Info("[CacheDB] Saved %llu items, %llu blobs of %llu bytes are referenced %llu times, dedup ratio %.2f",
+                       static_cast<DAVA::uint64>(fullCache.size()), blobStatistics.blobsCount, blobStatistics.storedSize,
+                       blobStatistics.referencesCount, blobStatistics.GetDedupRatio());
+
+    dbStateChanged = false;
+    lastSaveTime = DAVA::SystemTimer::GetMs();
+}
+
+void CacheDB::SaveSnapshot()
+{
+    DAVA::FileSystem* fs = DAVA::FileSystem::Instance();
+    fs->CreateDirectory(cacheRootFolder, true);
+
+    DAVA::FilePath tempSettings = cacheSettings + ".tmp";
+    {
+        DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(tempSettings, DAVA::File::CREATE | DAVA::File::WRITE));
+        if (!file)
+        {
+            DAVA::Logger::Error("[CacheDB::%s] Cannot create file %s", __FUNCTION__, tempSettings.GetStringValue().c_str());
+            return;
+        }
+
+        DAVA::ScopedPtr<DAVA::KeyedArchive> header(new DAVA::KeyedArchive());
+        header->SetString("signature", "cache");
+        header->SetUInt32("version", VERSION);
+        header->SetUInt64("itemsCount", fullCache.size());
+        header->SetUInt64("journalID", journalID + 1);
+        header->Save(file);
+
+        DAVA::ScopedPtr<DAVA::DynamicMemoryFile> buffer(DAVA::DynamicMemoryFile::Create(DAVA::File::CREATE | DAVA::File::WRITE));
+        for (const auto& item : fullCache)
+        {
+            CacheDBDetails::WriteKey(buffer, item.first);
+            item.second.Serialize(buffer);
+        }
+
+        DAVA::uint32 bufferSize = static_cast<DAVA::uint32>(buffer->GetSize());
+        if (file->Write(buffer->GetData(), bufferSize) != bufferSize)
+        {
+            DAVA::Logger::Error("[CacheDB::%s] Cannot write file %s", __FUNCTION__, tempSettings.GetStringValue().c_str());
+            return;
+        }
+    }
+
+    if (fs->MoveFile(tempSettings, cacheSettings, true) == false)
+    {
+        DAVA::Logger::Error("[CacheDB::%s] Cannot move %s to %s", __FUNCTION__, tempSettings.GetStringValue().c_str(), cacheSettings.GetStringValue().c_str());
         return;
     }
 
-    DAVA::ScopedPtr<DAVA::KeyedArchive> header(new DAVA::KeyedArchive());
-    header->SetString("signature", "cache");
-    header->SetUInt32("version", VERSION);
-    header->SetUInt64("itemsCount", fullCache.size());
-    header->Save(file);
+    // all changes are in snapshot now, so start new empty journal
+    ++journalID;
+    fs->DeleteFile(cacheJournal);
+    journalRecordsCount = 0;
+    pendingJournal.clear();
+    needSnapshot = false;
+}
 
-    DAVA::ScopedPtr<DAVA::KeyedArchive> cache(new DAVA::KeyedArchive());
-    DAVA::uint64 index = 0;
-    for (auto& item : fullCache)
+void CacheDB::AppendJournal()
+{
+    if (pendingJournal.empty())
     {
-        DAVA::ScopedPtr<DAVA::KeyedArchive> itemArchieve(new DAVA::KeyedArchive());
-        item.first.Serialize(itemArchieve);
-        item.second.Serialize(itemArchieve);
+        return;
+    }
 
-        cache->SetArchive(DAVA::Format("item_%d", index++), itemArchieve);
+    DAVA::ScopedPtr<DAVA::DynamicMemoryFile> buffer(DAVA::DynamicMemoryFile::Create(DAVA::File::CREATE | DAVA::File::WRITE));
+    if (journalRecordsCount == 0)
+    {
+        DAVA::FileSystem::Instance()->DeleteFile(cacheJournal);
+        buffer->Write(&CacheDBDetails::JOURNAL_SIGNATURE, sizeof(CacheDBDetails::JOURNAL_SIGNATURE));
+        buffer->Write(&journalID, sizeof(journalID));
     }
-    cache->Save(file);
 
-    dbStateChanged = false;
-    lastSaveTime = DAVA::SystemTimer::GetMs();
+    for (const auto& record : pendingJournal)
+    {
+        const ServerCacheEntry* entry = FindInFullCache(record.first);
+        JournalOperation operation = (entry != nullptr) ? record.second : JOURNAL_REMOVE;
+
+        DAVA::uint8 operationValue = operation;
+        buffer->Write(&operationValue, sizeof(operationValue));
+        CacheDBDetails::WriteKey(buffer, record.first);
+
+        if (operation == JOURNAL_INSERT)
+        {
+            entry->Serialize(buffer);
+        }
+        else if (operation == JOURNAL_TOUCH)
+        {
+            DAVA::uint64 timestamp = entry->GetTimestamp();
+            buffer->Write(&timestamp, sizeof(timestamp));
+        }
+    }
+
+    DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheJournal, DAVA::File::APPEND | DAVA::File::WRITE));
+    DAVA::uint32 bufferSize = static_cast<DAVA::uint32>(buffer->GetSize());
+    if (!file || file->Write(buffer->GetData(), bufferSize) != bufferSize)
+    {
+        DAVA::Logger::Error("[CacheDB::%s] Cannot write journal %s", __FUNCTION__, cacheJournal.GetStringValue().c_str());
+        needSnapshot = true;
+        return;
+    }
+
+    journalRecordsCount += pendingJournal.size();
+    pendingJournal.clear();
+}
+
+void CacheDB::AddJournalRecord(const DAVA::AssetCache::CacheItemKey& key, JournalOperation operation)
+{
+    auto found = pendingJournal.find(key);
+    if (found == pendingJournal.end())
+    {
+        pendingJournal.emplace(key, operation);
+    }
+    else if (!(found->second == JOURNAL_INSERT && operation == JOURNAL_TOUCH))
+    {
+        // insert followed by touch is still insert, all other sequences are defined by last operation
+        found->second = operation;
+    }
+
+    dbStateChanged = true;
 }
 
 void CacheDB::ReduceFullCacheToSize(DAVA::uint64 toSize)
 {
     while (occupiedSize > toSize)
     {
-        const auto& found = std::min_element(fullCache.begin(), fullCache.end(), [](const CacheMap::value_type& left, const CacheMap::value_type& right) -> bool
-                                             {
-                                                 return left.second.GetTimestamp() < right.second.GetTimestamp();
-                                             });
-        if (found != fullCache.end())
+        if (fullCacheLRU.empty() == false)
         {
+            auto found = fullCache.find(fullCacheLRU.front());
+            DVASSERT(found != fullCache.end());
             Remove(found);
         }
         else
@@ -213,21 +542,11 @@ void CacheDB::ReduceFullCacheToSize(DAVA::uint64 toSize)
 
 void CacheDB::ReduceFastCacheByCount(DAVA::uint32 countToRemove)
 {
-    for (; countToRemove > 0; --countToRemove)
+    for (; countToRemove > 0 && fastCacheLRU.empty() == false; --countToRemove)
     {
-        const auto& oldestFound = std::min_element(fastCache.begin(), fastCache.end(), [](const FastCacheMap::value_type& left, const FastCacheMap::value_type& right) -> bool
-                                                   {
-                                                       return left.second->GetTimestamp() < right.second->GetTimestamp();
-                                                   });
-
-        if (oldestFound != fastCache.end())
-        {
-            RemoveFromFastCache(oldestFound);
-        }
-        else
-        {
-            return;
-        }
+        auto oldestFound = fastCache.find(fastCacheLRU.front());
+        DVASSERT(oldestFound != fastCache.end());
+        RemoveFromFastCache(oldestFound);
     }
 }
 
@@ -242,7 +561,7 @@ ServerCacheEntry* CacheDB::Get(const DAVA::AssetCache::CacheItemKey& key)
         {
             const DAVA::FilePath path = CreateFolderPath(key);
 
-            if (true == entry->Fetch(path))
+            if (true == entry->Fetch(path, blobStorage))
             {
                 InsertInFastCache(key, entry);
             }
@@ -327,10 +646,24 @@ void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry
     DAVA::Logger::Debug("Inserting into cache: key %s", Brief(key).c_str());
     fullCache[key] = std::move(entry);
     ServerCacheEntry* insertedEntry = &fullCache[key];
-    DAVA::FilePath savedPath = CreateFolderPath(key);
-    insertedEntry->GetValue().ExportToFolder(savedPath);
+
+    DAVA::uint64 storedSizeBefore = blobStorage.GetStatistics().storedSize;
+    if (insertedEntry->StoreBlobs(blobStorage))
+    {
+        // only content that isn't stored yet takes place on disk
+        occupiedSize += blobStorage.GetStatistics().storedSize - storedSizeBefore;
+    }
+    else
+    {
+        DAVA::Logger::Warning("[CacheDB::%s] Cannot store blobs for %s, entry will be stored in own folder", __FUNCTION__, Brief(key).c_str());
+        DAVA::FilePath savedPath = CreateFolderPath(key);
+        insertedEntry->GetValue().ExportToFolder(savedPath);
+        occupiedSize += insertedEntry->GetValue().GetSize();
+    }
+    entriesIndexSize += GetEntryIndexSize(*insertedEntry);
+
     insertedEntry->UpdateAccessTimestamp();
-    occupiedSize += insertedEntry->GetValue().GetSize();
+    insertedEntry->fullCachePosition = fullCacheLRU.insert(fullCacheLRU.end(), key);
     NotifySizeChanged();
 
     InsertInFastCache(key, insertedEntry);
@@ -341,7 +674,7 @@ void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry
         DVASSERT(fullCache.find(key) != fullCache.end());
     }
 
-    dbStateChanged = true;
+    AddJournalRecord(key, JOURNAL_INSERT);
 }
 
 void CacheDB::InsertInFastCache(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry)
@@ -359,6 +692,8 @@ void CacheDB::InsertInFastCache(const DAVA::AssetCache::CacheItemKey& key, Serve
     DVASSERT(entry->GetValue().IsFetched() == true);
 
     fastCache[key] = entry;
+    fastCacheDataSize += entry->GetValue().GetSize();
+    entry->fastCachePosition = fastCacheLRU.insert(fastCacheLRU.end(), key);
 }
 
 void CacheDB::UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key)
@@ -377,7 +712,16 @@ void CacheDB::UpdateAccessTimestamp(ServerCacheEntry* entry)
     if (nullptr != entry)
     {
         entry->UpdateAccessTimestamp();
-        dbStateChanged = true;
+
+        // move entry to the end of LRU lists as most recently used
+        const DAVA::AssetCache::CacheItemKey& key = *entry->fullCachePosition;
+        fullCacheLRU.splice(fullCacheLRU.end(), fullCacheLRU, entry->fullCachePosition);
+        if (fastCache.count(key) != 0)
+        {
+            fastCacheLRU.splice(fastCacheLRU.end(), fastCacheLRU, entry->fastCachePosition);
+        }
+
+        AddJournalRecord(key, JOURNAL_TOUCH);
     }
 }
 
@@ -401,21 +745,34 @@ void CacheDB::Remove(const CacheMap::iterator& it)
         RemoveFromFastCache(found);
     }
 
+    AddJournalRecord(it->first, JOURNAL_REMOVE);
     RemoveFromFullCache(it);
-    dbStateChanged = true;
 }
 
 void CacheDB::RemoveFromFullCache(const CacheMap::iterator& it)
 {
     DVASSERT(it != fullCache.end());
 
-    DAVA::FilePath dataPath = CreateFolderPath(it->first);
-    DAVA::FileSystem::Instance()->DeleteDirectory(dataPath);
+    entriesIndexSize -= GetEntryIndexSize(it->second);
+
+    DAVA::uint64 itemSize = 0;
+    if (it->second.HasBlobs())
+    {
+        DAVA::uint64 storedSizeBefore = blobStorage.GetStatistics().storedSize;
+        it->second.ReleaseBlobs(blobStorage);
+        itemSize = storedSizeBefore - blobStorage.GetStatistics().storedSize;
+    }
+    else
+    {
+        DAVA::FilePath dataPath = CreateFolderPath(it->first);
+        DAVA::FileSystem::Instance()->DeleteDirectory(dataPath);
+        itemSize = it->second.GetValue().GetSize();
+    }
 
-    DAVA::uint64 itemSize = it->second.GetValue().GetSize();
     DVASSERT(itemSize <= occupiedSize);
     occupiedSize -= itemSize;
     DAVA::Logger::Debug("Removing from full cache: key %s", Brief(it->first).c_str());
+    fullCacheLRU.erase(it->second.fullCachePosition);
     fullCache.erase(it);
     NotifySizeChanged();
 }
@@ -425,7 +782,10 @@ void CacheDB::RemoveFromFastCache(const FastCacheMap::iterator& it)
     DVASSERT(it != fastCache.end());
 
     DVASSERT(it->second->GetValue().IsFetched() == true);
+    DVASSERT(it->second->GetValue().GetSize() <= fastCacheDataSize);
+    fastCacheDataSize -= it->second->GetValue().GetSize();
     it->second->Free();
+    fastCacheLRU.erase(it->second->fastCachePosition);
     fastCache.erase(it);
 }
 
@@ -450,6 +810,40 @@ void CacheDB::Update()
     }
 }
 
+DAVA::uint64 CacheDB::GetEntryIndexSize(const ServerCacheEntry& entry)
+{
+    using namespace DAVA;
+
+    uint64 size = entry.blobs.capacity() * sizeof(ServerCacheEntry::BlobReference);
+    for (const auto& data : entry.GetValue().GetDataContainer())
+    {
+        size += sizeof(AssetCache::CachedItemValue::ValueDataContainer::value_type) + CacheDBDetails::NODE_OVERHEAD + data.first.capacity();
+    }
+    return size;
+}
+
+CacheDB::MemoryUsage CacheDB::GetMemoryUsage() const
+{
+    using namespace DAVA;
+    using CacheDBDetails::NODE_OVERHEAD;
+
+    // sizes of entries are accumulated on insert and remove, so status requests don't walk the cache
+    MemoryUsage usage;
+    usage.itemsCount = fullCache.size();
+    usage.itemsInMemoryCount = fastCache.size();
+    usage.dataInMemorySize = fastCacheDataSize;
+
+    usage.indexMemorySize += fullCache.size() * (sizeof(CacheMap::value_type) + NODE_OVERHEAD);
+    usage.indexMemorySize += fullCache.bucket_count() * sizeof(void*);
+    usage.indexMemorySize += (fullCacheLRU.size() + fastCacheLRU.size()) * (sizeof(LRUList::value_type) + NODE_OVERHEAD);
+    usage.indexMemorySize += fastCache.size() * (sizeof(FastCacheMap::value_type) + NODE_OVERHEAD);
+    usage.indexMemorySize += fastCache.bucket_count() * sizeof(void*);
+    usage.indexMemorySize += entriesIndexSize;
+    usage.indexMemorySize += blobStorage.GetStatistics().blobsCount * (sizeof(BlobStorage::BlobID) + sizeof(uint64) * 2 + NODE_OVERHEAD);
+
+    return usage;
+}
+
 const DAVA::uint64 CacheDB::GetAvailableSize() const
 {
     DVASSERT(GetStorageSize() > GetOccupiedSize());
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ServerCacheEntry.h"
+
 #include <AssetCache/CacheItemKey.h>
 
 #include <Base/BaseTypes.h>
@@ -9,28 +11,56 @@
 
 namespace DAVA
 {
+class File;
 namespace AssetCache
 {
 class CachedItemValue;
 }
 }
 
-class ServerCacheEntry;
-
 struct CacheDBOwner
 {
     virtual void OnStorageSizeChanged(DAVA::uint64 occupied, DAVA::uint64 overall) = 0;
 };
 
+/**
+    Index of cached items.
+    Index is stored on disk as snapshot (DB_FILE_NAME) and append-only journal of changes (JOURNAL_FILE_NAME),
+    so Save() writes only changes made since previous save. Journal is compacted into new snapshot when it grows
+    bigger than the index itself.
+    Items are evicted in least-recently-used order, LRU lists are kept sorted by access, so eviction is O(1).
+    Files of items are stored in content-addressed BlobStorage, so identical files of different items take place on disk once.
+    Occupied size accounts only unique content.
+*/
 class CacheDB final
 {
     static const DAVA::String DB_FILE_NAME;
+    static const DAVA::String JOURNAL_FILE_NAME;
+    static const DAVA::String BLOBS_FOLDER_NAME;
     static const DAVA::uint32 VERSION;
+    static const DAVA::uint64 MIN_JOURNAL_RECORDS_TO_COMPACT;
 
     using CacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry>;
     using FastCacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry*>;
+    using LRUList = ServerCacheEntry::LRUList;
+
+    enum JournalOperation : DAVA::uint8
+    {
+        JOURNAL_INSERT = 0,
+        JOURNAL_TOUCH,
+        JOURNAL_REMOVE
+    };
+    using JournalMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, JournalOperation>;
 
 public:
+    struct MemoryUsage
+    {
+        DAVA::uint64 itemsCount = 0;
+        DAVA::uint64 itemsInMemoryCount = 0;
+        DAVA::uint64 dataInMemorySize = 0; //size of loaded files of items in fast cache
+        DAVA::uint64 indexMemorySize = 0; //estimated size of containers of index
+    };
+
     CacheDB(CacheDBOwner& owner);
     ~CacheDB();
 
@@ -51,6 +81,9 @@ public:
     const DAVA::uint64 GetAvailableSize() const;
     const DAVA::uint64 GetOccupiedSize() const;
 
+    const BlobStorage::Statistics& GetBlobStatistics() const;
+    MemoryUsage GetMemoryUsage() const;
+
     void Update();
 
 private:
@@ -60,6 +93,17 @@ private:
 
     void Unload();
 
+    bool LoadSnapshot();
+    bool LoadLegacySnapshot(DAVA::File* file, DAVA::uint64 itemsCount);
+    void LoadJournal();
+    void SaveSnapshot();
+    void AppendJournal();
+    void AddJournalRecord(const DAVA::AssetCache::CacheItemKey& key, JournalOperation operation);
+
+    void InsertInFullCache(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry&& entry);
+    void RebuildLRU();
+    void RestoreBlobReferences();
+
     ServerCacheEntry* FindInFastCache(const DAVA::AssetCache::CacheItemKey& key) const;
     ServerCacheEntry* FindInFullCache(const DAVA::AssetCache::CacheItemKey& key);
     const ServerCacheEntry* FindInFullCache(const DAVA::AssetCache::CacheItemKey& key) const;
@@ -78,6 +122,8 @@ private:
 
     void NotifySizeChanged();
 
+    static DAVA::uint64 GetEntryIndexSize(const ServerCacheEntry& entry);
+
 private:
     CacheDBOwner& owner;
 
@@ -96,6 +142,21 @@ private:
     FastCacheMap fastCache; //runtime, week storage
     CacheMap fullCache; //stored on disk, strong storage
 
+    LRUList fastCacheLRU; //keys of fastCache, least recently used is first
+    LRUList fullCacheLRU; //keys of fullCache, least recently used is first
+
+    DAVA::FilePath cacheJournal; //path to journal of changes made after snapshot
+    JournalMap pendingJournal; //changes that are not written to journal yet
+    DAVA::uint64 journalRecordsCount = 0; //records in journal on disk
+    DAVA::uint64 journalID = 0; //id of journal that belongs to current snapshot
+    DAVA::uint32 snapshotVersion = 0; //version of loaded snapshot and its journal
+    bool needSnapshot = false; //snapshot is missing or has old format
+
+    BlobStorage blobStorage;
+
+    DAVA::uint64 entriesIndexSize = 0; //estimated size of containers owned by entries of fullCache
+    DAVA::uint64 fastCacheDataSize = 0; //size of loaded files of entries in fastCache
+
     std::atomic<bool> dbStateChanged; //flag about changes in db
 };
 
@@ -113,3 +174,8 @@ inline const DAVA::uint64 CacheDB::GetOccupiedSize() const
 {
     return occupiedSize;
 }
+
+inline const BlobStorage::Statistics& CacheDB::GetBlobStatistics() const
+{
+    return blobStorage.GetStatistics();
+}
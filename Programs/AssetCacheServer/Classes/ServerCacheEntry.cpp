@@ -1,6 +1,7 @@
 #include "ServerCacheEntry.h"
 
 #include "FileSystem/KeyedArchive.h"
+#include "FileSystem/File.h"
 
 #include "Debug/DVAssert.h"
 
@@ -15,7 +16,10 @@ ServerCacheEntry::ServerCacheEntry(const DAVA::AssetCache::CachedItemValue& _val
 
 ServerCacheEntry::ServerCacheEntry(ServerCacheEntry&& right)
     : value(std::move(right.value))
+    , blobs(std::move(right.blobs))
     , accessTimestamp(right.accessTimestamp)
+    , fullCachePosition(right.fullCachePosition)
+    , fastCachePosition(right.fastCachePosition)
 {
 }
 
@@ -24,7 +28,10 @@ ServerCacheEntry& ServerCacheEntry::operator=(ServerCacheEntry&& right)
     if (this != &right)
     {
         value = std::move(right.value);
+        blobs = std::move(right.blobs);
         accessTimestamp = right.accessTimestamp;
+        fullCachePosition = right.fullCachePosition;
+        fastCachePosition = right.fastCachePosition;
     }
 
     return (*this);
@@ -57,11 +64,119 @@ void ServerCacheEntry::Deserialize(DAVA::KeyedArchive* archieve)
     value.Deserialize(valueArchieve);
 }
 
+bool ServerCacheEntry::Serialize(DAVA::File* file) const
+{
+    DVASSERT(nullptr != file);
+
+    if (file->Write(&accessTimestamp) != sizeof(accessTimestamp))
+        return false;
+
+    if (value.Serialize(file, false) == false)
+        return false;
+
+    DAVA::uint32 blobsCount = static_cast<DAVA::uint32>(blobs.size());
+    if (file->Write(&blobsCount) != sizeof(blobsCount))
+        return false;
+
+    for (const BlobReference& blob : blobs)
+    {
+        if (file->Write(blob.id.digest.data(), DAVA::MD5::MD5Digest::DIGEST_SIZE) != DAVA::MD5::MD5Digest::DIGEST_SIZE)
+            return false;
+        if (file->Write(&blob.size) != sizeof(blob.size))
+            return false;
+    }
+
+    return true;
+}
+
+bool ServerCacheEntry::Deserialize(DAVA::File* file, bool withBlobs)
+{
+    DVASSERT(nullptr != file);
+
+    if (file->Read(&accessTimestamp) != sizeof(accessTimestamp))
+        return false;
+
+    if (value.Deserialize(file) == false)
+        return false;
+
+    if (withBlobs)
+    {
+        DAVA::uint32 blobsCount = 0;
+        if (file->Read(&blobsCount) != sizeof(blobsCount))
+            return false;
+
+        blobs.resize(blobsCount);
+        for (BlobReference& blob : blobs)
+        {
+            if (file->Read(blob.id.digest.data(), DAVA::MD5::MD5Digest::DIGEST_SIZE) != DAVA::MD5::MD5Digest::DIGEST_SIZE)
+                return false;
+            if (file->Read(&blob.size) != sizeof(blob.size))
+                return false;
+        }
+    }
+
+    return true;
+}
+
 bool ServerCacheEntry::Fetch(const DAVA::FilePath& folder)
 {
     return value.Fetch(folder);
 }
 
+bool ServerCacheEntry::Fetch(const DAVA::FilePath& folder, const BlobStorage& blobStorage)
+{
+    if (blobs.empty())
+    {
+        return value.Fetch(folder);
+    }
+
+    DVASSERT(blobs.size() == value.GetItemCount());
+
+    DAVA::uint32 index = 0;
+    return value.Fetch([this, &blobStorage, &index](const DAVA::String&) {
+        return blobStorage.GetBlobPath(blobs[index++].id);
+    });
+}
+
+bool ServerCacheEntry::StoreBlobs(BlobStorage& blobStorage)
+{
+    DVASSERT(blobs.empty());
+    DVASSERT(value.IsFetched());
+
+    blobs.reserve(value.GetItemCount());
+    for (const auto& file : value.GetDataContainer())
+    {
+        BlobReference blob;
+        if (file.second == nullptr || blobStorage.Add(*file.second, blob.id) == false)
+        {
+            ReleaseBlobs(blobStorage);
+            return false;
+        }
+
+        blob.size = file.second->size();
+        blobs.push_back(blob);
+    }
+
+    return true;
+}
+
+void ServerCacheEntry::ReleaseBlobs(BlobStorage& blobStorage)
+{
+    for (const BlobReference& blob : blobs)
+    {
+        blobStorage.Release(blob.id);
+    }
+    blobs.clear();
+}
+
+void ServerCacheEntry::RestoreBlobReferences(BlobStorage& blobStorage) const
+{
+    for (const BlobReference& blob : blobs)
+    {
+        blobStorage.AddReference(blob.id, blob.size);
+    }
+}
+
 void ServerCacheEntry::Free()
 {
     value.Free();
@@ -1,17 +1,23 @@
 #pragma once
 
+#include "BlobStorage.h"
+
 #include <AssetCache/CachedItemValue.h>
+#include <AssetCache/CacheItemKey.h>
 #include <Base/BaseTypes.h>
 #include <chrono>
 
 namespace DAVA
 {
 class KeyedArchive;
+class File;
 }
 
 class ServerCacheEntry final
 {
 public:
+    using LRUList = DAVA::List<DAVA::AssetCache::CacheItemKey>;
+
     ServerCacheEntry();
     explicit ServerCacheEntry(const DAVA::AssetCache::CachedItemValue& value);
 
@@ -28,19 +34,48 @@ public:
     void Serialize(DAVA::KeyedArchive* archieve) const;
     void Deserialize(DAVA::KeyedArchive* archieve);
 
+    bool Serialize(DAVA::File* file) const;
+    bool Deserialize(DAVA::File* file, bool withBlobs = true);
+
     void UpdateAccessTimestamp();
+    void SetAccessTimestamp(DAVA::uint64 timestamp);
     DAVA::uint64 GetTimestamp() const;
 
     DAVA::AssetCache::CachedItemValue& GetValue();
+    const DAVA::AssetCache::CachedItemValue& GetValue() const;
 
     bool Fetch(const DAVA::FilePath& folder);
+    bool Fetch(const DAVA::FilePath& folder, const BlobStorage& blobStorage);
     void Free();
 
+    /**
+        Moves files of fetched value to `blobStorage`. Returns false if any file can't be stored,
+        in this case entry doesn't reference any blob
+    */
+    bool StoreBlobs(BlobStorage& blobStorage);
+    void ReleaseBlobs(BlobStorage& blobStorage);
+    void RestoreBlobReferences(BlobStorage& blobStorage) const;
+
+    /** Returns true if files are stored in blob storage, otherwise they are stored in own folder of entry */
+    bool HasBlobs() const;
+
 private:
+    struct BlobReference
+    {
+        BlobStorage::BlobID id;
+        DAVA::uint64 size = 0;
+    };
+
     DAVA::AssetCache::CachedItemValue value;
+    DAVA::Vector<BlobReference> blobs; //in order of value data container
 
 private:
     DAVA::uint64 accessTimestamp = 0;
+
+    friend class CacheDB;
+    // Positions of entry in LRU lists of CacheDB. Are valid only while entry is stored in corresponding cache
+    LRUList::iterator fullCachePosition;
+    LRUList::iterator fastCachePosition;
 };
 
 inline void ServerCacheEntry::UpdateAccessTimestamp()
@@ -48,12 +83,27 @@ inline void ServerCacheEntry::UpdateAccessTimestamp()
     accessTimestamp = std::chrono::steady_clock::now().time_since_epoch().count();
 }
 
+inline void ServerCacheEntry::SetAccessTimestamp(DAVA::uint64 timestamp)
+{
+    accessTimestamp = timestamp;
+}
+
 inline DAVA::uint64 ServerCacheEntry::GetTimestamp() const
 {
     return accessTimestamp;
 }
 
+inline bool ServerCacheEntry::HasBlobs() const
+{
+    return !blobs.empty();
+}
+
 inline DAVA::AssetCache::CachedItemValue& ServerCacheEntry::GetValue()
 {
     return value;
 }
+
+inline const DAVA::AssetCache::CachedItemValue& ServerCacheEntry::GetValue() const
+{
+    return value;
+}
@@ -293,7 +293,7 @@ void ServerCore::ReconnectNow()
     ConnectRemote();
 }
 
-void ServerCore::OnServerStatusReceived()
+void ServerCore::OnServerStatusReceived(const DAVA::AssetCache::ServerStatus& status)
 {
     DVASSERT(remoteState == RemoteState::VERIFYING);
 
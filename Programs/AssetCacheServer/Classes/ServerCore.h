@@ -60,7 +60,7 @@ public:
 
     // ClientNetProxyListener
     void OnClientProxyStateChanged() override;
-    void OnServerStatusReceived() override;
+    void OnServerStatusReceived(const DAVA::AssetCache::ServerStatus& status) override;
     void OnIncorrectPacketReceived(DAVA::AssetCache::IncorrectPacketType) override;
 
     // CacheDBOwner
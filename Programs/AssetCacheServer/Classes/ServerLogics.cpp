@@ -225,7 +225,7 @@ void ServerLogics::OnChunkRequestedFromCache(const std::shared_ptr<DAVA::Net::IC
             else
             {
                 client.status = DataGetTask::WAITING_NEXT_CHUNK;
-                client.waitingChunk = chunkNumber;
+                client.waitingChunks.insert(chunkNumber);
             }
         }
     }
@@ -274,7 +274,19 @@ void ServerLogics::OnStatusRequested(const std::shared_ptr<DAVA::Net::IChannel>&
     hasIncomingRequestsRecently = true;
 
     DAVA::Logger::Debug("Received status request from channel %p", channel.get());
-    serverProxy->SendStatus(channel);
+
+    DAVA::AssetCache::ServerStatus status;
+    if (nullptr != dataBase)
+    {
+        CacheDB::MemoryUsage memoryUsage = dataBase->GetMemoryUsage();
+        status.itemsCount = memoryUsage.itemsCount;
+        status.itemsInMemoryCount = memoryUsage.itemsInMemoryCount;
+        status.dataInMemorySize = memoryUsage.dataInMemorySize;
+        status.indexMemorySize = memoryUsage.indexMemorySize;
+        status.occupiedSize = dataBase->GetOccupiedSize();
+        status.storageSize = dataBase->GetStorageSize();
+    }
+    serverProxy->SendStatus(channel, status);
 }
 
 void ServerLogics::OnChannelClosed(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::char8*)
@@ -472,7 +484,8 @@ void ServerLogics::SendChunkToClient(DataGetMap::iterator taskIt, const std::sha
 
     DAVA::Logger::Debug("Sending chunk #%u: %u bytes", chunkNumber, chunk.size());
     serverProxy->SendChunk(clientChannel, taskIt->first, task.bytesOverall, task.chunksOverall, chunkNumber, chunk);
-    client.status = DataGetTask::READY;
+    client.waitingChunks.erase(chunkNumber);
+    client.status = client.waitingChunks.empty() ? DataGetTask::READY : DataGetTask::WAITING_NEXT_CHUNK;
 
     if (chunkNumber + 1 == task.chunksOverall)
     {
@@ -489,7 +502,7 @@ void ServerLogics::SendChunkToClients(ServerLogics::DataGetMap::iterator taskIt,
 
     for (std::pair<std::shared_ptr<DAVA::Net::IChannel> const, DataGetTask::ClientStatus>& client : task.clients)
     {
-        if (client.second.status == DataGetTask::WAITING_NEXT_CHUNK && client.second.waitingChunk == chunkNumber)
+        if (client.second.status == DataGetTask::WAITING_NEXT_CHUNK && client.second.waitingChunks.count(chunkNumber) > 0)
         {
             SendChunkToClient(taskIt, client.first, chunkNumber, chunk);
         }
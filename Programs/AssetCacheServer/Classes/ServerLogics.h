@@ -46,7 +46,7 @@ private:
             {
             }
             DataRequestStatus status = DataRequestStatus::READY;
-            DAVA::uint32 waitingChunk = 0;
+            DAVA::Set<DAVA::uint32> waitingChunks; // client may pipeline requests for several chunks
             bool lastChunkWasSent = false;
         };
 
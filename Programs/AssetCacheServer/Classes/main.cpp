@@ -130,6 +130,7 @@ int DAVAMain(DAVA::Vector<DAVA::String> cmdLine)
 
     KeyedArchive* options = new KeyedArchive; // options will be placed into RefPtr inside of Engine
     options->SetBool("separate_net_thread", true);
+    options->SetUInt32("net_loops_count", 2); // clients server and connection to remote cache are served concurrently
 
     Engine e;
     e.Init(eEngineRunMode::CONSOLE_MODE, modules, options);
@@ -24,6 +24,7 @@ private:
     DAVA::String compressionStr;
     DAVA::Compressor::Type compressionType;
     bool dummyFileData = false;
+    DAVA::uint32 dictionaryMaxFileSize = 0;
     DAVA::String packFileName;
     DAVA::String baseDir;
     DAVA::String metaDbPath;
@@ -13,6 +13,7 @@ const DAVA::String Compression = "-compression";
 const DAVA::String BaseDir = "-basedir";
 const DAVA::String MetaDbFile = "-metadb";
 const DAVA::String DummyFileData = "-dummyFileData";
+const DAVA::String DictionaryMaxFileSize = "-dictionaryMaxFileSize";
 }
 
 ArchivePackTool::ArchivePackTool()
@@ -22,8 +23,9 @@ ArchivePackTool::ArchivePackTool()
 
     options.AddOption(OptionNames::Compression, VariantType(String("lz4hc")), "default compression method, lz4hc - default");
     options.AddOption(OptionNames::BaseDir, VariantType(String("")), "source base directory");
-    options.AddOption(OptionNames::MetaDbFile, VariantType(String("")), "sqlite db with metadata");
+    options.AddOption(OptionNames::MetaDbFile, VariantType(String("")), "sqlite db with metadata of DLC superpack, empty - all files of basedir are packed");
     options.AddOption(OptionNames::DummyFileData, VariantType(false), "write dummy single-byte files instead of actual file data, useful if you are interested in pack footer only");
+    options.AddOption(OptionNames::DictionaryMaxFileSize, VariantType(static_cast<uint32>(0)), "train shared dictionary and use it for files not bigger than this size in bytes, 0 - default, no dictionary, can't be used with metadb");
     options.AddArgument("packfile");
 }
 
@@ -39,8 +41,14 @@ bool ArchivePackTool::ConvertOptionsToParamsInternal()
         return false;
     }
     compressionType = static_cast<Compressor::Type>(type);
+    if (compressionType == Compressor::Type::Lz4Dictionary)
+    {
+        Logger::Error("Invalid compression type: '%s', use %s option instead", compressionStr.c_str(), OptionNames::DictionaryMaxFileSize.c_str());
+        return false;
+    }
 
     dummyFileData = options.GetOption(OptionNames::DummyFileData).AsBool();
+    dictionaryMaxFileSize = options.GetOption(OptionNames::DictionaryMaxFileSize).AsUInt32();
 
     baseDir = options.GetOption(OptionNames::BaseDir).AsString();
     if (baseDir.empty())
@@ -49,9 +57,9 @@ bool ArchivePackTool::ConvertOptionsToParamsInternal()
         return false;
     }
     metaDbPath = options.GetOption(OptionNames::MetaDbFile).AsString();
-    if (metaDbPath.empty())
+    if (!metaDbPath.empty() && dictionaryMaxFileSize > 0)
     {
-        Logger::Error("%s - param is not specified", OptionNames::MetaDbFile.c_str());
+        Logger::Error("%s can't be used with %s, files of superpack are downloaded one by one", OptionNames::DictionaryMaxFileSize.c_str(), OptionNames::MetaDbFile.c_str());
         return false;
     }
 
@@ -75,6 +83,7 @@ int ArchivePackTool::ProcessInternal()
     params.baseDirPath = (baseDir.empty() ? FileSystem::Instance()->GetCurrentWorkingDirectory() : baseDir);
     params.metaDbPath = metaDbPath;
     params.dummyFileData = dummyFileData;
+    params.dictionaryMaxFileSize = dictionaryMaxFileSize;
 
     if (!CreateArchive(params))
     {
@@ -8,12 +8,14 @@
 #include <Engine/Engine.h>
 #include <Compression/LZ4Compressor.h>
 #include <Compression/ZipCompressor.h>
+#include <Utils/CRC32.h>
 
 #include "ResultCodes.h"
 
 static int UnpackFile(const DAVA::FilePath& archivePath,
                       const DAVA::PackFormat::PackFile::FilesTableBlock::FilesData::Data& fileInfo,
                       const DAVA::String& relativeFilePath,
+                      const DAVA::Compressor* dictionaryCompressor,
                       const bool extractInDvplFormat);
 
 ArchiveUnpackTool::ArchiveUnpackTool()
@@ -99,7 +101,7 @@ int ArchiveUnpackTool::ProcessInternal()
                                             const auto& fileInfoFromArchive = packFile.filesTable.data.files[i];
                                             const auto& fileInfo = fileInfoBase[i];
 
-                                            if (UnpackFile(packFilename, fileInfoFromArchive, fileInfo.relativeFilePath, extractInDvplFormat) == OK)
+                                            if (UnpackFile(packFilename, fileInfoFromArchive, fileInfo.relativeFilePath, packArchive.GetDictionaryCompressor(), extractInDvplFormat) == OK)
                                             {
                                                 ++countExtractedFiles;
                                             }
@@ -135,6 +137,7 @@ int ArchiveUnpackTool::ProcessInternal()
 static int UnpackFile(const DAVA::FilePath& archivePath,
                       const DAVA::PackFormat::PackFile::FilesTableBlock::FilesData::Data& fileInfo,
                       const DAVA::String& relativeFilePath,
+                      const DAVA::Compressor* dictionaryCompressor,
                       const bool extractInDvplFormat)
 {
     using namespace DAVA;
@@ -176,6 +179,23 @@ static int UnpackFile(const DAVA::FilePath& archivePath,
         liteFooter.type = fileInfo.type;
         liteFooter.crc32Compressed = fileInfo.compressedCrc32;
         liteFooter.sizeCompressed = fileInfo.compressedSize;
+
+        if (fileInfo.type == Compressor::Type::Lz4Dictionary)
+        {
+            // *.dvpl can't reference pack dictionary, so recompress content without it
+            Vector<uint8> content(fileInfo.originalSize);
+            if (dictionaryCompressor == nullptr || !dictionaryCompressor->Decompress(compressedContent, content))
+            {
+                return ERROR_CANT_EXTRACT_FILE;
+            }
+            if (!LZ4HCCompressor().Compress(content, compressedContent))
+            {
+                return ERROR_CANT_EXTRACT_FILE;
+            }
+            liteFooter.type = Compressor::Type::Lz4HC;
+            liteFooter.crc32Compressed = CRC32::ForBuffer(compressedContent.data(), compressedContent.size());
+            liteFooter.sizeCompressed = static_cast<uint32>(compressedContent.size());
+        }
         liteFooter.sizeUncompressed = fileInfo.originalSize;
         liteFooter.packMarkerLite = PackFormat::FILE_MARKER_LITE;
         static_assert(sizeof(liteFooter) == 20, "format not changed");
@@ -227,6 +247,13 @@ static int UnpackFile(const DAVA::FilePath& archivePath,
             return ERROR_CANT_EXTRACT_FILE;
         }
         break;
+    case Compressor::Type::Lz4Dictionary:
+        content.resize(fileInfo.originalSize);
+        if (dictionaryCompressor == nullptr || !dictionaryCompressor->Decompress(compressedContent, content))
+        {
+            return ERROR_CANT_EXTRACT_FILE;
+        }
+        break;
     case Compressor::Type::RFC1951:
         content.resize(fileInfo.originalSize);
         if (!ZipCompressor().Decompress(compressedContent, content))
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <REPlatform/Global/CommandLineModule.h>
+
+#include <FileSystem/FilePath.h>
+#include <Reflection/ReflectionRegistrator.h>
+
+class PhysicsPrecookTool : public DAVA::CommandLineModule
+{
+public:
+    PhysicsPrecookTool(const DAVA::Vector<DAVA::String>& commandLine);
+
+private:
+    bool PostInitInternal() override;
+    eFrameResult OnFrameInternal() override;
+    void ShowHelpInternal() override;
+
+    bool PrecookScene(const DAVA::FilePath& scenePath);
+
+    DAVA::Vector<DAVA::FilePath> scenePathes;
+    DAVA::FilePath cachePath;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(PhysicsPrecookTool, DAVA::CommandLineModule)
+    {
+        DAVA::ReflectionRegistrator<PhysicsPrecookTool>::Begin()[DAVA::M::CommandName("-physicsprecook")]
+        .ConstructorByPointer<DAVA::Vector<DAVA::String>>()
+        .End();
+    }
+};
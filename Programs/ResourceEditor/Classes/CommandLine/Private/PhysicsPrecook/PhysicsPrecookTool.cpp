@@ -0,0 +1,157 @@
+#include "Classes/CommandLine/PhysicsPrecookTool.h"
+
+#include <REPlatform/CommandLine/OptionName.h>
+
+#include <TArc/Utils/ModuleCollection.h>
+
+#include <Base/ScopedPtr.h>
+#include <Engine/Engine.h>
+#include <Engine/EngineContext.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+#include <ModuleManager/ModuleManager.h>
+#include <Scene3D/Scene.h>
+#include <Utils/StringUtils.h>
+
+#include <Physics/PhysicsModule.h>
+#include <Physics/PhysicsSystem.h>
+
+namespace PhysicsPrecookToolDetails
+{
+using namespace DAVA;
+
+// Shapes are created by PhysicsSystem on the first frames after their entities were added into scene
+const uint32 SCENE_UPDATES_COUNT = 3;
+
+Vector<FilePath> ReadScenesListFile(const FilePath& listFilePath)
+{
+    Vector<FilePath> scenes;
+    ScopedPtr<File> listFile(File::Create(listFilePath, File::OPEN | File::READ));
+    if (listFile)
+    {
+        while (!listFile->IsEof())
+        {
+            String str = StringUtils::Trim(listFile->ReadLine());
+            if (!str.empty())
+            {
+                scenes.push_back(str);
+            }
+        }
+    }
+    else
+    {
+        Logger::Error("Can't open scenes listfile %s", listFilePath.GetAbsolutePathname().c_str());
+    }
+
+    return scenes;
+}
+}
+
+PhysicsPrecookTool::PhysicsPrecookTool(const DAVA::Vector<DAVA::String>& commandLine)
+    : CommandLineModule(commandLine, "-physicsprecook")
+{
+    using namespace DAVA;
+
+    options.AddOption(OptionName::ProcessFile, VariantType(String("")), "Full pathname to scene file *.sc2");
+    options.AddOption(OptionName::ProcessFileList, VariantType(String("")), "Full pathname to file with list of scenes");
+    options.AddOption(OptionName::OutFile, VariantType(String("")), "Full pathname to cooked meshes cache file. Existing file is updated");
+}
+
+bool PhysicsPrecookTool::PostInitInternal()
+{
+    using namespace DAVA;
+
+    FilePath scenesListPath = options.GetOption(OptionName::ProcessFileList).AsString();
+    if (scenesListPath.IsEmpty() == false)
+    {
+        scenePathes = PhysicsPrecookToolDetails::ReadScenesListFile(scenesListPath);
+    }
+
+    FilePath scenePath = options.GetOption(OptionName::ProcessFile).AsString();
+    if (scenePath.IsEmpty() == false)
+    {
+        scenePathes.push_back(scenePath);
+    }
+
+    if (scenePathes.empty())
+    {
+        Logger::Error("Scene was not set");
+        return false;
+    }
+
+    cachePath = options.GetOption(OptionName::OutFile).AsString();
+    if (cachePath.IsEmpty())
+    {
+        Logger::Error("Cache file was not set");
+        return false;
+    }
+
+    return true;
+}
+
+DAVA::ConsoleModule::eFrameResult PhysicsPrecookTool::OnFrameInternal()
+{
+    using namespace DAVA;
+
+    PhysicsModule* physicsModule = GetEngineContext()->moduleManager->GetModule<PhysicsModule>();
+    if (GetEngineContext()->fileSystem->Exists(cachePath))
+    {
+        physicsModule->LoadCookedMeshCache(cachePath);
+    }
+
+    for (const FilePath& scenePath : scenePathes)
+    {
+        if (PrecookScene(scenePath) == false)
+        {
+            result = Result::RESULT_ERROR;
+        }
+    }
+
+    if (physicsModule->SaveCookedMeshCache(cachePath) == false)
+    {
+        result = Result::RESULT_ERROR;
+    }
+
+    return ConsoleModule::eFrameResult::FINISHED;
+}
+
+bool PhysicsPrecookTool::PrecookScene(const DAVA::FilePath& scenePath)
+{
+    using namespace DAVA;
+
+    ScopedPtr<Scene> scene(new Scene());
+    if (scene->LoadScene(scenePath) != SceneFileV2::eError::ERROR_NO_ERROR)
+    {
+        Logger::Error("Cannot load scene %s", scenePath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    if (scene->physicsSystem == nullptr)
+    {
+        Logger::Error("Scene %s was created without physics system", scenePath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    Logger::Info("Precooking physics shapes of %s", scenePath.GetAbsolutePathname().c_str());
+
+    // Only shapes creation is required, bodies shouldn't move
+    scene->physicsSystem->SetSimulationEnabled(false);
+    for (uint32 i = 0; i < PhysicsPrecookToolDetails::SCENE_UPDATES_COUNT; ++i)
+    {
+        scene->Update(0.0f);
+    }
+
+    return true;
+}
+
+void PhysicsPrecookTool::ShowHelpInternal()
+{
+    CommandLineModule::ShowHelpInternal();
+
+    DAVA::Logger::Info("Examples:");
+    DAVA::Logger::Info("\t-physicsprecook -processfile /Users/Test/DataSource/3d/Maps/scene.sc2 -outfile /Users/Test/Data/physics.cooked");
+    DAVA::Logger::Info("\t-physicsprecook -processfilelist /Users/Test/scenes.txt -outfile /Users/Test/Data/physics.cooked");
+}
+
+DECL_TARC_MODULE(PhysicsPrecookTool);
@@ -32,6 +32,7 @@ void PrintUsage()
     printf("\t-t - asset cache timeout\n");
     printf("\t-postifx - trailing part of texture name\n");
     printf("\t-output - output folder for .../Project/Data/Gfx/\n");
+    printf("\t-threads - max number of folders packed in parallel, all worker threads are used by default\n");
 
     printf("\n");
     printf("ResourcePacker [src_dir] - will pack resources from src_dir\n");
@@ -138,6 +139,12 @@ void ProcessRecourcePacker(Engine& e)
     resourcePacker.SetTag(CommandLineParser::GetCommandParam("-tag"));
     resourcePacker.SetIgnoresFile(CommandLineParser::GetCommandParam("-ignore"));
 
+    String threadsStr = CommandLineParser::GetCommandParam("-threads");
+    if (threadsStr.empty() == false)
+    {
+        resourcePacker.SetMaxConcurrentTasks(static_cast<uint32>(atoi(threadsStr.c_str())));
+    }
+
     if (CommandLineParser::CommandIsFound(String("-md5mode")))
     {
         resourcePacker.RecalculateMD5ForOutputDir();
@@ -2,6 +2,7 @@
 
 #include <Engine/Engine.h>
 #include <DLC/Patcher/PatchFile.h>
+#include <DLC/Patcher/PackPatch.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/VariantType.h>
 #include <CommandLine/ProgramOptions.h>
@@ -67,6 +68,8 @@ int Process(Engine& e)
     DAVA::ProgramOptions listOptions("list");
     DAVA::ProgramOptions applyOptions("apply");
     DAVA::ProgramOptions applyAllOptions("apply-all");
+    DAVA::ProgramOptions writePackOptions("write-pack");
+    DAVA::ProgramOptions applyPackOptions("apply-pack");
 
     writeOptions.AddOption("-a", DAVA::VariantType(false), "Append patch to existing file.");
     writeOptions.AddOption("-nc", DAVA::VariantType(false), "Generate uncompressed patch.");
@@ -94,6 +97,17 @@ int Process(Engine& e)
     applyAllOptions.AddOption("-t", DAVA::VariantType(false), "Truncate patch file, when applying it.");
     applyAllOptions.AddOption("-v", DAVA::VariantType(false), "Verbose output.");
 
+    writePackOptions.AddOption("-nc", DAVA::VariantType(false), "Generate uncompressed diffs.");
+    writePackOptions.AddOption("-v", DAVA::VariantType(false), "Verbose output.");
+    writePackOptions.AddArgument("OriginalPack");
+    writePackOptions.AddArgument("NewPack");
+    writePackOptions.AddArgument("PatchFile");
+
+    applyPackOptions.AddOption("-v", DAVA::VariantType(false), "Verbose output.");
+    applyPackOptions.AddArgument("PatchFile");
+    applyPackOptions.AddArgument("OriginalPack");
+    applyPackOptions.AddArgument("NewPack");
+
     FileSystem* fileSystem = e.GetContext()->fileSystem;
 
     DocumentsDirectorySetup::SetApplicationDocDirectory(fileSystem, "ResourcePatcher");
@@ -346,16 +360,55 @@ int Process(Engine& e)
                 }
             }
         }
+        else if (command == writePackOptions.GetCommand())
+        {
+            paramsOk = writePackOptions.Parse(cmdLine);
+            if (paramsOk)
+            {
+                DAVA::FilePath origPath = writePackOptions.GetArgument("OriginalPack");
+                DAVA::FilePath newPath = writePackOptions.GetArgument("NewPack");
+                DAVA::FilePath patchPath = writePackOptions.GetArgument("PatchFile");
+                BSType bsType = writePackOptions.GetOption("-nc").AsBool() ? BS_PLAIN : BS_ZLIB;
+                bool verbose = writePackOptions.GetOption("-v").AsBool();
+
+                DAVA::PackPatchWriter patchWriter(bsType, verbose);
+                if (!patchWriter.Write(origPath, newPath, patchPath))
+                {
+                    printf("Error, while creating pack patch [%s] -> [%s].\n", origPath.GetRelativePathname().c_str(), newPath.GetRelativePathname().c_str());
+                    ret = 1;
+                }
+            }
+        }
+        else if (command == applyPackOptions.GetCommand())
+        {
+            paramsOk = applyPackOptions.Parse(cmdLine);
+            if (paramsOk)
+            {
+                DAVA::FilePath patchPath = applyPackOptions.GetArgument("PatchFile");
+                DAVA::FilePath origPath = applyPackOptions.GetArgument("OriginalPack");
+                DAVA::FilePath newPath = applyPackOptions.GetArgument("NewPack");
+                bool verbose = applyPackOptions.GetOption("-v").AsBool();
+
+                DAVA::PackPatchReader patchReader(patchPath, verbose);
+                if (!patchReader.Apply(origPath, newPath))
+                {
+                    printf("Error, while applying pack patch %s, error: %d\n", patchPath.GetRelativePathname().c_str(), patchReader.GetError());
+                    ret = 1;
+                }
+            }
+        }
     }
 
     if (!paramsOk)
     {
         printf("Usage: ResourcePatcher <command>\n");
-        printf("\n Commands: write, list, apply, apply-all\n\n");
+        printf("\n Commands: write, list, apply, apply-all, write-pack, apply-pack\n\n");
         printf("%s\n\n", writeOptions.GetUsageString().c_str());
         printf("%s\n\n", listOptions.GetUsageString().c_str());
         printf("%s\n\n", applyOptions.GetUsageString().c_str());
         printf("%s\n\n", applyAllOptions.GetUsageString().c_str());
+        printf("%s\n\n", writePackOptions.GetUsageString().c_str());
+        printf("%s\n\n", applyPackOptions.GetUsageString().c_str());
     }
 
     return ret;
@@ -0,0 +1,125 @@
+#include "UnitTests/UnitTests.h"
+
+#if defined(__DAVAENGINE_WIN32__) || defined(__DAVAENGINE_MACOS__)
+
+#include <AssetCache/CachePacket.h>
+#include <Utils/StringFormat.h>
+
+using namespace DAVA;
+
+namespace AssetCachePacketTestDetails
+{
+// data chunk packet: header, key, dataSize, numOfChunks, chunkNumber, chunkDataSize, compression, compressedSize, compressed data
+const size_t CHUNK_DATA_SIZE_OFFSET = sizeof(AssetCache::CachePacketHeader) + AssetCache::HASH_SIZE + sizeof(uint64) + sizeof(uint32) + sizeof(uint32);
+const size_t COMPRESSED_SIZE_OFFSET = CHUNK_DATA_SIZE_OFFSET + sizeof(uint32) + sizeof(uint8);
+const size_t COMPRESSED_DATA_OFFSET = COMPRESSED_SIZE_OFFSET + sizeof(uint32);
+
+Vector<uint8> MakeChunkData()
+{
+    String text;
+    for (uint32 i = 0; i < 200; ++i)
+    {
+        text += Format("line %u of chunk, that is compressed well\n", i);
+    }
+    return Vector<uint8>(text.begin(), text.end());
+}
+
+Vector<uint8> MakeCompressedPacket(const Vector<uint8>& chunkData)
+{
+    AssetCache::CacheItemKey key;
+    key.fill(0x5a);
+
+    AssetCache::GetChunkResponsePacket packet(key, chunkData.size(), 1, 0, chunkData, true);
+    const uint8* data = packet.serializationBuffer->GetData();
+    return Vector<uint8>(data, data + packet.serializationBuffer->GetSize());
+}
+
+uint32 ReadUInt32(const Vector<uint8>& rawPacket, size_t offset)
+{
+    uint32 value = 0;
+    Memcpy(&value, &rawPacket[offset], sizeof(value));
+    return value;
+}
+
+void WriteUInt32(Vector<uint8>& rawPacket, size_t offset, uint32 value)
+{
+    Memcpy(&rawPacket[offset], &value, sizeof(value));
+}
+
+AssetCache::CachePacket::CreateResult CreatePacket(const Vector<uint8>& rawPacket, std::unique_ptr<AssetCache::CachePacket>& packet)
+{
+    return AssetCache::CachePacket::Create(rawPacket.data(), static_cast<uint32>(rawPacket.size()), packet);
+}
+} // namespace AssetCachePacketTestDetails
+
+DAVA_TESTCLASS (AssetCachePacketTest)
+{
+    DAVA_TEST (CompressedChunkTest)
+    {
+        using namespace AssetCachePacketTestDetails;
+
+        const Vector<uint8> chunkData = MakeChunkData();
+        const Vector<uint8> rawPacket = MakeCompressedPacket(chunkData);
+        TEST_VERIFY(rawPacket.size() < chunkData.size());
+        TEST_VERIFY(ReadUInt32(rawPacket, CHUNK_DATA_SIZE_OFFSET) == chunkData.size());
+        TEST_VERIFY(ReadUInt32(rawPacket, COMPRESSED_SIZE_OFFSET) == rawPacket.size() - COMPRESSED_DATA_OFFSET);
+
+        std::unique_ptr<AssetCache::CachePacket> packet;
+        TEST_VERIFY(CreatePacket(rawPacket, packet) == AssetCache::CachePacket::CREATED);
+        TEST_VERIFY(packet && packet->type == AssetCache::PACKET_GET_CHUNK_RESPONSE);
+        if (packet && packet->type == AssetCache::PACKET_GET_CHUNK_RESPONSE)
+        {
+            AssetCache::GetChunkResponsePacket* chunkPacket = static_cast<AssetCache::GetChunkResponsePacket*>(packet.get());
+            TEST_VERIFY(chunkPacket->wasCompressed);
+            TEST_VERIFY(chunkPacket->chunkData == chunkData);
+        }
+    }
+
+    DAVA_TEST (TruncatedChunkTest)
+    {
+        using namespace AssetCachePacketTestDetails;
+
+        const Vector<uint8> chunkData = MakeChunkData();
+        const Vector<uint8> rawPacket = MakeCompressedPacket(chunkData);
+        const uint32 compressedSize = ReadUInt32(rawPacket, COMPRESSED_SIZE_OFFSET);
+        std::unique_ptr<AssetCache::CachePacket> packet;
+
+        // packet is shorter than declared compressed size
+        Vector<uint8> truncatedPacket(rawPacket.begin(), rawPacket.end() - compressedSize / 2);
+        TEST_VERIFY(CreatePacket(truncatedPacket, packet) == AssetCache::CachePacket::ERR_INCORRECT_DATA);
+        TEST_VERIFY(!packet);
+
+        // compressed stream is cut, but its size is consistent with packet
+        WriteUInt32(truncatedPacket, COMPRESSED_SIZE_OFFSET, compressedSize - compressedSize / 2);
+        TEST_VERIFY(CreatePacket(truncatedPacket, packet) == AssetCache::CachePacket::ERR_INCORRECT_DATA);
+        TEST_VERIFY(!packet);
+    }
+
+    DAVA_TEST (OversizedChunkTest)
+    {
+        using namespace AssetCachePacketTestDetails;
+
+        const Vector<uint8> chunkData = MakeChunkData();
+        const Vector<uint8> rawPacket = MakeCompressedPacket(chunkData);
+        const uint32 chunkDataSize = static_cast<uint32>(chunkData.size());
+        std::unique_ptr<AssetCache::CachePacket> packet;
+
+        // declared size is bigger than decoded data, so chunk doesn't fill it
+        Vector<uint8> wrongPacket = rawPacket;
+        WriteUInt32(wrongPacket, CHUNK_DATA_SIZE_OFFSET, chunkDataSize + 100);
+        TEST_VERIFY(CreatePacket(wrongPacket, packet) == AssetCache::CachePacket::ERR_INCORRECT_DATA);
+        TEST_VERIFY(!packet);
+
+        // declared size is smaller than decoded data, decoding doesn't write over it
+        WriteUInt32(wrongPacket, CHUNK_DATA_SIZE_OFFSET, chunkDataSize - 100);
+        TEST_VERIFY(CreatePacket(wrongPacket, packet) == AssetCache::CachePacket::ERR_INCORRECT_DATA);
+        TEST_VERIFY(!packet);
+
+        // declared size is beyond lz4 expansion limit, it's rejected before allocation
+        WriteUInt32(wrongPacket, CHUNK_DATA_SIZE_OFFSET, 0xfffffff0);
+        TEST_VERIFY(CreatePacket(wrongPacket, packet) == AssetCache::CachePacket::ERR_INCORRECT_DATA);
+        TEST_VERIFY(!packet);
+    }
+};
+
+#endif // defined(__DAVAENGINE_WIN32__) || defined(__DAVAENGINE_MACOS__)
@@ -0,0 +1,310 @@
+#include "UnitTests/UnitTests.h"
+
+#if defined(__DAVAENGINE_WIN32__) || defined(__DAVAENGINE_MACOS__)
+
+#include "CacheDB.h"
+
+#include <AssetCache/CachedItemValue.h>
+#include <AssetCache/CacheItemKey.h>
+#include <Engine/Engine.h>
+#include <FileSystem/FileSystem.h>
+#include <Utils/MD5.h>
+
+using namespace DAVA;
+
+namespace AssetCacheServerTestDetails
+{
+const FilePath TEST_FOLDER("~doc:/UnitTests/AssetCacheServerTest/");
+const String DB_FILE_NAME = "cache.dat";
+const String JOURNAL_FILE_NAME = "cache.journal";
+const String BLOBS_FOLDER_NAME = "blobs/";
+const uint64 STORAGE_SIZE = 64 * 1024 * 1024;
+const uint32 ITEMS_IN_MEMORY = 4;
+
+struct TestDBOwner : public CacheDBOwner
+{
+    void OnStorageSizeChanged(uint64 occupied, uint64 overall) override
+    {
+        occupiedSize = occupied;
+    }
+
+    uint64 occupiedSize = 0;
+};
+
+AssetCache::CacheItemKey MakeKey(uint32 index)
+{
+    MD5::MD5Digest digest;
+    MD5::ForData(reinterpret_cast<const uint8*>(&index), sizeof(index), digest);
+
+    AssetCache::CacheItemKey key;
+    key.SetPrimaryKey(digest);
+    key.SetSecondaryKey(digest);
+    return key;
+}
+
+Vector<uint8> MakeData(const String& content)
+{
+    return Vector<uint8>(content.begin(), content.end());
+}
+
+FilePath GetBlobPath(const FilePath& cacheFolder, const String& content)
+{
+    BlobStorage::BlobID blobID;
+    Vector<uint8> data = MakeData(content);
+    MD5::ForData(data.data(), static_cast<uint32>(data.size()), blobID);
+
+    BlobStorage storage;
+    storage.SetRootFolder(cacheFolder + BLOBS_FOLDER_NAME);
+    return storage.GetBlobPath(blobID);
+}
+
+AssetCache::CachedItemValue MakeValue(const String& content)
+{
+    AssetCache::CachedItemValue value;
+    value.Add("file.bin", std::make_shared<Vector<uint8>>(MakeData(content)));
+    return value;
+}
+
+bool HasContent(CacheDB& db, uint32 index, const String& content)
+{
+    ServerCacheEntry* entry = db.Get(MakeKey(index));
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    const AssetCache::CachedItemValue::ValueDataContainer& files = entry->GetValue().GetDataContainer();
+    auto found = files.find("file.bin");
+    return found != files.end() && found->second != nullptr && String(found->second->begin(), found->second->end()) == content;
+}
+} // namespace AssetCacheServerTestDetails
+
+DAVA_TESTCLASS (AssetCacheServerTest)
+{
+    AssetCacheServerTest()
+    {
+        GetEngineContext()->fileSystem->CreateDirectory(AssetCacheServerTestDetails::TEST_FOLDER, true);
+    }
+
+    ~AssetCacheServerTest()
+    {
+        GetEngineContext()->fileSystem->DeleteDirectory(AssetCacheServerTestDetails::TEST_FOLDER, true);
+    }
+
+    DAVA_TEST (JournalReplayTest)
+    {
+        using namespace AssetCacheServerTestDetails;
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        const FilePath folder = TEST_FOLDER + "journal/";
+        TestDBOwner owner;
+
+        {
+            CacheDB db(owner);
+            db.UpdateSettings(folder, STORAGE_SIZE, ITEMS_IN_MEMORY, 0);
+            TEST_VERIFY(fs->Exists(folder + DB_FILE_NAME));
+            TEST_VERIFY(!fs->Exists(folder + JOURNAL_FILE_NAME));
+
+            db.Insert(MakeKey(0), MakeValue("first item"));
+            db.Insert(MakeKey(1), MakeValue("second item"));
+            db.Insert(MakeKey(2), MakeValue("third item"));
+            TEST_VERIFY(db.Remove(MakeKey(1)));
+
+            // changes are appended to journal, snapshot is kept as is
+            db.Save();
+            TEST_VERIFY(fs->Exists(folder + JOURNAL_FILE_NAME));
+
+            // these changes are appended to journal on unload
+            db.Insert(MakeKey(3), MakeValue("fourth item"));
+            TEST_VERIFY(db.Remove(MakeKey(0)));
+        }
+
+        {
+            // empty snapshot and journal give state of cache before unload
+            CacheDB db(owner);
+            db.UpdateSettings(folder, STORAGE_SIZE, ITEMS_IN_MEMORY, 0);
+            TEST_VERIFY(db.GetMemoryUsage().itemsCount == 2);
+            TEST_VERIFY(db.GetOccupiedSize() == String("third item").size() + String("fourth item").size());
+            TEST_VERIFY(owner.occupiedSize == db.GetOccupiedSize());
+
+            TEST_VERIFY(db.Get(MakeKey(0)) == nullptr);
+            TEST_VERIFY(db.Get(MakeKey(1)) == nullptr);
+            TEST_VERIFY(HasContent(db, 2, "third item"));
+            TEST_VERIFY(HasContent(db, 3, "fourth item"));
+        }
+    }
+
+    DAVA_TEST (JournalCompactionTest)
+    {
+        using namespace AssetCacheServerTestDetails;
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        const FilePath folder = TEST_FOLDER + "compaction/";
+        TestDBOwner owner;
+
+        // journal is compacted into snapshot when it has more records than cache has items and than 4096
+        const uint32 itemsCount = 4100;
+        const uint32 removedCount = 10;
+        {
+            CacheDB db(owner);
+            db.UpdateSettings(folder, STORAGE_SIZE, ITEMS_IN_MEMORY, 0);
+
+            for (uint32 i = 0; i < itemsCount; ++i)
+            {
+                db.Insert(MakeKey(i), MakeValue("same content of every item"));
+            }
+            db.Save();
+            TEST_VERIFY(fs->Exists(folder + JOURNAL_FILE_NAME));
+
+            for (uint32 i = 0; i < removedCount; ++i)
+            {
+                TEST_VERIFY(db.Remove(MakeKey(i)));
+            }
+            db.Save();
+            TEST_VERIFY(!fs->Exists(folder + JOURNAL_FILE_NAME));
+            TEST_VERIFY(fs->Exists(folder + DB_FILE_NAME));
+        }
+
+        {
+            CacheDB db(owner);
+            db.UpdateSettings(folder, STORAGE_SIZE, ITEMS_IN_MEMORY, 0);
+            TEST_VERIFY(db.GetMemoryUsage().itemsCount == itemsCount - removedCount);
+            TEST_VERIFY(db.GetBlobStatistics().blobsCount == 1);
+            TEST_VERIFY(db.GetBlobStatistics().referencesCount == itemsCount - removedCount);
+            TEST_VERIFY(db.Get(MakeKey(removedCount - 1)) == nullptr);
+            TEST_VERIFY(HasContent(db, removedCount, "same content of every item"));
+        }
+    }
+
+    DAVA_TEST (LRUEvictionOrderTest)
+    {
+        using namespace AssetCacheServerTestDetails;
+
+        const FilePath folder = TEST_FOLDER + "lru/";
+        const uint32 itemSize = 100;
+        TestDBOwner owner;
+
+        // storage takes three items, every insert over it evicts least recently used item
+        CacheDB db(owner);
+        db.UpdateSettings(folder, itemSize * 3 + itemSize / 2, ITEMS_IN_MEMORY, 0);
+        for (uint32 i = 0; i < 3; ++i)
+        {
+            db.Insert(MakeKey(i), MakeValue(String(itemSize, static_cast<char8>('a' + i))));
+        }
+
+        TEST_VERIFY(db.Get(MakeKey(0)) != nullptr); // order: 1, 2, 0
+        db.Insert(MakeKey(3), MakeValue(String(itemSize, 'd'))); // order: 2, 0, 3
+        TEST_VERIFY(db.Get(MakeKey(1)) == nullptr);
+
+        db.UpdateAccessTimestamp(MakeKey(2)); // order: 0, 3, 2
+        db.Insert(MakeKey(4), MakeValue(String(itemSize, 'e'))); // order: 3, 2, 4
+        TEST_VERIFY(db.Get(MakeKey(0)) == nullptr);
+
+        TEST_VERIFY(db.GetMemoryUsage().itemsCount == 3);
+        TEST_VERIFY(db.GetOccupiedSize() == itemSize * 3);
+        TEST_VERIFY(HasContent(db, 2, String(itemSize, 'c')));
+        TEST_VERIFY(HasContent(db, 3, String(itemSize, 'd')));
+        TEST_VERIFY(HasContent(db, 4, String(itemSize, 'e')));
+    }
+
+    DAVA_TEST (BlobRefCountTest)
+    {
+        using namespace AssetCacheServerTestDetails;
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        const FilePath folder = TEST_FOLDER + "refcount/";
+        const String content = "content of two identical files";
+
+        BlobStorage storage;
+        storage.SetRootFolder(folder + BLOBS_FOLDER_NAME);
+
+        BlobStorage::BlobID firstID;
+        BlobStorage::BlobID secondID;
+        TEST_VERIFY(storage.Add(MakeData(content), firstID));
+        TEST_VERIFY(storage.Add(MakeData(content), secondID));
+        TEST_VERIFY(firstID == secondID);
+        TEST_VERIFY(storage.GetStatistics().blobsCount == 1);
+        TEST_VERIFY(storage.GetStatistics().storedSize == content.size());
+        TEST_VERIFY(storage.GetStatistics().referencesCount == 2);
+        TEST_VERIFY(storage.GetStatistics().referencedSize == content.size() * 2);
+
+        const FilePath blobPath = storage.GetBlobPath(firstID);
+        TEST_VERIFY(fs->Exists(blobPath));
+
+        storage.Release(firstID);
+        TEST_VERIFY(fs->Exists(blobPath));
+        TEST_VERIFY(storage.GetStatistics().blobsCount == 1);
+
+        storage.Release(secondID);
+        TEST_VERIFY(!fs->Exists(blobPath));
+        TEST_VERIFY(storage.GetStatistics().blobsCount == 0);
+        TEST_VERIFY(storage.GetStatistics().storedSize == 0);
+    }
+
+    DAVA_TEST (DeduplicatedItemsTest)
+    {
+        using namespace AssetCacheServerTestDetails;
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        const FilePath folder = TEST_FOLDER + "dedup/";
+        const String content = "content of two identical files";
+        const FilePath blobPath = GetBlobPath(folder, content);
+        TestDBOwner owner;
+
+        // two items with identical files share one blob and take place of one file
+        CacheDB db(owner);
+        db.UpdateSettings(folder, STORAGE_SIZE, ITEMS_IN_MEMORY, 0);
+        db.Insert(MakeKey(0), MakeValue(content));
+        db.Insert(MakeKey(1), MakeValue(content));
+        TEST_VERIFY(db.GetBlobStatistics().blobsCount == 1);
+        TEST_VERIFY(db.GetBlobStatistics().referencesCount == 2);
+        TEST_VERIFY(db.GetOccupiedSize() == content.size());
+        TEST_VERIFY(fs->Exists(blobPath));
+
+        // blob is kept while any item references it
+        TEST_VERIFY(db.Remove(MakeKey(0)));
+        TEST_VERIFY(db.GetBlobStatistics().blobsCount == 1);
+        TEST_VERIFY(db.GetOccupiedSize() == content.size());
+        TEST_VERIFY(fs->Exists(blobPath));
+        TEST_VERIFY(HasContent(db, 1, content));
+
+        TEST_VERIFY(db.Remove(MakeKey(1)));
+        TEST_VERIFY(db.GetBlobStatistics().blobsCount == 0);
+        TEST_VERIFY(db.GetOccupiedSize() == 0);
+        TEST_VERIFY(!fs->Exists(blobPath));
+    }
+
+    DAVA_TEST (UnreferencedBlobsSweepTest)
+    {
+        using namespace AssetCacheServerTestDetails;
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        const FilePath folder = TEST_FOLDER + "sweep/";
+        const String savedContent = "content of saved item";
+        const String lostContent = "content of item that wasn't saved";
+        TestDBOwner owner;
+
+        {
+            CacheDB db(owner);
+            db.UpdateSettings(folder, STORAGE_SIZE, ITEMS_IN_MEMORY, 0);
+            db.Insert(MakeKey(0), MakeValue(savedContent));
+        }
+
+        // blob is written, but item referencing it isn't, like if server was stopped before save
+        BlobStorage lostStorage;
+        lostStorage.SetRootFolder(folder + BLOBS_FOLDER_NAME);
+        BlobStorage::BlobID lostID;
+        TEST_VERIFY(lostStorage.Add(MakeData(lostContent), lostID));
+        TEST_VERIFY(fs->Exists(GetBlobPath(folder, lostContent)));
+
+        CacheDB db(owner);
+        db.UpdateSettings(folder, STORAGE_SIZE, ITEMS_IN_MEMORY, 0);
+        TEST_VERIFY(!fs->Exists(GetBlobPath(folder, lostContent)));
+        TEST_VERIFY(fs->Exists(GetBlobPath(folder, savedContent)));
+        TEST_VERIFY(db.GetBlobStatistics().blobsCount == 1);
+        TEST_VERIFY(db.GetOccupiedSize() == savedContent.size());
+        TEST_VERIFY(HasContent(db, 0, savedContent));
+    }
+};
+
+#endif // defined(__DAVAENGINE_WIN32__) || defined(__DAVAENGINE_MACOS__)
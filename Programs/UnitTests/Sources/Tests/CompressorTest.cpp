@@ -60,4 +60,41 @@ DAVA_TESTCLASS (CompressorTest)
             TEST_VERIFY(uncompressedZip == in);
         }
     }
+
+    DAVA_TEST (TestLZ4Dictionary)
+    {
+        const String text = "format: tex\nsize: 256 256\nmipmaps: true\ncompression: PVR\n";
+        Vector<uint8> dictionary;
+        for (uint32 i = 0; i < 16; ++i)
+        {
+            dictionary.insert(dictionary.end(), text.begin(), text.end());
+        }
+
+        const String fileText = "format: tex\nsize: 128 256\nmipmaps: false\ncompression: PVR\n";
+        const Vector<uint8> in(fileText.begin(), fileText.end());
+
+        LZ4DictionaryCompressor lz4dict(dictionary);
+
+        Vector<uint8> compressedWithDictionary;
+        Vector<uint8> compressedLz4hc;
+        TEST_VERIFY(lz4dict.Compress(in, compressedWithDictionary));
+        TEST_VERIFY(LZ4HCCompressor().Compress(in, compressedLz4hc));
+        TEST_VERIFY(compressedWithDictionary.size() < compressedLz4hc.size());
+
+        // second compression uses primed context again
+        Vector<uint8> compressedAgain;
+        TEST_VERIFY(lz4dict.Compress(in, compressedAgain));
+        TEST_VERIFY(compressedAgain == compressedWithDictionary);
+
+        Vector<uint8> uncompressed(in.size(), '\0');
+        TEST_VERIFY(lz4dict.Decompress(compressedWithDictionary, uncompressed));
+        TEST_VERIFY(uncompressed == in);
+
+        // compressed data references dictionary, so other dictionary of the same size gives other content
+        Vector<uint8> wrongDictionary(dictionary.rbegin(), dictionary.rend());
+        TEST_VERIFY(wrongDictionary != dictionary);
+        Vector<uint8> uncompressedWithWrongDictionary(in.size(), '\0');
+        LZ4DictionaryCompressor(wrongDictionary).Decompress(compressedWithDictionary, uncompressedWithWrongDictionary);
+        TEST_VERIFY(uncompressedWithWrongDictionary != in);
+    }
 };
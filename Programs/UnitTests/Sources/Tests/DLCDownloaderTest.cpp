@@ -328,6 +328,49 @@ DAVA_TESTCLASS (DLCDownloaderTest)
         allTasks.clear();
     }
 
+    DAVA_TEST (SegmentedDownloadTest)
+    {
+        using namespace DAVA;
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        std::unique_ptr<DLCDownloader> downloader(DLCDownloader::Create());
+        String url = URL;
+
+        FilePath path("~doc:/segmented_tmp_file_from_server.remove.me");
+        fs->DeleteFile(path);
+        String p = path.GetAbsolutePathname();
+        String statePath = p + ".segments";
+
+        const uint32 crc32 = 0x89D4BC4E;
+
+        DLCDownloader::ITask* task = downloader->StartSegmentedTask(url, p, DLCDownloader::Range(), 4, crc32);
+        TEST_VERIFY(task != nullptr);
+        downloader->WaitTask(task);
+
+        const DLCDownloader::TaskInfo& info = downloader->GetTaskInfo(task);
+        const DLCDownloader::TaskStatus& status = downloader->GetTaskStatus(task);
+        TEST_VERIFY(info.type == DLCDownloader::TaskType::SEGMENTED);
+        TEST_VERIFY(info.segmentsCount == 4);
+        TEST_VERIFY(status.error.errorHappened == false);
+        TEST_VERIFY(status.sizeDownloaded == FULL_SIZE_ON_SERVER);
+        TEST_VERIFY(status.sizeTotal == FULL_SIZE_ON_SERVER);
+        downloader->RemoveTask(task);
+
+        TEST_VERIFY(CRC32::ForFile(p) == crc32);
+        TEST_VERIFY(!fs->IsFile(statePath));
+
+        // wrong checksum - file is removed
+        task = downloader->StartSegmentedTask(url, p, DLCDownloader::Range(0, FULL_SIZE_ON_SERVER), 4, crc32 + 1);
+        downloader->WaitTask(task);
+        const DLCDownloader::TaskStatus& statusWrongCrc = downloader->GetTaskStatus(task);
+        TEST_VERIFY(statusWrongCrc.error.errorHappened == true);
+        TEST_VERIFY(statusWrongCrc.error.crc32Mismatch == true);
+        downloader->RemoveTask(task);
+
+        TEST_VERIFY(!fs->IsFile(path));
+        TEST_VERIFY(!fs->IsFile(statePath));
+    }
+
     DAVA_TEST (ISP_return_internalErrorPageTest)
     {
         using namespace DAVA;
@@ -0,0 +1,162 @@
+#include <DLCManager/DLCManager.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+#include <Engine/Engine.h>
+#include <EmbeddedWebServer/EmbeddedWebServer.h>
+#include <Time/SystemTimer.h>
+
+#include "UnitTests/UnitTests.h"
+
+#include <atomic>
+
+#ifndef __DAVAENGINE_WIN_UAP__
+
+namespace DLCManagerCoalescedTestDetails
+{
+const DAVA::String superPackUrl("http://127.0.0.1:8484/superpack_for_unittests.dvpk");
+const DAVA::String wwwDirStr("~doc:/UnitTests/DLCManagerCoalescedTest/local_www/");
+const DAVA::String dlcDirStr("~doc:/UnitTests/DLCManagerCoalescedTest/dlc_dir/");
+const DAVA::String packName("0"); // pack without dependencies
+
+std::atomic<DAVA::uint32> httpRequestsCount(0);
+
+int CountRequest(mg_connection*)
+{
+    httpRequestsCount++;
+    return 0; // let web server send file
+}
+}
+
+DAVA_TESTCLASS (DLCManagerCoalescedTest)
+{
+    DAVA::DLCManager* dlcManager = nullptr;
+    bool packRequested = false;
+    bool finished = false;
+    DAVA::uint64 lastDownloaded = 0;
+    DAVA::float32 timeLeft = 60.f; // seconds
+
+    bool TestComplete(const DAVA::String& testName) const override
+    {
+        if (testName == "CoalescedDownloadTest")
+        {
+            return finished;
+        }
+        return true;
+    }
+
+    void Update(DAVA::float32 timeElapsed, const DAVA::String& testName) override
+    {
+        using namespace DAVA;
+        using namespace DLCManagerCoalescedTestDetails;
+
+        if (testName != "CoalescedDownloadTest" || finished)
+        {
+            return;
+        }
+
+        timeLeft -= SystemTimer::GetRealFrameDelta();
+        if (timeLeft <= 0.f)
+        {
+            TEST_VERIFY(false && "timeout of coalesced download");
+            Finish();
+            return;
+        }
+
+        if (!dlcManager->IsInitialized())
+        {
+            return;
+        }
+
+        if (!packRequested)
+        {
+            // count only requests of pack files, not of superpack meta
+            httpRequestsCount = 0;
+            TEST_VERIFY(dlcManager->RequestPack(packName) != nullptr);
+            packRequested = true;
+            return;
+        }
+
+        DLCManager::Progress progress = dlcManager->GetPacksProgress({ packName });
+        TEST_VERIFY(progress.alreadyDownloaded >= lastDownloaded);
+        TEST_VERIFY(progress.alreadyDownloaded <= progress.total);
+        lastDownloaded = progress.alreadyDownloaded;
+
+        if (dlcManager->IsPackDownloaded(packName))
+        {
+            TEST_VERIFY(progress.alreadyDownloaded == progress.total);
+
+            uint32 filesCount = 0;
+            for (const FilePath& path : GetEngineContext()->fileSystem->EnumerateFilesInDirectory(FilePath(dlcDirStr)))
+            {
+                if (path.GetExtension() == ".dvpl")
+                {
+                    ++filesCount;
+                }
+            }
+
+            uint32 requestsCount = httpRequestsCount.load();
+            Logger::Info("[DLCManagerCoalescedTest] files: %u, http requests: %u", filesCount, requestsCount);
+            TEST_VERIFY(filesCount > 1);
+            TEST_VERIFY(requestsCount > 0);
+            TEST_VERIFY(requestsCount < filesCount);
+            Finish();
+        }
+    }
+
+    void Finish()
+    {
+        using namespace DAVA;
+        using namespace DLCManagerCoalescedTestDetails;
+
+        dlcManager->Deinitialize();
+        DLCManager::Destroy(dlcManager);
+        dlcManager = nullptr;
+        StopEmbeddedWebServer();
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        fs->DeleteDirectory(FilePath(dlcDirStr));
+        fs->DeleteDirectory(FilePath(wwwDirStr));
+        finished = true;
+    }
+
+    DAVA_TEST (CoalescedDownloadTest)
+    {
+        using namespace DAVA;
+        using namespace DLCManagerCoalescedTestDetails;
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        FilePath wwwDir(wwwDirStr);
+        FilePath dlcDir(dlcDirStr);
+        fs->DeleteDirectory(wwwDir);
+        fs->DeleteDirectory(dlcDir);
+        fs->CreateDirectory(wwwDir, true);
+
+        const FilePath srcPath = "~res:/TestData/DLCManagerFullTest/superpack_for_unittests.dvpk";
+        if (!fs->CopyFile(srcPath, wwwDir + "superpack_for_unittests.dvpk", true))
+        {
+            Logger::Error("can't copy super pack for unittest from res:/");
+            TEST_VERIFY(false);
+            finished = true;
+            return;
+        }
+
+        if (!StartEmbeddedWebServer(wwwDir.GetAbsolutePathname().c_str(), "8484", &CountRequest))
+        {
+            TEST_VERIFY(false && "can't start embedded web server");
+            finished = true;
+            return;
+        }
+
+        DLCManager::Hints hints;
+        hints.logFilePath = "~doc:/coalesced_dlc_log.txt";
+        // every coalesced range and every small file is downloaded with exactly one http request
+        hints.downloaderChunkBufSize = hints.coalesceMaxRangeSize;
+        hints.segmentedDownloadMinSize = 0;
+
+        dlcManager = DLCManager::Create();
+        dlcManager->Initialize(dlcDir, superPackUrl, hints);
+        dlcManager->SetRequestingEnabled(true);
+    }
+};
+
+#endif // !__DAVAENGINE_WIN_UAP__
@@ -0,0 +1,102 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Render/2D/Private/FTGlyphAtlas.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (FTGlyphAtlasTest)
+{
+    FTFont* font = nullptr;
+
+    FTGlyphAtlasTest()
+    {
+        font = FTFont::Create("~res:/Fonts/DejaVuSans.ttf");
+        DVASSERT(font);
+    }
+
+    ~FTGlyphAtlasTest()
+    {
+        SafeRelease(font);
+    }
+
+    DAVA_TEST (GlyphPlacementsTest)
+    {
+        const WideString text = L"Hello world";
+        Vector<FTFont::GlyphPlacement> placements;
+        font->DrawStringToGlyphs(20.f, placements, 0, 0, 0, 0, text);
+
+        TEST_VERIFY(placements.size() == text.size());
+        for (size_t i = 1; i < placements.size(); ++i)
+        {
+            TEST_VERIFY(placements[i].x > placements[i - 1].x);
+            TEST_VERIFY(placements[i].y == placements[0].y);
+        }
+    }
+
+    DAVA_TEST (GlyphsAreRasterizedOnceTest)
+    {
+        const WideString text = L"Hello world";
+        Vector<FTFont::GlyphPlacement> placements;
+        font->DrawStringToGlyphs(20.f, placements, 0, 0, 0, 0, text);
+
+        FTGlyphAtlas atlas(256, 256);
+        for (const FTFont::GlyphPlacement& placement : placements)
+        {
+            const FTGlyphAtlas::Glyph* glyph = atlas.GetGlyph(font, 20.f, placement.glyphIndex);
+            TEST_VERIFY(glyph != nullptr);
+            if (glyph != nullptr && glyph->width > 0)
+            {
+                TEST_VERIFY(glyph->uvMin.x >= 0.f && glyph->uvMin.y >= 0.f);
+                TEST_VERIFY(glyph->uvMax.x <= 1.f && glyph->uvMax.y <= 1.f);
+                TEST_VERIFY(glyph->uvMin.x < glyph->uvMax.x && glyph->uvMin.y < glyph->uvMax.y);
+            }
+        }
+
+        // "Hello world" has 8 different characters including space
+        TEST_VERIFY(atlas.GetGlyphsCount() == 8);
+        TEST_VERIFY(atlas.GetRasterizedGlyphsCount() == 8);
+
+        for (const FTFont::GlyphPlacement& placement : placements)
+        {
+            atlas.GetGlyph(font, 20.f, placement.glyphIndex);
+        }
+        TEST_VERIFY(atlas.GetRasterizedGlyphsCount() == 8);
+
+        // Other size is a different glyph
+        atlas.GetGlyph(font, 30.f, placements[0].glyphIndex);
+        TEST_VERIFY(atlas.GetRasterizedGlyphsCount() == 9);
+
+        atlas.Clear();
+        TEST_VERIFY(atlas.GetGlyphsCount() == 0);
+    }
+
+    DAVA_TEST (ShelvesValidityTest)
+    {
+        Vector<FTFont::GlyphPlacement> placements;
+        font->DrawStringToGlyphs(20.f, placements, 0, 0, 0, 0, L"Hello");
+
+        FTGlyphAtlas atlas(256, 256);
+        Vector<uint32> usedShelves;
+        for (const FTFont::GlyphPlacement& placement : placements)
+        {
+            const FTGlyphAtlas::Glyph* glyph = atlas.GetGlyph(font, 20.f, placement.glyphIndex);
+            if (glyph != nullptr && glyph->shelfIndex != FTGlyphAtlas::INVALID_SHELF)
+            {
+                usedShelves.push_back(glyph->shelfIndex);
+            }
+        }
+        uint32 builtGeneration = atlas.GetGeneration();
+        TEST_VERIFY(!usedShelves.empty());
+        TEST_VERIFY(atlas.AreShelvesValid(builtGeneration, usedShelves));
+
+        // Adding glyphs doesn't invalidate glyphs already placed
+        atlas.GetGlyph(font, 40.f, placements[0].glyphIndex);
+        TEST_VERIFY(atlas.AreShelvesValid(builtGeneration, usedShelves));
+
+        atlas.Clear();
+        TEST_VERIFY(atlas.GetGeneration() != builtGeneration);
+        TEST_VERIFY(!atlas.AreShelvesValid(builtGeneration, usedShelves));
+        TEST_VERIFY(atlas.AreShelvesValid(atlas.GetGeneration(), {}));
+    }
+};
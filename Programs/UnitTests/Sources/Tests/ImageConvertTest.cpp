@@ -0,0 +1,210 @@
+#include "UnitTests/UnitTests.h"
+
+#include <Base/BaseTypes.h>
+#include <Functional/Function.h>
+#include <Logger/Logger.h>
+#include <Render/Image/ImageConvert.h>
+#include <Time/SystemTimer.h>
+
+using namespace DAVA;
+
+namespace ImageConvertTestDetails
+{
+void FillPattern(Vector<uint8>& data, uint32 seed)
+{
+    uint32 value = seed * 2654435761u + 1;
+    for (uint8& byte : data)
+    {
+        value = value * 1664525u + 1013904223u;
+        byte = static_cast<uint8>(value >> 24);
+    }
+}
+
+struct Conversion
+{
+    PixelFormat inFormat;
+    PixelFormat outFormat;
+    uint32 inPixelSize;
+    uint32 outPixelSize;
+    Function<void(const void*, uint32, uint32, uint32, void*, uint32)> scalarConvert;
+};
+
+template <class TYPE_IN, class TYPE_OUT, typename CONVERT_FUNC>
+Function<void(const void*, uint32, uint32, uint32, void*, uint32)> MakeScalarConvert()
+{
+    return [](const void* inData, uint32 width, uint32 height, uint32 inPitch, void* outData, uint32 outPitch) {
+        ConvertDirect<TYPE_IN, TYPE_OUT, CONVERT_FUNC> convert;
+        convert(inData, width, height, inPitch, outData, width, height, outPitch);
+    };
+}
+
+Vector<Conversion> GetConversions()
+{
+    return {
+        { FORMAT_BGRA8888, FORMAT_RGBA8888, 4, 4, MakeScalarConvert<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888>() },
+        { FORMAT_RGB888, FORMAT_RGBA8888, 3, 4, MakeScalarConvert<RGB888, uint32, ConvertRGB888toRGBA8888>() },
+        { FORMAT_BGR888, FORMAT_RGBA8888, 3, 4, MakeScalarConvert<BGR888, uint32, ConvertBGR888toRGBA8888>() },
+        { FORMAT_BGR888, FORMAT_RGB888, 3, 3, MakeScalarConvert<BGR888, RGB888, ConvertBGR888toRGB888>() },
+        { FORMAT_RGBA8888, FORMAT_RGB888, 4, 3, MakeScalarConvert<uint32, RGB888, ConvertRGBA8888toRGB888>() }
+    };
+}
+
+void ScalarDownscale(PixelFormat format, const Vector<uint8>& in, uint32 inWidth, uint32 inHeight, Vector<uint8>& out)
+{
+    if (format == FORMAT_RGBA8888)
+    {
+        ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> convert;
+        convert(in.data(), inWidth, inHeight, inWidth * 4, out.data(), inWidth / 2, inHeight / 2, inWidth / 2 * 4);
+    }
+    else
+    {
+        ConvertDownscaleTwiceBillinear<uint8, uint8, uint32, UnpackA8, PackA8> convert;
+        convert(in.data(), inWidth, inHeight, inWidth, out.data(), inWidth / 2, inHeight / 2, inWidth / 2);
+    }
+}
+}
+
+DAVA_TESTCLASS (ImageConvertTest)
+{
+    // sizes cover row tails of vector kernels and images split into rows for worker jobs
+    const Vector<Size2i> sizes = { Size2i(1, 1), Size2i(5, 3), Size2i(17, 9), Size2i(63, 31), Size2i(64, 64), Size2i(1030, 600) };
+
+    DAVA_TEST (ConvertMatchesScalarFunctorsTest)
+    {
+        using namespace ImageConvertTestDetails;
+
+        for (const Conversion& conversion : GetConversions())
+        {
+            for (const Size2i& size : sizes)
+            {
+                const uint32 width = static_cast<uint32>(size.dx);
+                const uint32 height = static_cast<uint32>(size.dy);
+
+                Vector<uint8> in(width * height * conversion.inPixelSize);
+                FillPattern(in, width + height);
+
+                Vector<uint8> expected(width * height * conversion.outPixelSize, 0);
+                Vector<uint8> converted(width * height * conversion.outPixelSize, 0);
+
+                conversion.scalarConvert(in.data(), width, height, width * conversion.inPixelSize, expected.data(), width * conversion.outPixelSize);
+                bool result = ImageConvert::ConvertImageDirect(conversion.inFormat, conversion.outFormat,
+                                                               in.data(), width, height, width * conversion.inPixelSize,
+                                                               converted.data(), width, height, width * conversion.outPixelSize);
+                TEST_VERIFY(result);
+                TEST_VERIFY(converted == expected);
+            }
+        }
+    }
+
+    DAVA_TEST (SwapRedBlueInPlaceTest)
+    {
+        using namespace ImageConvertTestDetails;
+
+        for (const Size2i& size : sizes)
+        {
+            const uint32 width = static_cast<uint32>(size.dx);
+            const uint32 height = static_cast<uint32>(size.dy);
+
+            Vector<uint8> rgba(width * height * 4);
+            FillPattern(rgba, width * height);
+            Vector<uint8> expected(rgba.size());
+            MakeScalarConvert<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888>()(rgba.data(), width, height, width * 4, expected.data(), width * 4);
+            ImageConvert::SwapRedBlueChannels(FORMAT_RGBA8888, rgba.data(), width, height, width * 4);
+            TEST_VERIFY(rgba == expected);
+
+            Vector<uint8> rgb(width * height * 3);
+            FillPattern(rgb, width * height);
+            expected.resize(rgb.size());
+            MakeScalarConvert<BGR888, RGB888, ConvertBGR888toRGB888>()(rgb.data(), width, height, width * 3, expected.data(), width * 3);
+            ImageConvert::SwapRedBlueChannels(FORMAT_RGB888, rgb.data(), width, height, width * 3);
+            TEST_VERIFY(rgb == expected);
+        }
+    }
+
+    DAVA_TEST (DownscaleMatchesScalarFunctorsTest)
+    {
+        using namespace ImageConvertTestDetails;
+
+        for (PixelFormat format : { FORMAT_RGBA8888, FORMAT_A8 })
+        {
+            const uint32 pixelSize = (format == FORMAT_RGBA8888) ? 4 : 1;
+            for (const Size2i& size : sizes)
+            {
+                const uint32 inWidth = static_cast<uint32>(size.dx) * 2;
+                const uint32 inHeight = static_cast<uint32>(size.dy) * 2;
+                const uint32 outWidth = inWidth / 2;
+                const uint32 outHeight = inHeight / 2;
+
+                Vector<uint8> in(inWidth * inHeight * pixelSize);
+                FillPattern(in, inWidth);
+
+                Vector<uint8> expected(outWidth * outHeight * pixelSize, 0);
+                Vector<uint8> downscaled(outWidth * outHeight * pixelSize, 0);
+
+                ScalarDownscale(format, in, inWidth, inHeight, expected);
+                bool result = ImageConvert::DownscaleTwiceBillinear(format, format, in.data(), inWidth, inHeight, inWidth * pixelSize,
+                                                                    downscaled.data(), outWidth, outHeight, outWidth * pixelSize, false);
+                TEST_VERIFY(result);
+                TEST_VERIFY(downscaled == expected);
+            }
+        }
+    }
+
+    DAVA_TEST (ConvertBenchmark)
+    {
+        using namespace ImageConvertTestDetails;
+
+        const uint32 width = 2048;
+        const uint32 height = 2048;
+        const uint32 MEASURED_RUNS = 5;
+
+        Vector<uint8> in(width * height * 4);
+        FillPattern(in, 0);
+        Vector<uint8> out(width * height * 4);
+
+        for (const Conversion& conversion : GetConversions())
+        {
+            int64 startUs = SystemTimer::GetUs();
+            for (uint32 i = 0; i < MEASURED_RUNS; ++i)
+            {
+                conversion.scalarConvert(in.data(), width, height, width * conversion.inPixelSize, out.data(), width * conversion.outPixelSize);
+            }
+            int64 scalarUs = (SystemTimer::GetUs() - startUs) / MEASURED_RUNS;
+
+            startUs = SystemTimer::GetUs();
+            for (uint32 i = 0; i < MEASURED_RUNS; ++i)
+            {
+                ImageConvert::ConvertImageDirect(conversion.inFormat, conversion.outFormat, in.data(), width, height, width * conversion.inPixelSize,
+                                                 out.data(), width, height, width * conversion.outPixelSize);
+            }
+            int64 convertUs = (SystemTimer::GetUs() - startUs) / MEASURED_RUNS;
+
+            Logger::Info("[ImageConvertTest] %s -> %s %ux%u: functors %.2f ms, ImageConvert %.2f ms",
+                         PixelFormatDescriptor::GetPixelFormatString(conversion.inFormat), PixelFormatDescriptor::GetPixelFormatString(conversion.outFormat),
+                         width, height, scalarUs / 1000.f, convertUs / 1000.f);
+        }
+
+        for (PixelFormat format : { FORMAT_RGBA8888, FORMAT_A8 })
+        {
+            const uint32 pixelSize = (format == FORMAT_RGBA8888) ? 4 : 1;
+
+            int64 startUs = SystemTimer::GetUs();
+            for (uint32 i = 0; i < MEASURED_RUNS; ++i)
+            {
+                ScalarDownscale(format, in, width, height, out);
+            }
+            int64 scalarUs = (SystemTimer::GetUs() - startUs) / MEASURED_RUNS;
+
+            startUs = SystemTimer::GetUs();
+            for (uint32 i = 0; i < MEASURED_RUNS; ++i)
+            {
+                ImageConvert::DownscaleTwiceBillinear(format, format, in.data(), width, height, width * pixelSize,
+                                                      out.data(), width / 2, height / 2, width / 2 * pixelSize, false);
+            }
+            int64 downscaleUs = (SystemTimer::GetUs() - startUs) / MEASURED_RUNS;
+
+            Logger::Info("[ImageConvertTest] downscale %s %ux%u: functors %.2f ms, ImageConvert %.2f ms",
+                         PixelFormatDescriptor::GetPixelFormatString(format), width, height, scalarUs / 1000.f, downscaleUs / 1000.f);
+        }
+    }
+};
@@ -87,6 +87,42 @@ DAVA_TESTCLASS (JobManagerTest)
         // ...
     }
 
+    DAVA_TEST (TestParallelFor)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        // every element is visited exactly once, including last incomplete chunk and range of one chunk
+        for (uint32 count : { 0u, 1u, 7u, 64u, 1000u, 100003u })
+        {
+            Vector<std::atomic<uint32>> visits(count);
+            std::atomic<uint32> wrongChunks(0);
+
+            jobManager->ParallelFor(count, 64, [&visits, &wrongChunks](uint32 begin, uint32 end) {
+                if (begin >= end || end - begin > 64)
+                {
+                    wrongChunks++;
+                }
+                for (uint32 i = begin; i < end; ++i)
+                {
+                    visits[i]++;
+                }
+            });
+
+            bool visitedOnce = std::all_of(visits.begin(), visits.end(), [](const std::atomic<uint32>& v) { return v.load() == 1; });
+            TEST_VERIFY(visitedOnce);
+            TEST_VERIFY(wrongChunks.load() == 0);
+        }
+
+        // ParallelFor can be called from chunk of another one
+        std::atomic<uint32> processed(0);
+        jobManager->ParallelFor(16, 1, [jobManager, &processed](uint32, uint32) {
+            jobManager->ParallelFor(256, 16, [&processed](uint32 begin, uint32 end) {
+                processed += end - begin;
+            });
+        });
+        TEST_VERIFY(processed.load() == 16 * 256);
+    }
+
     void ThreadFunc(JobManagerTestData * data)
     {
         for (uint32 i = 0; i < JOBS_COUNT; i++)
@@ -3,6 +3,7 @@
 
 #include "Network/Base/IPAddress.h"
 #include "Network/Base/Endpoint.h"
+#include "Network/Base/IOLoop.h"
 
 #include "Network/NetConfig.h"
 #include "Network/NetService.h"
@@ -232,6 +233,76 @@ private:
     size_t pendingDelivered = 0; // Parcel index expected to be confirmed as delivered
 };
 
+// Sends many small packets referencing the same buffer and measures time until all of them are delivered
+class TestThroughputClient : public DAVA::Net::NetService
+{
+public:
+    static const size_t PACKET_SIZE = 64;
+    static const size_t PACKET_COUNT = 20000;
+
+    TestThroughputClient()
+        : packet(PACKET_SIZE, 'T')
+    {
+    }
+
+    void ChannelOpen() override
+    {
+        startTime = SystemTimer::GetUs();
+        for (size_t i = 0; i < PACKET_COUNT; ++i)
+        {
+            Send(packet.data(), packet.size());
+        }
+    }
+    void OnPacketDelivered(const std::shared_ptr<IChannel>& channel, uint32 packetId) override
+    {
+        packetsDelivered += 1;
+        if (PACKET_COUNT == packetsDelivered)
+        {
+            elapsedTime = SystemTimer::GetUs() - startTime;
+            testDone = true;
+        }
+    }
+
+    bool IsTestDone() const
+    {
+        return testDone;
+    }
+    int64 ElapsedTime() const
+    {
+        return elapsedTime;
+    }
+
+private:
+    Vector<uint8> packet;
+    bool testDone = false;
+    size_t packetsDelivered = 0;
+    int64 startTime = 0;
+    int64 elapsedTime = 0;
+};
+
+class TestThroughputServer : public DAVA::Net::NetService
+{
+public:
+    void OnPacketReceived(const std::shared_ptr<IChannel>& channel, const void* buffer, size_t length) override
+    {
+        packetsRecieved += 1;
+        bytesRecieved += length;
+    }
+
+    size_t PacketsRecieved() const
+    {
+        return packetsRecieved;
+    }
+    size_t BytesRecieved() const
+    {
+        return bytesRecieved;
+    }
+
+private:
+    size_t packetsRecieved = 0;
+    size_t bytesRecieved = 0;
+};
+
 DAVA_TESTCLASS (NetworkTest)
 {
     //BEGIN_FILES_COVERED_BY_TESTS( )
@@ -244,21 +315,29 @@ DAVA_TESTCLASS (NetworkTest)
 
     enum eServiceTypes
     {
-        SERVICE_ECHO = 1000
+        SERVICE_ECHO = 1000,
+        SERVICE_THROUGHPUT = 1001
     };
 
     enum
     {
         ECHO_SERVER_CONTEXT,
-        ECHO_CLIENT_CONTEXT
+        ECHO_CLIENT_CONTEXT,
+        THROUGHPUT_SERVER_CONTEXT,
+        THROUGHPUT_CLIENT_CONTEXT
     };
 
     static const uint16 ECHO_PORT = 55101;
+    static const uint16 THROUGHPUT_PORT = 55102;
 
     bool echoTestDone = false;
     TestEchoServer echoServer;
     TestEchoClient echoClient;
 
+    bool throughputTestDone = false;
+    TestThroughputServer throughputServer;
+    TestThroughputClient throughputClient;
+
     NetCore::TrackId serverId = NetCore::INVALID_TRACK_ID;
     NetCore::TrackId clientId = NetCore::INVALID_TRACK_ID;
 
@@ -278,13 +357,28 @@ DAVA_TESTCLASS (NetworkTest)
                 TEST_VERIFY(echoServer.BytesRecieved() == echoClient.BytesRecieved());
             }
         }
+        else if (testName == "TestThroughput")
+        {
+            throughputTestDone = throughputClient.IsTestDone();
+            if (throughputTestDone)
+            {
+                TEST_VERIFY(throughputServer.PacketsRecieved() == TestThroughputClient::PACKET_COUNT);
+                TEST_VERIFY(throughputServer.BytesRecieved() == TestThroughputClient::PACKET_COUNT * TestThroughputClient::PACKET_SIZE);
+
+                float64 seconds = Max(throughputClient.ElapsedTime(), int64(1)) / 1000000.0;
+                float64 megabytes = throughputServer.BytesRecieved() / (1024.0 * 1024.0);
+                Logger::Info("NetworkTest: %u packets of %u bytes delivered in %.1f ms, %.0f packets/s, %.2f MB/s",
+                             uint32(TestThroughputClient::PACKET_COUNT), uint32(TestThroughputClient::PACKET_SIZE),
+                             seconds * 1000.0, TestThroughputClient::PACKET_COUNT / seconds, megabytes / seconds);
+            }
+        }
 
         TestClass::Update(timeElapsed, testName);
     }
 
     void TearDown(const String& testName) override
     {
-        if (testName == "TestEcho")
+        if (testName == "TestEcho" || testName == "TestThroughput")
         {
             // Check whether DestroyControllerBlocked() really blocks until controller is destroyed
             size_t nactive = NetCore::Instance()->ControllersCount();
@@ -305,6 +399,10 @@ DAVA_TESTCLASS (NetworkTest)
         {
             return echoTestDone;
         }
+        else if (testName == "TestThroughput")
+        {
+            return throughputTestDone;
+        }
         return true;
     }
 
@@ -374,6 +472,37 @@ DAVA_TESTCLASS (NetworkTest)
         TEST_VERIFY(3 == config2.Services().size());
     }
 
+    DAVA_TEST (TestIOLoopCrossPosting)
+    {
+        const uint32 postsCount = 100;
+        IOLoop loopA(false);
+        IOLoop loopB(false);
+        std::atomic<uint32> handledByB{ 0 };
+
+        RefPtr<Thread> threadB(Thread::Create([&loopB]() { loopB.Run(); }));
+        threadB->Start();
+
+        // Handlers running in loop A post handlers into loop B running in other thread
+        for (uint32 i = 0; i < postsCount; ++i)
+        {
+            loopA.Post([&loopB, &handledByB]() { loopB.Post([&handledByB]() { ++handledByB; }); });
+        }
+        loopA.Post([&loopA, &loopB]() {
+            loopB.Post([&loopB]() { loopB.PostQuit(); });
+            loopA.PostQuit();
+        });
+
+        loopA.Run();
+        threadB->Join();
+
+        TEST_VERIFY(handledByB == postsCount);
+        TEST_VERIFY(loopA.GetPostedHandlersCount() == postsCount + 1);
+        TEST_VERIFY(loopA.GetExecutedHandlersCount() == postsCount + 1);
+        TEST_VERIFY(loopB.GetPostedHandlersCount() == postsCount + 1);
+        TEST_VERIFY(loopB.GetExecutedHandlersCount() == postsCount + 1);
+        TEST_VERIFY(loopB.GetAsyncWakeupsCount() >= 1);
+    }
+
     DAVA_TEST (TestEcho)
     {
         NetCore::Instance()->RegisterService(SERVICE_ECHO, MakeFunction(this, &NetworkTest::CreateEcho), MakeFunction(this, &NetworkTest::DeleteEcho));
@@ -389,12 +518,30 @@ DAVA_TESTCLASS (NetworkTest)
         clientId = NetCore::Instance()->CreateController(clientConfig, reinterpret_cast<void*>(ECHO_CLIENT_CONTEXT));
     }
 
+    DAVA_TEST (TestThroughput)
+    {
+        NetCore::Instance()->RegisterService(SERVICE_THROUGHPUT, MakeFunction(this, &NetworkTest::CreateEcho), MakeFunction(this, &NetworkTest::DeleteEcho));
+
+        NetConfig serverConfig(SERVER_ROLE);
+        serverConfig.AddTransport(TRANSPORT_TCP, Endpoint(THROUGHPUT_PORT));
+        serverConfig.AddService(SERVICE_THROUGHPUT);
+
+        NetConfig clientConfig = serverConfig.Mirror(IPAddress("127.0.0.1"));
+
+        serverId = NetCore::Instance()->CreateController(serverConfig, reinterpret_cast<void*>(THROUGHPUT_SERVER_CONTEXT));
+        clientId = NetCore::Instance()->CreateController(clientConfig, reinterpret_cast<void*>(THROUGHPUT_CLIENT_CONTEXT));
+    }
+
     IChannelListener* CreateEcho(uint32 serviceId, void* context)
     {
         if (ECHO_SERVER_CONTEXT == reinterpret_cast<intptr_t>(context))
             return &echoServer;
         else if (ECHO_CLIENT_CONTEXT == reinterpret_cast<intptr_t>(context))
             return &echoClient;
+        else if (THROUGHPUT_SERVER_CONTEXT == reinterpret_cast<intptr_t>(context))
+            return &throughputServer;
+        else if (THROUGHPUT_CLIENT_CONTEXT == reinterpret_cast<intptr_t>(context))
+            return &throughputClient;
         return nullptr;
     }
 
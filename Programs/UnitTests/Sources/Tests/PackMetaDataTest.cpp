@@ -0,0 +1,88 @@
+#include "UnitTests/UnitTests.h"
+
+#include <FileSystem/Private/PackMetaData.h>
+#include <Utils/StringFormat.h>
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (PackMetaDataTest)
+{
+    DAVA_TEST (FileNamesTreeFindTest)
+    {
+        // '\0' separated names like in superpack file table
+        String fileNames;
+        Vector<String> paths;
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            paths.push_back(Format("Data/3d/Maps/map_%02u/landscape/%u.tex", i % 7, i));
+        }
+        paths.push_back("Data/a.txt");
+        paths.push_back("Data/a.txt.bak");
+        paths.push_back("z");
+
+        for (const String& path : paths)
+        {
+            fileNames += path;
+            fileNames += '\0';
+        }
+
+        FileNamesTree tree;
+        tree.Build(fileNames);
+
+        TEST_VERIFY(tree.GetCount() == paths.size());
+        for (uint32 i = 0; i < paths.size(); ++i)
+        {
+            TEST_VERIFY(tree.Find(paths[i]));
+            TEST_VERIFY(tree.FindIndex(paths[i]) == i);
+        }
+
+        TEST_VERIFY(!tree.Find("Data/a"));
+        TEST_VERIFY(!tree.Find("Data/a.txt.ba"));
+        TEST_VERIFY(!tree.Find("Data/3d/Maps/map_00/landscape/1.tex"));
+        TEST_VERIFY(!tree.Find("A"));
+        TEST_VERIFY(!tree.Find("zz"));
+        TEST_VERIFY(tree.FindIndex("Data") == FileNamesTree::NOT_FOUND);
+    }
+
+    DAVA_TEST (FileNamesTreeDirectoryTest)
+    {
+        FileNamesTree tree;
+        tree.Add("Data/3d/Maps/map_00/landscape/0.tex");
+        tree.Add("Data/3d/Maps.txt");
+        tree.Add("Data/a.txt");
+        tree.Build();
+
+        // directories of files are known as before, though they have no index
+        TEST_VERIFY(tree.Find("Data"));
+        TEST_VERIFY(tree.Find("Data/"));
+        TEST_VERIFY(tree.Find("Data/3d/Maps"));
+        TEST_VERIFY(tree.Find("Data/3d/Maps/map_00/landscape"));
+        TEST_VERIFY(tree.FindIndex("Data/3d/Maps") == FileNamesTree::NOT_FOUND);
+
+        // only whole path elements match
+        TEST_VERIFY(!tree.Find("Dat"));
+        TEST_VERIFY(!tree.Find("Data/3d/Map"));
+        TEST_VERIFY(!tree.Find("Data/a"));
+        TEST_VERIFY(!tree.Find("Data/a.txt/"));
+        TEST_VERIFY(!tree.Find("Data/3d/Maps/map_01"));
+        TEST_VERIFY(!tree.Find("Data/3d/Maps/map_00/landscape/0.tex/b"));
+    }
+
+    DAVA_TEST (FileNamesTreeAddTest)
+    {
+        FileNamesTree tree;
+        tree.Add("b/c.txt");
+        tree.Add("a/b.txt");
+        tree.Add("b/c.txt");
+        tree.Build();
+
+        TEST_VERIFY(tree.GetCount() == 2);
+        TEST_VERIFY(tree.FindIndex("b/c.txt") == 0);
+        TEST_VERIFY(tree.FindIndex("a/b.txt") == 1);
+        TEST_VERIFY(!tree.Find("a/c.txt"));
+
+        FileNamesTree empty;
+        empty.Build();
+        TEST_VERIFY(!empty.Find("a/b.txt"));
+    }
+};
@@ -0,0 +1,217 @@
+#include "UnitTests/UnitTests.h"
+
+#include <DLC/Patcher/PackPatch.h>
+#include <FileSystem/FileSystem.h>
+#include <FileSystem/Private/PackArchive.h>
+#include <FileSystem/Private/PackFormatSpec.h>
+#include <Compression/LZ4Compressor.h>
+#include <Utils/CRC32.h>
+#include <Utils/StringFormat.h>
+#include <Logger/Logger.h>
+#include <Engine/Engine.h>
+
+using namespace DAVA;
+
+namespace PackPatchTestDetails
+{
+const FilePath TEST_FOLDER("~doc:/UnitTests/PackPatchTest/");
+
+using PackContent = Vector<std::pair<String, String>>;
+
+// Writes pack with uncompressed files in given order and without metadata
+bool WritePack(const FilePath& path, const PackContent& content)
+{
+    PackFormat::PackFile::FooterBlock footer;
+    Vector<PackFormat::FileTableEntry> entries;
+    Vector<uint8> names;
+
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        return false;
+    }
+
+    uint64 position = 0;
+    for (const auto& nameAndData : content)
+    {
+        const String& data = nameAndData.second;
+        const uint32 size = static_cast<uint32>(data.size());
+        if (file->Write(data.data(), size) != size)
+        {
+            return false;
+        }
+
+        PackFormat::FileTableEntry entry = {};
+        entry.startPosition = position;
+        entry.compressedSize = size;
+        entry.originalSize = size;
+        entry.compressedCrc32 = CRC32::ForBuffer(data.data(), data.size());
+        entry.originalCrc32 = entry.compressedCrc32;
+        entry.type = Compressor::Type::None;
+        entries.push_back(entry);
+        position += size;
+
+        names.insert(names.end(), nameAndData.first.begin(), nameAndData.first.end());
+        names.push_back('\0');
+    }
+
+    Vector<uint8> compressedNames;
+    if (!LZ4HCCompressor().Compress(names, compressedNames))
+    {
+        return false;
+    }
+    const uint32 compressedNamesCrc32 = CRC32::ForBuffer(compressedNames);
+
+    Vector<uint8> filesTable(entries.size() * sizeof(PackFormat::FileTableEntry));
+    std::copy_n(reinterpret_cast<const uint8*>(entries.data()), filesTable.size(), filesTable.data());
+    filesTable.insert(filesTable.end(), compressedNames.begin(), compressedNames.end());
+    const uint8* crcBytes = reinterpret_cast<const uint8*>(&compressedNamesCrc32);
+    filesTable.insert(filesTable.end(), crcBytes, crcBytes + sizeof(compressedNamesCrc32));
+
+    footer.info.numFiles = static_cast<uint32>(entries.size());
+    footer.info.namesSizeCompressed = static_cast<uint32>(compressedNames.size());
+    footer.info.namesSizeOriginal = static_cast<uint32>(names.size());
+    footer.info.filesTableSize = static_cast<uint32>(filesTable.size());
+    footer.info.filesTableCrc32 = CRC32::ForBuffer(filesTable);
+    footer.info.packArchiveMarker = PackFormat::FILE_MARKER;
+    footer.infoCrc32 = CRC32::ForBuffer(&footer.info, sizeof(footer.info));
+
+    const uint32 filesTableSize = static_cast<uint32>(filesTable.size());
+    return file->Write(filesTable.data(), filesTableSize) == filesTableSize &&
+    file->Write(&footer, sizeof(footer)) == sizeof(footer);
+}
+
+String MakeText(uint32 linesCount, uint32 seed)
+{
+    String text;
+    for (uint32 i = 0; i < linesCount; ++i)
+    {
+        text += Format("line %u of file %u: some text which is similar in every line\n", i, seed);
+    }
+    return text;
+}
+} // namespace PackPatchTestDetails
+
+DAVA_TESTCLASS (PackPatchTest)
+{
+    PackPatchTest()
+    {
+        GetEngineContext()->fileSystem->CreateDirectory(PackPatchTestDetails::TEST_FOLDER, true);
+    }
+
+    ~PackPatchTest()
+    {
+        GetEngineContext()->fileSystem->DeleteDirectory(PackPatchTestDetails::TEST_FOLDER, true);
+    }
+
+    DAVA_TEST (WriteApplyRoundTripTest)
+    {
+        using namespace PackPatchTestDetails;
+
+        const String sameData = MakeText(100, 1);
+        const String movedData = MakeText(100, 2);
+        const String origChangedData = MakeText(1000, 3);
+        String newChangedData = origChangedData;
+        newChangedData.replace(newChangedData.size() / 2, 4, "CHANGED");
+        const String removedData = MakeText(100, 4);
+        const String addedData = MakeText(100, 5);
+
+        // files are reordered, so reused ones are placed at other offsets in new pack
+        const PackContent origContent = {
+            { "Data/same.txt", sameData },
+            { "Data/moved.txt", movedData },
+            { "Data/changed.txt", origChangedData },
+            { "Data/removed.txt", removedData }
+        };
+        const PackContent newContent = {
+            { "Data/added.txt", addedData },
+            { "Data/changed.txt", newChangedData },
+            { "Data/Other/moved.txt", movedData },
+            { "Data/same.txt", sameData }
+        };
+
+        const FilePath origPack = TEST_FOLDER + "orig.dvpk";
+        const FilePath newPack = TEST_FOLDER + "new.dvpk";
+        const FilePath patchPath = TEST_FOLDER + "pack.patch";
+        const FilePath patchedPack = TEST_FOLDER + "patched.dvpk";
+        TEST_VERIFY(WritePack(origPack, origContent));
+        TEST_VERIFY(WritePack(newPack, newContent));
+
+        PackPatchWriter writer(BS_ZLIB);
+        TEST_VERIFY(writer.Write(origPack, newPack, patchPath));
+
+        const PackPatchWriter::Stats& stats = writer.GetStats();
+        TEST_VERIFY(stats.copiedFiles == 2);
+        TEST_VERIFY(stats.diffedFiles == 1);
+        TEST_VERIFY(stats.storedFiles == 1);
+
+        uint64 newPackSize = 0;
+        TEST_VERIFY(GetEngineContext()->fileSystem->GetFileSize(newPack, newPackSize));
+        TEST_VERIFY(stats.patchSize < newPackSize);
+
+        PackPatchReader reader(patchPath);
+        TEST_VERIFY(reader.Apply(origPack, patchedPack));
+        TEST_VERIFY(reader.GetError() == PackPatchReader::ERROR_NO);
+        TEST_VERIFY(CRC32::ForFile(patchedPack) == CRC32::ForFile(newPack));
+
+        try
+        {
+            RefPtr<File> file(File::Create(patchedPack, File::OPEN | File::READ));
+            PackArchive archive(file, patchedPack);
+            TEST_VERIFY(!archive.HasFile("Data/removed.txt"));
+            TEST_VERIFY(!archive.HasFile("Data/moved.txt"));
+            for (const auto& nameAndData : newContent)
+            {
+                Vector<uint8> data;
+                TEST_VERIFY(archive.LoadFile(nameAndData.first, data));
+                TEST_VERIFY(String(data.begin(), data.end()) == nameAndData.second);
+            }
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Error("%s", ex.what());
+            TEST_VERIFY(false && "can't open patched pack");
+        }
+
+        // patch is applied in place, already patched pack is kept as is
+        TEST_VERIFY(reader.Apply(origPack, origPack));
+        TEST_VERIFY(CRC32::ForFile(origPack) == CRC32::ForFile(newPack));
+        TEST_VERIFY(reader.Apply(origPack, origPack));
+    }
+
+    DAVA_TEST (CorruptedPatchTest)
+    {
+        using namespace PackPatchTestDetails;
+
+        const FilePath origPack = TEST_FOLDER + "corrupted_orig.dvpk";
+        const FilePath newPack = TEST_FOLDER + "corrupted_new.dvpk";
+        const FilePath patchPath = TEST_FOLDER + "corrupted.patch";
+        const FilePath patchedPack = TEST_FOLDER + "corrupted_patched.dvpk";
+        TEST_VERIFY(WritePack(origPack, { { "a.txt", MakeText(1000, 1) } }));
+        TEST_VERIFY(WritePack(newPack, { { "a.txt", MakeText(1000, 2) } }));
+
+        PackPatchWriter writer(BS_ZLIB);
+        TEST_VERIFY(writer.Write(origPack, newPack, patchPath));
+        TEST_VERIFY(writer.GetStats().diffedFiles == 1);
+
+        // diff operation of first file declares diff bigger than patch itself, it's rejected before allocation
+        // header: signature, version, origSize, origCRC, newSize, newCRC, operationsCount
+        // diff operation: type, origOffset, origSize, newSize, diffSize
+        const size_t headerSize = 15 + sizeof(uint32) + sizeof(uint64) + sizeof(uint32) + sizeof(uint64) + sizeof(uint32) + sizeof(uint32);
+        const size_t diffSizeOffset = headerSize + sizeof(uint8) + sizeof(uint64) + sizeof(uint32) + sizeof(uint32);
+        const uint32 hugeDiffSize = 0xfffffff0;
+
+        Vector<uint8> patchData;
+        TEST_VERIFY(GetEngineContext()->fileSystem->ReadFileContents(patchPath, patchData));
+        TEST_VERIFY(patchData.size() > diffSizeOffset + sizeof(hugeDiffSize));
+        Memcpy(&patchData[diffSizeOffset], &hugeDiffSize, sizeof(hugeDiffSize));
+        ScopedPtr<File> file(File::Create(patchPath, File::CREATE | File::WRITE));
+        TEST_VERIFY(file->Write(patchData.data(), static_cast<uint32>(patchData.size())) == patchData.size());
+        file.reset();
+
+        PackPatchReader reader(patchPath);
+        TEST_VERIFY(!reader.Apply(origPack, patchedPack));
+        TEST_VERIFY(reader.GetError() == PackPatchReader::ERROR_CORRUPTED);
+        TEST_VERIFY(!GetEngineContext()->fileSystem->Exists(patchedPack));
+    }
+};
@@ -0,0 +1,142 @@
+#include "UnitTests/UnitTests.h"
+
+#include <Concurrency/Thread.h>
+#include <Debug/ProfilerCPU.h>
+#include <Engine/Engine.h>
+#include <FileSystem/FileSystem.h>
+
+#include <atomic>
+
+using namespace DAVA;
+
+namespace ProfilerCPUCaptureTestDetails
+{
+const FilePath TEST_FOLDER("~doc:/UnitTests/ProfilerCPUCaptureTest/");
+const uint32 THREADS_COUNT = 4;
+const uint32 COUNTERS_PER_THREAD = 1000;
+
+// names are stored in capture by pointer until flush, so they should be static
+const char* const COUNTER_NAMES[THREADS_COUNT] = { "CaptureCounter0", "CaptureCounter1", "CaptureCounter2", "CaptureCounter3" };
+const char* const VALUE_NAME = "CaptureValue";
+const char* const FLOW_NAME = "CaptureFlow";
+}
+
+DAVA_TESTCLASS (ProfilerCPUCaptureTest)
+{
+    ProfilerCPUCaptureTest()
+    {
+        GetEngineContext()->fileSystem->CreateDirectory(ProfilerCPUCaptureTestDetails::TEST_FOLDER, true);
+    }
+
+    ~ProfilerCPUCaptureTest()
+    {
+        GetEngineContext()->fileSystem->DeleteDirectory(ProfilerCPUCaptureTestDetails::TEST_FOLDER, true);
+    }
+
+    DAVA_TEST (MultiThreadedCaptureTest)
+    {
+        using namespace ProfilerCPUCaptureTestDetails;
+
+        const FilePath capturePath = TEST_FOLDER + "capture.pcap";
+        ProfilerCPU profiler;
+        TEST_VERIFY(profiler.StartCapture(capturePath));
+
+        // every thread records into own buffer, main thread flushes buffers on frame markers meanwhile
+        uint64 threadIDs[THREADS_COUNT] = {};
+        std::atomic<uint32> threadsFinished{ 0 };
+        Vector<Thread*> threads;
+        for (uint32 i = 0; i < THREADS_COUNT; ++i)
+        {
+            threads.push_back(Thread::Create([&profiler, &threadIDs, &threadsFinished, i]() {
+                threadIDs[i] = Thread::GetCurrentIdAsUInt64();
+                profiler.AddFlowBegin(FLOW_NAME, i + 1);
+                for (uint32 c = 0; c < COUNTERS_PER_THREAD; ++c)
+                {
+                    ProfilerCPU::ScopedCounter counter(COUNTER_NAMES[i], &profiler);
+                }
+                profiler.AddCounterValue(VALUE_NAME, i);
+                threadsFinished++;
+            }));
+        }
+
+        for (Thread* thread : threads)
+        {
+            thread->Start();
+        }
+
+        uint32 frameIndex = 0;
+        while (threadsFinished != THREADS_COUNT)
+        {
+            profiler.MarkFrame(++frameIndex);
+            Thread::Sleep(1);
+        }
+
+        for (Thread* thread : threads)
+        {
+            thread->Join();
+            SafeRelease(thread);
+        }
+
+        for (uint32 i = 0; i < THREADS_COUNT; ++i)
+        {
+            profiler.AddFlowEnd(FLOW_NAME, i + 1);
+        }
+        profiler.StopCapture();
+        TEST_VERIFY(!profiler.IsCapturing());
+
+        Vector<TraceEvent> trace;
+        TEST_VERIFY(ProfilerCPU::ConvertCaptureToTrace(capturePath, trace));
+
+        uint32 countersCount[THREADS_COUNT] = {};
+        uint32 valuesCount = 0;
+        uint32 framesCount = 0;
+        uint64 flowBeginIDs = 0;
+        uint64 flowEndIDs = 0;
+        for (const TraceEvent& event : trace)
+        {
+            TEST_VERIFY(event.name != FastName("ProfilerDroppedEvents"));
+
+            switch (event.phase)
+            {
+            case TraceEvent::PHASE_DURATION:
+                for (uint32 i = 0; i < THREADS_COUNT; ++i)
+                {
+                    if (event.name == FastName(COUNTER_NAMES[i]))
+                    {
+                        TEST_VERIFY(event.threadID == threadIDs[i]);
+                        ++countersCount[i];
+                    }
+                }
+                break;
+            case TraceEvent::PHASE_COUNTER:
+                TEST_VERIFY(event.name == FastName(VALUE_NAME));
+                ++valuesCount;
+                break;
+            case TraceEvent::PHASE_FLOW_BEGIN:
+                flowBeginIDs |= uint64(1) << event.id;
+                break;
+            case TraceEvent::PHASE_FLOW_END:
+                flowEndIDs |= uint64(1) << event.id;
+                break;
+            case TraceEvent::PHASE_INSTANCE:
+                TEST_VERIFY(event.name == FastName("Frame"));
+                ++framesCount;
+                break;
+            default:
+                TEST_VERIFY(false && "unexpected event in capture");
+                break;
+            }
+        }
+
+        for (uint32 i = 0; i < THREADS_COUNT; ++i)
+        {
+            TEST_VERIFY(countersCount[i] == COUNTERS_PER_THREAD);
+        }
+        TEST_VERIFY(valuesCount == THREADS_COUNT);
+        TEST_VERIFY(framesCount == frameIndex);
+
+        const uint64 flowIDs = ((uint64(1) << THREADS_COUNT) - 1) << 1;
+        TEST_VERIFY(flowBeginIDs == flowIDs);
+        TEST_VERIFY(flowEndIDs == flowIDs);
+    }
+};
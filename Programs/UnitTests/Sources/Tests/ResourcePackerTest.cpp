@@ -188,6 +188,49 @@ DAVA_TESTCLASS (ResourcePackerTest)
         TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CompareTextFiles(outputDir + "eye_tut.txt", tagsOutputDir + "eye_tut.txt") == true);
     };
 
+    DAVA_TEST (ParallelFoldersTest)
+    {
+        using namespace DAVA;
+
+        ClearWorkingFolders();
+
+        // each folder has its own flags, so flags of one folder must not leak into folders packed at the same time
+        for (uint32 i = 0; i < static_cast<uint32>(psdBaseNames.size()); ++i)
+        {
+            FilePath folder = inputDir + Format("folder%u/", i);
+            TEST_VERIFY(GetEngineContext()->fileSystem->CreateDirectory(folder, true) != FileSystem::DIRECTORY_CANT_CREATE);
+            TEST_VERIFY(GetEngineContext()->fileSystem->CopyFile(resourcesDir + psdBaseNames[i] + ".psd", folder + psdBaseNames[i] + ".psd") == true);
+
+            ScopedPtr<File> flagsFile(File::Create(folder + "flags.txt", File::CREATE | File::WRITE));
+            flagsFile->WriteLine((i % 2 == 0) ? "--add4pixel --square" : "--add0pixel --disableCropAlpha");
+        }
+
+        FilePath serialOutputDir = rootDir + "SerialOutput/";
+        {
+            ResourcePacker2D packer;
+            packer.InitFolders(inputDir, serialOutputDir);
+            packer.SetMaxConcurrentTasks(1);
+            packer.PackResources({ eGPUFamily::GPU_ORIGIN });
+            TEST_VERIFY(packer.GetErrors().empty() == true);
+        }
+
+        GetEngineContext()->fileSystem->DeleteDirectory(rootDir + "$process/", true);
+
+        ResourcePacker2D packer;
+        packer.InitFolders(inputDir, outputDir);
+        packer.PackResources({ eGPUFamily::GPU_ORIGIN });
+        TEST_VERIFY(packer.GetErrors().empty() == true);
+
+        for (uint32 i = 0; i < static_cast<uint32>(psdBaseNames.size()); ++i)
+        {
+            String folder = Format("folder%u/", i);
+            String textureName = "texture0.png";
+            TEST_VERIFY(GetEngineContext()->fileSystem->Exists(outputDir + folder + textureName) == true);
+            TEST_VERIFY(GetEngineContext()->fileSystem->CompareBinaryFiles(serialOutputDir + folder + textureName, outputDir + folder + textureName) == true);
+            TEST_VERIFY(GetEngineContext()->fileSystem->CompareTextFiles(serialOutputDir + folder + psdBaseNames[i] + ".txt", outputDir + folder + psdBaseNames[i] + ".txt") == true);
+        }
+    }
+
     DAVA_TEST (MissingTagTest)
     {
         using namespace DAVA;
@@ -55,4 +55,54 @@ DAVA_TESTCLASS (UILayoutSystemTest)
         SafeRelease(parent);
         SafeRelease(child);
     }
+
+    DAVA_TEST (IncrementalLayout_ProcessesOnlyDirtySubtree)
+    {
+        UILayoutSystem* layoutSystem = GetEngineContext()->uiControlSystem->GetLayoutSystem();
+
+        UIControl* screen = MakeRoot("screen");
+        screen->SetSize(Vector2(200.0f, 200.0f));
+
+        Vector<UIControl*> controls;
+        UIControl* groups[2] = {};
+        for (UIControl*& group : groups)
+        {
+            group = MakeChild(screen, "group");
+            controls.push_back(group);
+            for (int32 i = 0; i < 10; i++)
+            {
+                UIControl* item = MakeChild(group, "item");
+                UISizePolicyComponent* itemSizePolicy = item->GetOrCreateComponent<UISizePolicyComponent>();
+                itemSizePolicy->SetHorizontalPolicy(UISizePolicyComponent::FIXED_SIZE);
+                itemSizePolicy->SetHorizontalValue(20.0f);
+                controls.push_back(item);
+            }
+        }
+
+        layoutSystem->ProcessControlHierarhy(screen);
+        layoutSystem->ProcessControlHierarhy(screen);
+
+        layoutSystem->layoutedControlsCount = 0;
+        layoutSystem->ProcessControlHierarhy(screen);
+        TEST_VERIFY(layoutSystem->layoutedControlsCount == 0);
+        TEST_VERIFY(screen->IsLayoutChildrenDirty() == false);
+
+        UIControl* changedItem = groups[0]->GetChildren().front().Get();
+        changedItem->GetComponent<UISizePolicyComponent>()->SetHorizontalValue(30.0f);
+        TEST_VERIFY(groups[0]->IsLayoutChildrenDirty());
+        TEST_VERIFY(screen->IsLayoutChildrenDirty());
+        TEST_VERIFY(groups[1]->IsLayoutChildrenDirty() == false);
+
+        // Only changed group and its items are layouted
+        layoutSystem->layoutedControlsCount = 0;
+        layoutSystem->ProcessControlHierarhy(screen);
+        TEST_VERIFY(layoutSystem->layoutedControlsCount == 11);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(changedItem->GetSize().x, 30.0f, 0.01f));
+
+        SafeRelease(screen);
+        for (UIControl* control : controls)
+        {
+            SafeRelease(control);
+        }
+    }
 };
@@ -0,0 +1,102 @@
+#include "UnitTests/UnitTests.h"
+
+#include <Engine/Engine.h>
+#include <Engine/EngineContext.h>
+#include <FileSystem/YamlNode.h>
+#include <FileSystem/YamlParser.h>
+#include <Logger/Logger.h>
+#include <Time/SystemTimer.h>
+#include <UI/DefaultUIPackageBuilder.h>
+#include <UI/Styles/UIStyleSheetSystem.h>
+#include <UI/UIControl.h>
+#include <UI/UIControlBackground.h>
+#include <UI/UIControlSystem.h>
+#include <UI/UIPackage.h>
+#include <UI/UIPackageLoader.h>
+#include <Utils/StringFormat.h>
+
+using namespace DAVA;
+
+namespace UIStyleSheetSystemTestDetails
+{
+const int32 STYLE_SHEETS_COUNT = 500;
+const int32 ITEMS_COUNT = 2000;
+const int32 MEASURED_RUNS = 10;
+
+String GeneratePackage()
+{
+    String yaml = "Header:\n    version: \"18\"\nStyleSheets:\n";
+    for (int32 i = 0; i < STYLE_SHEETS_COUNT; ++i)
+    {
+        float32 value = static_cast<float32>(i) / STYLE_SHEETS_COUNT;
+        yaml += Format("-   selector: \".item-%d\"\n    properties:\n        bg-color: [%f, 0.0, 0.0, 1.0]\n", i, value);
+        yaml += Format("-   selector: \".list .item-%d:selected\"\n    properties:\n        bg-color: [0.0, %f, 0.0, 1.0]\n", i, value);
+    }
+    yaml += "-   selector: \".item-1.night\"\n    properties:\n        bg-color: [0.0, 0.0, 1.0, 1.0]\n";
+
+    yaml += "Controls:\n-   class: \"UIControl\"\n    name: \"Root\"\n    classes: \"list\"\n    children:\n";
+    for (int32 i = 0; i < ITEMS_COUNT; ++i)
+    {
+        yaml += Format("    -   class: \"UIControl\"\n        name: \"Item_%d\"\n        classes: \"item-%d\"\n        components:\n            Background: {}\n", i, i % STYLE_SHEETS_COUNT);
+    }
+
+    return yaml;
+}
+
+const Color& GetItemColor(UIControl* root, int32 index)
+{
+    return root->FindByName(Format("Item_%d", index), false)->GetComponent<UIControlBackground>()->GetColor();
+}
+} // namespace UIStyleSheetSystemTestDetails
+
+DAVA_TESTCLASS (UIStyleSheetSystemTest)
+{
+    DAVA_TEST (GeneratedPackageBenchmark)
+    {
+        using namespace UIStyleSheetSystemTestDetails;
+
+        RefPtr<YamlParser> parser = YamlParser::CreateAndParseString(GeneratePackage());
+        TEST_VERIFY(parser);
+
+        DefaultUIPackageBuilder builder;
+        TEST_VERIFY(UIPackageLoader().LoadPackage(parser->GetRootNode(), "~res:/UI/GeneratedStyles.yaml", &builder));
+        UIControl* root = builder.GetPackage()->GetControl("Root");
+        TEST_VERIFY(root != nullptr);
+
+        UIControlSystem* controlSystem = GetEngineContext()->uiControlSystem;
+        UIStyleSheetSystem* styleSheetSystem = controlSystem->GetStyleSheetSystem();
+
+        int64 startUs = SystemTimer::GetUs();
+        for (int32 i = 0; i < MEASURED_RUNS; ++i)
+        {
+            styleSheetSystem->ProcessControl(root, true);
+        }
+        int64 fullRestyleUs = (SystemTimer::GetUs() - startUs) / MEASURED_RUNS;
+
+        TEST_VERIFY(FLOAT_EQUAL_EPS(GetItemColor(root, 5).r, 5.0f / STYLE_SHEETS_COUNT, 0.001f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(GetItemColor(root, STYLE_SHEETS_COUNT + 5).r, 5.0f / STYLE_SHEETS_COUNT, 0.001f));
+
+        // Selector chain with state
+        UIControl* selectedItem = root->FindByName("Item_7", false);
+        selectedItem->SetSelected(true, false);
+        controlSystem->ForceUpdateControl(0.0f, root);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(GetItemColor(root, 7).g, 7.0f / STYLE_SHEETS_COUNT, 0.001f));
+        selectedItem->SetSelected(false, false);
+
+        // Global class changes restyle only controls of package referring to it
+        startUs = SystemTimer::GetUs();
+        styleSheetSystem->AddGlobalClass(FastName("night"));
+        controlSystem->ForceUpdateControl(0.0f, root);
+        int64 globalClassUs = SystemTimer::GetUs() - startUs;
+
+        TEST_VERIFY(FLOAT_EQUAL_EPS(GetItemColor(root, 1).b, 1.0f, 0.001f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(GetItemColor(root, STYLE_SHEETS_COUNT + 1).b, 1.0f, 0.001f));
+
+        styleSheetSystem->RemoveGlobalClass(FastName("night"));
+        controlSystem->ForceUpdateControl(0.0f, root);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(GetItemColor(root, 1).b, 0.0f, 0.001f));
+
+        Logger::Info("[UIStyleSheetSystemTest] %d style sheets, %d controls: full restyle %.2f ms, global class change %.2f ms",
+                     2 * STYLE_SHEETS_COUNT + 1, ITEMS_COUNT, fullRestyleUs / 1000.0f, globalClassUs / 1000.0f);
+    }
+};
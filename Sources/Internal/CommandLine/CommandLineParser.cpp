@@ -17,7 +17,12 @@ CommandLineParser::CommandLineParser()
 {
 }
 
-void CommandLineParser::SetFlags(const Vector<String>& tokens)
+CommandLineFlags::CommandLineFlags(const Vector<String>& tokens)
+{
+    SetFlags(tokens);
+}
+
+void CommandLineFlags::SetFlags(const Vector<String>& tokens)
 {
     ClearFlags();
 
@@ -41,11 +46,52 @@ void CommandLineParser::SetFlags(const Vector<String>& tokens)
     }
 }
 
-void CommandLineParser::ClearFlags()
+void CommandLineFlags::ClearFlags()
 {
     flags.clear();
 }
 
+bool CommandLineFlags::IsFlagSet(const String& s) const
+{
+    for (auto& flag : flags)
+    {
+        if (flag.name == s)
+            return true;
+    }
+    return false;
+}
+
+String CommandLineFlags::GetParamForFlag(const String& flag) const
+{
+    Vector<String> params = GetParamsForFlag(flag);
+    if (!params.empty())
+    {
+        return params[0];
+    }
+    else
+        return String();
+}
+
+Vector<String> CommandLineFlags::GetParamsForFlag(const String& flagname) const
+{
+    for (auto& flag : flags)
+    {
+        if (flag.name == flagname)
+            return flag.params;
+    }
+    return Vector<String>();
+}
+
+void CommandLineParser::SetFlags(const Vector<String>& tokens)
+{
+    flags.SetFlags(tokens);
+}
+
+void CommandLineParser::ClearFlags()
+{
+    flags.ClearFlags();
+}
+
 void CommandLineParser::SetVerbose(bool _isVerbose)
 {
     isVerbose = _isVerbose;
@@ -82,33 +128,22 @@ CommandLineParser::~CommandLineParser()
 
 bool CommandLineParser::IsFlagSet(const String& s) const
 {
-    for (auto& flag : flags)
-    {
-        if (flag.name == s)
-            return true;
-    }
-    return false;
+    return flags.IsFlagSet(s);
 }
 
 String CommandLineParser::GetParamForFlag(const String& flag)
 {
-    Vector<String> params = GetParamsForFlag(flag);
-    if (!params.empty())
-    {
-        return params[0];
-    }
-    else
-        return String();
+    return flags.GetParamForFlag(flag);
 }
 
 Vector<String> CommandLineParser::GetParamsForFlag(const String& flagname)
 {
-    for (auto& flag : flags)
-    {
-        if (flag.name == flagname)
-            return flag.params;
-    }
-    return Vector<String>();
+    return flags.GetParamsForFlag(flagname);
+}
+
+const CommandLineFlags& CommandLineParser::GetFlags() const
+{
+    return flags;
 }
 
 bool CommandLineParser::CommandIsFound(const DAVA::String& command)
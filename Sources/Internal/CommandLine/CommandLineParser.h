@@ -6,6 +6,37 @@
 
 namespace DAVA
 {
+/**
+    Set of flags parsed from '--flag param1 param2 --otherFlag' tokens.
+    Used by CommandLineParser and as standalone value, e.g. for per-folder flags of resource packer.
+*/
+class CommandLineFlags
+{
+public:
+    CommandLineFlags() = default;
+    explicit CommandLineFlags(const Vector<String>& tokens);
+
+    void SetFlags(const Vector<String>& tokens);
+    void ClearFlags();
+
+    bool IsFlagSet(const String& s) const;
+    String GetParamForFlag(const String& flag) const;
+    Vector<String> GetParamsForFlag(const String& flag) const;
+
+private:
+    struct Flag
+    {
+        explicit Flag(const String& f)
+            : name(f)
+        {
+        }
+        String name;
+        Vector<String> params;
+    };
+
+    Vector<Flag> flags;
+};
+
 class CommandLineParser : public StaticSingleton<CommandLineParser>
 {
 public:
@@ -27,6 +58,7 @@ public:
     bool IsFlagSet(const String& s) const;
     String GetParamForFlag(const String& flag);
     Vector<String> GetParamsForFlag(const String& flag);
+    const CommandLineFlags& GetFlags() const;
 
     static int32 GetCommandsCount();
 
@@ -40,17 +72,7 @@ public:
 private:
     static int32 GetCommandPosition(const DAVA::String& command);
 
-    struct Flag
-    {
-        explicit Flag(const String& f)
-            : name(f)
-        {
-        }
-        String name;
-        Vector<String> params;
-    };
-
-    Vector<Flag> flags;
+    CommandLineFlags flags;
     bool isVerbose;
     bool isExtendedOutput;
     bool useTeamcityOutput;
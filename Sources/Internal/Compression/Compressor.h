@@ -13,6 +13,7 @@ public:
         Lz4,
         Lz4HC,
         RFC1951, // deflate, inflate
+        Lz4Dictionary, // lz4hc with shared dictionary, see LZ4DictionaryCompressor
     };
 
     virtual ~Compressor();
@@ -1,4 +1,6 @@
 #include "Compression/LZ4Compressor.h"
+#include "Base/TemplateHelpers.h"
+#include "Concurrency/LockGuard.h"
 #include "Logger/Logger.h"
 
 #include <lz4/lz4.h>
@@ -66,4 +68,155 @@ bool LZ4HCCompressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) cons
     return true;
 }
 
+namespace LZ4DictionaryCompressorDetails
+{
+// decompressor may reference up to 64Kb before output, dictionary is placed at the end of this prefix
+const size_t DECOMPRESS_PREFIX_SIZE = 64 * 1024;
+const size_t MIN_INPUT_CAPACITY = 64 * 1024;
+}
+
+struct LZ4DictionaryCompressor::Context
+{
+    // lz4hc state keeps pointers into buffer, so it is primed with dictionary
+    // once per buffer allocation and copied from primedState before each compression
+    bool Reserve(const Vector<uint8>& dictionary, size_t inputSize)
+    {
+        using namespace LZ4DictionaryCompressorDetails;
+
+        if (buffer.size() >= dictionary.size() + inputSize)
+        {
+            return true;
+        }
+
+        buffer.resize(dictionary.size() + std::max(inputSize, MIN_INPUT_CAPACITY));
+        std::copy(dictionary.begin(), dictionary.end(), buffer.begin());
+
+        const size_t stateSize = (static_cast<size_t>(LZ4_sizeofStreamStateHC()) + sizeof(uint64) - 1) / sizeof(uint64);
+        primedState.resize(stateSize);
+        state.resize(stateSize);
+
+        char* dictionaryStart = reinterpret_cast<char*>(buffer.data());
+        if (LZ4_resetStreamStateHC(primedState.data(), dictionaryStart) != 0)
+        {
+            buffer.clear();
+            return false;
+        }
+
+        if (!dictionary.empty())
+        {
+            const int32 dictionarySize = static_cast<int32>(dictionary.size());
+            Vector<char> compressedDictionary(LZ4_compressBound(dictionarySize));
+            if (LZ4_compressHC_continue(primedState.data(), dictionaryStart, compressedDictionary.data(), dictionarySize) == 0)
+            {
+                buffer.clear();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    Vector<uint8> buffer; // dictionary followed by input
+    Vector<uint64> primedState;
+    Vector<uint64> state;
+};
+
+LZ4DictionaryCompressor::LZ4DictionaryCompressor(const Vector<uint8>& dictionary_)
+    : dictionary(dictionary_)
+{
+    DVASSERT(dictionary.size() <= MAX_DICTIONARY_SIZE);
+}
+
+LZ4DictionaryCompressor::~LZ4DictionaryCompressor()
+{
+    for (Context* context : freeContexts)
+    {
+        delete context;
+    }
+}
+
+const Vector<uint8>& LZ4DictionaryCompressor::GetDictionary() const
+{
+    return dictionary;
+}
+
+LZ4DictionaryCompressor::Context* LZ4DictionaryCompressor::AcquireContext() const
+{
+    LockGuard<Mutex> lock(contextsMutex);
+    if (freeContexts.empty())
+    {
+        return new Context();
+    }
+    Context* context = freeContexts.back();
+    freeContexts.pop_back();
+    return context;
+}
+
+void LZ4DictionaryCompressor::ReleaseContext(Context* context) const
+{
+    LockGuard<Mutex> lock(contextsMutex);
+    freeContexts.push_back(context);
+}
+
+bool LZ4DictionaryCompressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
+{
+    if (in.size() > LZ4_MAX_INPUT_SIZE - dictionary.size())
+    {
+        Logger::Error("LZ4 compress failed too big input buffer");
+        return false;
+    }
+    if (in.empty())
+    {
+        Logger::Error("LZ4 can't compress empty buffer");
+        return false;
+    }
+
+    Context* context = AcquireContext();
+    SCOPE_EXIT
+    {
+        ReleaseContext(context);
+    };
+
+    if (!context->Reserve(dictionary, in.size()))
+    {
+        Logger::Error("LZ4 can't prepare dictionary");
+        return false;
+    }
+
+    uint8* inputStart = context->buffer.data() + dictionary.size();
+    std::copy(in.begin(), in.end(), inputStart);
+    std::copy(context->primedState.begin(), context->primedState.end(), context->state.begin());
+
+    uint32 maxSize = static_cast<uint32>(LZ4_compressBound(static_cast<uint32>(in.size())));
+    if (out.size() < maxSize)
+    {
+        out.resize(maxSize);
+    }
+    int32 compressedSize = LZ4_compressHC_continue(context->state.data(), reinterpret_cast<const char*>(inputStart), reinterpret_cast<char*>(out.data()), static_cast<uint32>(in.size()));
+    if (compressedSize == 0)
+    {
+        return false;
+    }
+    out.resize(static_cast<uint32>(compressedSize));
+    return true;
+}
+
+bool LZ4DictionaryCompressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) const
+{
+    using namespace LZ4DictionaryCompressorDetails;
+
+    Vector<uint8> buffer(DECOMPRESS_PREFIX_SIZE + out.size());
+    std::copy(dictionary.begin(), dictionary.end(), buffer.begin() + (DECOMPRESS_PREFIX_SIZE - dictionary.size()));
+
+    int32 decompressResult = LZ4_decompress_safe_withPrefix64k(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(buffer.data() + DECOMPRESS_PREFIX_SIZE),
+                                                               static_cast<int32>(in.size()), static_cast<int32>(out.size()));
+    if (decompressResult != static_cast<int32>(out.size()))
+    {
+        Logger::Error("LZ4 decompress failed");
+        return false;
+    }
+    std::copy(buffer.begin() + DECOMPRESS_PREFIX_SIZE, buffer.end(), out.begin());
+    return true;
+}
+
 } // end namespace DAVA
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Compression/Compressor.h"
+#include "Concurrency/Mutex.h"
 
 namespace DAVA
 {
@@ -18,4 +19,36 @@ public:
     bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
 };
 
+/**
+    LZ4HC compressor with shared dictionary, used for small similar files in pack.
+    Dictionary is placed right before compressed block, so matches can reference
+    dictionary content. Compressed block can be decompressed only with the same dictionary.
+    Compress and Decompress are thread-safe.
+*/
+class LZ4DictionaryCompressor final : public Compressor
+{
+public:
+    /** Max dictionary size, limited by lz4 max match distance */
+    static const uint32 MAX_DICTIONARY_SIZE = 64 * 1024 - 1;
+
+    explicit LZ4DictionaryCompressor(const Vector<uint8>& dictionary);
+    ~LZ4DictionaryCompressor();
+
+    const Vector<uint8>& GetDictionary() const;
+
+    bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    // you should resize output to correct size before call this method
+    bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+
+private:
+    struct Context;
+
+    Context* AcquireContext() const;
+    void ReleaseContext(Context* context) const;
+
+    Vector<uint8> dictionary;
+    mutable Mutex contextsMutex;
+    mutable Vector<Context*> freeContexts;
+};
+
 } // end namespace DAVA
@@ -0,0 +1,554 @@
+#include "PackPatch.h"
+#include "Engine/Engine.h"
+#include "FileSystem/DynamicMemoryFile.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "FileSystem/Private/PackArchive.h"
+#include "Job/JobManager.h"
+#include "Logger/Logger.h"
+#include "Utils/CRC32.h"
+
+namespace DAVA
+{
+namespace PackPatchDetails
+{
+static const char8 packPatchSignature[] = "[DAVAPACKPATCH]";
+static const uint32 packPatchSignatureSize = sizeof(packPatchSignature) - 1;
+static const uint32 packPatchVersion = 1;
+static const uint32 copyChunkSize = 1024 * 1024;
+static const uint32 maxDataOperationSize = 1024 * 1024 * 1024;
+// diffs of one batch are kept in memory until written in order
+static const size_t maxOperationsInBatch = 512;
+
+// patch file: signature, version, origSize, origCRC, newSize, newCRC, operationsCount, operations
+// new pack is concatenation of operations results
+enum OperationType : uint8
+{
+    OPERATION_COPY = 1, // uint64 origOffset, uint32 size
+    OPERATION_DIFF = 2, // uint64 origOffset, uint32 origSize, uint32 newSize, uint32 diffSize, diffSize bytes of bsdiff
+    OPERATION_DATA = 3 // uint32 size, size bytes
+};
+
+struct Operation
+{
+    OperationType type = OPERATION_DATA;
+    bool isPackedFile = false;
+    uint64 origOffset = 0;
+    uint32 origSize = 0;
+    uint64 newOffset = 0;
+    uint32 newSize = 0;
+    Vector<uint8> diff;
+};
+
+template <class T>
+bool WriteValue(File* file, const T& value)
+{
+    return file->Write(&value, sizeof(T)) == sizeof(T);
+}
+
+template <class T>
+bool ReadValue(File* file, T& value)
+{
+    return file->Read(&value, sizeof(T)) == sizeof(T);
+}
+
+bool ReadFileRange(File* file, uint64 offset, uint32 size, Vector<uint8>& data)
+{
+    data.resize(size);
+    return file->Seek(offset, File::SEEK_FROM_START) && file->Read(data.data(), size) == size;
+}
+
+PackPatchReader::PatchError CopyData(File* from, uint64 size, File* to, CRC32* crc, PackPatchReader::PatchError readError)
+{
+    Vector<uint8> buffer(static_cast<size_t>(std::min(size, static_cast<uint64>(copyChunkSize))));
+    while (size > 0)
+    {
+        const uint32 chunkSize = static_cast<uint32>(std::min(size, static_cast<uint64>(copyChunkSize)));
+        if (from->Read(buffer.data(), chunkSize) != chunkSize)
+        {
+            return readError;
+        }
+        if (to->Write(buffer.data(), chunkSize) != chunkSize)
+        {
+            return PackPatchReader::ERROR_NEW_WRITE;
+        }
+        if (crc != nullptr)
+        {
+            crc->AddData(buffer.data(), chunkSize);
+        }
+        size -= chunkSize;
+    }
+    return PackPatchReader::ERROR_NO;
+}
+
+void MakeDiff(const FilePath& origPack, const FilePath& newPack, BSType diffType, Operation& operation)
+{
+    ScopedPtr<File> origFile(File::Create(origPack, File::OPEN | File::READ));
+    ScopedPtr<File> newFile(File::Create(newPack, File::OPEN | File::READ));
+
+    Vector<uint8> origData;
+    Vector<uint8> newData;
+    if (!origFile || !newFile ||
+        !ReadFileRange(origFile, operation.origOffset, operation.origSize, origData) ||
+        !ReadFileRange(newFile, operation.newOffset, operation.newSize, newData))
+    {
+        Logger::Error("[PackPatchWriter] can't read file content for diff, it will be stored as is");
+        operation.type = OPERATION_DATA;
+        return;
+    }
+
+    ScopedPtr<DynamicMemoryFile> diffFile(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+    const bool diffOk = BSDiff::Diff(reinterpret_cast<char8*>(origData.data()), operation.origSize,
+                                     reinterpret_cast<char8*>(newData.data()), operation.newSize, diffFile, diffType);
+
+    // diff can be bigger than changed file itself, store it as is then
+    if (diffOk && diffFile->GetSize() < operation.newSize)
+    {
+        operation.diff = diffFile->GetDataVector();
+    }
+    else
+    {
+        operation.type = OPERATION_DATA;
+    }
+}
+}
+
+// ======================================================================================
+// PackPatchWriter
+// ======================================================================================
+PackPatchWriter::PackPatchWriter(BSType diffType_, bool beVerbose)
+    : diffType(diffType_)
+    , verbose(beVerbose)
+{
+}
+
+bool PackPatchWriter::Write(const FilePath& origPack, const FilePath& newPack, const FilePath& patchPath)
+{
+    using namespace PackPatchDetails;
+
+    stats = Stats();
+
+    std::unique_ptr<PackArchive> origArchive;
+    std::unique_ptr<PackArchive> newArchive;
+    try
+    {
+        RefPtr<File> origFile(File::Create(origPack, File::OPEN | File::READ));
+        origArchive.reset(new PackArchive(origFile, origPack));
+        RefPtr<File> newFile(File::Create(newPack, File::OPEN | File::READ));
+        newArchive.reset(new PackArchive(newFile, newPack));
+    }
+    catch (std::exception& ex)
+    {
+        Logger::Error("[PackPatchWriter] can't open pack: %s", ex.what());
+        return false;
+    }
+
+    FileSystem* fs = FileSystem::Instance();
+    uint64 origSize = 0;
+    uint64 newSize = 0;
+    if (!fs->GetFileSize(origPack, origSize) || !fs->GetFileSize(newPack, newSize))
+    {
+        Logger::Error("[PackPatchWriter] can't get size of packs");
+        return false;
+    }
+
+    // original files are matched by compressed content first, by name second
+    const Vector<PackFormat::FileTableEntry>& origEntries = origArchive->GetPackFile().filesTable.data.files;
+    const Vector<ResourceArchive::FileInfo>& origInfos = origArchive->GetFilesInfo();
+    Map<std::pair<uint32, uint32>, const PackFormat::FileTableEntry*> origByContent;
+    UnorderedMap<String, const PackFormat::FileTableEntry*> origByName;
+    for (size_t i = 0; i < origEntries.size(); ++i)
+    {
+        const PackFormat::FileTableEntry& entry = origEntries[i];
+        if (entry.compressedSize > 0)
+        {
+            origByContent.emplace(std::make_pair(entry.compressedCrc32, entry.compressedSize), &entry);
+            origByName.emplace(origInfos[i].relativeFilePath, &entry);
+        }
+    }
+
+    const Vector<PackFormat::FileTableEntry>& newEntries = newArchive->GetPackFile().filesTable.data.files;
+    const Vector<ResourceArchive::FileInfo>& newInfos = newArchive->GetFilesInfo();
+    Vector<size_t> newOrder;
+    newOrder.reserve(newEntries.size());
+    for (size_t i = 0; i < newEntries.size(); ++i)
+    {
+        if (newEntries[i].compressedSize > 0)
+        {
+            newOrder.push_back(i);
+        }
+    }
+    std::sort(newOrder.begin(), newOrder.end(), [&](size_t left, size_t right) {
+        return newEntries[left].startPosition < newEntries[right].startPosition;
+    });
+
+    Vector<Operation> operations;
+    uint64 newOffset = 0;
+
+    auto addData = [&](uint64 end) {
+        while (newOffset < end)
+        {
+            Operation operation;
+            operation.type = OPERATION_DATA;
+            operation.newOffset = newOffset;
+            operation.newSize = static_cast<uint32>(std::min(end - newOffset, static_cast<uint64>(maxDataOperationSize)));
+            operations.push_back(operation);
+            newOffset += operation.newSize;
+        }
+    };
+
+    for (size_t index : newOrder)
+    {
+        const PackFormat::FileTableEntry& entry = newEntries[index];
+        if (entry.startPosition < newOffset || entry.startPosition + entry.compressedSize > newSize)
+        {
+            Logger::Error("[PackPatchWriter] unexpected position of %s in %s", newInfos[index].relativeFilePath.c_str(), newPack.GetAbsolutePathname().c_str());
+            return false;
+        }
+        addData(entry.startPosition);
+
+        Operation operation;
+        operation.isPackedFile = true;
+        operation.newOffset = entry.startPosition;
+        operation.newSize = entry.compressedSize;
+
+        auto contentIt = origByContent.find(std::make_pair(entry.compressedCrc32, entry.compressedSize));
+        if (contentIt != origByContent.end())
+        {
+            operation.type = OPERATION_COPY;
+            operation.origOffset = contentIt->second->startPosition;
+            operation.origSize = contentIt->second->compressedSize;
+        }
+        else
+        {
+            auto nameIt = origByName.find(newInfos[index].relativeFilePath);
+            if (nameIt != origByName.end())
+            {
+                operation.type = OPERATION_DIFF;
+                operation.origOffset = nameIt->second->startPosition;
+                operation.origSize = nameIt->second->compressedSize;
+            }
+            else
+            {
+                operation.type = OPERATION_DATA;
+            }
+        }
+
+        operations.push_back(std::move(operation));
+        newOffset += entry.compressedSize;
+    }
+    addData(newSize);
+
+    ScopedPtr<File> newData(File::Create(newPack, File::OPEN | File::READ));
+    ScopedPtr<File> patchFile(File::Create(patchPath, File::CREATE | File::WRITE));
+    if (!newData || !patchFile)
+    {
+        Logger::Error("[PackPatchWriter] can't create %s", patchPath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    const uint32 origCRC = CRC32::ForFile(origPack);
+    const uint32 newCRC = CRC32::ForFile(newPack);
+    const uint32 operationsCount = static_cast<uint32>(operations.size());
+
+    bool ret = patchFile->Write(packPatchSignature, packPatchSignatureSize) == packPatchSignatureSize &&
+    WriteValue(patchFile, packPatchVersion) &&
+    WriteValue(patchFile, origSize) &&
+    WriteValue(patchFile, origCRC) &&
+    WriteValue(patchFile, newSize) &&
+    WriteValue(patchFile, newCRC) &&
+    WriteValue(patchFile, operationsCount);
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    DVASSERT(jobManager != nullptr);
+
+    for (size_t batchStart = 0; ret && batchStart < operations.size(); batchStart += maxOperationsInBatch)
+    {
+        const size_t batchEnd = std::min(batchStart + maxOperationsInBatch, operations.size());
+
+        // changed files of batch are diffed in parallel
+        for (size_t i = batchStart; i < batchEnd; ++i)
+        {
+            if (operations[i].type == OPERATION_DIFF)
+            {
+                jobManager->CreateWorkerJob([&, i]() {
+                    MakeDiff(origPack, newPack, diffType, operations[i]);
+                });
+            }
+        }
+        jobManager->WaitWorkerJobs();
+
+        for (size_t i = batchStart; ret && i < batchEnd; ++i)
+        {
+            Operation& operation = operations[i];
+            ret = WriteValue(patchFile, static_cast<uint8>(operation.type));
+
+            switch (operation.type)
+            {
+            case OPERATION_COPY:
+                ret = ret && WriteValue(patchFile, operation.origOffset) && WriteValue(patchFile, operation.newSize);
+                stats.copiedFiles += operation.isPackedFile ? 1 : 0;
+                break;
+            case OPERATION_DIFF:
+            {
+                const uint32 diffSize = static_cast<uint32>(operation.diff.size());
+                ret = ret && WriteValue(patchFile, operation.origOffset) && WriteValue(patchFile, operation.origSize) &&
+                WriteValue(patchFile, operation.newSize) && WriteValue(patchFile, diffSize) &&
+                patchFile->Write(operation.diff.data(), diffSize) == diffSize;
+                stats.diffedFiles += 1;
+
+                Vector<uint8>().swap(operation.diff); // free memory
+            }
+            break;
+            case OPERATION_DATA:
+                ret = ret && WriteValue(patchFile, operation.newSize) && newData->Seek(operation.newOffset, File::SEEK_FROM_START) &&
+                CopyData(newData, operation.newSize, patchFile, nullptr, PackPatchReader::ERROR_CORRUPTED) == PackPatchReader::ERROR_NO;
+                stats.storedFiles += operation.isPackedFile ? 1 : 0;
+                break;
+            }
+        }
+    }
+
+    if (!ret)
+    {
+        Logger::Error("[PackPatchWriter] can't write %s", patchPath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    stats.patchSize = patchFile->GetSize();
+    if (verbose)
+    {
+        Logger::Info("[PackPatchWriter] %s -> %s: copied %u files, diffed %u files, stored %u files, patch size %llu bytes",
+                     origPack.GetAbsolutePathname().c_str(), newPack.GetAbsolutePathname().c_str(),
+                     stats.copiedFiles, stats.diffedFiles, stats.storedFiles, stats.patchSize);
+    }
+
+    return true;
+}
+
+// ======================================================================================
+// PackPatchReader
+// ======================================================================================
+PackPatchReader::PackPatchReader(const FilePath& patchPath_, bool beVerbose)
+    : patchPath(patchPath_)
+    , verbose(beVerbose)
+{
+}
+
+bool PackPatchReader::Apply(const FilePath& origPack, const FilePath& newPack)
+{
+    using namespace PackPatchDetails;
+
+    lastError = ERROR_NO;
+
+    ScopedPtr<File> patchFile(File::Create(patchPath, File::OPEN | File::READ));
+    if (!patchFile)
+    {
+        lastError = ERROR_CANT_READ;
+        Logger::Error("[PackPatchReader::Apply] Can't read %s", patchPath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    char8 signature[packPatchSignatureSize];
+    uint32 version = 0;
+    uint64 origSize = 0;
+    uint32 origCRC = 0;
+    uint64 newSize = 0;
+    uint32 newCRC = 0;
+    uint32 operationsCount = 0;
+
+    if (patchFile->Read(signature, packPatchSignatureSize) != packPatchSignatureSize ||
+        Memcmp(signature, packPatchSignature, packPatchSignatureSize) != 0 ||
+        !ReadValue(patchFile, version) || version != packPatchVersion ||
+        !ReadValue(patchFile, origSize) || !ReadValue(patchFile, origCRC) ||
+        !ReadValue(patchFile, newSize) || !ReadValue(patchFile, newCRC) ||
+        !ReadValue(patchFile, operationsCount))
+    {
+        lastError = ERROR_CORRUPTED;
+        Logger::Error("[PackPatchReader::Apply] Wrong header in %s", patchPath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    FileSystem* fs = FileSystem::Instance();
+
+    // new pack can be already patched
+    uint64 existingSize = 0;
+    if (fs->GetFileSize(newPack, existingSize) && existingSize == newSize && CRC32::ForFile(newPack) == newCRC)
+    {
+        return true;
+    }
+
+    uint64 origActualSize = 0;
+    if (!fs->GetFileSize(origPack, origActualSize))
+    {
+        lastError = ERROR_ORIG_READ;
+        Logger::Error("[PackPatchReader::Apply] Can't read %s", origPack.GetAbsolutePathname().c_str());
+        return false;
+    }
+    if (origActualSize != origSize || CRC32::ForFile(origPack) != origCRC)
+    {
+        lastError = ERROR_ORIG_CRC;
+        Logger::Error("[PackPatchReader::Apply] Original size or crc doesn't match to expected: %s", origPack.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    ScopedPtr<File> origFile(File::Create(origPack, File::OPEN | File::READ));
+    if (!origFile)
+    {
+        lastError = ERROR_ORIG_READ;
+        Logger::Error("[PackPatchReader::Apply] Can't read %s", origPack.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    FilePath tmpNewPath = newPack;
+    tmpNewPath += String(".tmp_patch");
+    fs->CreateDirectory(tmpNewPath.GetDirectory(), true);
+
+    ScopedPtr<File> newFile(File::Create(tmpNewPath, File::CREATE | File::WRITE));
+    if (!newFile)
+    {
+        lastError = ERROR_NEW_CREATE;
+        Logger::Error("[PackPatchReader::Apply] Can't create %s", tmpNewPath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    CRC32 actualCRC;
+    for (uint32 i = 0; i < operationsCount && lastError == ERROR_NO; ++i)
+    {
+        uint8 type = 0;
+        if (!ReadValue(patchFile, type))
+        {
+            lastError = ERROR_CORRUPTED;
+            break;
+        }
+
+        switch (type)
+        {
+        case OPERATION_COPY:
+        {
+            uint64 origOffset = 0;
+            uint32 size = 0;
+            if (!ReadValue(patchFile, origOffset) || !ReadValue(patchFile, size) ||
+                origOffset > origSize || size > origSize - origOffset || size > newSize - newFile->GetPos())
+            {
+                lastError = ERROR_CORRUPTED;
+            }
+            else if (!origFile->Seek(origOffset, File::SEEK_FROM_START))
+            {
+                lastError = ERROR_ORIG_READ;
+            }
+            else
+            {
+                lastError = CopyData(origFile, size, newFile, &actualCRC, ERROR_ORIG_READ);
+            }
+        }
+        break;
+        case OPERATION_DIFF:
+        {
+            uint64 origOffset = 0;
+            uint32 origDataSize = 0;
+            uint32 newDataSize = 0;
+            uint32 diffSize = 0;
+            Vector<uint8> diff;
+            if (!ReadValue(patchFile, origOffset) || !ReadValue(patchFile, origDataSize) ||
+                !ReadValue(patchFile, newDataSize) || !ReadValue(patchFile, diffSize))
+            {
+                lastError = ERROR_CORRUPTED;
+                break;
+            }
+
+            // sizes are checked before allocation, so corrupted patch can't make us allocate gigabytes
+            if (origOffset > origSize || origDataSize > origSize - origOffset ||
+                newDataSize > newSize - newFile->GetPos() ||
+                diffSize > patchFile->GetSize() - patchFile->GetPos())
+            {
+                lastError = ERROR_CORRUPTED;
+                break;
+            }
+
+            diff.resize(diffSize);
+            if (patchFile->Read(diff.data(), diffSize) != diffSize)
+            {
+                lastError = ERROR_CORRUPTED;
+                break;
+            }
+
+            Vector<uint8> origData;
+            if (!ReadFileRange(origFile, origOffset, origDataSize, origData))
+            {
+                lastError = ERROR_ORIG_READ;
+                break;
+            }
+
+            // bsdiff reads its stream with read ahead, so diff is given to it in separate memory file
+            ScopedPtr<DynamicMemoryFile> diffFile(DynamicMemoryFile::Create(diff.data(), static_cast<int32>(diffSize), File::OPEN | File::READ));
+            Vector<uint8> newData(newDataSize);
+            if (!BSDiff::Patch(reinterpret_cast<char8*>(origData.data()), origDataSize, reinterpret_cast<char8*>(newData.data()), newDataSize, diffFile))
+            {
+                lastError = ERROR_CORRUPTED;
+                break;
+            }
+
+            if (newFile->Write(newData.data(), newDataSize) != newDataSize)
+            {
+                lastError = ERROR_NEW_WRITE;
+                break;
+            }
+            actualCRC.AddData(newData.data(), newDataSize);
+        }
+        break;
+        case OPERATION_DATA:
+        {
+            uint32 size = 0;
+            if (!ReadValue(patchFile, size) || size > newSize - newFile->GetPos())
+            {
+                lastError = ERROR_CORRUPTED;
+            }
+            else
+            {
+                lastError = CopyData(patchFile, size, newFile, &actualCRC, ERROR_CORRUPTED);
+            }
+        }
+        break;
+        default:
+            lastError = ERROR_CORRUPTED;
+            break;
+        }
+    }
+
+    if (lastError == ERROR_NO && !newFile->Flush())
+    {
+        lastError = ERROR_NEW_WRITE;
+    }
+
+    if (lastError == ERROR_NO && (newFile->GetSize() != newSize || actualCRC.Done() != newCRC))
+    {
+        lastError = ERROR_NEW_CRC;
+        Logger::Error("[PackPatchReader::Apply] New pack size or crc doesn't match to expected: %s", tmpNewPath.GetAbsolutePathname().c_str());
+    }
+
+    newFile.reset();
+    origFile.reset();
+
+    // this operation should be atomic
+    if (lastError == ERROR_NO && !fs->MoveFile(tmpNewPath, newPack, true))
+    {
+        lastError = ERROR_NEW_WRITE;
+        Logger::Error("[PackPatchReader::Apply] Can't move patched pack to %s", newPack.GetAbsolutePathname().c_str());
+    }
+
+    if (lastError != ERROR_NO)
+    {
+        Logger::Error("[PackPatchReader::Apply] Can't apply %s, error: %d", patchPath.GetAbsolutePathname().c_str(), lastError);
+        fs->DeleteFile(tmpNewPath);
+        return false;
+    }
+
+    if (verbose)
+    {
+        Logger::Info("[PackPatchReader::Apply] Done: %s", newPack.GetAbsolutePathname().c_str());
+    }
+
+    return true;
+}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "FileSystem/FilePath.h"
+#include "BSDiff.h"
+
+namespace DAVA
+{
+// ======================================================================================
+// Patch between two versions of pack file (see PackFormat::PackFile).
+// Files of new pack are matched with files of original pack:
+//  - file with the same compressed content is copied from original pack (matched by crc32, so moved and renamed files are reused)
+//  - changed file is bsdiff'ed against original file with the same name
+//  - other data (new files, pack tail with file table and footer) is stored as is
+// Patch is applied as a stream, so only one file of pack is kept in memory.
+// ======================================================================================
+class PackPatchWriter
+{
+public:
+    struct Stats
+    {
+        uint32 copiedFiles = 0;
+        uint32 diffedFiles = 0;
+        uint32 storedFiles = 0;
+        uint64 patchSize = 0;
+    };
+
+    PackPatchWriter(BSType diffType, bool beVerbose = false);
+
+    /** Write patch from `origPack` to `newPack` into `patchPath`, changed files are diffed by worker jobs */
+    bool Write(const FilePath& origPack, const FilePath& newPack, const FilePath& patchPath);
+
+    const Stats& GetStats() const;
+
+private:
+    BSType diffType;
+    bool verbose;
+    Stats stats;
+};
+
+// ======================================================================================
+// class for applying pack patch file
+// ======================================================================================
+class PackPatchReader
+{
+public:
+    enum PatchError
+    {
+        ERROR_NO = 0,
+        ERROR_CANT_READ, // patch file can't be read
+        ERROR_CORRUPTED, // patch file is corrupted
+        ERROR_ORIG_READ, // original pack can't be opened for reading
+        ERROR_ORIG_CRC, // original pack has wrong size or crc to apply patch
+        ERROR_NEW_CREATE, // new pack can't be opened for writing
+        ERROR_NEW_WRITE, // new pack can't be written
+        ERROR_NEW_CRC // new pack has wrong size or crc after applied patch
+    };
+
+    PackPatchReader(const FilePath& patchPath, bool beVerbose = false);
+
+    /** Apply patch to `origPack` and write result into `newPack`, paths may be the same */
+    bool Apply(const FilePath& origPack, const FilePath& newPack);
+
+    PatchError GetError() const;
+
+private:
+    FilePath patchPath;
+    bool verbose;
+    PatchError lastError = ERROR_NO;
+};
+
+inline const PackPatchWriter::Stats& PackPatchWriter::GetStats() const
+{
+    return stats;
+}
+
+inline PackPatchReader::PatchError PackPatchReader::GetError() const
+{
+    return lastError;
+}
+}
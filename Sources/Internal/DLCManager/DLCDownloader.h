@@ -15,6 +15,7 @@ class ProfilerCPU;
 	1. download file with one or more simultaneous curl easy handlers
 	2. get remote file size
 	3. resume previous download
+	4. download big file by several segments at once with resume of every segment
 	Also you can download into file or your custom buffer implementing
 	```DLCDownloader::IWriter``` interface.
 	Typical usage:
@@ -85,7 +86,8 @@ public:
     {
         FULL, //!< Truncate file if exist and download again
         RESUME, //!< Resume downloading from current output file(buffer) size
-        SIZE //!< Just return size of remote file, see ```TaskStatus::sizeTotal```
+        SIZE, //!< Just return size of remote file, see ```TaskStatus::sizeTotal```
+        SEGMENTED //!< Download into preallocated file by several segments at once, resume every segment from its saved position
     };
 
     /**
@@ -134,6 +136,8 @@ public:
         int32 timeoutSec = 30; //!< Timeout in seconds
         int64 rangeOffset = -1; //!< Index of first byte to download from or -1 [0 - first byte index]
         int64 rangeSize = -1; //!< Size of downloaded range in bytes
+        uint32 segmentsCount = 0; //!< Number of simultaneously downloaded segments for ```TaskType::SEGMENTED```
+        uint32 crc32 = 0; //!< Expected crc32 of downloaded range for ```TaskType::SEGMENTED```, 0 - do not check
     };
     /**
 		Four types of error can happen during download process. All grouped
@@ -154,6 +158,7 @@ public:
         //!< See http://en.cppreference.com/w/cpp/error/errno_macros
         const char* errStr = ""; //!< See https://curl.haxx.se/libcurl/c/curl_multi_strerror.html
         //!< And https://curl.haxx.se/libcurl/c/curl_easy_strerror.html
+        bool crc32Mismatch = false; //!< Downloaded file doesn't match expected crc32 (```TaskType::SEGMENTED```)
         bool errorHappened = false; //!< Flag set to true if any error
     };
     /**
@@ -190,6 +195,13 @@ public:
 	    You can reuse customWriter after finish Task
 	*/
     virtual ITask* ResumeTask(const String& srcUrl, std::shared_ptr<IWriter> customWriter, Range range = EmptyRange) = 0;
+    /** Download range into dstPath file with `segmentsCount` connections at once.
+	    File is preallocated and every segment is written at its offset directly
+	    from network. Progress of segments is saved into dstPath + ".segments" file,
+	    so the same call after interruption continues every segment from its
+	    position. If `crc32` != 0 downloaded file is checked and deleted on mismatch.
+	*/
+    virtual ITask* StartSegmentedTask(const String& srcUrl, const String& dstPath, Range range, uint32 segmentsCount, uint32 crc32 = 0) = 0;
 
     /**  Clear task data and free resources */
     virtual void RemoveTask(ITask* task) = 0;
@@ -145,6 +145,10 @@ public:
         uint32 skipCDNConnectAfterAttempts = 3; //!< if local metadata exists and CDN is not available use local files without CDN
         uint32 downloaderMaxHandles = 8; //!< play with any values you like from 1 to max open file per process
         uint32 downloaderChunkBufSize = 512 * 1024; //!< 512Kb RAM buffer for one handle, you can set any value in bytes
+        uint32 coalesceMaxRangeSize = 4 * 1024 * 1024; //!< adjacent files of pack are downloaded with one HTTP range request up to this size in bytes, 0 - request per file
+        uint32 coalesceMaxGapSize = 16 * 1024; //!< max bytes between files (of other packs) downloaded and skipped to coalesce requests
+        uint32 segmentedDownloadMinSize = 8 * 1024 * 1024; //!< files of this size and bigger are downloaded with several parallel range requests, 0 - never
+        uint32 downloadSegmentsCount = 4; //!< count of parallel range requests for one big file
         uint32 profilerSamplerCounts = 1024 * 2; //!< number of counters in profiler ring buffer
         bool fireSignalsInBackground = false; //!< if false, signals are accumulated and will be fired only when an app returns to foreground
         bool validateLocalPacksFiles = false; //!< if true, check every file exist in ~res:/
@@ -3,10 +3,11 @@
 #include "Engine/Engine.h"
 #include "FileSystem/File.h"
 #include "FileSystem/FileSystem.h"
+#include "Base/ScopedPtr.h"
 
 namespace DAVA
 {
-DLCDownloaderDefaultWriter::DLCDownloaderDefaultWriter(const String& outputFile)
+DLCDownloaderDefaultWriter::DLCDownloaderDefaultWriter(const String& outputFile, Mode mode)
 {
     FileSystem* fs = GetEngineContext()->fileSystem;
 
@@ -18,7 +19,18 @@ DLCDownloaderDefaultWriter::DLCDownloaderDefaultWriter(const String& outputFile)
         DAVA_THROW(Exception, "can't create output directory: " + directory.GetAbsolutePathname() + " errno:(" + err + ") outputFile: " + outputFile);
     }
 
-    f = RefPtr<File>(File::Create(outputFile, File::WRITE | File::APPEND));
+    if (mode == Mode::Append)
+    {
+        f = RefPtr<File>(File::Create(outputFile, File::WRITE | File::APPEND));
+    }
+    else
+    {
+        if (!fs->IsFile(path))
+        {
+            ScopedPtr<File> created(File::Create(outputFile, File::CREATE | File::WRITE));
+        }
+        f = RefPtr<File>(File::Create(outputFile, File::OPEN | File::READ | File::WRITE));
+    }
 
     if (!f)
     {
@@ -41,6 +53,25 @@ uint64 DLCDownloaderDefaultWriter::Save(const void* ptr, uint64 size)
 {
     return f->Write(ptr, static_cast<uint32>(size));
 }
+uint64 DLCDownloaderDefaultWriter::SaveAt(uint64 offset, const void* ptr, uint64 size)
+{
+    if (f->GetPos() != offset && !f->Seek(static_cast<int64>(offset), File::eFileSeek::SEEK_FROM_START))
+    {
+        return 0;
+    }
+    return f->Write(ptr, static_cast<uint32>(size));
+}
+
+bool DLCDownloaderDefaultWriter::Resize(uint64 size)
+{
+    return f->Truncate(size);
+}
+
+bool DLCDownloaderDefaultWriter::Flush()
+{
+    return f->Flush();
+}
+
 // return current size of saved byte stream
 uint64 DLCDownloaderDefaultWriter::GetSeekPos()
 {
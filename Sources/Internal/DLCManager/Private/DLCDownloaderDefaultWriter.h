@@ -11,10 +11,21 @@ class File;
 struct DLCDownloaderDefaultWriter :
 DLCDownloader::IWriter
 {
-    explicit DLCDownloaderDefaultWriter(const String& outputFile);
+    enum class Mode
+    {
+        Append,
+        RandomAccess //!< existing content is kept, data is written with SaveAt
+    };
+
+    explicit DLCDownloaderDefaultWriter(const String& outputFile, Mode mode = Mode::Append);
     ~DLCDownloaderDefaultWriter();
 
     void MoveToEndOfFile() const;
+    /** Save buffer at `offset` from begin of file, on error result != size */
+    uint64 SaveAt(uint64 offset, const void* ptr, uint64 size);
+    /** Set file size without changing content before `size`, return false on error */
+    bool Resize(uint64 size);
+    bool Flush();
     uint64 Save(const void* ptr, uint64 size) override;
     uint64 GetSeekPos() override;
     bool Truncate() override;
@@ -7,9 +7,24 @@
 #include "Concurrency/LockGuard.h"
 #include "Engine/Engine.h"
 #include "Debug/ProfilerCPU.h"
+#include "Base/ScopedPtr.h"
+#include "Utils/CRC32.h"
 
 namespace DAVA
 {
+static const char* const segmentsStateExt = ".segments";
+static const uint32 SEGMENTS_STATE_VERSION = 1;
+static const uint64 SEGMENTS_STATE_SAVE_STEP = 1024 * 1024; // save progress of segments after every 1Mb
+static const int64 MIN_SEGMENT_SIZE = 256 * 1024;
+
+struct SegmentsStateHeader
+{
+    uint32 version = SEGMENTS_STATE_VERSION;
+    uint32 segmentsCount = 0;
+    int64 rangeOffset = 0;
+    int64 rangeSize = 0;
+};
+
 struct IDownloaderSubTask
 {
     DLCDownloaderImpl::Task& task;
@@ -42,6 +57,21 @@ struct DLCDownloaderImpl::Task : public DLCDownloader::ITask
     int64 restOffset = -1;
     int64 restSize = -1;
 
+    // [start] used only for TaskType::SEGMENTED
+    struct Segment
+    {
+        int64 offset = 0; // relative to info.rangeOffset
+        int64 size = 0;
+        int64 downloaded = 0;
+        bool running = false;
+    };
+    Vector<Segment> segments;
+    DLCDownloaderDefaultWriter* segmentsWriter = nullptr; // same object as writer
+    uint64 sizeSinceStateSave = 0;
+    bool segmentsPlanned = false;
+    bool segmentsFinished = false;
+    // [end]
+
     Task(ICurlEasyStorage& storage,
          const String& srcUrl,
          const String& dstPath,
@@ -63,11 +93,22 @@ struct DLCDownloaderImpl::Task : public DLCDownloader::ITask
     void SetupResumeDownload();
     void SetupGetSizeDownload();
 
+    void SetupSegmentedDownload();
+    void PlanSegments();
+    bool LoadSegmentsState();
+    void SaveSegmentsState();
+    bool NeedDownloadMoreSegments() const;
+    void GenerateSegmentSubRequests();
+    void FinishSegmentedDownload();
+    bool VerifySegmentedDownload();
+    String GetSegmentsStatePath() const;
+
     // error handles
     static void OnErrorCurlMulti(int32 multiCode, Task& task, int32 line);
     static void OnErrorCurlEasy(int32 easyCode, Task& task, int32 line);
     static void OnErrorCurlErrno(int32 errnoVal, Task& task, int32 line);
     static void OnErrorHttpCode(long httpCode, Task& task, int32 line);
+    static void OnErrorCrc32(Task& task, int32 line);
 };
 
 DLCDownloader::Range::Range() = default;
@@ -80,6 +121,7 @@ std::ostream& operator<<(std::ostream& stream, const DLCDownloader::TaskError& e
     stream << " curl_err: " << error.curlErr;
     stream << " curlm_err: " << error.curlMErr;
     stream << " errno: " << error.fileErrno;
+    stream << " crc32_mismatch: " << std::boolalpha << error.crc32Mismatch;
     stream << " err_str: " << error.errStr;
     stream << " file_line: " << error.fileLine;
     return stream;
@@ -305,6 +347,45 @@ static size_t CurlDataRecvHandler(void* ptr, size_t size, size_t nmemb, void* pa
     return 0;
 }
 
+static void CurlSetRangeRequest(DLCDownloaderImpl::Task& task, CURL* easy, IDownloaderSubTask* subTask, int64 offset, int64 size)
+{
+    const char* url = task.info.srcUrl.c_str();
+    CURLcode code = curl_easy_setopt(easy, CURLOPT_URL, url);
+    if (CURLE_OK != code)
+    {
+        DLCDownloaderImpl::Task::OnErrorCurlEasy(code, task, __LINE__);
+    }
+
+    code = curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, CurlDataRecvHandler);
+    if (code != CURLE_OK)
+    {
+        DLCDownloaderImpl::Task::OnErrorCurlEasy(code, task, __LINE__);
+    }
+
+    code = curl_easy_setopt(easy, CURLOPT_WRITEDATA, subTask);
+    if (code != CURLE_OK)
+    {
+        DLCDownloaderImpl::Task::OnErrorCurlEasy(code, task, __LINE__);
+    }
+
+    char buf[128] = { 0 };
+    int result = snprintf(buf, sizeof(buf), "%lld-%lld", offset, offset + size - 1);
+    if (result < 0 || result >= sizeof(buf))
+    {
+        Logger::Error("range format failed");
+        DVASSERT(false);
+    }
+
+    code = curl_easy_setopt(easy, CURLOPT_RANGE, buf);
+    if (code != CURLE_OK)
+    {
+        DLCDownloaderImpl::Task::OnErrorCurlEasy(code, task, __LINE__);
+    }
+
+    // set all timeouts
+    CurlSetTimeout(task, easy);
+}
+
 struct DownloadChunkSubTask : IDownloaderSubTask
 {
     CURL* easy = nullptr;
@@ -336,41 +417,7 @@ struct DownloadChunkSubTask : IDownloaderSubTask
             DVASSERT(easy != nullptr);
         }
 
-        const char* url = task.info.srcUrl.c_str();
-        CURLcode code = curl_easy_setopt(easy, CURLOPT_URL, url);
-        if (CURLE_OK != code)
-        {
-            DLCDownloaderImpl::Task::OnErrorCurlEasy(code, task, __LINE__);
-        }
-
-        code = curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, CurlDataRecvHandler);
-        if (code != CURLE_OK)
-        {
-            DLCDownloaderImpl::Task::OnErrorCurlEasy(code, task, __LINE__);
-        }
-
-        code = curl_easy_setopt(easy, CURLOPT_WRITEDATA, this);
-        if (code != CURLE_OK)
-        {
-            DLCDownloaderImpl::Task::OnErrorCurlEasy(code, task, __LINE__);
-        }
-
-        char buf[128] = { 0 };
-        int result = snprintf(buf, sizeof(buf), "%lld-%lld", offset, offset + size - 1);
-        if (result < 0 || result >= sizeof(buf))
-        {
-            Logger::Error("range format failed");
-            DVASSERT(false);
-        }
-
-        code = curl_easy_setopt(easy, CURLOPT_RANGE, buf);
-        if (code != CURLE_OK)
-        {
-            DLCDownloaderImpl::Task::OnErrorCurlEasy(code, task, __LINE__);
-        }
-
-        // set all timeouts
-        CurlSetTimeout(task, easy);
+        CurlSetRangeRequest(task, easy, this, offset, size);
 
         CURLM* multi = task.curlStorage.GetMultiHandle();
         CURLMcode codem = curl_multi_add_handle(multi, easy);
@@ -589,6 +636,163 @@ struct GetSizeSubTask : IDownloaderSubTask
     }
 };
 
+/**
+    Download one segment of TaskType::SEGMENTED task directly into file at segment offset.
+    Segment subtask is its own IWriter, so data is not buffered and written in order.
+*/
+struct DownloadSegmentSubTask : IDownloaderSubTask, DLCDownloader::IWriter
+{
+    CURL* easy = nullptr;
+    size_t segmentIndex = 0;
+    bool rangeResponseChecked = false;
+
+    DownloadSegmentSubTask(DLCDownloaderImpl::Task& task_, size_t segmentIndex_)
+        : IDownloaderSubTask(task_)
+        , segmentIndex(segmentIndex_)
+    {
+        ++(task.lastCreateSubTaskIndex);
+        downloadOrderIndex = task.lastCreateSubTaskIndex;
+
+        DLCDownloaderImpl::Task::Segment& segment = task.segments[segmentIndex];
+        segment.running = true;
+
+        easy = task.curlStorage.CurlCreateHandle();
+
+        const int64 offset = task.info.rangeOffset + segment.offset + segment.downloaded;
+        const int64 size = segment.size - segment.downloaded;
+        CurlSetRangeRequest(task, easy, this, offset, size);
+
+        CURLM* multi = task.curlStorage.GetMultiHandle();
+        CURLMcode codem = curl_multi_add_handle(multi, easy);
+        if (CURLM_OK != codem)
+        {
+            DLCDownloaderImpl::Task::OnErrorCurlMulti(codem, task, __LINE__);
+        }
+
+        task.curlStorage.Map(easy, *this);
+    }
+
+    ~DownloadSegmentSubTask()
+    {
+        Cleanup();
+    }
+
+    void Cleanup()
+    {
+        if (easy != nullptr)
+        {
+            ICurlEasyStorage& storage = task.curlStorage;
+
+            storage.UnMap(easy);
+            CURLM* multiHandle = storage.GetMultiHandle();
+            CURLMcode code = curl_multi_remove_handle(multiHandle, easy);
+            if (CURLM_OK != code)
+            {
+                DLCDownloaderImpl::Task::OnErrorCurlMulti(code, task, __LINE__);
+            }
+            storage.CurlDeleteHandle(easy);
+            easy = nullptr;
+        }
+    }
+
+    void OnDone(CURLMsg* curlMsg) override
+    {
+        DLCDownloaderImpl::Task::Segment& segment = task.segments[segmentIndex];
+        segment.running = false;
+
+        const bool segmentReceived = segment.downloaded == segment.size;
+        if (curlMsg->data.result != CURLE_OK)
+        {
+            // we stop receiving by returning less bytes if server sends more than segment
+            if (!(segmentReceived && (curlMsg->data.result == CURLE_WRITE_ERROR || curlMsg->data.result == CURLE_PARTIAL_FILE)))
+            {
+                DLCDownloaderImpl::Task::OnErrorCurlEasy(curlMsg->data.result, task, __LINE__);
+            }
+        }
+        else if (!segmentReceived)
+        {
+            DLCDownloaderImpl::Task::OnErrorCurlEasy(CURLE_PARTIAL_FILE, task, __LINE__);
+        }
+
+        CheckHttpCode(easy, task, this);
+
+        // remember progress even on error, next start of the same task continues from here
+        task.SaveSegmentsState();
+
+        Cleanup();
+    }
+
+    DLCDownloaderImpl::Task& GetTask() override
+    {
+        return task;
+    }
+
+    CURL* GetEasyHandle() override
+    {
+        return easy;
+    }
+
+    DLCDownloader::IWriter& GetIWriter() override
+    {
+        return *this;
+    }
+
+    Buffer GetBuffer() override
+    {
+        return Buffer(); // already written
+    }
+
+    uint64 Save(const void* ptr, uint64 size) override
+    {
+        DLCDownloaderImpl::Task::Segment& segment = task.segments[segmentIndex];
+
+        if (!rangeResponseChecked)
+        {
+            rangeResponseChecked = true;
+            long httpCode = 0;
+            curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &httpCode);
+            if (httpCode == 200 && task.info.rangeOffset + segment.offset + segment.downloaded != 0)
+            {
+                Logger::Error("DLC server ignores range requests, can't download segment: %s", task.info.srcUrl.c_str());
+                return 0;
+            }
+        }
+
+        const uint64 toWrite = std::min(size, static_cast<uint64>(segment.size - segment.downloaded));
+        const uint64 written = task.segmentsWriter->SaveAt(segment.offset + segment.downloaded, ptr, toWrite);
+
+        segment.downloaded += written;
+        task.status.sizeDownloaded += written;
+        task.sizeSinceStateSave += written;
+        if (task.sizeSinceStateSave >= SEGMENTS_STATE_SAVE_STEP)
+        {
+            task.SaveSegmentsState();
+        }
+
+        return written;
+    }
+
+    uint64 GetSeekPos() override
+    {
+        return task.segments[segmentIndex].downloaded;
+    }
+
+    bool Truncate() override
+    {
+        return false;
+    }
+
+    bool Close() override
+    {
+        return true;
+    }
+
+    bool IsClosed() const override
+    {
+        return task.segmentsWriter == nullptr || task.segmentsWriter->IsClosed();
+    }
+};
+
 DLCDownloaderImpl::Task::Task(ICurlEasyStorage& storage_,
                               const String& srcUrl,
                               const String& dstPath,
@@ -630,6 +834,7 @@ bool DLCDownloaderImpl::Task::FlushWriterAndReset()
         allGood = writer->Close();
     }
     writer.reset();
+    segmentsWriter = nullptr;
 
     return allGood;
 }
@@ -638,6 +843,12 @@ DLCDownloaderImpl::Task::~Task()
 {
     FlushWriterAndReset();
 
+    if (segmentsPlanned && !segmentsFinished)
+    {
+        // task is removed before finish, keep segments progress to resume
+        SaveSegmentsState();
+    }
+
     for (auto& t : subTasksWorking)
     {
         delete t;
@@ -676,6 +887,9 @@ void DLCDownloaderImpl::Task::PrepareForDownloading()
     case TaskType::SIZE:
         SetupGetSizeDownload();
         break;
+    case TaskType::SEGMENTED:
+        SetupSegmentedDownload();
+        break;
     }
 
     if (status.state == TaskState::JustAdded)
@@ -686,11 +900,19 @@ void DLCDownloaderImpl::Task::PrepareForDownloading()
 
 bool DLCDownloaderImpl::Task::IsDone() const
 {
+    if (info.type == TaskType::SEGMENTED && NeedDownloadMoreSegments())
+    {
+        return false;
+    }
     return subTasksWorking.empty() && subTasksReadyToWrite.empty();
 }
 
 bool DLCDownloaderImpl::Task::NeedDownloadMoreData() const
 {
+    if (info.type == TaskType::SEGMENTED)
+    {
+        return NeedDownloadMoreSegments();
+    }
     return restSize > 0;
 }
 
@@ -702,6 +924,15 @@ void DLCDownloaderImpl::Task::OnSubTaskDone()
         subTasksReadyToWrite.remove(subTask);
         delete subTask;
     }
+    else if (info.type == TaskType::SEGMENTED)
+    {
+        // segments are written by subtasks themselves
+        for (IDownloaderSubTask* subTask : subTasksReadyToWrite)
+        {
+            delete subTask;
+        }
+        subTasksReadyToWrite.clear();
+    }
     else
     {
         if (!subTasksReadyToWrite.empty())
@@ -835,7 +1066,9 @@ DLCDownloader::ITask* DLCDownloaderImpl::StartAnyTask(const String& srcUrl,
                                                       const String& dstPath,
                                                       TaskType taskType,
                                                       std::shared_ptr<IWriter> dstWriter = std::shared_ptr<IWriter>(),
-                                                      Range range)
+                                                      Range range,
+                                                      uint32 segmentsCount,
+                                                      uint32 crc32)
 {
     DAVA_PROFILER_CPU_SCOPE_CUSTOM(__FUNCTION__, hints.profiler);
 
@@ -851,7 +1084,13 @@ DLCDownloader::ITask* DLCDownloaderImpl::StartAnyTask(const String& srcUrl,
 
     if (taskType != TaskType::RESUME &&
         taskType != TaskType::FULL &&
-        taskType != TaskType::SIZE)
+        taskType != TaskType::SIZE &&
+        taskType != TaskType::SEGMENTED)
+    {
+        return nullptr;
+    }
+
+    if (taskType == TaskType::SEGMENTED && (dstPath.empty() || segmentsCount == 0))
     {
         return nullptr;
     }
@@ -869,6 +1108,8 @@ DLCDownloader::ITask* DLCDownloaderImpl::StartAnyTask(const String& srcUrl,
                           range.offset,
                           range.size,
                           hints.timeout);
+    task->info.segmentsCount = segmentsCount;
+    task->info.crc32 = crc32;
 
     {
         LockGuard<Mutex> lock(mutexInputList);
@@ -909,6 +1150,11 @@ DLCDownloader::ITask* DLCDownloaderImpl::ResumeTask(const String& srcUrl, std::s
     return StartAnyTask(srcUrl, "", TaskType::RESUME, customWriter, range);
 }
 
+DLCDownloader::ITask* DLCDownloaderImpl::StartSegmentedTask(const String& srcUrl, const String& dstPath, Range range, uint32 segmentsCount, uint32 crc32)
+{
+    return StartAnyTask(srcUrl, dstPath, TaskType::SEGMENTED, nullptr, range, segmentsCount, crc32);
+}
+
 void DLCDownloaderImpl::RemoveTask(ITask* task)
 {
     DAVA_PROFILER_CPU_SCOPE_CUSTOM(__FUNCTION__, hints.profiler);
@@ -1191,6 +1437,12 @@ void DLCDownloaderImpl::DeleteTask(ITask* task)
 
 void DLCDownloaderImpl::Task::GenerateChunkSubRequests(const int chunkSize)
 {
+    if (info.type == TaskType::SEGMENTED)
+    {
+        GenerateSegmentSubRequests();
+        return;
+    }
+
     while (NeedDownloadMoreData() && curlStorage.GetFreeHandleCount() > 0)
     {
         if (restSize < chunkSize)
@@ -1326,6 +1578,223 @@ void DLCDownloaderImpl::Task::SetupGetSizeDownload()
     subTasksWorking.push_back(subTask);
 }
 
+void DLCDownloaderImpl::Task::SetupSegmentedDownload()
+{
+    try
+    {
+        segmentsWriter = new DLCDownloaderDefaultWriter(info.dstPath, DLCDownloaderDefaultWriter::Mode::RandomAccess);
+        writer.reset(segmentsWriter);
+    }
+    catch (Exception& ex)
+    {
+        OnErrorCurlErrno(errno, *this, __LINE__);
+        Logger::Error("can't create DLCDownloaderDefaultWriter: %s %s %d", ex.what(), ex.file.c_str(), static_cast<int>(ex.line));
+        return;
+    }
+
+    if (info.rangeOffset != -1 && info.rangeSize != -1)
+    {
+        GenerateSegmentSubRequests();
+        if (!status.error.errorHappened && IsDone())
+        {
+            // everything was downloaded before
+            FinishSegmentedDownload();
+        }
+    }
+    else
+    {
+        // first get size of full file
+        IDownloaderSubTask* subTask = new GetSizeSubTask(*this);
+        subTasksWorking.push_back(subTask);
+    }
+}
+
+void DLCDownloaderImpl::Task::PlanSegments()
+{
+    DVASSERT(!segmentsPlanned);
+    segmentsPlanned = true;
+
+    if (info.rangeSize > 0)
+    {
+        const int64 maxSegmentsCount = std::max(int64(1), info.rangeSize / MIN_SEGMENT_SIZE);
+        const int64 segmentsCount = std::min(static_cast<int64>(info.segmentsCount), maxSegmentsCount);
+        const int64 segmentSize = (info.rangeSize + segmentsCount - 1) / segmentsCount;
+
+        for (int64 offset = 0; offset < info.rangeSize; offset += segmentSize)
+        {
+            Segment segment;
+            segment.offset = offset;
+            segment.size = std::min(segmentSize, info.rangeSize - offset);
+            segments.push_back(segment);
+        }
+    }
+
+    const bool resumed = LoadSegmentsState();
+    if (!resumed && !segmentsWriter->Resize(0))
+    {
+        OnErrorCurlErrno(errno, *this, __LINE__);
+        return;
+    }
+    // preallocate file, so segments can be written at any offset
+    if (!segmentsWriter->Resize(info.rangeSize))
+    {
+        OnErrorCurlErrno(errno, *this, __LINE__);
+        return;
+    }
+
+    status.sizeTotal = info.rangeSize;
+    status.sizeDownloaded = 0;
+    for (const Segment& segment : segments)
+    {
+        status.sizeDownloaded += segment.downloaded;
+    }
+
+    if (!resumed)
+    {
+        SaveSegmentsState();
+    }
+}
+
+bool DLCDownloaderImpl::Task::LoadSegmentsState()
+{
+    const FilePath statePath(GetSegmentsStatePath());
+    if (!GetEngineContext()->fileSystem->IsFile(statePath))
+    {
+        return false;
+    }
+
+    ScopedPtr<File> f(File::Create(statePath, File::OPEN | File::READ));
+    if (!f)
+    {
+        return false;
+    }
+
+    SegmentsStateHeader header;
+    if (f->Read(&header, sizeof(header)) != sizeof(header) ||
+        header.version != SEGMENTS_STATE_VERSION ||
+        header.segmentsCount != segments.size() ||
+        header.rangeOffset != info.rangeOffset ||
+        header.rangeSize != info.rangeSize)
+    {
+        // other file or other range, download from scratch
+        return false;
+    }
+
+    Vector<int64> downloaded(segments.size());
+    const uint32 downloadedSize = static_cast<uint32>(downloaded.size() * sizeof(int64));
+    if (f->Read(downloaded.data(), downloadedSize) != downloadedSize)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        segments[i].downloaded = Clamp(downloaded[i], int64(0), segments[i].size);
+    }
+    return true;
+}
+
+void DLCDownloaderImpl::Task::SaveSegmentsState()
+{
+    // data of segments should reach file before progress is saved
+    if (segmentsWriter != nullptr && !segmentsWriter->IsClosed())
+    {
+        segmentsWriter->Flush();
+    }
+
+    ScopedPtr<File> f(File::Create(GetSegmentsStatePath(), File::CREATE | File::WRITE));
+    if (!f)
+    {
+        Logger::Error("can't save segments state: %s", GetSegmentsStatePath().c_str());
+        return;
+    }
+
+    SegmentsStateHeader header;
+    header.segmentsCount = static_cast<uint32>(segments.size());
+    header.rangeOffset = info.rangeOffset;
+    header.rangeSize = info.rangeSize;
+    f->Write(&header, sizeof(header));
+    for (const Segment& segment : segments)
+    {
+        f->Write(&segment.downloaded, sizeof(segment.downloaded));
+    }
+
+    sizeSinceStateSave = 0;
+}
+
+bool DLCDownloaderImpl::Task::NeedDownloadMoreSegments() const
+{
+    if (!segmentsPlanned)
+    {
+        return info.rangeSize != -1;
+    }
+
+    for (const Segment& segment : segments)
+    {
+        if (!segment.running && segment.downloaded < segment.size)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DLCDownloaderImpl::Task::GenerateSegmentSubRequests()
+{
+    if (!segmentsPlanned)
+    {
+        PlanSegments();
+        if (status.error.errorHappened)
+        {
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < segments.size() && curlStorage.GetFreeHandleCount() > 0; ++i)
+    {
+        const Segment& segment = segments[i];
+        if (!segment.running && segment.downloaded < segment.size)
+        {
+            IDownloaderSubTask* subTask = new DownloadSegmentSubTask(*this, i);
+            subTasksWorking.push_back(subTask);
+        }
+    }
+}
+
+void DLCDownloaderImpl::Task::FinishSegmentedDownload()
+{
+    const bool allGood = FlushWriterAndReset();
+    if (!allGood)
+    {
+        OnErrorCurlErrno(errno, *this, __LINE__);
+    }
+    else if (VerifySegmentedDownload())
+    {
+        status.state = TaskState::Finished;
+    }
+}
+
+bool DLCDownloaderImpl::Task::VerifySegmentedDownload()
+{
+    FileSystem* fs = GetEngineContext()->fileSystem;
+
+    segmentsFinished = true;
+    fs->DeleteFile(GetSegmentsStatePath());
+
+    if (info.crc32 != 0 && CRC32::ForFile(info.dstPath) != info.crc32)
+    {
+        fs->DeleteFile(info.dstPath);
+        OnErrorCrc32(*this, __LINE__);
+        return false;
+    }
+    return true;
+}
+
+String DLCDownloaderImpl::Task::GetSegmentsStatePath() const
+{
+    return info.dstPath + segmentsStateExt;
+}
+
 bool DLCDownloaderImpl::TakeNewTaskFromInputList()
 {
     DAVA_PROFILER_CPU_SCOPE_CUSTOM(__FUNCTION__, hints.profiler);
@@ -1398,7 +1867,11 @@ void DLCDownloaderImpl::ConsumeSubTask(CURLMsg* curlMsg, CURL* easyHandle)
     {
         task.GenerateChunkSubRequests(hints.chunkMemBuffSize);
 
-        if (task.IsDone())
+        if (task.IsDone() && task.info.type == TaskType::SEGMENTED)
+        {
+            task.FinishSegmentedDownload();
+        }
+        else if (task.IsDone())
         {
             bool allGood = task.FlushWriterAndReset();
             if (allGood)
@@ -1542,6 +2015,19 @@ void DLCDownloaderImpl::Task::OnErrorHttpCode(long httpCode, Task& task, int32 l
     task.status.state = TaskState::Finished;
 }
 
+void DLCDownloaderImpl::Task::OnErrorCrc32(Task& task, int32 line)
+{
+    task.status.error.errorHappened = true;
+    task.status.error.crc32Mismatch = true;
+    task.status.error.errStr = "crc32 of downloaded file mismatch";
+
+    if (task.status.error.fileLine == 0)
+    {
+        task.status.error.fileLine = line;
+    }
+    task.status.state = TaskState::Finished;
+}
+
 void DLCDownloaderImpl::DownloadThreadFunc()
 {
     DVASSERT(hints.profiler != nullptr);
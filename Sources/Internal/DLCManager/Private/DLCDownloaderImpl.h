@@ -51,6 +51,8 @@ public:
 
     ITask* ResumeTask(const String& srcUrl, std::shared_ptr<IWriter> customWriter, Range range = EmptyRange) override;
 
+    ITask* StartSegmentedTask(const String& srcUrl, const String& dstPath, Range range, uint32 segmentsCount, uint32 crc32 = 0) override;
+
     // Cancel download by ID (works for scheduled and current)
     void RemoveTask(ITask* task) override;
 
@@ -78,7 +80,9 @@ private:
                         const String& dsrPath,
                         TaskType taskType,
                         std::shared_ptr<IWriter> dstWriter,
-                        Range range = EmptyRange);
+                        Range range = EmptyRange,
+                        uint32 segmentsCount = 0,
+                        uint32 crc32 = 0);
 
     // [start] implement ICurlEasyStorage interface
     CURL* CurlCreateHandle() override;
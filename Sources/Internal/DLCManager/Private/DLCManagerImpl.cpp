@@ -334,7 +334,6 @@ void DLCManagerImpl::ClearResouces()
 
     buffer.clear();
     uncompressedFileNames.clear();
-    mapFileData.clear();
     startFileNameIndexesInUncompressedNames.clear();
 
     if (downloadTask != nullptr)
@@ -441,6 +440,10 @@ void DLCManagerImpl::DumpInitialParams(const FilePath& dirToDownloadPacks, const
             << "        skipCDNConnectAfterAttemps: " << hints_.skipCDNConnectAfterAttempts << '\n'
             << "        downloaderMaxHandles: " << hints_.downloaderMaxHandles << '\n'
             << "        downloaderChankBufSize: " << hints_.downloaderChunkBufSize << '\n'
+            << "        coalesceMaxRangeSize: " << hints_.coalesceMaxRangeSize << '\n'
+            << "        coalesceMaxGapSize: " << hints_.coalesceMaxGapSize << '\n'
+            << "        segmentedDownloadMinSize: " << hints_.segmentedDownloadMinSize << '\n'
+            << "        downloadSegmentsCount: " << hints_.downloadSegmentsCount << '\n'
             << "    )\n"
             << ")\n";
 
@@ -1005,6 +1008,16 @@ void DLCManagerImpl::GetFooter()
                 return;
             }
 
+            if (initFooterOnServer.dictionarySize > 0)
+            {
+                // files are downloaded one by one into *.dvpl, which can't reference shared dictionary of superpack
+                initErrorMsg = "superpack is packed with shared dictionary, files compressed with it can't be loaded from DLC\n";
+                log << initErrorMsg;
+                Logger::Error("%s", initErrorMsg.c_str());
+                TestRetryCountLocalMetaAndGoTo(InitState::LoadingPacksDataFromLocalMeta, InitState::LoadingRequestAskFooter);
+                return;
+            }
+
             if (!SaveServerFooter())
             {
                 TestRetryCountLocalMetaAndGoTo(InitState::LoadingPacksDataFromLocalMeta, InitState::LoadingRequestAskFooter);
@@ -1920,6 +1933,8 @@ DLCManager::FileInfo DLCManagerImpl::GetFileInfo(const FilePath& path) const
         return fileInfo;
     }
 
+    fileInfo.relativePathInMeta = path.StartsWith("~res:/") ? path.GetRelativePathname("~res:/") : path.GetRelativePathname();
+
     if (HasLocalMeta())
     {
         // no information for local(static files in APK) files
@@ -1937,35 +1952,25 @@ DLCManager::FileInfo DLCManagerImpl::GetFileInfo(const FilePath& path) const
         const PackMetaData& meta = GetRemoteMeta();
         const FileNamesTree& remoteFilesTree = meta.GetFileNamesTree();
 
-        fileInfo.relativePathInMeta = path.StartsWith("~res:/") ? path.GetRelativePathname("~res:/") : path.GetRelativePathname();
-
-        if (remoteFilesTree.Find(fileInfo.relativePathInMeta))
+        // index of name in remote meta matches index of file in filesTable
+        const uint32 fileIndex = remoteFilesTree.FindIndex(fileInfo.relativePathInMeta);
+        if (fileIndex != FileNamesTree::NOT_FOUND)
         {
             fileInfo.isRemoteFile = true;
             fileInfo.isKnownFile = true;
 
-            const auto it = mapFileData.find(fileInfo.relativePathInMeta);
-            if (it != end(mapFileData))
-            {
-                const PackFormat::FileTableEntry* entry = it->second;
-
-                fileInfo.indexOfPackInMeta = entry->metaIndex;
-                const PackMetaData::PackInfo& packInfo = meta.GetPackInfo(entry->metaIndex);
-                fileInfo.packName = packInfo.packName;
-
-                const size_t indexInString = uncompressedFileNames.find(fileInfo.relativePathInMeta);
-                DVASSERT(indexInString != String::npos);
-                const String& str = uncompressedFileNames;
-                const size_t numOfNullChars = std::count(begin(str), begin(str) + indexInString + 1, '\0');
-                const uint32 fileIndex = static_cast<uint32>(numOfNullChars); // will match index of string and index of file in filesTable
-
-                fileInfo.indexOfFileInMeta = fileIndex;
-                fileInfo.hashCompressedInMeta = entry->compressedCrc32;
-                fileInfo.hashUncompressedInMeta = entry->originalCrc32;
-                fileInfo.sizeCompressedInMeta = entry->compressedSize;
-                fileInfo.sizeUncompressedInMeta = entry->originalSize;
-                fileInfo.isDlcMngThinkFileReady = IsFileReady(fileIndex);
-            }
+            const PackFormat::FileTableEntry& entry = GetPack().filesTable.data.files.at(fileIndex);
+
+            fileInfo.indexOfPackInMeta = entry.metaIndex;
+            const PackMetaData::PackInfo& packInfo = meta.GetPackInfo(entry.metaIndex);
+            fileInfo.packName = packInfo.packName;
+
+            fileInfo.indexOfFileInMeta = fileIndex;
+            fileInfo.hashCompressedInMeta = entry.compressedCrc32;
+            fileInfo.hashUncompressedInMeta = entry.originalCrc32;
+            fileInfo.sizeCompressedInMeta = entry.compressedSize;
+            fileInfo.sizeUncompressedInMeta = entry.originalSize;
+            fileInfo.isDlcMngThinkFileReady = IsFileReady(fileIndex);
         }
     }
     return fileInfo;
@@ -2240,9 +2245,7 @@ void DLCManagerImpl::ThreadScanFunc()
     // merge with meta
     // Yes! is pack loaded before meta
     const PackFormat::PackFile& pack = GetPack();
-
-    Vector<ResourceArchive::FileInfo> filesInfo;
-    PackArchive::FillFilesInfo(pack, uncompressedFileNames, mapFileData, filesInfo);
+    const FileNamesTree& remoteFilesTree = metaRemote->GetFileNamesTree();
 
     String relativeNameWithoutDvpl;
 
@@ -2256,14 +2259,14 @@ void DLCManagerImpl::ThreadScanFunc()
     for (const LocalFileInfo& info : localFiles)
     {
         relativeNameWithoutDvpl = info.relativeName.substr(0, info.relativeName.size() - 5);
-        const PackFormat::FileTableEntry* entry = mapFileData[relativeNameWithoutDvpl];
-        if (entry != nullptr)
+        const uint32 fileIndex = remoteFilesTree.FindIndex(relativeNameWithoutDvpl);
+        if (fileIndex != FileNamesTree::NOT_FOUND)
         {
-            if (entry->compressedCrc32 == info.crc32Hash &&
-                entry->compressedSize == info.compressedSize &&
-                entry->compressedSize + sizeof(PackFormat::LitePack::Footer) == info.sizeOnDevice)
+            const PackFormat::FileTableEntry& entry = pack.filesTable.data.files[fileIndex];
+            if (entry.compressedCrc32 == info.crc32Hash &&
+                entry.compressedSize == info.compressedSize &&
+                entry.compressedSize + sizeof(PackFormat::LitePack::Footer) == info.sizeOnDevice)
             {
-                size_t fileIndex = std::distance(&pack.filesTable.data.files[0], entry);
                 SetFileIsReady(fileIndex, info.compressedSize);
             }
             else
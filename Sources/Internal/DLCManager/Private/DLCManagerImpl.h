@@ -301,7 +301,6 @@ private:
     PackFormat::PackFile usedPackFile; // current superpack info
     Vector<uint8> buffer; // temp buff
     String uncompressedFileNames;
-    UnorderedMap<String, const PackFormat::FileTableEntry*> mapFileData;
     Vector<uint32> startFileNameIndexesInUncompressedNames;
     DLCDownloader::ITask* downloadTask = nullptr;
     uint64 fullSizeServerData = 0;
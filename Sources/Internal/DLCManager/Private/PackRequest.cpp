@@ -49,9 +49,22 @@ void PackRequest::CancelCurrentDownloadRequests()
         {
             downloader.RemoveTask(r.task);
             r.task = nullptr;
+            r.segmented = false;
             r.status = CheckLocalFile;
         }
     }
+
+    for (CoalescedRequest& c : coalescedRequests)
+    {
+        downloader.RemoveTask(c.task);
+        for (uint32 requestIndex : c.requestIndexes)
+        {
+            FileRequest& r = requests[requestIndex];
+            r.coalesced = false;
+            r.status = CheckLocalFile;
+        }
+    }
+    coalescedRequests.clear();
 }
 
 PackRequest::~PackRequest()
@@ -64,6 +77,7 @@ PackRequest::~PackRequest()
         packManager = nullptr;
     }
     requests.clear();
+    coalescedRequests.clear();
     fileIndexes.clear();
     requestedPackName.clear();
     delayedRequest = false;
@@ -351,6 +365,7 @@ bool operator==(const DLCDownloader::TaskError& errLeft, const DLCDownloader::Ta
     strcmp(errLeft.errStr, errRight.errStr) == 0 &&
     errLeft.fileErrno == errRight.fileErrno &&
     errLeft.httpCode == errRight.httpCode &&
+    errLeft.crc32Mismatch == errRight.crc32Mismatch &&
     errLeft.fileLine == errRight.fileLine;
 }
 
@@ -387,6 +402,14 @@ bool PackRequest::CheckLoadingStatusOfFileRequest(FileRequest& fileRequest, DLCD
             fileRequest.task = nullptr;
             fileRequest.dvplWriter.reset();
 
+            if (!status.error.errorHappened && fileRequest.segmented && !FinishSegmentedFile(fileRequest))
+            {
+                status.error.errorHappened = true;
+                status.error.fileErrno = errno;
+                status.error.errStr = "can't finish segmented dvpl";
+            }
+            fileRequest.segmented = false;
+
             if (status.error.errorHappened)
             {
                 // log same error only once, stop spam
@@ -433,8 +456,30 @@ bool PackRequest::CheckLoadingStatusOfFileRequest(FileRequest& fileRequest, DLCD
 
 bool PackRequest::LoadingPackFileState(FileSystem* fs, FileRequest& fileRequest)
 {
+    if (fileRequest.coalesced)
+    {
+        // downloading with other files, see UpdateCoalescedRequests
+        return false;
+    }
+
     DLCDownloader& dm = packManager->GetDownloader();
     String dstPath = fileRequest.localFile.GetAbsolutePathname();
+    if (fileRequest.task == nullptr && IsSegmentedDownload(fileRequest))
+    {
+        // data is written at segment offsets, crc32 is checked by downloader, footer is added in FinishSegmentedFile
+        const DLCManager::Hints& hints = packManager->GetHints();
+        DLCDownloader::Range range = DLCDownloader::Range(fileRequest.startLoadingPos, fileRequest.sizeOfCompressedFile);
+        fileRequest.task = dm.StartSegmentedTask(fileRequest.url, dstPath, range, hints.downloadSegmentsCount, fileRequest.compressedCrc32);
+        fileRequest.segmented = fileRequest.task != nullptr;
+
+        if (nullptr == fileRequest.task)
+        {
+            Logger::Error("can't create segmented task: url: %s, dstPath: %s, range: %lld-%lld", fileRequest.url.c_str(), dstPath.c_str(), fileRequest.sizeOfCompressedFile, fileRequest.startLoadingPos);
+            fileRequest.status = CheckLocalFile; // lets start all over again
+        }
+        return false;
+    }
+
     if (fileRequest.task == nullptr)
     {
         fileRequest.dvplWriter.reset(new DVPLWriter(fileRequest.localFile,
@@ -457,6 +502,50 @@ bool PackRequest::LoadingPackFileState(FileSystem* fs, FileRequest& fileRequest)
     return CheckLoadingStatusOfFileRequest(fileRequest, dm, dstPath);
 }
 
+bool PackRequest::IsSegmentedDownload(const FileRequest& fileRequest) const
+{
+    const DLCManager::Hints& hints = packManager->GetHints();
+    return hints.segmentedDownloadMinSize > 0 &&
+    hints.downloadSegmentsCount > 1 &&
+    fileRequest.sizeOfCompressedFile >= hints.segmentedDownloadMinSize;
+}
+
+bool PackRequest::FinishSegmentedFile(FileRequest& fileRequest)
+{
+    const FilePath& localPath = fileRequest.localFile;
+    {
+        ScopedPtr<File> f(File::Create(localPath, File::APPEND | File::WRITE));
+        if (!f)
+        {
+            Logger::Error("can't open downloaded file: %s", localPath.GetStringValue().c_str());
+            return false;
+        }
+
+        // write 20 bytes LitePack footer
+        PackFormat::LitePack::Footer footer = { static_cast<uint32>(fileRequest.sizeOfUncompressedFile),
+                                                static_cast<uint32>(fileRequest.sizeOfCompressedFile),
+                                                fileRequest.compressedCrc32,
+                                                fileRequest.compressionType,
+                                                PackFormat::FILE_MARKER_LITE };
+        if (f->Write(&footer, sizeof(footer)) != sizeof(footer))
+        {
+            Logger::Error("failed to write footer to dvpl: %s", localPath.GetStringValue().c_str());
+            return false;
+        }
+    }
+
+    FilePath newPath(localPath);
+    newPath.ReplaceExtension("");
+
+    FileSystem* fs = GetEngineContext()->fileSystem;
+    if (!fs->MoveFile(localPath, newPath, true))
+    {
+        Logger::Error("failed to move file: %s to %s", localPath.GetStringValue().c_str(), newPath.GetStringValue().c_str());
+        return false;
+    }
+    return true;
+}
+
 bool PackRequest::UpdateFileRequests()
 {
     DAVA_PROFILER_CPU_SCOPE_CUSTOM(__FUNCTION__, &packManager->profiler);
@@ -467,6 +556,8 @@ bool PackRequest::UpdateFileRequests()
 
     FileSystem* fs = GetEngineContext()->fileSystem;
 
+    StartCoalescedRequests(fs);
+
     for (FileRequest& fileRequest : requests)
     {
         bool downloadedMore = false;
@@ -499,10 +590,193 @@ bool PackRequest::UpdateFileRequests()
         }
     } // end for requests
 
+    if (UpdateCoalescedRequests())
+    {
+        callUpdateSignal = true;
+    }
+
     // call signal only once during update
     return callUpdateSignal;
 }
 
+void PackRequest::StartCoalescedRequests(FileSystem* fs)
+{
+    const DLCManager::Hints& hints = packManager->GetHints();
+    if (hints.coalesceMaxRangeSize == 0)
+    {
+        return;
+    }
+
+    // files partially downloaded before are resumed one by one
+    Vector<uint32> candidates;
+    for (uint32 i = 0; i < static_cast<uint32>(requests.size()); ++i)
+    {
+        const FileRequest& r = requests[i];
+        if (r.status == LoadingPackFile && r.task == nullptr && !r.coalesced && !r.skipCoalescing &&
+            r.sizeOfCompressedFile > 0 && !IsSegmentedDownload(r) && !fs->IsFile(r.localFile))
+        {
+            candidates.push_back(i);
+        }
+    }
+
+    if (candidates.size() < 2)
+    {
+        return;
+    }
+
+    std::sort(begin(candidates), end(candidates), [this](uint32 left, uint32 right) {
+        return requests[left].startLoadingPos < requests[right].startLoadingPos;
+    });
+
+    Vector<uint32> group;
+    for (uint32 requestIndex : candidates)
+    {
+        const FileRequest& next = requests[requestIndex];
+        if (!group.empty())
+        {
+            const FileRequest& first = requests[group.front()];
+            const FileRequest& prev = requests[group.back()];
+            const uint64 prevEnd = prev.startLoadingPos + prev.sizeOfCompressedFile;
+            const uint64 nextEnd = next.startLoadingPos + next.sizeOfCompressedFile;
+
+            if (next.startLoadingPos < prevEnd ||
+                next.startLoadingPos - prevEnd > hints.coalesceMaxGapSize ||
+                nextEnd - first.startLoadingPos > hints.coalesceMaxRangeSize)
+            {
+                if (group.size() > 1)
+                {
+                    StartCoalescedRequest(group);
+                }
+                group.clear();
+            }
+        }
+        group.push_back(requestIndex);
+    }
+
+    if (group.size() > 1)
+    {
+        StartCoalescedRequest(group);
+    }
+}
+
+void PackRequest::StartCoalescedRequest(const Vector<uint32>& requestIndexes)
+{
+    const FileRequest& first = requests[requestIndexes.front()];
+    const FileRequest& last = requests[requestIndexes.back()];
+    const uint64 rangeBegin = first.startLoadingPos;
+    const uint64 rangeEnd = last.startLoadingPos + last.sizeOfCompressedFile;
+
+    Vector<CoalescedWriter::Part> parts;
+    parts.reserve(requestIndexes.size());
+    for (uint32 requestIndex : requestIndexes)
+    {
+        FileRequest& r = requests[requestIndex];
+
+        CoalescedWriter::Part part;
+        part.offset = r.startLoadingPos - rangeBegin;
+        part.size = r.sizeOfCompressedFile;
+        part.writer = std::make_shared<DVPLWriter>(r.localFile,
+                                                   static_cast<uint32>(r.sizeOfCompressedFile),
+                                                   static_cast<uint32>(r.sizeOfUncompressedFile),
+                                                   r.compressedCrc32,
+                                                   r.compressionType);
+        parts.push_back(std::move(part));
+    }
+
+    CoalescedRequest coalescedRequest;
+    coalescedRequest.requestIndexes = requestIndexes;
+    coalescedRequest.writer = std::make_shared<CoalescedWriter>(std::move(parts));
+
+    DLCDownloader& dm = packManager->GetDownloader();
+    DLCDownloader::Range range(rangeBegin, rangeEnd - rangeBegin);
+    coalescedRequest.task = dm.ResumeTask(first.url, coalescedRequest.writer, range);
+    if (coalescedRequest.task == nullptr)
+    {
+        Logger::Error("can't create task: url: %s, range: %llu-%llu", first.url.c_str(), rangeBegin, rangeEnd);
+        return; // files will be downloaded one by one
+    }
+
+    for (uint32 requestIndex : requestIndexes)
+    {
+        requests[requestIndex].coalesced = true;
+    }
+    coalescedRequests.push_back(std::move(coalescedRequest));
+}
+
+bool PackRequest::UpdateCoalescedRequests()
+{
+    DLCDownloader& dm = packManager->GetDownloader();
+    bool downloadedMore = false;
+
+    for (auto it = coalescedRequests.begin(); it != coalescedRequests.end();)
+    {
+        CoalescedRequest& c = *it;
+        DLCDownloader::TaskStatus status = dm.GetTaskStatus(c.task);
+        if (status.state != DLCDownloader::TaskState::Finished)
+        {
+            // report progress of every file, not only of whole range
+            for (size_t i = 0; i < c.requestIndexes.size(); ++i)
+            {
+                FileRequest& r = requests[c.requestIndexes[i]];
+                uint64 receivedSize = c.writer->GetReceivedSize(i);
+                if (r.downloadedFileSize != receivedSize)
+                {
+                    r.downloadedFileSize = receivedSize;
+                    downloadedMore = true;
+                }
+            }
+            ++it;
+            continue;
+        }
+
+        dm.RemoveTask(c.task);
+        c.task = nullptr;
+
+        if (status.error.errorHappened)
+        {
+            if (prevTaskError != status.error)
+            {
+                packManager->GetLog() << "coalesced request failed: files: " << c.requestIndexes.size() << " status: " << status << std::endl;
+                prevTaskError = status.error;
+            }
+
+            if (status.error.curlErr != 0 || status.error.curlMErr != 0 || status.error.httpCode >= 400)
+            {
+                packManager->FireNetworkReady(false);
+            }
+        }
+        else
+        {
+            packManager->FireNetworkReady(true);
+        }
+
+        // files completed before error are ready, the rest are downloaded one by one
+        const Vector<CoalescedWriter::Part>& parts = c.writer->GetParts();
+        for (size_t i = 0; i < c.requestIndexes.size(); ++i)
+        {
+            FileRequest& r = requests[c.requestIndexes[i]];
+            r.coalesced = false;
+            if (parts[i].written)
+            {
+                r.downloadedFileSize = r.sizeOfCompressedFile;
+                r.status = Ready;
+                packManager->SetFileIsReady(r.fileIndex, static_cast<uint32>(r.sizeOfCompressedFile));
+                downloadedMore = true;
+            }
+            else
+            {
+                r.downloadedFileSize = 0;
+                r.status = LoadingPackFile;
+                r.skipCoalescing = true;
+            }
+        }
+
+        it = coalescedRequests.erase(it);
+    }
+
+    return downloadedMore;
+}
+
 bool PackRequest::DVPLWriter::OpenFile()
 {
     DVASSERT(!fout.is_open());
@@ -668,4 +942,95 @@ bool PackRequest::DVPLWriter::IsClosed() const
     return !fout.is_open();
 }
 
+PackRequest::CoalescedWriter::CoalescedWriter(Vector<Part> parts_)
+    : parts(std::move(parts_))
+    , receivedSizes(parts.size())
+{
+}
+
+uint64 PackRequest::CoalescedWriter::Save(const void* ptr, uint64 size)
+{
+    const char* data = static_cast<const char*>(ptr);
+    uint64 rest = size;
+
+    while (rest > 0 && currentPart < parts.size())
+    {
+        Part& part = parts[currentPart];
+        uint64 count = 0;
+        if (position < part.offset)
+        {
+            // skip bytes of files between requested ones
+            count = std::min(rest, part.offset - position);
+        }
+        else
+        {
+            count = std::min(rest, part.offset + part.size - position);
+            if (part.writer->Save(data, count) != count)
+            {
+                return size - rest;
+            }
+            receivedSizes[currentPart] += count;
+        }
+
+        data += count;
+        rest -= count;
+        position += count;
+        CloseReceivedParts();
+    }
+
+    position += rest;
+    return size;
+}
+
+uint64 PackRequest::CoalescedWriter::GetSeekPos()
+{
+    return position;
+}
+
+bool PackRequest::CoalescedWriter::Truncate()
+{
+    // files can't be taken back after they are moved
+    return position == 0;
+}
+
+bool PackRequest::CoalescedWriter::Close()
+{
+    if (!closed)
+    {
+        closed = true;
+        // not completed files fail checks and are deleted by DVPLWriter
+        for (; currentPart < parts.size(); ++currentPart)
+        {
+            parts[currentPart].writer->Close();
+        }
+    }
+    return true;
+}
+
+bool PackRequest::CoalescedWriter::IsClosed() const
+{
+    return closed;
+}
+
+const Vector<PackRequest::CoalescedWriter::Part>& PackRequest::CoalescedWriter::GetParts() const
+{
+    return parts;
+}
+
+uint64 PackRequest::CoalescedWriter::GetReceivedSize(size_t partIndex) const
+{
+    return receivedSizes[partIndex];
+}
+
+void PackRequest::CoalescedWriter::CloseReceivedParts()
+{
+    while (currentPart < parts.size() && position >= parts[currentPart].offset + parts[currentPart].size)
+    {
+        Part& part = parts[currentPart];
+        part.written = part.writer->Close();
+        part.writer.reset();
+        ++currentPart;
+    }
+}
+
 } // end namespace DAVA
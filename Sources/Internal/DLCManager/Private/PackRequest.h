@@ -6,6 +6,7 @@
 #include "Compression/Compressor.h"
 #include "Utils/CRC32.h"
 
+#include <atomic>
 #include <fstream>
 
 namespace DAVA
@@ -111,6 +112,46 @@ private:
         const Compressor::Type compressionType;
     };
 
+    /**
+	   CoalescedWriter splits one downloaded range of superpack into files.
+	   Adjacent files of a pack are downloaded with one HTTP request instead of
+	   request per file. Bytes between files (other packs files not bigger
+	   than Hints::coalesceMaxGapSize) are skipped. Every file is checked
+	   and moved by its DVPLWriter as soon as its last byte is received.
+	*/
+    class CoalescedWriter final : public DLCDownloader::IWriter
+    {
+    public:
+        struct Part
+        {
+            uint64 offset = 0; // relative to begin of downloaded range
+            uint64 size = 0;
+            std::shared_ptr<DVPLWriter> writer;
+            bool written = false; // file fully received, crc32 is correct and file is moved
+        };
+
+        explicit CoalescedWriter(Vector<Part> parts_);
+
+        uint64 Save(const void* ptr, uint64 size) final;
+        uint64 GetSeekPos() final;
+        bool Truncate() final;
+        bool Close() final;
+        bool IsClosed() const final;
+
+        const Vector<Part>& GetParts() const;
+        /** Return count of bytes of part received so far, can be called while range is downloading */
+        uint64 GetReceivedSize(size_t partIndex) const;
+
+    private:
+        void CloseReceivedParts();
+
+        Vector<Part> parts;
+        Vector<std::atomic<uint64>> receivedSizes; // written by downloader thread, read by main thread
+        size_t currentPart = 0;
+        uint64 position = 0;
+        bool closed = false;
+    };
+
     struct FileRequest
     {
         FileRequest() = default;
@@ -138,16 +179,32 @@ private:
         Compressor::Type compressionType = Compressor::Type::Lz4HC;
         Status status = CheckLocalFile;
         std::shared_ptr<DVPLWriter> dvplWriter;
+        bool coalesced = false; // downloading as a part of CoalescedRequest
+        bool skipCoalescing = false; // coalesced download of file failed, download it alone
+        bool segmented = false; // big file downloaded with several range requests directly into .part file
+    };
+
+    struct CoalescedRequest
+    {
+        Vector<uint32> requestIndexes; // indexes of file requests in order of their position in superpack
+        DLCDownloader::ITask* task = nullptr;
+        std::shared_ptr<CoalescedWriter> writer;
     };
 
     bool CheckLocalFileState(FileSystem* fs, FileRequest& fileRequest);
     bool CheckLoadingStatusOfFileRequest(FileRequest& fileRequest, DLCDownloader& dm, const String& dstPath);
     bool LoadingPackFileState(FileSystem* fs, FileRequest& fileRequest);
+    bool IsSegmentedDownload(const FileRequest& fileRequest) const;
+    bool FinishSegmentedFile(FileRequest& fileRequest);
     bool UpdateFileRequests();
+    void StartCoalescedRequests(FileSystem* fs);
+    void StartCoalescedRequest(const Vector<uint32>& requestIndexes);
+    bool UpdateCoalescedRequests();
 
     DLCManagerImpl* packManager = nullptr;
 
     Vector<FileRequest> requests;
+    Vector<CoalescedRequest> coalescedRequests;
     Vector<uint32> fileIndexes;
     String requestedPackName;
 
@@ -4,7 +4,10 @@
 #include "Concurrency/LockGuard.h"
 #include "Base/AllocatorFactory.h"
 #include "Debug/DVAssert.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
 #include "ProfilerRingArray.h"
+#include "ProfilerThreadBuffer.h"
 #include <ostream>
 
 //==============================================================================
@@ -31,6 +34,27 @@ struct ProfilerCPU::Counter
     uint32 frame = 0;
 };
 
+struct ProfilerCPU::CaptureEvent
+{
+    enum eType : uint8
+    {
+        TYPE_COUNTER = 0,
+        TYPE_FRAME,
+        TYPE_VALUE,
+        TYPE_FLOW_BEGIN,
+        TYPE_FLOW_END,
+        TYPE_DROPPED,
+
+        TYPE_COUNT
+    };
+
+    uint64 timestamp = 0;
+    uint64 value = 0; //duration for counter, value for counter value, id for flow
+    const char* name = nullptr;
+    uint32 frame = 0;
+    uint8 type = TYPE_COUNTER;
+};
+
 namespace ProfilerCPUDetails
 {
 struct CounterTreeNode
@@ -60,6 +84,32 @@ protected:
     uint32 count; //recursive and duplicate counters
 };
 
+//Capture file layout:
+// header: CAPTURE_MAGIC, CAPTURE_VERSION
+// sequence of records, each starts with uint8 record type:
+//  RECORD_NAME:  uint32 nameID, uint32 length, char[length]
+//  RECORD_EVENT: uint8 eventType, uint32 nameID, uint64 threadID, uint64 timestamp, uint64 value, uint32 frame
+static const uint32 CAPTURE_MAGIC = 0x50435044; // 'DPCP'
+static const uint32 CAPTURE_VERSION = 1;
+static const uint32 CAPTURE_BUFFER_SIZE = 16384; //events per thread between two flushes
+static const uint8 RECORD_NAME = 0;
+static const uint8 RECORD_EVENT = 1;
+static const uint32 DROPPED_NAME_ID = 0;
+static const char* DROPPED_NAME = "ProfilerDroppedEvents";
+
+template <class T>
+void AppendPOD(Vector<uint8>& data, const T& value)
+{
+    const uint8* ptr = reinterpret_cast<const uint8*>(&value);
+    data.insert(data.end(), ptr, ptr + sizeof(T));
+}
+
+template <class T>
+bool ReadPOD(File* file, T& value)
+{
+    return file->Read(&value, uint32(sizeof(T))) == sizeof(T);
+}
+
 bool NameEquals(const char* name1, const char* name2)
 {
 #ifdef __DAVAENGINE_DEBUG__
@@ -74,9 +124,16 @@ const FastName ProfilerCPU::TRACE_ARG_FRAME("Frame Number");
 
 //////////////////////////////////////////////////////////////////////////
 
-ProfilerCPU::ScopedCounter::ScopedCounter(const char* counterName, ProfilerCPU* _profiler, uint32 frame)
+ProfilerCPU::ScopedCounter::ScopedCounter(const char* counterName, ProfilerCPU* _profiler, uint32 _frame)
+    : name(counterName)
+    , frame(_frame)
 {
     profiler = _profiler;
+    if (profiler->isCapturing)
+    {
+        captureStartTime = SystemTimer::GetUs();
+    }
+
     if (profiler->isStarted)
     {
         Counter& c = profiler->counters->next();
@@ -86,7 +143,7 @@ ProfilerCPU::ScopedCounter::ScopedCounter(const char* counterName, ProfilerCPU*
         c.endTime = 0;
         c.name = counterName;
         c.threadID = Thread::GetCurrentIdAsUInt64();
-        c.frame = frame;
+        c.frame = _frame;
     }
 }
 
@@ -101,15 +158,35 @@ ProfilerCPU::ScopedCounter::~ScopedCounter()
     {
         *endTime = SystemTimer::GetUs();
     }
+
+    if (profiler->isCapturing && captureStartTime != 0)
+    {
+        CaptureEvent event;
+        event.timestamp = captureStartTime;
+        event.value = SystemTimer::GetUs() - captureStartTime;
+        event.name = name;
+        event.frame = frame;
+        event.type = CaptureEvent::TYPE_COUNTER;
+        profiler->PushCaptureEvent(event);
+    }
 }
 
 ProfilerCPU::ProfilerCPU(uint32 numCounters_)
     : numCounters(numCounters_)
+    , threadCaptureBuffer([](CaptureBuffer*) {})
 {
 }
 
 ProfilerCPU::~ProfilerCPU()
 {
+    StopCapture();
+
+    for (CaptureBuffer*& b : captureBuffers)
+    {
+        SafeDelete(b);
+    }
+    captureBuffers.clear();
+
     DeleteSnapshots();
     SafeDelete(counters);
 }
@@ -358,6 +435,314 @@ const ProfilerCPU::CounterArray* ProfilerCPU::GetCounterArray(int32 snapshot) co
     return counters;
 }
 
+bool ProfilerCPU::StartCapture(const FilePath& capturePath)
+{
+    LockGuard<Mutex> lock(captureMutex);
+    if (isCapturing)
+    {
+        return true;
+    }
+
+    FileSystem::Instance()->CreateDirectory(capturePath.GetDirectory(), true);
+    captureFile = File::Create(capturePath, File::CREATE | File::WRITE);
+    if (captureFile == nullptr)
+    {
+        return false;
+    }
+
+    //Drop events left from previous capture
+    for (CaptureBuffer* buffer : captureBuffers)
+    {
+        buffer->Consume([](const CaptureEvent&) {});
+        buffer->TakeDroppedCount();
+    }
+
+    captureNames.clear();
+    captureData.clear();
+
+    using namespace ProfilerCPUDetails;
+    AppendPOD(captureData, CAPTURE_MAGIC);
+    AppendPOD(captureData, CAPTURE_VERSION);
+
+    AppendPOD(captureData, RECORD_NAME);
+    AppendPOD(captureData, DROPPED_NAME_ID);
+    AppendPOD(captureData, uint32(strlen(DROPPED_NAME)));
+    captureData.insert(captureData.end(), DROPPED_NAME, DROPPED_NAME + strlen(DROPPED_NAME));
+
+    isCapturing = true;
+    return true;
+}
+
+void ProfilerCPU::StopCapture()
+{
+    LockGuard<Mutex> lock(captureMutex);
+    if (isCapturing)
+    {
+        isCapturing = false;
+        FlushCapture();
+        SafeRelease(captureFile);
+        captureNames.clear();
+        captureData.clear();
+    }
+}
+
+bool ProfilerCPU::IsCapturing() const
+{
+    return isCapturing;
+}
+
+void ProfilerCPU::MarkFrame(uint32 frameIndex)
+{
+    if (isCapturing)
+    {
+        CaptureEvent event;
+        event.timestamp = SystemTimer::GetUs();
+        event.name = "Frame";
+        event.frame = frameIndex;
+        event.type = CaptureEvent::TYPE_FRAME;
+        PushCaptureEvent(event);
+
+        LockGuard<Mutex> lock(captureMutex);
+        if (isCapturing)
+        {
+            FlushCapture();
+        }
+    }
+}
+
+void ProfilerCPU::AddCounterValue(const char* counterName, uint32 value)
+{
+    if (isCapturing)
+    {
+        CaptureEvent event;
+        event.timestamp = SystemTimer::GetUs();
+        event.value = value;
+        event.name = counterName;
+        event.type = CaptureEvent::TYPE_VALUE;
+        PushCaptureEvent(event);
+    }
+}
+
+void ProfilerCPU::AddFlowBegin(const char* flowName, uint64 flowID)
+{
+    if (isCapturing)
+    {
+        CaptureEvent event;
+        event.timestamp = SystemTimer::GetUs();
+        event.value = flowID;
+        event.name = flowName;
+        event.type = CaptureEvent::TYPE_FLOW_BEGIN;
+        PushCaptureEvent(event);
+    }
+}
+
+void ProfilerCPU::AddFlowEnd(const char* flowName, uint64 flowID)
+{
+    if (isCapturing)
+    {
+        CaptureEvent event;
+        event.timestamp = SystemTimer::GetUs();
+        event.value = flowID;
+        event.name = flowName;
+        event.type = CaptureEvent::TYPE_FLOW_END;
+        PushCaptureEvent(event);
+    }
+}
+
+ProfilerCPU::CaptureBuffer* ProfilerCPU::GetCaptureBuffer()
+{
+    CaptureBuffer* buffer = threadCaptureBuffer.Get();
+    if (buffer == nullptr)
+    {
+        buffer = new CaptureBuffer(ProfilerCPUDetails::CAPTURE_BUFFER_SIZE, Thread::GetCurrentIdAsUInt64());
+        threadCaptureBuffer.Reset(buffer);
+
+        LockGuard<Mutex> lock(captureMutex);
+        captureBuffers.push_back(buffer);
+    }
+
+    return buffer;
+}
+
+void ProfilerCPU::PushCaptureEvent(const CaptureEvent& event)
+{
+    GetCaptureBuffer()->Push(event);
+}
+
+void ProfilerCPU::FlushCapture()
+{
+    //Should be called under captureMutex
+    using namespace ProfilerCPUDetails;
+
+    auto writeEvent = [this](const CaptureEvent& event, uint32 nameID, uint64 threadID) {
+        AppendPOD(captureData, RECORD_EVENT);
+        AppendPOD(captureData, event.type);
+        AppendPOD(captureData, nameID);
+        AppendPOD(captureData, threadID);
+        AppendPOD(captureData, event.timestamp);
+        AppendPOD(captureData, event.value);
+        AppendPOD(captureData, event.frame);
+    };
+
+    for (CaptureBuffer* buffer : captureBuffers)
+    {
+        uint64 threadID = buffer->GetThreadID();
+        uint64 lastTimestamp = 0;
+
+        buffer->Consume([&](const CaptureEvent& event) {
+            auto found = captureNames.find(event.name);
+            uint32 nameID = 0;
+            if (found == captureNames.end())
+            {
+                nameID = uint32(captureNames.size()) + 1; //0 is reserved by DROPPED_NAME_ID
+                captureNames.emplace(event.name, nameID);
+
+                uint32 length = uint32(strlen(event.name));
+                AppendPOD(captureData, RECORD_NAME);
+                AppendPOD(captureData, nameID);
+                AppendPOD(captureData, length);
+                captureData.insert(captureData.end(), event.name, event.name + length);
+            }
+            else
+            {
+                nameID = found->second;
+            }
+
+            writeEvent(event, nameID, threadID);
+            lastTimestamp = event.timestamp;
+        });
+
+        uint32 dropped = buffer->TakeDroppedCount();
+        if (dropped != 0)
+        {
+            CaptureEvent event;
+            event.timestamp = (lastTimestamp != 0) ? lastTimestamp : SystemTimer::GetUs();
+            event.value = dropped;
+            event.type = CaptureEvent::TYPE_DROPPED;
+            writeEvent(event, DROPPED_NAME_ID, threadID);
+        }
+    }
+
+    if (!captureData.empty() && captureFile != nullptr)
+    {
+        captureFile->Write(captureData.data(), uint32(captureData.size()));
+        captureFile->Flush();
+        captureData.clear();
+    }
+}
+
+bool ProfilerCPU::ConvertCaptureToTrace(const FilePath& capturePath, Vector<TraceEvent>& trace)
+{
+    using namespace ProfilerCPUDetails;
+
+    ScopedPtr<File> file(File::Create(capturePath, File::OPEN | File::READ));
+    if (!file)
+    {
+        return false;
+    }
+
+    uint32 magic = 0, version = 0;
+    if (!ReadPOD(file.get(), magic) || !ReadPOD(file.get(), version) || magic != CAPTURE_MAGIC || version != CAPTURE_VERSION)
+    {
+        return false;
+    }
+
+    static const FastName valueArgName("value");
+    static const FastName droppedArgName("count");
+
+    UnorderedMap<uint32, FastName> names;
+    uint8 recordType = 0;
+    while (ReadPOD(file.get(), recordType))
+    {
+        if (recordType == RECORD_NAME)
+        {
+            uint32 nameID = 0, length = 0;
+            if (!ReadPOD(file.get(), nameID) || !ReadPOD(file.get(), length))
+            {
+                return false;
+            }
+
+            String name(length, '\0');
+            if (length != 0 && file->Read(&name[0], length) != length)
+            {
+                return false;
+            }
+
+            names[nameID] = FastName(name);
+        }
+        else if (recordType == RECORD_EVENT)
+        {
+            uint8 eventType = 0;
+            uint32 nameID = 0, frame = 0;
+            uint64 threadID = 0, timestamp = 0, value = 0;
+            if (!ReadPOD(file.get(), eventType) || !ReadPOD(file.get(), nameID) || !ReadPOD(file.get(), threadID) ||
+                !ReadPOD(file.get(), timestamp) || !ReadPOD(file.get(), value) || !ReadPOD(file.get(), frame))
+            {
+                return false;
+            }
+
+            TraceEvent event = { names[nameID], timestamp, 0, threadID, 0, TraceEvent::PHASE_INSTANCE };
+            switch (eventType)
+            {
+            case CaptureEvent::TYPE_COUNTER:
+                event.phase = TraceEvent::PHASE_DURATION;
+                event.duration = value;
+                if (frame)
+                {
+                    event.args.push_back({ TRACE_ARG_FRAME, frame });
+                }
+                break;
+
+            case CaptureEvent::TYPE_FRAME:
+                event.args.push_back({ TRACE_ARG_FRAME, frame });
+                break;
+
+            case CaptureEvent::TYPE_VALUE:
+                event.phase = TraceEvent::PHASE_COUNTER;
+                event.args.push_back({ valueArgName, uint32(value) });
+                break;
+
+            case CaptureEvent::TYPE_FLOW_BEGIN:
+                event.phase = TraceEvent::PHASE_FLOW_BEGIN;
+                event.id = value;
+                break;
+
+            case CaptureEvent::TYPE_FLOW_END:
+                event.phase = TraceEvent::PHASE_FLOW_END;
+                event.id = value;
+                break;
+
+            case CaptureEvent::TYPE_DROPPED:
+                event.args.push_back({ droppedArgName, uint32(value) });
+                break;
+
+            default:
+                return false;
+            }
+
+            trace.push_back(std::move(event));
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ProfilerCPU::ConvertCaptureToJSON(const FilePath& capturePath, const FilePath& jsonPath)
+{
+    Vector<TraceEvent> trace;
+    if (ConvertCaptureToTrace(capturePath, trace))
+    {
+        TraceEvent::DumpJSON(trace, jsonPath);
+        return true;
+    }
+
+    return false;
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 //Internal Definition
 namespace ProfilerCPUDetails
@@ -14,6 +14,8 @@ const char* ENGINE_UPDATE_WINDOW = "Engine::UpdateWindow";
 const char* ENGINE_DRAW_WINDOW = "Engine::DrawWindow";
 
 const char* JOB_MANAGER = "JobManager";
+const char* JOB_WORKER_JOB = "JobManager::WorkerJob";
+const char* JOB_WORKER_JOBS_COUNT = "JobManager::WorkerJobsCount";
 const char* SOUND_SYSTEM = "SoundSystem";
 const char* ANIMATION_MANAGER = "AnimationManager";
 const char* UI_UPDATE = "UI::Update";
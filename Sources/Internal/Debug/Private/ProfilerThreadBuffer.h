@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/MathHelpers.h"
+#include "Debug/DVAssert.h"
+#include <atomic>
+
+namespace DAVA
+{
+//////////////////////////////////////////////////////////////////////////
+// Lock-free single-producer/single-consumer ring buffer.
+// Every recording thread owns its own buffer, so producer never contends
+// with other threads. Consumer is the capture flush, which is serialized
+// by profiler. If consumer doesn't keep up, new elements are dropped
+// (and counted) instead of overwriting not yet consumed ones.
+//////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class ProfilerThreadBuffer
+{
+public:
+    ProfilerThreadBuffer(uint32 _size, uint64 _threadID)
+        : threadID(_threadID)
+    {
+        DVASSERT(IsPowerOf2(_size) && "Size of ProfilerThreadBuffer should be pow of two");
+        mask = _size - 1;
+        elements = new T[_size];
+    }
+    ~ProfilerThreadBuffer()
+    {
+        SafeDeleteArray(elements);
+    }
+
+    ProfilerThreadBuffer(const ProfilerThreadBuffer&) = delete;
+    ProfilerThreadBuffer& operator=(const ProfilerThreadBuffer&) = delete;
+
+    //Should be called only from owner thread
+    bool Push(const T& value)
+    {
+        uint32 write = writeIndex.load(std::memory_order_relaxed);
+        uint32 read = readIndex.load(std::memory_order_acquire);
+        if (write - read > mask)
+        {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        elements[write & mask] = value;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    //Should be called only from one consumer thread at a time
+    template <class F>
+    uint32 Consume(F fn)
+    {
+        uint32 read = readIndex.load(std::memory_order_relaxed);
+        uint32 write = writeIndex.load(std::memory_order_acquire);
+        uint32 count = write - read;
+        for (; read != write; ++read)
+        {
+            fn(elements[read & mask]);
+        }
+        readIndex.store(read, std::memory_order_release);
+        return count;
+    }
+
+    uint32 TakeDroppedCount()
+    {
+        return droppedCount.exchange(0, std::memory_order_relaxed);
+    }
+
+    uint64 GetThreadID() const
+    {
+        return threadID;
+    }
+
+private:
+    T* elements = nullptr;
+    uint32 mask = 0;
+    uint64 threadID = 0;
+
+    std::atomic<uint32> writeIndex{ 0 };
+    std::atomic<uint32> readIndex{ 0 };
+    std::atomic<uint32> droppedCount{ 0 };
+};
+
+} //ns DAVA
@@ -3,6 +3,9 @@
 #include "Base/BaseTypes.h"
 #include "Debug/TraceEvent.h"
 #include "Concurrency/Mutex.h"
+#include "Concurrency/ThreadLocalPtr.h"
+#include "FileSystem/FilePath.h"
+#include <atomic>
 #include <iosfwd>
 
 #ifndef PROFILER_CPU_ENABLED
@@ -13,6 +16,9 @@ namespace DAVA
 {
 template <class T>
 class ProfilerRingArray;
+template <class T>
+class ProfilerThreadBuffer;
+class File;
 
 /**
     \ingroup profilers
@@ -61,6 +67,20 @@ class ProfilerRingArray;
 			       TraceEvent::DumpJSON(events, file);
 			   }
 			   \endcode
+
+             Ring array is suitable for last few frames only. To record many frames from many threads use capture.
+             While capture is active every thread records counters into own lock-free buffer, so recording threads never contend.
+             Buffers are flushed to binary capture file on every frame marker (`DAVA_PROFILER_CPU_FRAME`) and on `StopCapture`.
+             Besides counters capture contains frame markers, counter values (`DAVA_PROFILER_CPU_COUNTER`) and flow events
+             (`DAVA_PROFILER_CPU_FLOW_BEGIN`/`DAVA_PROFILER_CPU_FLOW_END`) that connect, for example, job creation with its execution on worker thread.
+             Capture can be converted to Chromium Trace Viewer format offline:
+               \code
+               profiler.StartCapture("~doc:/capture.pcap");
+               ...
+               profiler.StopCapture();
+
+               ProfilerCPU::ConvertCaptureToJSON("~doc:/capture.pcap", "~doc:/capture.json");
+               \endcode
 */
 class ProfilerCPU
 {
@@ -70,6 +90,9 @@ public:
     struct Counter;
     using CounterArray = ProfilerRingArray<Counter>;
 
+    struct CaptureEvent;
+    using CaptureBuffer = ProfilerThreadBuffer<CaptureEvent>;
+
     /**
         Scoped counter to measure executing time of code block.
         Use DAVA_PROFILER_CPU_SCOPE defines instead of manual object creation.
@@ -83,6 +106,10 @@ public:
     private:
         uint64* endTime = nullptr;
         ProfilerCPU* profiler;
+
+        const char* name = nullptr;
+        uint64 captureStartTime = 0;
+        uint32 frame = 0;
     };
 
     static const int32 NO_SNAPSHOT_ID = -1; ///< Value used to dump or build trace from current counters array
@@ -156,15 +183,75 @@ public:
     */
     Vector<TraceEvent> GetTrace(const char* counterName, uint32 desiredFrameIndex = 0, int32 snapshotID = NO_SNAPSHOT_ID) const;
 
+    /**
+        Start streaming capture of counters, frame markers, counter values and flow events to binary file with `capturePath`.
+        Returns false if file can't be created
+    */
+    bool StartCapture(const FilePath& capturePath);
+
+    /**
+        Flush all recorded events and close capture file
+    */
+    void StopCapture();
+
+    /**
+        Returns is capture started
+    */
+    bool IsCapturing() const;
+
+    /**
+        Record frame marker with `frameIndex` and flush per-thread buffers to capture file.
+        Should be called once per frame from one thread (usually main thread). Does nothing if capture isn't started
+    */
+    void MarkFrame(uint32 frameIndex);
+
+    /**
+        Record `value` of counter with `counterName`. Does nothing if capture isn't started
+    */
+    void AddCounterValue(const char* counterName, uint32 value);
+
+    /**
+        Record begin of flow with `flowID`. Flow connects current counter with counter containing flow end with the same `flowID`.
+        Does nothing if capture isn't started
+    */
+    void AddFlowBegin(const char* flowName, uint64 flowID);
+
+    /**
+        Record end of flow with `flowID`. Does nothing if capture isn't started
+    */
+    void AddFlowEnd(const char* flowName, uint64 flowID);
+
+    /**
+        Read binary capture from `capturePath` and build trace. Returns false if capture is invalid
+    */
+    static bool ConvertCaptureToTrace(const FilePath& capturePath, Vector<TraceEvent>& trace);
+
+    /**
+        Read binary capture from `capturePath` and dump it to `jsonPath` in JSON Chromium Trace Viewer format
+    */
+    static bool ConvertCaptureToJSON(const FilePath& capturePath, const FilePath& jsonPath);
+
 private:
     const CounterArray* GetCounterArray(int32 snapshot) const;
 
+    CaptureBuffer* GetCaptureBuffer();
+    void PushCaptureEvent(const CaptureEvent& event);
+    void FlushCapture();
+
     CounterArray* counters = nullptr;
     Vector<CounterArray*> snapshots;
     Mutex mutex;
     uint32 numCounters = 2048;
     bool isStarted = false;
 
+    ThreadLocalPtr<CaptureBuffer> threadCaptureBuffer;
+    Vector<CaptureBuffer*> captureBuffers;
+    UnorderedMap<const char*, uint32> captureNames;
+    Vector<uint8> captureData;
+    File* captureFile = nullptr;
+    Mutex captureMutex;
+    std::atomic<bool> isCapturing{ false };
+
     friend class ScopedCounter;
 };
 
@@ -178,6 +265,11 @@ private:
 #define DAVA_PROFILER_CPU_SCOPE_CUSTOM(counter_name, profiler) DAVA::ProfilerCPU::ScopedCounter time_profiler_scope_counter_custom(counter_name, profiler);
 #define DAVA_PROFILER_CPU_SCOPE_CUSTOM_WITH_FRAME_INDEX(counter_name, profiler, index) DAVA::ProfilerCPU::ScopedCounter time_profiler_scope_counter_custom(counter_name, profiler, index);
 
+#define DAVA_PROFILER_CPU_FRAME(index) DAVA::ProfilerCPU::globalProfiler->MarkFrame(index);
+#define DAVA_PROFILER_CPU_COUNTER(counter_name, value) DAVA::ProfilerCPU::globalProfiler->AddCounterValue(counter_name, value);
+#define DAVA_PROFILER_CPU_FLOW_BEGIN(flow_name, id) DAVA::ProfilerCPU::globalProfiler->AddFlowBegin(flow_name, id);
+#define DAVA_PROFILER_CPU_FLOW_END(flow_name, id) DAVA::ProfilerCPU::globalProfiler->AddFlowEnd(flow_name, id);
+
 #else
 
 #define DAVA_PROFILER_CPU_SCOPE(counter_name)
@@ -186,4 +278,9 @@ private:
 #define DAVA_PROFILER_CPU_SCOPE_CUSTOM(counter_name, profiler)
 #define DAVA_PROFILER_CPU_SCOPE_CUSTOM_WITH_FRAME_INDEX(counter_name, profiler, index)
 
+#define DAVA_PROFILER_CPU_FRAME(index)
+#define DAVA_PROFILER_CPU_COUNTER(counter_name, value)
+#define DAVA_PROFILER_CPU_FLOW_BEGIN(flow_name, id)
+#define DAVA_PROFILER_CPU_FLOW_END(flow_name, id)
+
 #endif
\ No newline at end of file
@@ -14,6 +14,8 @@ extern const char* ENGINE_UPDATE_WINDOW;
 extern const char* ENGINE_DRAW_WINDOW;
 
 extern const char* JOB_MANAGER;
+extern const char* JOB_WORKER_JOB;
+extern const char* JOB_WORKER_JOBS_COUNT;
 extern const char* SOUND_SYSTEM;
 extern const char* ANIMATION_MANAGER;
 extern const char* UI_UPDATE;
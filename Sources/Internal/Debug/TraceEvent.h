@@ -20,6 +20,9 @@ struct TraceEvent
         PHASE_END, ///< End of duration event. It does not use `duration` field
         PHASE_INSTANCE, ///< The instance event-type. Correspond to something that happens buy has no duration. It does not use `duration` field
         PHASE_DURATION, ///< Complete event. Logically combines a pair of `Begin` and `End` events. Preferably to use this event type instead Begin/End because it reduce the size of the trace.
+        PHASE_COUNTER, ///< Counter event. Values of counter are passed in `args`. It does not use `duration` field
+        PHASE_FLOW_BEGIN, ///< Begin of flow event. Connects event on one thread with event on other thread (with the same `id`). It does not use `duration` field
+        PHASE_FLOW_END, ///< End of flow event. Binds to enclosing duration event. It does not use `duration` field
 
         PHASE_COUNT ///< Count of implemented event types.
     };
@@ -31,6 +34,7 @@ struct TraceEvent
     uint32 processID; ///< The process ID for the process that generate this event.
     EventPhase phase; ///< The event type. The valid values are listed in enum description.
     Vector<std::pair<FastName, uint32>> args; ///< Any arguments provided for the event. Used as `meta-info`. The arguments are displayed in Trace Viewer.
+    uint64 id = 0; ///< The id of flow event. Used only by flow events to connect begin and end.
 
     /**
         Dump `trace` from any type container with value type `TraceEvent` to file with `filePath` in JSON-format
@@ -66,7 +70,7 @@ void TraceEvent::DumpJSON(const Container& trace, std::ostream& stream)
     static_assert(std::is_same<typename Container::value_type, TraceEvent>::value, "Container should contain TraceEvent class");
 
     static const char* const PHASE_STR[PHASE_COUNT] = {
-        "B", "E", "I", "X"
+        "B", "E", "I", "X", "C", "s", "f"
     };
 
     stream << "{ \"traceEvents\": [\n";
@@ -89,12 +93,31 @@ void TraceEvent::DumpJSON(const Container& trace, std::ostream& stream)
             stream << "\"dur\": " << event.duration << ", ";
         }
 
+        if (event.phase == PHASE_FLOW_BEGIN || event.phase == PHASE_FLOW_END)
+        {
+            stream << "\"id\": " << event.id << ", ";
+            stream << "\"cat\": \"flow\", ";
+        }
+
+        if (event.phase == PHASE_FLOW_END)
+        {
+            stream << "\"bp\": \"e\", ";
+        }
+
         stream << "\"ph\": \"" << PHASE_STR[event.phase] << "\", ";
         stream << "\"name\": \"" << event.name.c_str() << "\"";
 
-        for (const std::pair<FastName, uint32>& arg : event.args)
+        if (!event.args.empty())
         {
-            stream << ", \"args\": { \"" << arg.first.c_str() << "\": " << arg.second << " }";
+            stream << ", \"args\": { ";
+            for (auto arg = event.args.begin(); arg != event.args.end(); ++arg)
+            {
+                if (arg != event.args.begin())
+                    stream << ", ";
+
+                stream << "\"" << arg->first.c_str() << "\": " << arg->second;
+            }
+            stream << " }";
         }
 
         stream << " }";
@@ -426,6 +426,7 @@ void EngineBackend::OnFrameConsole()
 
     // Notify memory profiler about new frame
     DAVA_MEMORY_PROFILER_UPDATE();
+    DAVA_PROFILER_CPU_FRAME(globalFrameIndex);
 
     globalFrameIndex += 1;
 }
@@ -470,6 +471,7 @@ int32 EngineBackend::OnFrame()
 
     // Notify memory profiler about new frame
     DAVA_MEMORY_PROFILER_UPDATE();
+    DAVA_PROFILER_CPU_FRAME(globalFrameIndex);
 
     globalFrameIndex += 1;
     return Renderer::GetDesiredFPS();
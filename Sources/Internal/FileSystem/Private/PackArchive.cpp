@@ -174,6 +174,26 @@ PackArchive::PackArchive(RefPtr<File>& file_, const FilePath& archiveName_)
         }
         packMeta.reset(new PackMetaData(&metaBlock[0], metaBlock.size(), fileNames));
     }
+
+    if (footerBlock.dictionarySize > 0)
+    {
+        // dictionary block is placed right before metadata block
+        uint64 startDictionaryBlock = size - (sizeof(packFile.footer) + packFile.footer.info.filesTableSize + footerBlock.metaDataSize + footerBlock.dictionarySize);
+        Vector<uint8> dictionary(footerBlock.dictionarySize);
+        if (!file->Seek(startDictionaryBlock, File::SEEK_FROM_START))
+        {
+            DAVA_THROW(Exception, "can't seek dictionary");
+        }
+        if (file->Read(dictionary.data(), footerBlock.dictionarySize) != footerBlock.dictionarySize)
+        {
+            DAVA_THROW(Exception, "can't read dictionary");
+        }
+        if (CRC32::ForBuffer(dictionary.data(), dictionary.size()) != footerBlock.dictionaryCrc32)
+        {
+            DAVA_THROW(DAVA::Exception, "crc32 not match in dictionary in file: " + fileName);
+        }
+        dictionaryCompressor.reset(new LZ4DictionaryCompressor(dictionary));
+    }
 }
 
 const Vector<ResourceArchive::FileInfo>& PackArchive::GetFilesInfo() const
@@ -257,6 +277,30 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
         }
     }
     break;
+    case Compressor::Type::Lz4Dictionary:
+    {
+        if (!dictionaryCompressor)
+        {
+            Logger::Error("can't load file: %s course: no dictionary in pack file", relativeFilePath.c_str());
+            return false;
+        }
+
+        Vector<uint8> packedBuf(fileEntry.compressedSize);
+
+        uint32 readOk = file->Read(packedBuf.data(), fileEntry.compressedSize);
+        if (readOk != fileEntry.compressedSize)
+        {
+            Logger::Error("can't load file: %s course: can't read compressed content", relativeFilePath.c_str());
+            return false;
+        }
+
+        if (!dictionaryCompressor->Decompress(packedBuf, output))
+        {
+            Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
+            return false;
+        }
+    }
+    break;
     case Compressor::Type::RFC1951:
     {
         Vector<uint8> packedBuf(fileEntry.compressedSize);
@@ -315,4 +359,9 @@ const PackFormat::PackFile& PackArchive::GetPackFile() const
     return packFile;
 }
 
+const LZ4DictionaryCompressor* PackArchive::GetDictionaryCompressor() const
+{
+    return dictionaryCompressor.get();
+}
+
 } // end namespace DAVA
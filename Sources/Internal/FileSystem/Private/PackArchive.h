@@ -4,6 +4,7 @@
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/PackMetaData.h"
 #include "FileSystem/File.h"
+#include "Compression/LZ4Compressor.h"
 
 namespace DAVA
 {
@@ -31,6 +32,12 @@ public:
 
     const PackFormat::PackFile& GetPackFile() const;
 
+    /**
+		return compressor for files of Compressor::Type::Lz4Dictionary type
+		or nullptr if pack has no shared dictionary
+	*/
+    const LZ4DictionaryCompressor* GetDictionaryCompressor() const;
+
     static void ExtractFileTableData(const PackFormat::PackFile::FooterBlock& footerBlock,
                                      const Vector<uint8>& tmpBuffer,
                                      String& fileNames,
@@ -47,6 +54,7 @@ private:
     mutable RefPtr<File> file;
     PackFormat::PackFile packFile;
     std::unique_ptr<PackMetaData> packMeta;
+    std::unique_ptr<LZ4DictionaryCompressor> dictionaryCompressor;
     UnorderedMap<String, const PackFormat::FileTableEntry*> mapFileData;
     Vector<ResourceArchive::FileInfo> filesInfo;
 };
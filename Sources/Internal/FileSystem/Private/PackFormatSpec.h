@@ -16,6 +16,12 @@ struct PackFile
     {
     } rawBytesOfCompressedFiles;
 
+    // 0 or footer.dictionarySize bytes
+    // shared dictionary for files compressed with Compressor::Type::Lz4Dictionary
+    struct DictionaryBlock
+    {
+    } dictionary;
+
     // 0 or footer.metaDataSize bytes
     struct CustomMetadataBlock
     {
@@ -51,7 +57,8 @@ struct PackFile
 
     struct FooterBlock
     {
-        Array<uint8, 8> reserved{};
+        uint32 dictionarySize = 0; // 0 or size of shared dictionary block
+        uint32 dictionaryCrc32 = 0; // 0 or crc32 for shared dictionary block
         uint32 metaDataCrc32 = 0; // 0 or crc32 for custom user meta block
         uint32 metaDataSize = 0; // 0 or size of custom user meta data block
         uint32 infoCrc32 = 0;
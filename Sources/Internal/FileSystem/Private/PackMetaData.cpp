@@ -12,91 +12,251 @@
 
 #include <sqlite_modern_cpp.h>
 
+#include <cstring>
+
 namespace DAVA
 {
-Vector<String> FileNamesTree::GetPathElements(const String& relativeFilePath)
+namespace FileNamesTreeDetails
+{
+void WriteVarUint(Vector<uint8>& out, uint32 value)
 {
-    // TODO better in future use string_view
-    Vector<String> tokens;
-    const size_t countNames = 1 + std::count_if(begin(relativeFilePath), end(relativeFilePath), [](char value) { return value == '/'; });
-    tokens.reserve(countNames);
-    Split(relativeFilePath, "/", tokens);
-    return tokens;
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<uint8>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8>(value));
+}
+
+uint32 ReadVarUint(const uint8*& ptr)
+{
+    uint32 value = 0;
+    for (uint32 shift = 0;; shift += 7)
+    {
+        const uint8 byte = *ptr++;
+        value |= static_cast<uint32>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+}
+
+int32 Compare(const char* left, size_t leftSize, const char* right, size_t rightSize)
+{
+    const int32 result = std::memcmp(left, right, std::min(leftSize, rightSize));
+    if (result != 0)
+    {
+        return result;
+    }
+    return leftSize < rightSize ? -1 : (leftSize > rightSize ? 1 : 0);
+}
+
+struct NameRef
+{
+    const char* ptr;
+    uint32 size;
+    uint32 index;
+};
 }
 
 void FileNamesTree::Add(const String& relativeFilePath)
 {
-    Vector<String> tokens = GetPathElements(relativeFilePath);
-    Node* currentNode = &treeRoot;
-    for (String& element : tokens)
+    addedNames.append(relativeFilePath);
+    addedNames.push_back('\0');
+}
+
+void FileNamesTree::Build()
+{
+    String fileNames;
+    fileNames.swap(addedNames);
+    Build(fileNames);
+}
+
+void FileNamesTree::Build(const String& fileNames)
+{
+    using namespace FileNamesTreeDetails;
+
+    Vector<NameRef> refs;
+    refs.reserve(std::count(begin(fileNames), end(fileNames), '\0'));
+
+    uint32 index = 0;
+    for (size_t pos = 0; pos < fileNames.size(); ++index)
     {
-        Node& node = currentNode->children[element];
-        currentNode = &node;
+        size_t nameEnd = fileNames.find('\0', pos);
+        if (nameEnd == String::npos)
+        {
+            nameEnd = fileNames.size();
+        }
+        refs.push_back(NameRef{ fileNames.data() + pos, static_cast<uint32>(nameEnd - pos), index });
+        pos = nameEnd + 1;
+    }
+
+    // stable sort keeps first index of duplicated name
+    std::stable_sort(begin(refs), end(refs), [](const NameRef& left, const NameRef& right) {
+        return Compare(left.ptr, left.size, right.ptr, right.size) < 0;
+    });
+
+    names.clear();
+    blockOffsets.clear();
+    indexes.clear();
+    indexes.reserve(refs.size());
+
+    const NameRef* prev = nullptr;
+    for (const NameRef& ref : refs)
+    {
+        if (prev != nullptr && Compare(prev->ptr, prev->size, ref.ptr, ref.size) == 0)
+        {
+            continue;
+        }
+
+        uint32 prefixSize = 0;
+        if (indexes.size() % BLOCK_SIZE == 0)
+        {
+            blockOffsets.push_back(static_cast<uint32>(names.size()));
+        }
+        else
+        {
+            const uint32 maxPrefixSize = std::min(prev->size, ref.size);
+            while (prefixSize < maxPrefixSize && prev->ptr[prefixSize] == ref.ptr[prefixSize])
+            {
+                ++prefixSize;
+            }
+        }
+
+        WriteVarUint(names, prefixSize);
+        WriteVarUint(names, ref.size - prefixSize);
+        names.insert(end(names), ref.ptr + prefixSize, ref.ptr + ref.size);
+        indexes.push_back(ref.index);
+
+        prev = &ref;
     }
+
+    names.shrink_to_fit();
+    blockOffsets.shrink_to_fit();
 }
 
 bool FileNamesTree::Find(const String& relativeFilePath) const
 {
-    Vector<String> tokens = GetPathElements(relativeFilePath);
-    const Node* currentNode = &treeRoot;
-    for (String& element : tokens)
+    if (FindIndex(relativeFilePath) != NOT_FOUND)
+    {
+        return true;
+    }
+
+    // directory is known if there is some file inside it, like in tree of path elements used before
+    String directory = relativeFilePath;
+    while (!directory.empty() && directory.back() == '/')
+    {
+        directory.pop_back();
+    }
+    if (directory.empty())
+    {
+        return GetCount() > 0;
+    }
+    directory.push_back('/');
+
+    String name;
+    const uint32 position = LowerBound(directory.data(), directory.size(), name);
+    return position < indexes.size() && name.compare(0, directory.size(), directory) == 0;
+}
+
+uint32 FileNamesTree::FindIndex(const String& relativeFilePath) const
+{
+    String name;
+    const uint32 position = LowerBound(relativeFilePath.data(), relativeFilePath.size(), name);
+    if (position < indexes.size() && name == relativeFilePath)
+    {
+        return indexes[position];
+    }
+    return NOT_FOUND;
+}
+
+uint32 FileNamesTree::LowerBound(const char* key, size_t keySize, String& name) const
+{
+    using namespace FileNamesTreeDetails;
+
+    DVASSERT(addedNames.empty(), "call Build() before search");
+
+    const uint32 blocksCount = static_cast<uint32>(blockOffsets.size());
+
+    // find last block with head not greater than key
+    uint32 first = 0;
+    uint32 last = blocksCount;
+    while (first < last)
     {
-        const auto it = currentNode->children.find(element);
-        if (it != end(currentNode->children))
+        const uint32 middle = first + (last - first) / 2;
+        const uint8* ptr = names.data() + blockOffsets[middle];
+        ReadVarUint(ptr); // always 0 for head
+        const uint32 headSize = ReadVarUint(ptr);
+        if (Compare(key, keySize, reinterpret_cast<const char*>(ptr), headSize) < 0)
         {
-            currentNode = &it->second;
+            last = middle;
         }
         else
         {
-            return false;
+            first = middle + 1;
+        }
+    }
+
+    // if key is less than all heads the first name is the bound, else scan stops at head of next block at most
+    const uint32 block = (first == 0) ? 0 : first - 1;
+    const uint8* ptr = names.data() + (block < blocksCount ? blockOffsets[block] : 0);
+    const uint8* namesEnd = names.data() + names.size();
+
+    name.clear();
+    for (uint32 i = block * BLOCK_SIZE; ptr < namesEnd; ++i)
+    {
+        const uint32 prefixSize = ReadVarUint(ptr);
+        const uint32 suffixSize = ReadVarUint(ptr);
+        name.resize(prefixSize);
+        name.append(reinterpret_cast<const char*>(ptr), suffixSize);
+        ptr += suffixSize;
+
+        if (Compare(name.data(), name.size(), key, keySize) >= 0)
+        {
+            return i;
         }
     }
-    return true;
+    return static_cast<uint32>(indexes.size());
+}
+
+size_t FileNamesTree::GetCount() const
+{
+    return indexes.size();
 }
 
 PackMetaData::PackMetaData(const void* ptr, std::size_t size, const String& fileNames)
 {
     Deserialize(ptr, size);
 
-    const size_t sizeOfNames = fileNames.size();
-    size_t index = 0;
-
-    while (index < fileNames.size())
-    {
-        // TODO in future do it with std::string_view
-        const char* filePath = &fileNames[index];
-        namesTree.Add(filePath);
-        // start of next substring after null character
-        index = fileNames.find('\0', index + 1) + 1;
-    }
+    namesTree.Build(fileNames);
 }
 
 Vector<uint32> PackMetaData::ConvertStringWithNumbersToVector(const String& dependencies) const
 {
     Vector<uint32> result;
 
-    const String delimiter(", ");
-
-    Vector<String> requestNamesStr;
-    Split(dependencies, delimiter, requestNamesStr);
-
-    // convert every name from string representation of index to packName
-    for (String& pack : requestNamesStr)
+    // parse "1, 2, 3" in place, without splitting into strings
+    const char* ptr = dependencies.c_str();
+    while (*ptr != '\0')
     {
-        unsigned long i = 0;
-        try
+        if (*ptr == ',' || *ptr == ' ')
         {
-            i = stoul(pack);
+            ++ptr;
+            continue;
         }
-        catch (std::exception& ex)
+
+        char* numberEnd = nullptr;
+        const unsigned long index = std::strtoul(ptr, &numberEnd, 10);
+        if (numberEnd == ptr || (*numberEnd != ',' && *numberEnd != ' ' && *numberEnd != '\0'))
         {
-            const String errStr = Format("bad dependency index: value: %s, error: %s.", pack.c_str(), ex.what());
+            const String errStr = Format("bad dependency index: value: %s", dependencies.c_str());
             Logger::Error("%s", errStr.c_str());
             DAVA_THROW(Exception, errStr);
         }
 
-        uint32 index = static_cast<uint32>(i);
-        result.push_back(index);
+        result.push_back(static_cast<uint32>(index));
+        ptr = numberEnd;
     }
 
     SortAndEraseDuplicates(result);
@@ -158,6 +318,8 @@ PackMetaData::PackMetaData(const FilePath& metaDb)
         packIndexes.push_back(packIndex);
     };
 
+    namesTree.Build();
+
     size_t numPacks = 0;
 
     db << "SELECT count(*) FROM packs"
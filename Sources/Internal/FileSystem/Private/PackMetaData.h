@@ -7,22 +7,44 @@ namespace DAVA
 {
 class FilePath;
 
+/**
+    Set of relative file paths stored as sorted front coded table.
+    Every `BLOCK_SIZE`-th name is stored fully, others as length of prefix shared
+    with previous name and the rest of chars. All names take one flat buffer
+    without allocation per name or path element, lookup is binary search over
+    block heads and scan of one block.
+    Fill it with `Add` and call `Build()`, or build from '\0' separated names at once.
+*/
 class FileNamesTree
 {
 public:
+    static const uint32 NOT_FOUND = ~0u;
+
     FileNamesTree() = default;
+    /** Append name to build, index of name is the count of names added before */
     void Add(const String& relativeFilePath);
+    /** Build table from names passed to `Add` */
+    void Build();
+    /** Build table from '\0' separated names, index of name is its position in list */
+    void Build(const String& fileNames);
+
+    /** Return true for name of file in table and for directory with some file of table, e.g. "a" and "a/b" for "a/b/c.txt" */
     bool Find(const String& relativeFilePath) const;
+    /** Return index of name or `NOT_FOUND` */
+    uint32 FindIndex(const String& relativeFilePath) const;
+    /** Return count of unique names in table */
+    size_t GetCount() const;
 
 private:
-    static Vector<String> GetPathElements(const String& relativeFilePath);
+    static const uint32 BLOCK_SIZE = 16;
 
-    struct Node
-    {
-        Map<String, Node> children;
-    };
+    /** Return sorted position of first name not less than key and decode it into `name`, or `GetCount()` if there is no such name */
+    uint32 LowerBound(const char* key, size_t keySize, String& name) const;
 
-    Node treeRoot;
+    String addedNames; // '\0' separated names before `Build()`
+    Vector<uint8> names; // front coded names in sorted order
+    Vector<uint32> blockOffsets; // offset of every block head in `names`
+    Vector<uint32> indexes; // index of every sorted name
 };
 
 class PackMetaData
@@ -11,6 +11,34 @@
 
 namespace DAVA
 {
+namespace JobManagerDetails
+{
+struct ParallelForState
+{
+    Function<void(uint32, uint32)> fn;
+    uint32 count = 0;
+    uint32 chunkSize = 0;
+    uint32 chunksCount = 0;
+    std::atomic<uint32> nextChunk{ 0 };
+    std::atomic<uint32> completedChunks{ 0 };
+};
+
+bool ProcessParallelForChunk(ParallelForState& state)
+{
+    uint32 chunk = state.nextChunk.fetch_add(1);
+    if (chunk >= state.chunksCount)
+    {
+        return false;
+    }
+
+    uint32 begin = chunk * state.chunkSize;
+    uint32 end = Min(begin + state.chunkSize, state.count);
+    state.fn(begin, end);
+    state.completedChunks.fetch_add(1, std::memory_order_release);
+    return true;
+}
+}
+
 JobManager::JobManager(Engine* e)
     : engine(e)
     , mainJobIDCounter(1)
@@ -52,6 +80,7 @@ JobManager::~JobManager()
 void JobManager::Update(float32 /*frameDelta*/)
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::JOB_MANAGER);
+    DAVA_PROFILER_CPU_COUNTER(ProfilerCPUMarkerName::JOB_WORKER_JOBS_COUNT, workerQueue.GetJobsCount());
 
     bool hasFinishedJobs = false;
 
@@ -237,7 +266,25 @@ bool JobManager::HasMainJobID(uint32 mainJobID)
 
 void JobManager::CreateWorkerJob(const Function<void()>& fn)
 {
-    workerQueue.Push(fn);
+#if PROFILER_CPU_ENABLED
+    if (ProfilerCPU::globalProfiler->IsCapturing() && fn != nullptr)
+    {
+        // Connect place where job was created with its execution on worker thread
+        uint64 flowID = ++workerJobFlowCounter;
+        DAVA_PROFILER_CPU_FLOW_BEGIN(ProfilerCPUMarkerName::JOB_WORKER_JOB, flowID);
+
+        workerQueue.Push([fn, flowID]() {
+            DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::JOB_WORKER_JOB);
+            DAVA_PROFILER_CPU_FLOW_END(ProfilerCPUMarkerName::JOB_WORKER_JOB, flowID);
+            fn();
+        });
+    }
+    else
+#endif
+    {
+        workerQueue.Push(fn);
+    }
+
     workerQueue.Signal();
 }
 
@@ -266,4 +313,48 @@ bool JobManager::HasWorkerJobs()
 {
     return !workerQueue.IsEmpty();
 }
+
+void JobManager::ParallelFor(uint32 count, uint32 chunkSize, const Function<void(uint32, uint32)>& fn)
+{
+    using namespace JobManagerDetails;
+
+    DVASSERT(chunkSize > 0);
+
+    uint32 chunksCount = (count + chunkSize - 1) / chunkSize;
+    uint32 jobsCount = (chunksCount > 1) ? Min(GetWorkersCount(), chunksCount - 1) : 0;
+    if (jobsCount == 0)
+    {
+        if (count > 0)
+        {
+            fn(0, count);
+        }
+        return;
+    }
+
+    // Jobs started after all chunks are taken find nothing to do and only touch shared state,
+    // so they aren't waited for. It also makes ParallelFor safe to call from worker job
+    std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+    state->fn = fn;
+    state->count = count;
+    state->chunkSize = chunkSize;
+    state->chunksCount = chunksCount;
+
+    for (uint32 i = 0; i < jobsCount; ++i)
+    {
+        CreateWorkerJob([state]() {
+            while (ProcessParallelForChunk(*state))
+            {
+            }
+        });
+    }
+
+    while (ProcessParallelForChunk(*state))
+    {
+    }
+
+    while (state->completedChunks.load(std::memory_order_acquire) < chunksCount)
+    {
+        Thread::Yield();
+    }
+}
 }
@@ -8,6 +8,8 @@
 #include "Functional/Function.h"
 #include "Job/JobQueue.h"
 
+#include <atomic>
+
 namespace DAVA
 {
 class Engine;
@@ -70,6 +72,15 @@ public:
 	*/
     bool HasWorkerJobs();
 
+    /*! Split range [0, count) into chunks of `chunkSize` elements and call `fn(begin, end)` for every chunk in worker-threads.
+        Calling thread takes part in processing and returns as soon as all chunks are processed, so function can be
+        called from worker-thread job too. If there is only one chunk, it is processed in calling thread.
+		\param [in] count Number of elements in range.
+		\param [in] chunkSize Number of elements processed by one call of `fn`.
+		\param [in] fn Function to process elements in range [begin, end). Calls for different chunks run concurrently.
+	*/
+    void ParallelFor(uint32 count, uint32 chunkSize, const Function<void(uint32, uint32)>& fn);
+
 protected:
     struct MainJob
     {
@@ -99,6 +110,7 @@ protected:
 
     Semaphore workerDoneSem;
     JobQueueWorker workerQueue;
+    std::atomic<uint32> workerJobFlowCounter{ 0 };
     Vector<JobThread*> workerThreads;
 };
 }
@@ -71,6 +71,12 @@ bool JobQueueWorker::IsEmpty()
     return (nextPopIndex == nextPushIndex && 0 == processingCount);
 }
 
+uint32 JobQueueWorker::GetJobsCount()
+{
+    LockGuard<Spinlock> guard(lock);
+    return uint32(processingCount);
+}
+
 void JobQueueWorker::Signal()
 {
     LockGuard<Mutex> guard(jobsInQueueMutex);
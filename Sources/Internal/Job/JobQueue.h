@@ -18,6 +18,7 @@ public:
     bool PopAndExec();
 
     bool IsEmpty();
+    uint32 GetJobsCount();
 
     void Signal();
     void Broadcast();
@@ -61,6 +61,7 @@ void IOLoop::Post(UserHandlerType handler)
         // TODO: maybe do not insert duplicates
         queuedHandlers.push_back(handler);
     }
+    ++postedHandlersCount;
     uv_async_send(&uvasync);
 #endif
 }
@@ -68,9 +69,9 @@ void IOLoop::Post(UserHandlerType handler)
 void IOLoop::PostQuit()
 {
 #if !defined(DAVA_NETWORK_DISABLE)
-    if (false == quitFlag)
+    bool expected = false;
+    if (quitFlag.compare_exchange_strong(expected, true))
     {
-        quitFlag = true;
         uv_async_send(&uvasync);
     }
 #endif
@@ -86,11 +87,13 @@ void IOLoop::HandleAsync()
         LockGuard<Mutex> lock(mutex);
         execHandlers.swap(queuedHandlers);
     }
+    ++asyncWakeupsCount;
 
     for (Vector<UserHandlerType>::const_iterator i = execHandlers.begin(), e = execHandlers.end(); i != e; ++i)
     {
         (*i)();
     }
+    executedHandlersCount += execHandlers.size();
     execHandlers.clear();
 
     if (true == quitFlag)
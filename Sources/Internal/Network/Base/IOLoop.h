@@ -9,6 +9,8 @@
 #include "Base/Noncopyable.h"
 #include "Concurrency/Mutex.h"
 
+#include <atomic>
+
 namespace DAVA
 {
 namespace Net
@@ -20,6 +22,7 @@ namespace Net
  Post is a special method to shedule user specified handler to be run in context of thread where Run
  method is running.
  To finish running IOLoop you should finish all network operations and call PostQuit method
+ Post and PostQuit can be called from any thread, including threads running other IOLoops.
 */
 class IOLoop : private Noncopyable
 {
@@ -48,6 +51,11 @@ public:
     void Post(UserHandlerType handler);
     void PostQuit();
 
+    // Loop metrics, can be read from any thread
+    uint64 GetPostedHandlersCount() const;
+    uint64 GetExecutedHandlersCount() const;
+    uint64 GetAsyncWakeupsCount() const;
+
 private:
     void HandleAsync();
 
@@ -58,14 +66,33 @@ private:
 #if !defined(DAVA_NETWORK_DISABLE)
     uv_loop_t uvloop; // libuv loop handle itself
 
-    bool quitFlag = false;
+    std::atomic<bool> quitFlag{ false };
     uv_async_t uvasync; // libuv handle for calling callback from different threads
 #endif
     Vector<UserHandlerType> queuedHandlers; // List of queued user handlers
     Vector<UserHandlerType> execHandlers; // List of executing user handlers
     Mutex mutex;
+
+    std::atomic<uint64> postedHandlersCount{ 0 };
+    std::atomic<uint64> executedHandlersCount{ 0 };
+    std::atomic<uint64> asyncWakeupsCount{ 0 };
 };
 
+inline uint64 IOLoop::GetPostedHandlersCount() const
+{
+    return postedHandlersCount;
+}
+
+inline uint64 IOLoop::GetExecutedHandlersCount() const
+{
+    return executedHandlersCount;
+}
+
+inline uint64 IOLoop::GetAsyncWakeupsCount() const
+{
+    return asyncWakeupsCount;
+}
+
 } // namespace Net
 } // namespace DAVA
 
@@ -21,7 +21,7 @@ template <typename T>
 class TCPSocketTemplate : private Noncopyable
 {
     // Maximum write buffers that can be sent in one operation
-    static const size_t MAX_WRITE_BUFFERS = 4;
+    static const size_t MAX_WRITE_BUFFERS = 16;
 
 public:
     TCPSocketTemplate(IOLoop* ioLoop);
@@ -14,6 +14,9 @@
 #include "Network/NetCore.h"
 #include "Concurrency/Thread.h"
 #include "Concurrency/ManualResetEvent.h"
+#include "Debug/DVAssert.h"
+
+#include <atomic>
 
 namespace DAVA
 {
@@ -40,6 +43,17 @@ class NetConfig;
         e.Run();
         \endcode
 
+    When running in a separate thread NetCore can spread controllers over a pool of IOLoops, each running in its own thread.
+    Number of loops is set by option "net_loops_count" (1 by default), and the way controllers are assigned to loops by
+    option "net_loops_affinity": "round_robin" (default) or "endpoint_hash" (controllers with the same endpoint always
+    share a loop). All transports and services of a controller live on its loop, so connections of different controllers
+    are served concurrently.
+
+        \code
+        options->SetBool("separate_net_thread", true);
+        options->SetUInt32("net_loops_count", 4);
+        \endcode
+
     If NetCore is running it separate thread, all callbacks from network will be invoked it that network thread.
     In that case, it is recommended to perform processing as soon as possible to prevent freeze of network.
     Optionally, user could use proxy classes that pass callbacks from network thread using NetEventsDispatcher.
@@ -125,12 +139,22 @@ public:
 
     static const char8 defaultAnnounceMulticastGroup[];
 
+    enum eLoopAffinity
+    {
+        LOOP_AFFINITY_ROUND_ROBIN,
+        LOOP_AFFINITY_ENDPOINT_HASH
+    };
+
 public:
     NetCore(Engine* e);
     ~NetCore();
 
     IOLoop* Loop() const;
 
+    /** Number of IOLoops used by NetCore, loop with index 0 is the one returned by `Loop()` */
+    size_t LoopsCount() const;
+    IOLoop* Loop(size_t index) const;
+
     bool RegisterService(ServiceID serviceId, ServiceCreator creator, ServiceDeleter deleter, const char8* serviceName = NULL);
     bool UnregisterService(ServiceID serviceId);
     void UnregisterAllServices();
@@ -152,6 +176,8 @@ public:
     void RestartAllControllers();
 
     size_t ControllersCount() const;
+    /** Number of controllers working on `ioLoop` */
+    size_t ControllersCount(const IOLoop* ioLoop) const;
 
     int32 Run();
     void Poll(float32 frameDelta = 0.0f);
@@ -177,11 +203,13 @@ public:
 private:
     void ProcessPendingEvents();
 
-    TrackId StartController(std::unique_ptr<IController> controller);
+    TrackId StartController(std::unique_ptr<IController> controller, IOLoop* ctrlLoop);
+    IOLoop* SelectLoop(const Endpoint& endpoint);
 
     void NetThreadHandler();
+    void CreateLoopsPool(uint32 loopsCount);
     void DoStart(IController* ctrl);
-    void DoRestart();
+    void DoRestart(IOLoop* ctrlLoop);
 
     bool PostAllToDestroy();
     void WaitForAllDestroyed();
@@ -199,6 +227,11 @@ private:
     IOLoop* loop = nullptr; // Heart of NetCore and network library - event loop
     bool useSeparateThread = false;
 
+    Vector<IOLoop*> poolLoops; // Additional loops, each one is running in its own thread
+    Vector<RefPtr<Thread>> poolThreads;
+    eLoopAffinity loopAffinity = LOOP_AFFINITY_ROUND_ROBIN;
+    std::atomic<uint32> nextLoopIndex{ 0 };
+
     struct ControllerContext
     {
         enum Status
@@ -208,6 +241,7 @@ private:
             DESTROYING
         } status = STARTING;
         std::unique_ptr<IController> ctrl;
+        IOLoop* loop = nullptr;
         Function<void()> controllerStoppedCallback;
     };
 
@@ -299,5 +333,16 @@ inline IOLoop* NetCore::Loop() const
     return loop;
 }
 
+inline size_t NetCore::LoopsCount() const
+{
+    return poolLoops.size() + 1;
+}
+
+inline IOLoop* NetCore::Loop(size_t index) const
+{
+    DVASSERT(index < LoopsCount());
+    return index == 0 ? loop : poolLoops[index - 1];
+}
+
 } // namespace Net
 } // namespace DAVA
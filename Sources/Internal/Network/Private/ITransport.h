@@ -35,6 +35,9 @@ struct IClientListener;
 
 struct IClientTransport
 {
+    // Maximum buffers that can be passed to Send, they are written as one vectored write
+    static const size_t MAX_SEND_BUFFERS = 16;
+
     virtual ~IClientTransport();
 
     virtual int32 Start(IClientListener* listener) = 0;
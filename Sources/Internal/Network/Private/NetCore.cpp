@@ -10,6 +10,7 @@
 #include "FileSystem/KeyedArchive.h"
 #include "Concurrency/LockGuard.h"
 #include "Utils/StringFormat.h"
+#include "Logger/Logger.h"
 
 namespace DAVA
 {
@@ -17,6 +18,14 @@ namespace Net
 {
 const char8 NetCore::defaultAnnounceMulticastGroup[] = "239.192.100.1";
 
+namespace NetCoreDetails
+{
+size_t EndpointHash(const Endpoint& endpoint)
+{
+    return std::hash<uint32>()(endpoint.Address().ToUInt()) ^ (std::hash<uint16>()(endpoint.Port()) << 1);
+}
+}
+
 NetCore::NetCore(Engine* e)
     : engine(e)
     , loopCreatedEvent(false)
@@ -24,6 +33,16 @@ NetCore::NetCore(Engine* e)
     bool separateThreadDefaultValue = false;
     const KeyedArchive* options = e->GetOptions();
     useSeparateThread = options->GetBool("separate_net_thread", separateThreadDefaultValue);
+    uint32 loopsCount = options->GetUInt32("net_loops_count", 1);
+    String affinity = options->GetString("net_loops_affinity", "round_robin");
+    if (affinity == "endpoint_hash")
+    {
+        loopAffinity = LOOP_AFFINITY_ENDPOINT_HASH;
+    }
+    else if (affinity != "round_robin")
+    {
+        Logger::Warning("[NetCore] Unknown net_loops_affinity '%s', round_robin is used", affinity.c_str());
+    }
 
     e->update.Connect(this, &NetCore::Update);
 
@@ -35,10 +54,16 @@ NetCore::NetCore(Engine* e)
         netThread = Thread::Create([this]() { NetThreadHandler(); });
         netThread->Start();
         loopCreatedEvent.Wait();
+        CreateLoopsPool(loopsCount);
     }
     else
     {
         loop = new IOLoop(true);
+        if (loopsCount > 1)
+        {
+            // Callbacks of controllers are expected on the main thread in this mode
+            Logger::Warning("[NetCore] net_loops_count is ignored without separate_net_thread");
+        }
     }
 
 #if defined(__DAVAENGINE_IPHONE__)
@@ -62,6 +87,11 @@ NetCore::~NetCore()
     {
         DVASSERT(netThread->GetState() == Thread::eThreadState::STATE_ENDED);
     }
+    for (size_t i = 0; i < poolLoops.size(); ++i)
+    {
+        DVASSERT(poolThreads[i]->GetState() == Thread::eThreadState::STATE_ENDED);
+        SafeDelete(poolLoops[i]);
+    }
 
     DVASSERT(true == controllers.empty());
 
@@ -79,6 +109,40 @@ void NetCore::NetThreadHandler()
     SafeDelete(loop);
 }
 
+void NetCore::CreateLoopsPool(uint32 loopsCount)
+{
+    for (uint32 i = 1; i < loopsCount; ++i)
+    {
+        // libuv loop is not bound to thread it was created in, so pool loops are created here and only run by their threads
+        IOLoop* poolLoop = new IOLoop(false);
+        RefPtr<Thread> poolThread(Thread::Create([poolLoop]() { poolLoop->Run(); }));
+        poolThread->SetName(Format("NetLoop%u", i));
+        poolThread->Start();
+
+        poolLoops.push_back(poolLoop);
+        poolThreads.push_back(poolThread);
+    }
+}
+
+IOLoop* NetCore::SelectLoop(const Endpoint& endpoint)
+{
+    if (poolLoops.empty())
+    {
+        return loop;
+    }
+
+    size_t index = 0;
+    if (loopAffinity == LOOP_AFFINITY_ENDPOINT_HASH)
+    {
+        index = NetCoreDetails::EndpointHash(endpoint) % LoopsCount();
+    }
+    else
+    {
+        index = nextLoopIndex++ % LoopsCount();
+    }
+    return Loop(index);
+}
+
 void NetCore::Update(float32)
 {
     ProcessPendingEvents();
@@ -96,7 +160,7 @@ void NetCore::ProcessPendingEvents()
     }
 }
 
-NetCore::TrackId NetCore::StartController(std::unique_ptr<IController> ctrl)
+NetCore::TrackId NetCore::StartController(std::unique_ptr<IController> ctrl, IOLoop* ctrlLoop)
 {
     IController* c = ctrl.get();
     TrackId id = ObjectToTrackId(c);
@@ -106,8 +170,9 @@ NetCore::TrackId NetCore::StartController(std::unique_ptr<IController> ctrl)
 
         context.status = ControllerContext::STARTING;
         context.ctrl = std::move(ctrl);
+        context.loop = ctrlLoop;
     }
-    loop->Post(Bind(&NetCore::DoStart, this, c));
+    ctrlLoop->Post(Bind(&NetCore::DoStart, this, c));
     return id;
 }
 
@@ -121,11 +186,12 @@ NetCore::TrackId NetCore::CreateController(const NetConfig& config, void* contex
 #if !defined(DAVA_NETWORK_DISABLE)
     DVASSERT(state == State::ACTIVE && true == config.Validate());
 
-    std::unique_ptr<NetController> ctrl = std::make_unique<NetController>(loop, registrar, context, readTimeout);
+    IOLoop* ctrlLoop = SelectLoop(config.Transports().front().endpoint);
+    std::unique_ptr<NetController> ctrl = std::make_unique<NetController>(ctrlLoop, registrar, context, readTimeout);
 
     if (true == ctrl->ApplyConfig(config))
     {
-        return StartController(std::move(ctrl));
+        return StartController(std::move(ctrl), ctrlLoop);
     }
     else
     {
@@ -154,8 +220,9 @@ NetCore::TrackId NetCore::CreateAnnouncer(const Endpoint& endpoint, uint32 sendP
 {
 #if !defined(DAVA_NETWORK_DISABLE)
     DVASSERT(state == State::ACTIVE);
-    std::unique_ptr<Announcer> ctrl = std::make_unique<Announcer>(loop, endpoint, sendPeriod, needDataCallback, tcpEndpoint);
-    return StartController(std::move(ctrl));
+    IOLoop* ctrlLoop = SelectLoop(endpoint);
+    std::unique_ptr<Announcer> ctrl = std::make_unique<Announcer>(ctrlLoop, endpoint, sendPeriod, needDataCallback, tcpEndpoint);
+    return StartController(std::move(ctrl), ctrlLoop);
 #else
     return INVALID_TRACK_ID;
 #endif
@@ -165,8 +232,9 @@ NetCore::TrackId NetCore::CreateDiscoverer(const Endpoint& endpoint, Function<vo
 {
 #if !defined(DAVA_NETWORK_DISABLE)
     DVASSERT(state == State::ACTIVE);
-    std::unique_ptr<Discoverer> ctrl = std::make_unique<Discoverer>(loop, endpoint, dataReadyCallback);
-    discovererId = StartController(std::move(ctrl));
+    IOLoop* ctrlLoop = SelectLoop(endpoint);
+    std::unique_ptr<Discoverer> ctrl = std::make_unique<Discoverer>(ctrlLoop, endpoint, dataReadyCallback);
+    discovererId = StartController(std::move(ctrl), ctrlLoop);
     return discovererId;
 #else
     return INVALID_TRACK_ID;
@@ -199,7 +267,7 @@ void NetCore::DestroyController(TrackId id, Function<void()> callback)
             {
                 context.status = ControllerContext::DESTROYING;
                 context.controllerStoppedCallback = callback;
-                loop->Post(Bind(&NetCore::DoDestroy, this, context.ctrl.get()));
+                context.loop->Post(Bind(&NetCore::DoDestroy, this, context.ctrl.get()));
             }
         }
         else
@@ -243,7 +311,7 @@ void NetCore::DestroyControllerBlocked(TrackId id)
                 if (context.status == ControllerContext::RUNNING)
                 {
                     context.status = ControllerContext::DESTROYING;
-                    loop->Post(Bind(&NetCore::DoDestroy, this, context.ctrl.get()));
+                    context.loop->Post(Bind(&NetCore::DoDestroy, this, context.ctrl.get()));
                 }
             }
         }
@@ -296,7 +364,7 @@ bool NetCore::PostAllToDestroy()
             if (context.status == ControllerContext::RUNNING)
             {
                 context.status = ControllerContext::DESTROYING;
-                loop->Post(Bind(&NetCore::DoDestroy, this, context.ctrl.get()));
+                context.loop->Post(Bind(&NetCore::DoDestroy, this, context.ctrl.get()));
             }
             hasControllersToDestroy = true;
         }
@@ -344,8 +412,12 @@ void NetCore::WaitForAllDestroyed()
 void NetCore::RestartAllControllers()
 {
 #if !defined(DAVA_NETWORK_DISABLE)
-    // Restart controllers on mobile devices
-    loop->Post(MakeFunction(this, &NetCore::DoRestart));
+    // Restart controllers on mobile devices, each controller is restarted in thread of its loop
+    for (size_t i = 0; i < LoopsCount(); ++i)
+    {
+        IOLoop* ctrlLoop = Loop(i);
+        ctrlLoop->Post(Bind(&NetCore::DoRestart, this, ctrlLoop));
+    }
 #endif
 }
 
@@ -373,6 +445,10 @@ void NetCore::Finish(bool waitForFinished)
             if (useSeparateThread)
             {
                 netThread->Join();
+                for (RefPtr<Thread>& poolThread : poolThreads)
+                {
+                    poolThread->Join();
+                }
             }
             else
             {
@@ -439,12 +515,12 @@ void NetCore::DoStart(IController* ctrl)
     }
 }
 
-void NetCore::DoRestart()
+void NetCore::DoRestart(IOLoop* ctrlLoop)
 {
     LockGuard<Mutex> lock(controllersMutex);
     for (auto& entry : controllers)
     {
-        if (entry.second.status == ControllerContext::RUNNING)
+        if (entry.second.status == ControllerContext::RUNNING && entry.second.loop == ctrlLoop)
             entry.second.ctrl->Restart();
     }
 }
@@ -466,6 +542,10 @@ void NetCore::AllDestroyed()
     {
         state = State::FINISHED;
         loop->PostQuit();
+        for (IOLoop* poolLoop : poolLoops)
+        {
+            poolLoop->PostQuit();
+        }
     }
 }
 
@@ -515,5 +595,13 @@ size_t NetCore::ControllersCount() const
     return controllers.size();
 }
 
+size_t NetCore::ControllersCount(const IOLoop* ioLoop) const
+{
+    LockGuard<Mutex> lock(controllersMutex);
+    return std::count_if(controllers.begin(), controllers.end(), [ioLoop](const std::pair<const TrackId, ControllerContext>& entry) {
+        return entry.second.loop == ioLoop;
+    });
+}
+
 } // namespace Net
 } // namespace DAVA
@@ -192,6 +192,14 @@ void ProtoDriver::OnSendComplete()
             ch->service->OnPacketSent(ch, curPacket.data, curPacket.dataLength);
             curPacket.data = NULL;
         }
+
+        for (size_t i = 0; i < coalescedCount; ++i)
+        {
+            Packet& packet = coalescedPackets[i];
+            std::shared_ptr<Channel> ch = GetChannel(packet.channelId);
+            ch->service->OnPacketSent(ch, packet.data, packet.dataLength);
+        }
+        coalescedCount = 0;
     }
 
     if (true == DequeueControl(&curControl)) // First send control packets if any
@@ -319,6 +327,13 @@ void ProtoDriver::ClearQueues()
 
         curPacket.data = NULL;
     }
+    for (size_t i = 0; i < coalescedCount; ++i)
+    {
+        Packet& packet = coalescedPackets[i];
+        std::shared_ptr<Channel> ch = GetChannel(packet.channelId);
+        ch->service->OnPacketSent(ch, packet.data, packet.dataLength);
+    }
+    coalescedCount = 0;
     for (Deque<Packet>::iterator i = dataQueue.begin(), e = dataQueue.end(); i != e; ++i)
     {
         Packet& packet = *i;
@@ -338,13 +353,59 @@ void ProtoDriver::SendCurPacket()
     whatIsSending = SENDING_DATA_FRAME;
     curPacket.chunkLength = proto.EncodeDataFrame(&header, curPacket.channelId, curPacket.packetId, curPacket.dataLength, curPacket.sentLength);
 
-    Buffer buffers[2];
+    Buffer buffers[IClientTransport::MAX_SEND_BUFFERS];
     buffers[0] = CreateBuffer(&header);
     buffers[1] = CreateBuffer(curPacket.data + curPacket.sentLength, curPacket.chunkLength);
-    if (0 == transport->Send(buffers, 2) && 0 == curPacket.sentLength)
+    size_t bufferCount = 2;
+
+    // Queued packets can follow only the last frame of current packet
+    DVASSERT(0 == coalescedCount);
+    if (curPacket.sentLength + curPacket.chunkLength == curPacket.dataLength)
+    {
+        bufferCount += CoalescePackets(buffers + bufferCount, curPacket.chunkLength);
+    }
+
+    if (0 == transport->Send(buffers, bufferCount))
+    {
+        if (0 == curPacket.sentLength)
+        {
+            pendingAckQueue.push_back(curPacket.packetId);
+        }
+        for (size_t i = 0; i < coalescedCount; ++i)
+        {
+            pendingAckQueue.push_back(coalescedPackets[i].packetId);
+        }
+    }
+}
+
+size_t ProtoDriver::CoalescePackets(Buffer* buffers, size_t coalescedLength)
+{
+    size_t bufferCount = 0;
+
+    LockGuard<Mutex> lock(queueMutex);
+    while (coalescedCount < MAX_COALESCED_PACKETS && false == dataQueue.empty())
     {
-        pendingAckQueue.push_back(curPacket.packetId);
+        // Only packets which fit into one frame are coalesced, so each of them is completed by this write
+        const Packet& next = dataQueue.front();
+        if (next.dataLength > PROTO_MAX_FRAME_DATA_SIZE || coalescedLength + next.dataLength > MAX_COALESCED_LENGTH)
+        {
+            break;
+        }
+
+        Packet& packet = coalescedPackets[coalescedCount];
+        ProtoHeader& packetHeader = coalescedHeaders[coalescedCount];
+        packet = next;
+        dataQueue.pop_front();
+
+        packet.chunkLength = proto.EncodeDataFrame(&packetHeader, packet.channelId, packet.packetId, packet.dataLength, 0);
+        DVASSERT(packet.chunkLength == packet.dataLength);
+        buffers[bufferCount++] = CreateBuffer(&packetHeader);
+        buffers[bufferCount++] = CreateBuffer(packet.data, packet.chunkLength);
+
+        coalescedLength += packet.dataLength;
+        coalescedCount += 1;
     }
+    return bufferCount;
 }
 
 void ProtoDriver::SendCurControl()
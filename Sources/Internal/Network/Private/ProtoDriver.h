@@ -47,6 +47,10 @@ private:
         IChannelListener* service = nullptr;
     };
 
+    // Small packets waiting in queue are sent together with current one in one transport write
+    static const size_t MAX_COALESCED_PACKETS = IClientTransport::MAX_SEND_BUFFERS / 2 - 1;
+    static const size_t MAX_COALESCED_LENGTH = 64 * 1024;
+
     enum eSendingFrameType
     {
         SENDING_DATA_FRAME = false,
@@ -82,6 +86,7 @@ private:
 
     void SendCurPacket();
     void SendCurControl();
+    size_t CoalescePackets(Buffer* buffers, size_t coalescedLength);
 
     void PreparePacket(Packet* packet, uint32 channelId, const void* buffer, size_t length);
     bool EnqueuePacket(Packet* packet);
@@ -102,6 +107,9 @@ private:
     bool pendingPong;
 
     Packet curPacket;
+    Packet coalescedPackets[MAX_COALESCED_PACKETS]; // Whole packets sent with last frame of current packet
+    ProtoHeader coalescedHeaders[MAX_COALESCED_PACKETS];
+    size_t coalescedCount = 0;
     Deque<Packet> dataQueue;
     Deque<uint32> pendingAckQueue;
 
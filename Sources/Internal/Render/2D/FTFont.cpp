@@ -11,6 +11,7 @@
 #include "Render/2D/Private/FTManager.h"
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
 #include "Render/Renderer.h"
+#include "Concurrency/LockGuard.h"
 #include "UI/UIControlSystem.h"
 #include "Utils/UTF8Utils.h"
 
@@ -39,7 +40,9 @@ public:
                                    int32 justifyWidth, int32 spaceAddon,
                                    float32 ascendScale, float32 descendScale,
                                    Vector<float32>* charSizes = NULL,
-                                   bool contentScaleIncluded = false);
+                                   bool contentScaleIncluded = false,
+                                   Vector<FTFont::GlyphPlacement>* placements = nullptr);
+    bool RasterizeGlyph(float32 size, uint32 glyphIndex, FTFont::GlyphBitmap& bitmap);
     uint32 GetFontHeight(float32 size, float32 ascendScale, float32 descendScale);
     bool IsCharAvaliable(char16 ch);
 
@@ -186,6 +189,21 @@ Font::StringMetrics FTFont::DrawStringToBuffer(float32 size, void* buffer, int32
     return internalFont->DrawString(str, buffer, bufWidth, bufHeight, 255, 255, 255, 255, size, true, offsetX, offsetY, justifyWidth, spaceAddon, ascendScale, descendScale, NULL, contentScaleIncluded);
 }
 
+Font::StringMetrics FTFont::DrawStringToGlyphs(float32 size, Vector<GlyphPlacement>& glyphs, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, bool contentScaleIncluded)
+{
+    return internalFont->DrawString(str, nullptr, 0, 0, 0, 0, 0, 0, size, false, offsetX, offsetY, justifyWidth, spaceAddon, ascendScale, descendScale, nullptr, contentScaleIncluded, &glyphs);
+}
+
+bool FTFont::RasterizeGlyph(float32 size, uint32 glyphIndex, GlyphBitmap& bitmap) const
+{
+    return internalFont->RasterizeGlyph(size, glyphIndex, bitmap);
+}
+
+const FTInternalFont* FTFont::GetInternalFont() const
+{
+    return internalFont;
+}
+
 Font::StringMetrics FTFont::GetStringMetrics(float32 size, const WideString& str, Vector<float32>* charSizes) const
 {
     if (charSizes != nullptr)
@@ -335,7 +353,8 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                                                int32 justifyWidth, int32 spaceAddon,
                                                float32 ascendScale, float32 descendScale,
                                                Vector<float32>* charSizes,
-                                               bool contentScaleIncluded)
+                                               bool contentScaleIncluded,
+                                               Vector<FTFont::GlyphPlacement>* placements)
 {
     if (!initialized)
     {
@@ -540,6 +559,15 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                 }
             }
 
+            if (placements != nullptr && glyph.index > 0)
+            {
+                FTFont::GlyphPlacement placement;
+                placement.glyphIndex = glyph.index;
+                placement.x = FtRound(int32(pen.x)) >> ftToPixelShift;
+                placement.y = multilineOffsetY - (FtRound(int32(pen.y)) >> ftToPixelShift);
+                placements->push_back(placement);
+            }
+
             pen.x += advances[i].x;
             pen.y += advances[i].y;
         }
@@ -583,6 +611,52 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
     return metrics;
 }
 
+bool FTInternalFont::RasterizeGlyph(float32 size, uint32 glyphIndex, FTFont::GlyphBitmap& bitmap)
+{
+    if (!initialized)
+    {
+        return false;
+    }
+
+    LockGuard<Mutex> guard(drawStringMutex);
+
+    size = GetEngineContext()->uiControlSystem->vcs->ConvertVirtualToPhysicalY(size); // increase size for high dpi screens
+    FT_Glyph cachedImage = nullptr;
+    if (ftm->LookupGlyph(this, size, glyphIndex, &cachedImage) != FT_Err_Ok || cachedImage == nullptr)
+    {
+        return false;
+    }
+
+    // Glyph from cache is owned by FTManager, so it is copied before rendering
+    FT_Glyph image = nullptr;
+    FT_Error error = FT_Glyph_Copy(cachedImage, &image);
+    if (error == 0)
+    {
+        error = FT_Glyph_To_Bitmap(&image, FT_RENDER_MODE_NORMAL, nullptr, 1);
+    }
+
+    if (error == 0)
+    {
+        FT_BitmapGlyph bit = FT_BitmapGlyph(image);
+        const FT_Bitmap& ftBitmap = bit->bitmap;
+        bitmap.width = int32(ftBitmap.width);
+        bitmap.height = int32(ftBitmap.rows);
+        bitmap.left = bit->left;
+        bitmap.top = bit->top;
+        bitmap.pixels.resize(bitmap.width * bitmap.height);
+        for (int32 row = 0; row < bitmap.height; ++row)
+        {
+            Memcpy(bitmap.pixels.data() + row * bitmap.width, ftBitmap.buffer + row * ftBitmap.pitch, bitmap.width);
+        }
+    }
+
+    if (image != nullptr)
+    {
+        FT_Done_Glyph(image);
+    }
+    return error == 0;
+}
+
 bool FTInternalFont::IsCharAvaliable(char16 ch)
 {
     if (!initialized)
@@ -590,6 +664,7 @@ bool FTInternalFont::IsCharAvaliable(char16 ch)
         return false;
     }
 
+    LockGuard<Mutex> guard(drawStringMutex);
     uint32 index = ftm->LookupGlyphIndex(this, ch);
     return index != 0;
 }
@@ -601,6 +676,8 @@ uint32 FTInternalFont::GetFontHeight(float32 size, float32 ascendScale, float32
         return 0;
     }
 
+    LockGuard<Mutex> guard(drawStringMutex);
+
     size = GetEngineContext()->uiControlSystem->vcs->ConvertVirtualToPhysicalY(size); // increase size for high dpi screens
     FT_Size ft_size = nullptr;
     if (ftm->LookupSize(this, size, &ft_size) == FT_Err_Ok)
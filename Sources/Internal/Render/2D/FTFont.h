@@ -22,6 +22,24 @@ class FTInternalFont;
 class FTFont : public Font
 {
 public:
+    /** Position of glyph origin (left end of baseline) in buffer coordinates, in pixels. */
+    struct GlyphPlacement
+    {
+        uint32 glyphIndex = 0;
+        int32 x = 0;
+        int32 y = 0;
+    };
+
+    /** Alpha bitmap of single glyph rendered at zero origin. `left` and `top` are offsets of bitmap from origin, `top` is directed up. */
+    struct GlyphBitmap
+    {
+        Vector<uint8> pixels;
+        int32 width = 0;
+        int32 height = 0;
+        int32 left = 0;
+        int32 top = 0;
+    };
+
     /**
 		\brief Factory method.
 		\param[in] path - path to freetype-supported file (.ttf, .otf)
@@ -82,6 +100,22 @@ public:
 	*/
     virtual StringMetrics DrawStringToBuffer(float32 size, void* buffer, int32 bufWidth, int32 bufHeight, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, bool contentScaleIncluded = false);
 
+    /**
+		\brief Layout string same way as `DrawStringToBuffer` does, but instead of rasterization return positions of visible glyphs.
+		Glyphs are placed on whole pixels, so they can be taken from glyph cache.
+		\returns bounding rect for string in pixels
+	*/
+    StringMetrics DrawStringToGlyphs(float32 size, Vector<GlyphPlacement>& glyphs, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, bool contentScaleIncluded = false);
+
+    /**
+		\brief Rasterize single glyph of font with `size` in virtual coordinates.
+		\returns false if glyph can't be rendered
+	*/
+    bool RasterizeGlyph(float32 size, uint32 glyphIndex, GlyphBitmap& bitmap) const;
+
+    /** Return object shared between all fonts created from the same file, identifies font face in glyph caches. */
+    const FTInternalFont* GetInternalFont() const;
+
     bool IsTextSupportsSoftwareRendering() const override;
 
     //We need to return font path
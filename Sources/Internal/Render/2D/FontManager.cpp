@@ -3,7 +3,9 @@
 #include "Render/2D/FontManager.h"
 #include "Render/2D/FTFont.h"
 #include "Render/2D/GraphicFont.h"
+#include "Render/2D/Private/FTGlyphAtlas.h"
 #include "Render/2D/Private/FTManager.h"
+#include "Render/2D/Private/TextBlockLayoutCache.h"
 #include "Logger/Logger.h"
 #include "Render/2D/Sprite.h"
 #include "Utils/StringFormat.h"
@@ -125,15 +127,41 @@ struct GraphicFontConfigDescriptor : public FontConfigDescriptor
 
 FontManager::FontManager()
     : ftmanager(std::make_unique<FTManager>())
+    , textLayoutCache(std::make_unique<TextBlockLayoutCache>())
 {
 }
 
 FontManager::~FontManager()
 {
+    glyphAtlas.reset();
     FTFont::ClearCache();
     UnregisterFontsPresets();
 }
 
+FTGlyphAtlas* FontManager::GetGlyphAtlas()
+{
+    if (!glyphAtlas)
+    {
+        glyphAtlas = std::make_unique<FTGlyphAtlas>();
+    }
+    return glyphAtlas.get();
+}
+
+void FontManager::SetGlyphAtlasEnabled(bool enabled)
+{
+    glyphAtlasEnabled = enabled;
+}
+
+bool FontManager::IsGlyphAtlasEnabled() const
+{
+    return glyphAtlasEnabled;
+}
+
+TextBlockLayoutCache* FontManager::GetTextLayoutCache()
+{
+    return textLayoutCache.get();
+}
+
 RefPtr<Font> FontManager::LoadFont(const FilePath& fontPath)
 {
     using namespace FontManagerDetails;
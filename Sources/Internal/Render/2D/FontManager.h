@@ -9,6 +9,8 @@ namespace DAVA
 {
 class Font;
 class FTManager;
+class FTGlyphAtlas;
+class TextBlockLayoutCache;
 class FilePath;
 
 namespace FontManagerDetails
@@ -30,6 +32,23 @@ public:
         return ftmanager.get();
     }
 
+    /**
+     \brief Get shared atlas with glyphs of FreeType fonts. Atlas is created on first call.
+     */
+    FTGlyphAtlas* GetGlyphAtlas();
+
+    /**
+     \brief Enable rendering of FreeType text with quads from shared glyph atlas instead of texture per text block.
+     Applies to text blocks which font is set after the call. Disabled by default.
+     */
+    void SetGlyphAtlasEnabled(bool enabled);
+    bool IsGlyphAtlasEnabled() const;
+
+    /**
+     \brief Get shared cache of text block layouts. Cache is thread-safe.
+     */
+    TextBlockLayoutCache* GetTextLayoutCache();
+
     RefPtr<Font> LoadFont(const FilePath& fontPath);
 
     /**
@@ -83,5 +102,8 @@ private:
     UnorderedMap<String, FontPreset> fontPresetMap;
     UnorderedMap<String, std::unique_ptr<FontManagerDetails::FontConfigDescriptor>> fontConfigs;
     std::unique_ptr<FTManager> ftmanager;
+    std::unique_ptr<FTGlyphAtlas> glyphAtlas;
+    std::unique_ptr<TextBlockLayoutCache> textLayoutCache;
+    bool glyphAtlasEnabled = false;
 };
 };
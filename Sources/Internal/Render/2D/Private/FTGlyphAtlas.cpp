@@ -0,0 +1,307 @@
+#include "Render/2D/Private/FTGlyphAtlas.h"
+#include "Debug/DVAssert.h"
+#include "Engine/Engine.h"
+#include "Logger/Logger.h"
+#include "Render/2D/FTFont.h"
+#include "Render/2D/Systems/VirtualCoordinatesSystem.h"
+#include "Render/Renderer.h"
+#include "Render/Texture.h"
+#include "UI/UIControlSystem.h"
+
+namespace DAVA
+{
+namespace FTGlyphAtlasDetails
+{
+const uint32 GLYPH_PADDING = 1; // empty pixels between glyphs to avoid filtering artifacts
+const uint32 SHELF_HEIGHT_GRANULARITY = 4;
+
+uint32 GetCurrentFrame()
+{
+    return Engine::Instance()->GetGlobalFrameIndex();
+}
+}
+
+bool FTGlyphAtlas::GlyphKey::operator<(const GlyphKey& other) const
+{
+    return std::tie(font, size, glyphIndex) < std::tie(other.font, other.size, other.glyphIndex);
+}
+
+FTGlyphAtlas::FTGlyphAtlas(uint32 width_, uint32 height_)
+    : width(width_)
+    , height(height_)
+    , pixels(width_ * height_, 0)
+{
+    Renderer::GetSignals().needRestoreResources.Connect(this, &FTGlyphAtlas::Restore);
+}
+
+FTGlyphAtlas::~FTGlyphAtlas()
+{
+    Renderer::GetSignals().needRestoreResources.Disconnect(this);
+    SafeRelease(texture);
+}
+
+const FTGlyphAtlas::Glyph* FTGlyphAtlas::GetGlyph(FTFont* font, float32 size, uint32 glyphIndex)
+{
+    using namespace FTGlyphAtlasDetails;
+
+    CheckPhysicalScale();
+
+    GlyphKey key;
+    key.font = font->GetInternalFont();
+    key.size = size;
+    key.glyphIndex = glyphIndex;
+
+    auto it = glyphs.find(key);
+    if (it != glyphs.end())
+    {
+        return &it->second;
+    }
+
+    FTFont::GlyphBitmap bitmap;
+    if (!font->RasterizeGlyph(size, glyphIndex, bitmap))
+    {
+        return nullptr;
+    }
+    ++rasterizedGlyphsCount;
+
+    Glyph glyph;
+    glyph.left = bitmap.left;
+    glyph.top = bitmap.top;
+    glyph.width = bitmap.width;
+    glyph.height = bitmap.height;
+
+    if (bitmap.width > 0 && bitmap.height > 0)
+    {
+        uint32 x = 0;
+        uint32 y = 0;
+        glyph.shelfIndex = AllocateRegion(uint32(bitmap.width) + GLYPH_PADDING, uint32(bitmap.height) + GLYPH_PADDING, x, y);
+        if (glyph.shelfIndex == INVALID_SHELF)
+        {
+            return nullptr;
+        }
+
+        for (int32 row = 0; row < bitmap.height; ++row)
+        {
+            Memcpy(pixels.data() + (y + row) * width + x, bitmap.pixels.data() + row * bitmap.width, bitmap.width);
+        }
+        MarkDirty(x, y, uint32(bitmap.width), uint32(bitmap.height));
+
+        glyph.uvMin = Vector2(float32(x) / width, float32(y) / height);
+        glyph.uvMax = Vector2(float32(x + bitmap.width) / width, float32(y + bitmap.height) / height);
+    }
+
+    return &(glyphs[key] = glyph);
+}
+
+void FTGlyphAtlas::TouchShelf(uint32 shelfIndex)
+{
+    DVASSERT(shelfIndex < shelves.size());
+    shelves[shelfIndex].lastUsedFrame = FTGlyphAtlasDetails::GetCurrentFrame();
+}
+
+Texture* FTGlyphAtlas::GetTexture()
+{
+    if (texture == nullptr)
+    {
+        texture = Texture::CreateTextFromData(FORMAT_A8, pixels.data(), width, height, false, "FTGlyphAtlas");
+        texture->SetWrapMode(rhi::TEXADDR_CLAMP, rhi::TEXADDR_CLAMP);
+        texture->SetMinMagFilter(rhi::TEXFILTER_LINEAR, rhi::TEXFILTER_LINEAR, rhi::TEXMIPFILTER_NONE);
+        ResetDirty();
+    }
+    else if (dirtyRight != 0)
+    {
+        uint32 regionWidth = dirtyRight - dirtyLeft;
+        uint32 regionHeight = dirtyBottom - dirtyTop;
+        const uint8* regionPixels = pixels.data() + dirtyTop * width;
+        if (regionWidth != width)
+        {
+            // Rows of uploaded region should be tightly packed
+            uploadPixels.resize(regionWidth * regionHeight);
+            for (uint32 row = 0; row < regionHeight; ++row)
+            {
+                Memcpy(uploadPixels.data() + row * regionWidth, regionPixels + row * width + dirtyLeft, regionWidth);
+            }
+            regionPixels = uploadPixels.data();
+        }
+        rhi::UpdateTextureRegion(texture->handle, regionPixels, 0, dirtyLeft, dirtyTop, regionWidth, regionHeight);
+        ResetDirty();
+    }
+    return texture;
+}
+
+bool FTGlyphAtlas::AreShelvesValid(uint32 builtGeneration, const Vector<uint32>& shelfIndices) const
+{
+    if (builtGeneration == generation)
+    {
+        return true;
+    }
+    if (builtGeneration < clearGeneration)
+    {
+        return false;
+    }
+    for (uint32 shelfIndex : shelfIndices)
+    {
+        if (shelfIndex >= shelves.size() || shelves[shelfIndex].evictedGeneration > builtGeneration)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FTGlyphAtlas::Clear()
+{
+    glyphs.clear();
+    shelves.clear();
+    shelvesBottom = 0;
+    std::fill(pixels.begin(), pixels.end(), uint8(0));
+    MarkDirty(0, 0, width, height);
+    clearGeneration = ++generation;
+}
+
+uint32 FTGlyphAtlas::AllocateRegion(uint32 regionWidth, uint32 regionHeight, uint32& x, uint32& y)
+{
+    using namespace FTGlyphAtlasDetails;
+
+    if (regionWidth > width || regionHeight > height)
+    {
+        Logger::Warning("[FTGlyphAtlas] Glyph %ux%u is too big for atlas", regionWidth, regionHeight);
+        return INVALID_SHELF;
+    }
+
+    uint32 currentFrame = GetCurrentFrame();
+    uint32 shelfHeight = (regionHeight + SHELF_HEIGHT_GRANULARITY - 1) / SHELF_HEIGHT_GRANULARITY * SHELF_HEIGHT_GRANULARITY;
+    shelfHeight = Min(shelfHeight, height);
+
+    // Best fit among existing shelves, too high shelves are skipped to not waste space
+    uint32 bestShelf = INVALID_SHELF;
+    for (uint32 i = 0; i < uint32(shelves.size()); ++i)
+    {
+        const Shelf& shelf = shelves[i];
+        if (shelf.height >= regionHeight && shelf.height <= shelfHeight * 2 && shelf.usedWidth + regionWidth <= width)
+        {
+            if (bestShelf == INVALID_SHELF || shelf.height < shelves[bestShelf].height)
+            {
+                bestShelf = i;
+            }
+        }
+    }
+
+    if (bestShelf == INVALID_SHELF && shelvesBottom + shelfHeight <= height)
+    {
+        Shelf shelf;
+        shelf.y = shelvesBottom;
+        shelf.height = shelfHeight;
+        shelves.push_back(shelf);
+        shelvesBottom += shelfHeight;
+        bestShelf = uint32(shelves.size()) - 1;
+    }
+
+    if (bestShelf == INVALID_SHELF)
+    {
+        // Evict least recently used shelf that is high enough
+        for (uint32 i = 0; i < uint32(shelves.size()); ++i)
+        {
+            const Shelf& shelf = shelves[i];
+            if (shelf.height >= regionHeight && shelf.lastUsedFrame != currentFrame)
+            {
+                if (bestShelf == INVALID_SHELF || shelf.lastUsedFrame < shelves[bestShelf].lastUsedFrame)
+                {
+                    bestShelf = i;
+                }
+            }
+        }
+
+        if (bestShelf == INVALID_SHELF)
+        {
+            Logger::Warning("[FTGlyphAtlas] No space for %ux%u glyph, all shelves are used in current frame", regionWidth, regionHeight);
+            return INVALID_SHELF;
+        }
+        EvictShelf(bestShelf);
+    }
+
+    Shelf& shelf = shelves[bestShelf];
+    x = shelf.usedWidth;
+    y = shelf.y;
+    shelf.usedWidth += regionWidth;
+    shelf.lastUsedFrame = currentFrame;
+    return bestShelf;
+}
+
+void FTGlyphAtlas::EvictShelf(uint32 shelfIndex)
+{
+    Shelf& shelf = shelves[shelfIndex];
+    for (auto it = glyphs.begin(); it != glyphs.end();)
+    {
+        if (it->second.shelfIndex == shelfIndex)
+        {
+            it = glyphs.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    uint8* shelfPixels = pixels.data() + shelf.y * width;
+    std::fill(shelfPixels, shelfPixels + shelf.height * width, uint8(0));
+    MarkDirty(0, shelf.y, shelf.usedWidth, shelf.height);
+    shelf.usedWidth = 0;
+
+    shelf.evictedGeneration = ++generation;
+    ++evictedShelvesCount;
+}
+
+void FTGlyphAtlas::MarkDirty(uint32 x, uint32 y, uint32 regionWidth, uint32 regionHeight)
+{
+    if (regionWidth == 0 || regionHeight == 0)
+    {
+        return;
+    }
+
+    if (dirtyRight == 0)
+    {
+        dirtyLeft = x;
+        dirtyTop = y;
+        dirtyRight = x + regionWidth;
+        dirtyBottom = y + regionHeight;
+    }
+    else
+    {
+        dirtyLeft = Min(dirtyLeft, x);
+        dirtyTop = Min(dirtyTop, y);
+        dirtyRight = Max(dirtyRight, x + regionWidth);
+        dirtyBottom = Max(dirtyBottom, y + regionHeight);
+    }
+}
+
+void FTGlyphAtlas::ResetDirty()
+{
+    dirtyLeft = 0;
+    dirtyTop = 0;
+    dirtyRight = 0;
+    dirtyBottom = 0;
+}
+
+void FTGlyphAtlas::CheckPhysicalScale()
+{
+    float32 scale = GetEngineContext()->uiControlSystem->vcs->ConvertVirtualToPhysicalY(1.f);
+    if (scale != physicalScale)
+    {
+        physicalScale = scale;
+        if (!glyphs.empty())
+        {
+            Clear();
+        }
+    }
+}
+
+void FTGlyphAtlas::Restore()
+{
+    if (texture != nullptr && rhi::NeedRestoreTexture(texture->handle))
+    {
+        texture->TexImage(0, width, height, pixels.data(), static_cast<uint32>(pixels.size()), Texture::INVALID_CUBEMAP_FACE);
+        ResetDirty();
+    }
+}
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/Vector.h"
+
+namespace DAVA
+{
+class FTFont;
+class FTInternalFont;
+class Texture;
+
+/**
+    Shared alpha texture with glyphs of FreeType fonts.
+    Glyphs are rasterized once per (font, size, glyph) and packed into horizontal shelves.
+    When atlas is full, least recently used shelf is evicted with all its glyphs. Shelves used during current frame are
+    never evicted, so geometry already pushed for rendering stays valid.
+    Atlas is dropped when virtual to physical scale changes, as glyphs are rasterized in physical pixels.
+*/
+class FTGlyphAtlas final
+{
+public:
+    static const uint32 DEFAULT_SIZE = 1024;
+    static const uint32 INVALID_SHELF = ~0u;
+
+    struct Glyph
+    {
+        Vector2 uvMin;
+        Vector2 uvMax;
+        int32 left = 0; // offset of bitmap from glyph origin, in physical pixels
+        int32 top = 0; // directed up from baseline
+        int32 width = 0; // zero for glyphs without image, e.g. space
+        int32 height = 0;
+        uint32 shelfIndex = INVALID_SHELF;
+    };
+
+    FTGlyphAtlas(uint32 width = DEFAULT_SIZE, uint32 height = DEFAULT_SIZE);
+    ~FTGlyphAtlas();
+
+    /**
+        Return glyph from atlas, glyph is rasterized and added if it wasn't found.
+        Returned pointer is valid until next `GetGlyph` call. Return nullptr if glyph can't be rendered or there is no space for it.
+    */
+    const Glyph* GetGlyph(FTFont* font, float32 size, uint32 glyphIndex);
+
+    /** Mark shelf as used in current frame, to keep it from eviction. */
+    void TouchShelf(uint32 shelfIndex);
+
+    /** Generation is incremented each time glyphs are removed from atlas. */
+    uint32 GetGeneration() const;
+
+    /**
+        Check that glyphs of shelves with `shelfIndices` weren't removed since `builtGeneration`.
+        Geometry built at other generation should be rebuilt only if this check fails.
+    */
+    bool AreShelvesValid(uint32 builtGeneration, const Vector<uint32>& shelfIndices) const;
+
+    /** Upload pending changes and return texture. Only region changed since previous upload is sent. Texture is created on first call. */
+    Texture* GetTexture();
+
+    void Clear();
+
+    uint32 GetGlyphsCount() const;
+    uint32 GetRasterizedGlyphsCount() const;
+    uint32 GetEvictedShelvesCount() const;
+
+private:
+    struct GlyphKey
+    {
+        const FTInternalFont* font = nullptr;
+        float32 size = 0.f;
+        uint32 glyphIndex = 0;
+
+        bool operator<(const GlyphKey& other) const;
+    };
+
+    struct Shelf
+    {
+        uint32 y = 0;
+        uint32 height = 0;
+        uint32 usedWidth = 0;
+        uint32 lastUsedFrame = 0;
+        uint32 evictedGeneration = 0;
+    };
+
+    uint32 AllocateRegion(uint32 regionWidth, uint32 regionHeight, uint32& x, uint32& y);
+    void EvictShelf(uint32 shelfIndex);
+    void MarkDirty(uint32 x, uint32 y, uint32 regionWidth, uint32 regionHeight);
+    void ResetDirty();
+    void CheckPhysicalScale();
+    void Restore();
+
+    uint32 width = 0;
+    uint32 height = 0;
+    Vector<uint8> pixels;
+    Texture* texture = nullptr;
+
+    // Region of `pixels` changed since last upload, empty when `dirtyRight` is zero
+    uint32 dirtyLeft = 0;
+    uint32 dirtyTop = 0;
+    uint32 dirtyRight = 0;
+    uint32 dirtyBottom = 0;
+    Vector<uint8> uploadPixels;
+
+    Map<GlyphKey, Glyph> glyphs;
+    Vector<Shelf> shelves;
+    uint32 shelvesBottom = 0;
+    float32 physicalScale = 0.f;
+
+    uint32 generation = 0;
+    uint32 clearGeneration = 0;
+    uint32 rasterizedGlyphsCount = 0;
+    uint32 evictedShelvesCount = 0;
+};
+
+inline uint32 FTGlyphAtlas::GetGeneration() const
+{
+    return generation;
+}
+
+inline uint32 FTGlyphAtlas::GetGlyphsCount() const
+{
+    return static_cast<uint32>(glyphs.size());
+}
+
+inline uint32 FTGlyphAtlas::GetRasterizedGlyphsCount() const
+{
+    return rasterizedGlyphsCount;
+}
+
+inline uint32 FTGlyphAtlas::GetEvictedShelvesCount() const
+{
+    return evictedShelvesCount;
+}
+}
@@ -0,0 +1,100 @@
+#include "Render/2D/Private/TextBlockLayoutCache.h"
+#include "Concurrency/LockGuard.h"
+
+namespace DAVA
+{
+bool TextBlockLayoutCache::Key::operator<(const Key& other) const
+{
+    return std::tie(fontHash, renderSize, rectSize.x, rectSize.y, requestedSize.x, requestedSize.y, physicalScale.x, physicalScale.y,
+                    align, useRtlAlign, fittingType, multiline, multilineBySymbol, useBiDi, systemRtl, text) <
+    std::tie(other.fontHash, other.renderSize, other.rectSize.x, other.rectSize.y, other.requestedSize.x, other.requestedSize.y, other.physicalScale.x, other.physicalScale.y,
+             other.align, other.useRtlAlign, other.fittingType, other.multiline, other.multilineBySymbol, other.useBiDi, other.systemRtl, other.text);
+}
+
+TextBlockLayoutCache::TextBlockLayoutCache(uint32 capacity_)
+    : capacity(capacity_)
+{
+}
+
+bool TextBlockLayoutCache::Find(const Key& key, Layout& layout)
+{
+    LockGuard<Mutex> lock(mutex);
+
+    auto it = entries.find(key);
+    if (it == entries.end())
+    {
+        ++missesCount;
+        return false;
+    }
+
+    ++hitsCount;
+    it->second.lastUseIndex = ++useIndex;
+    layout = it->second.layout;
+    return true;
+}
+
+void TextBlockLayoutCache::Add(const Key& key, const Layout& layout)
+{
+    LockGuard<Mutex> lock(mutex);
+
+    Entry& entry = entries[key];
+    entry.layout = layout;
+    entry.lastUseIndex = ++useIndex;
+
+    if (entries.size() > capacity)
+    {
+        Shrink();
+    }
+}
+
+void TextBlockLayoutCache::Clear()
+{
+    LockGuard<Mutex> lock(mutex);
+    entries.clear();
+}
+
+uint32 TextBlockLayoutCache::GetLayoutsCount() const
+{
+    LockGuard<Mutex> lock(mutex);
+    return static_cast<uint32>(entries.size());
+}
+
+uint32 TextBlockLayoutCache::GetHitsCount() const
+{
+    LockGuard<Mutex> lock(mutex);
+    return hitsCount;
+}
+
+uint32 TextBlockLayoutCache::GetMissesCount() const
+{
+    LockGuard<Mutex> lock(mutex);
+    return missesCount;
+}
+
+void TextBlockLayoutCache::Shrink()
+{
+    // Remove a quarter of least recently used layouts at once, so full cache isn't scanned on each addition
+    Vector<uint64> useIndices;
+    useIndices.reserve(entries.size());
+    for (const auto& pair : entries)
+    {
+        useIndices.push_back(pair.second.lastUseIndex);
+    }
+
+    size_t removeCount = Max(size_t(1), useIndices.size() / 4);
+    std::nth_element(useIndices.begin(), useIndices.begin() + (removeCount - 1), useIndices.end());
+    uint64 threshold = useIndices[removeCount - 1];
+
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->second.lastUseIndex <= threshold)
+        {
+            it = entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/Mutex.h"
+#include "Math/Vector.h"
+
+namespace DAVA
+{
+/**
+    Shared cache of text block layouts.
+    Layout of a text block depends only on text, font, size, rect and layout flags, so the same string shown by many
+    controls (or by the same control after recreation) is split into lines, shaped and fitted only once.
+    Cache is thread-safe, text blocks are laid out from worker jobs by UITextSystem.
+*/
+class TextBlockLayoutCache final
+{
+public:
+    static const uint32 DEFAULT_CAPACITY = 1024;
+
+    struct Key
+    {
+        WideString text;
+        uint32 fontHash = 0; // font path, type, spacing and ascend/descend scales
+        float32 renderSize = 0.f;
+        Vector2 rectSize;
+        Vector2 requestedSize;
+        Vector2 physicalScale;
+        int32 align = 0;
+        int32 useRtlAlign = 0;
+        int32 fittingType = 0;
+        bool multiline = false;
+        bool multilineBySymbol = false;
+        bool useBiDi = false;
+        bool systemRtl = false;
+
+        bool operator<(const Key& other) const;
+    };
+
+    struct Layout
+    {
+        WideString visualText;
+        Vector<WideString> multilineStrings;
+        Vector<float32> stringSizes;
+        Vector2 finalSize;
+        Vector2 spriteOffset;
+        Vector2 textSize;
+        float32 renderSize = 0.f;
+        int32 dx = 0;
+        int32 dy = 0;
+        int32 w = 0;
+        int32 ox = 0;
+        int32 oy = 0;
+        int32 visualAlign = 0;
+        int32 fittingTypeUsed = 0;
+        bool visualTextCroped = false;
+        bool useJustify = false;
+        bool treatMultilineAsSingleLine = false;
+        bool isRtl = false;
+    };
+
+    TextBlockLayoutCache(uint32 capacity = DEFAULT_CAPACITY);
+
+    /** Copy cached layout for `key` into `layout`. Return false if there is no such layout. */
+    bool Find(const Key& key, Layout& layout);
+
+    /** Add layout, least recently used layouts are removed when cache exceeds its capacity. */
+    void Add(const Key& key, const Layout& layout);
+
+    void Clear();
+
+    uint32 GetLayoutsCount() const;
+    uint32 GetHitsCount() const;
+    uint32 GetMissesCount() const;
+
+private:
+    struct Entry
+    {
+        Layout layout;
+        uint64 lastUseIndex = 0;
+    };
+
+    void Shrink();
+
+    uint32 capacity = 0;
+    mutable Mutex mutex;
+    Map<Key, Entry> entries;
+    uint64 useIndex = 0;
+    uint32 hitsCount = 0;
+    uint32 missesCount = 0;
+};
+}
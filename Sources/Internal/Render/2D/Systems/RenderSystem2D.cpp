@@ -28,6 +28,36 @@ const bool virtualToPhysicalTransformEnabledDefaultValue = true;
 const uint32 MAX_VERTICES = 1024;
 const uint32 MAX_INDECES = MAX_VERTICES * 2;
 const float32 SEGMENT_LENGTH = 15.0f;
+const uint32 MAX_REORDERED_PACKETS = 32;
+
+uint32 GetPrimitiveCount(rhi::PrimitiveType primitiveType, uint32 indexCount)
+{
+    switch (primitiveType)
+    {
+    case rhi::PRIMITIVE_LINELIST:
+        return indexCount / 2;
+    case rhi::PRIMITIVE_TRIANGLELIST:
+        return indexCount / 3;
+    case rhi::PRIMITIVE_TRIANGLESTRIP:
+        return indexCount - 2;
+    }
+    return 0;
+}
+
+Rect GetBatchBounds(const BatchDescriptor2D& batchDesc)
+{
+    Vector2 minPoint(batchDesc.vertexPointer[0], batchDesc.vertexPointer[1]);
+    Vector2 maxPoint = minPoint;
+    for (uint32 i = 1; i < batchDesc.vertexCount; ++i)
+    {
+        const float32* vertex = batchDesc.vertexPointer + i * batchDesc.vertexStride;
+        minPoint.x = Min(minPoint.x, vertex[0]);
+        minPoint.y = Min(minPoint.y, vertex[1]);
+        maxPoint.x = Max(maxPoint.x, vertex[0]);
+        maxPoint.y = Max(maxPoint.y, vertex[1]);
+    }
+    return Rect(minPoint, maxPoint - minPoint);
+}
 }
 
 const FastName RenderSystem2D::RENDER_PASS_NAME("2d");
@@ -493,28 +523,18 @@ void RenderSystem2D::Flush()
     Called on each EndFrame, particle draw, screen transitions preparing, screen borders draw and changing state
     */
 
+    FlushReorderedPackets();
+    FlushCurrentPacket();
+}
+
+void RenderSystem2D::FlushCurrentPacket()
+{
     if (vertexIndex == 0 && indexIndex == 0)
     {
         return;
     }
 
-    DynamicBufferAllocator::AllocResultVB vertexBuffer = DynamicBufferAllocator::AllocateVertexBuffer(GetVBOStride(currentTexcoordStreamCount), vertexIndex);
-    DynamicBufferAllocator::AllocResultIB indexBuffer = DynamicBufferAllocator::AllocateIndexBuffer(indexIndex);
-    DVASSERT(vertexBuffer.allocatedVertices == vertexIndex);
-    DVASSERT(indexBuffer.allocatedindices == indexIndex);
-    Memcpy(vertexBuffer.data, currentVertexBuffer.data(), GetVBOStride(currentTexcoordStreamCount) * vertexIndex);
-    Memcpy(indexBuffer.data, currentIndexBuffer.data(), indexIndex * 2);
-
-    currentPacket.vertexStream[0] = vertexBuffer.buffer;
-    currentPacket.vertexCount = vertexBuffer.allocatedVertices;
-    currentPacket.baseVertex = vertexBuffer.baseVertex;
-    currentPacket.indexBuffer = indexBuffer.buffer;
-    currentPacket.startIndex = indexBuffer.baseIndex;
-
-    if (currentPacketListHandle != rhi::InvalidHandle && currentPacket.primitiveCount > 0)
-    {
-        AddPacket(currentPacket);
-    }
+    SubmitBatchedPacket(currentPacket, currentVertexBuffer, currentIndexBuffer, vertexIndex, indexIndex, currentTexcoordStreamCount);
 
     currentVertexBuffer.clear();
     currentIndexBuffer.clear();
@@ -530,6 +550,61 @@ void RenderSystem2D::Flush()
     lastMaterial = nullptr;
 }
 
+void RenderSystem2D::FlushReorderedPackets()
+{
+    if (reorderedPacketsCount == 0)
+    {
+        return;
+    }
+
+    for (uint32 i = 0; i < reorderedPacketsCount; ++i)
+    {
+        ReorderedPacket& reordered = reorderedPackets[i];
+        SubmitBatchedPacket(reordered.packet, reordered.vertexBuffer, reordered.indexBuffer, reordered.vertexCount, reordered.indexCount, reordered.texCoordStreamCount);
+    }
+    reorderedPacketsCount = 0;
+
+    // Dynamic bindings were changed by reordered packets, so current packet should be set up again
+    lastMaterial = nullptr;
+}
+
+void RenderSystem2D::SubmitBatchedPacket(rhi::Packet& packet, const Vector<uint8>& vertexBuffer, const Vector<uint16>& indexBuffer, uint32 vertexCount, uint32 indexCount, uint32 texCoordStreamCount)
+{
+    uint32 vertexStride = GetVBOStride(texCoordStreamCount);
+    DynamicBufferAllocator::AllocResultVB vb = DynamicBufferAllocator::AllocateVertexBuffer(vertexStride, vertexCount);
+    DynamicBufferAllocator::AllocResultIB ib = DynamicBufferAllocator::AllocateIndexBuffer(indexCount);
+    DVASSERT(vb.allocatedVertices == vertexCount);
+    DVASSERT(ib.allocatedindices == indexCount);
+    Memcpy(vb.data, vertexBuffer.data(), vertexStride * vertexCount);
+    Memcpy(ib.data, indexBuffer.data(), indexCount * 2);
+
+    packet.vertexStream[0] = vb.buffer;
+    packet.vertexCount = vb.allocatedVertices;
+    packet.baseVertex = vb.baseVertex;
+    packet.indexBuffer = ib.buffer;
+    packet.startIndex = ib.baseIndex;
+
+    if (currentPacketListHandle != rhi::InvalidHandle && packet.primitiveCount > 0)
+    {
+        AddPacket(packet);
+    }
+}
+
+void RenderSystem2D::BeginBatchReordering()
+{
+    ++batchReorderingDepth;
+}
+
+void RenderSystem2D::EndBatchReordering()
+{
+    DVASSERT(batchReorderingDepth > 0);
+    --batchReorderingDepth;
+    if (batchReorderingDepth == 0)
+    {
+        FlushReorderedPackets();
+    }
+}
+
 void RenderSystem2D::DrawPacket(rhi::Packet& packet)
 {
     if (currentClip.dx == 0.f || currentClip.dy == 0.f)
@@ -581,10 +656,17 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
     ++Renderer::GetRenderStats().batches2d;
 #endif
     uint32 trimmedTexCoordCount = Max(batchDesc.texCoordCount, 1u); //for zero texCoordCount count we just use 1 empty texcoord stream for batching optimization
+    if (batchReorderingDepth > 0 && batchDesc.worldMatrix == nullptr && batchDesc.vertexCount <= MAX_VERTICES && batchDesc.indexCount <= MAX_INDECES)
+    {
+        PushReorderedBatch(batchDesc, trimmedTexCoordCount);
+        return;
+    }
+    FlushReorderedPackets();
+
     if ((vertexIndex + batchDesc.vertexCount > MAX_VERTICES) || (indexIndex + batchDesc.indexCount > MAX_INDECES) || (trimmedTexCoordCount != currentTexcoordStreamCount))
     {
         // Buffer overflow or format changed. Switch to next VBO.
-        Flush();
+        FlushCurrentPacket();
         currentTexcoordStreamCount = trimmedTexCoordCount;
         currentPacket.vertexLayoutUID = GetVertexLayoutId(currentTexcoordStreamCount);
 
@@ -628,44 +710,140 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
     // Begin new packet
     if (currentPacket.textureSet != batchDesc.textureSetHandle || currentPacket.primitiveType != batchDesc.primitiveType || lastMaterial != batchDesc.material || lastClip != currentClip || needUpdateWorldMatrix)
     {
-        Flush();
-        if (useCustomWorldMatrix)
+        FlushCurrentPacket();
+        BindBatchPacket(currentPacket, batchDesc, useCustomWorldMatrix);
+        lastClip = currentClip;
+        lastMaterial = batchDesc.material;
+    }
+    // End new packet
+
+    uint32 vertexStride = GetVBOStride(currentTexcoordStreamCount);
+    currentVertexBuffer.resize(vertexStride * (vertexIndex + batchDesc.vertexCount));
+    currentIndexBuffer.resize(indexIndex + batchDesc.indexCount);
+    FillBatchBuffers(batchDesc, currentTexcoordStreamCount, currentVertexBuffer.data() + vertexStride * vertexIndex, currentIndexBuffer.data() + indexIndex, vertexIndex);
+
+    currentPacket.primitiveCount += GetPrimitiveCount(currentPacket.primitiveType, batchDesc.indexCount);
+    indexIndex += batchDesc.indexCount;
+    vertexIndex += batchDesc.vertexCount;
+}
+
+uint32 RenderSystem2D::FindReorderedPacket(const ReorderedPacket* packets, uint32 packetsCount, const ReorderedPacket& batch)
+{
+    // Batch can be moved back to earlier packet with the same state only over packets it doesn't overlap
+    for (uint32 i = packetsCount; i > 0; --i)
+    {
+        const ReorderedPacket& reordered = packets[i - 1];
+        if (reordered.packet.textureSet == batch.packet.textureSet && reordered.packet.primitiveType == batch.packet.primitiveType &&
+            reordered.material == batch.material && reordered.clip == batch.clip && reordered.texCoordStreamCount == batch.texCoordStreamCount &&
+            reordered.vertexCount + batch.vertexCount <= MAX_VERTICES && reordered.indexCount + batch.indexCount <= MAX_INDECES)
         {
-            Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_WORLD, &lastCustomWorldMatrix, DynamicBindings::UPDATE_SEMANTIC_ALWAYS);
+            return i - 1;
         }
-        else
+
+        if (reordered.bounds.RectIntersects(batch.bounds))
         {
-            Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_WORLD, &Matrix4::IDENTITY, reinterpret_cast<pointer_size>(&Matrix4::IDENTITY));
+            break;
         }
-        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_PROJ, &projMatrix, static_cast<pointer_size>(projMatrixSemantic));
-        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_VIEW, &viewMatrix, static_cast<pointer_size>(viewMatrixSemantic));
-        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_GLOBAL_TIME, &globalTime, reinterpret_cast<pointer_size>(&globalTime));
+    }
+    return packetsCount;
+}
+
+void RenderSystem2D::PushReorderedBatch(const BatchDescriptor2D& batchDesc, uint32 texCoordStreamCount)
+{
+    FlushCurrentPacket();
+
+    const Rect batchBounds = GetBatchBounds(batchDesc);
+    ReorderedPacket reorderingBatch;
+    reorderingBatch.packet.textureSet = batchDesc.textureSetHandle;
+    reorderingBatch.packet.primitiveType = batchDesc.primitiveType;
+    reorderingBatch.material = batchDesc.material;
+    reorderingBatch.clip = currentClip;
+    reorderingBatch.bounds = batchBounds;
+    reorderingBatch.texCoordStreamCount = texCoordStreamCount;
+    reorderingBatch.vertexCount = batchDesc.vertexCount;
+    reorderingBatch.indexCount = batchDesc.indexCount;
 
-        if (currentClip.dx > 0.f && currentClip.dy > 0.f)
+    const uint32 targetIndex = FindReorderedPacket(reorderedPackets.data(), reorderedPacketsCount, reorderingBatch);
+    ReorderedPacket* target = (targetIndex < reorderedPacketsCount) ? &reorderedPackets[targetIndex] : nullptr;
+
+    if (target == nullptr)
+    {
+        if (reorderedPacketsCount == MAX_REORDERED_PACKETS)
         {
-            const Rect& transformedClipRect = TransformClipRect(currentClip, currentVirtualToPhysicalMatrix);
-            currentPacket.scissorRect.x = static_cast<int16>(std::floor(transformedClipRect.x));
-            currentPacket.scissorRect.y = static_cast<int16>(std::floor(transformedClipRect.y));
-            currentPacket.scissorRect.width = static_cast<int16>(std::ceil(transformedClipRect.dx));
-            currentPacket.scissorRect.height = static_cast<int16>(std::ceil(transformedClipRect.dy));
-            currentPacket.options |= rhi::Packet::OPT_OVERRIDE_SCISSOR;
+            FlushReorderedPackets();
         }
-        else
+        if (reorderedPacketsCount == reorderedPackets.size())
         {
-            currentPacket.options &= ~rhi::Packet::OPT_OVERRIDE_SCISSOR;
+            reorderedPackets.emplace_back();
         }
-        lastClip = currentClip;
 
-        currentPacket.primitiveType = batchDesc.primitiveType;
+        target = &reorderedPackets[reorderedPacketsCount++];
+        target->packet = rhi::Packet();
+        target->packet.vertexStreamCount = 1;
+        target->packet.options = 0;
+        target->packet.primitiveCount = 0;
+        target->packet.vertexLayoutUID = GetVertexLayoutId(texCoordStreamCount);
+        BindBatchPacket(target->packet, batchDesc, false);
+        target->material = batchDesc.material;
+        target->clip = currentClip;
+        target->bounds = batchBounds;
+        target->texCoordStreamCount = texCoordStreamCount;
+        target->vertexCount = 0;
+        target->indexCount = 0;
+    }
+    else
+    {
+        target->bounds = target->bounds.Combine(batchBounds);
+    }
 
-        DVASSERT(batchDesc.material);
-        lastMaterial = batchDesc.material;
-        lastMaterial->BindParams(currentPacket);
-        currentPacket.textureSet = batchDesc.textureSetHandle;
-        currentPacket.samplerState = batchDesc.samplerStateHandle;
+    uint32 vertexStride = GetVBOStride(texCoordStreamCount);
+    target->vertexBuffer.resize(vertexStride * (target->vertexCount + batchDesc.vertexCount));
+    target->indexBuffer.resize(target->indexCount + batchDesc.indexCount);
+    FillBatchBuffers(batchDesc, texCoordStreamCount, target->vertexBuffer.data() + vertexStride * target->vertexCount, target->indexBuffer.data() + target->indexCount, target->vertexCount);
+
+    target->packet.primitiveCount += GetPrimitiveCount(target->packet.primitiveType, batchDesc.indexCount);
+    target->vertexCount += batchDesc.vertexCount;
+    target->indexCount += batchDesc.indexCount;
+}
+
+void RenderSystem2D::BindBatchPacket(rhi::Packet& packet, const BatchDescriptor2D& batchDesc, bool useCustomWorldMatrix)
+{
+    if (useCustomWorldMatrix)
+    {
+        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_WORLD, &lastCustomWorldMatrix, DynamicBindings::UPDATE_SEMANTIC_ALWAYS);
     }
-    // End new packet
+    else
+    {
+        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_WORLD, &Matrix4::IDENTITY, reinterpret_cast<pointer_size>(&Matrix4::IDENTITY));
+    }
+    Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_PROJ, &projMatrix, static_cast<pointer_size>(projMatrixSemantic));
+    Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_VIEW, &viewMatrix, static_cast<pointer_size>(viewMatrixSemantic));
+    Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_GLOBAL_TIME, &globalTime, reinterpret_cast<pointer_size>(&globalTime));
+
+    if (currentClip.dx > 0.f && currentClip.dy > 0.f)
+    {
+        const Rect& transformedClipRect = TransformClipRect(currentClip, currentVirtualToPhysicalMatrix);
+        packet.scissorRect.x = static_cast<int16>(std::floor(transformedClipRect.x));
+        packet.scissorRect.y = static_cast<int16>(std::floor(transformedClipRect.y));
+        packet.scissorRect.width = static_cast<int16>(std::ceil(transformedClipRect.dx));
+        packet.scissorRect.height = static_cast<int16>(std::ceil(transformedClipRect.dy));
+        packet.options |= rhi::Packet::OPT_OVERRIDE_SCISSOR;
+    }
+    else
+    {
+        packet.options &= ~rhi::Packet::OPT_OVERRIDE_SCISSOR;
+    }
+
+    packet.primitiveType = batchDesc.primitiveType;
+
+    DVASSERT(batchDesc.material);
+    batchDesc.material->BindParams(packet);
+    packet.textureSet = batchDesc.textureSetHandle;
+    packet.samplerState = batchDesc.samplerStateHandle;
+}
 
+void RenderSystem2D::FillBatchBuffers(const BatchDescriptor2D& batchDesc, uint32 texCoordStreamCount, uint8* vertices, uint16* indices, uint32 baseVertex)
+{
     // Begin define draw color
     Color useColor = batchDesc.singleColor;
     if (highlightControlsVerticesLimit > 0 && batchDesc.vertexCount > highlightControlsVerticesLimit && Renderer::GetOptions()->IsOptionEnabled(RenderOptions::HIGHLIGHT_HARD_CONTROLS))
@@ -706,13 +884,10 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
         Vector2 uv_ext[BatchDescriptor2D::MAX_TEXTURE_STREAMS_COUNT - 1];
     };
 
-    uint32 vertexStride = GetVBOStride(currentTexcoordStreamCount);
-    currentVertexBuffer.resize(vertexStride * (vertexIndex + batchDesc.vertexCount));
-    currentIndexBuffer.resize(indexIndex + batchDesc.indexCount);
-
+    uint32 vertexStride = GetVBOStride(texCoordStreamCount);
     for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
     {
-        BatchVertex& v = *OffsetPointer<BatchVertex>(currentVertexBuffer.data(), vertexStride * (vertexIndex + i));
+        BatchVertex& v = *OffsetPointer<BatchVertex>(vertices, vertexStride * i);
         v.pos.x = batchDesc.vertexPointer[i * batchDesc.vertexStride];
         v.pos.y = batchDesc.vertexPointer[i * batchDesc.vertexStride + 1];
         //TODO: rethink do we still require z in rhi?
@@ -727,34 +902,17 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
         for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
         {
             DVASSERT(batchDesc.texCoordPointer[texStream] != nullptr);
-            BatchVertex& v = *OffsetPointer<BatchVertex>(currentVertexBuffer.data(), vertexStride * (vertexIndex + i));
+            BatchVertex& v = *OffsetPointer<BatchVertex>(vertices, vertexStride * i);
             v.uv_ext[texStream - 1].x = batchDesc.texCoordPointer[texStream][i * texStride];
             v.uv_ext[texStream - 1].y = batchDesc.texCoordPointer[texStream][i * texStride + 1];
         }
     }
 
-    uint32 ii = indexIndex;
     for (uint32 i = 0; i < batchDesc.indexCount; ++i)
     {
-        currentIndexBuffer[ii++] = vertexIndex + batchDesc.indexPointer[i];
+        indices[i] = static_cast<uint16>(baseVertex + batchDesc.indexPointer[i]);
     }
     // End fill vertex and index buffers
-
-    switch (currentPacket.primitiveType)
-    {
-    case rhi::PRIMITIVE_LINELIST:
-        currentPacket.primitiveCount += batchDesc.indexCount / 2;
-        break;
-    case rhi::PRIMITIVE_TRIANGLELIST:
-        currentPacket.primitiveCount += batchDesc.indexCount / 3;
-        break;
-    case rhi::PRIMITIVE_TRIANGLESTRIP:
-        currentPacket.primitiveCount += batchDesc.indexCount - 2;
-        break;
-    }
-
-    indexIndex += batchDesc.indexCount;
-    vertexIndex += batchDesc.vertexCount;
 }
 
 void RenderSystem2D::Draw(Sprite* sprite, SpriteDrawState* drawState, const Color& color)
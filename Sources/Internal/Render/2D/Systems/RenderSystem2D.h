@@ -192,6 +192,16 @@ public:
     void EndFrame();
     void Flush();
 
+    /**
+     * Enable reordering of batches until matching `EndBatchReordering` call.
+     * In this mode batch is merged into earlier packet with the same texture, material and clip if it doesn't overlap
+     * batches pushed after that packet, so interleaved draws of few atlases produce few packets.
+     * Batches with custom world matrix and `DrawPacket` calls are not reordered and submit everything collected before them.
+     * Calls can be nested.
+     */
+    void BeginBatchReordering();
+    void EndBatchReordering();
+
     void SetClip(const Rect& rect);
     void IntersectClipRect(const Rect& rect);
     void RemoveClip();
@@ -311,6 +321,27 @@ public:
 
     Vector2 GetAlignedVertex(const Vector2& vertex);
 
+    /** Packet collected in batch reordering mode, it is submitted in order of collection. */
+    struct ReorderedPacket
+    {
+        rhi::Packet packet;
+        NMaterial* material = nullptr;
+        Rect clip;
+        Rect bounds;
+        uint32 texCoordStreamCount = 1;
+        uint32 vertexCount = 0;
+        uint32 indexCount = 0;
+        Vector<uint8> vertexBuffer;
+        Vector<uint16> indexBuffer;
+    };
+
+    /**
+     * Returns index of packet from `packets` with the same state as `batch` which batch can be merged into
+     * without moving it over overlapping packets collected later, or `packetsCount` if batch should start new packet.
+     * Only state, bounds and sizes of `batch` are used.
+     */
+    static uint32 FindReorderedPacket(const ReorderedPacket* packets, uint32 packetsCount, const ReorderedPacket& batch);
+
 private:
     void UpdateVirtualToPhysicalMatrix(bool);
     bool IsPreparedSpriteOnScreen(SpriteDrawState* drawState);
@@ -318,6 +349,13 @@ private:
 
     void AddPacket(rhi::Packet& packet);
 
+    void FlushCurrentPacket();
+    void FlushReorderedPackets();
+    void PushReorderedBatch(const BatchDescriptor2D& batchDesc, uint32 texCoordStreamCount);
+    void SubmitBatchedPacket(rhi::Packet& packet, const Vector<uint8>& vertexBuffer, const Vector<uint16>& indexBuffer, uint32 vertexCount, uint32 indexCount, uint32 texCoordStreamCount);
+    void FillBatchBuffers(const BatchDescriptor2D& batchDesc, uint32 texCoordStreamCount, uint8* vertices, uint16* indices, uint32 baseVertex);
+    void BindBatchPacket(rhi::Packet& packet, const BatchDescriptor2D& batchDesc, bool useCustomWorldMatrix);
+
     Rect TransformClipRect(const Rect& rect, const Matrix4& transformMatrix);
 
     inline bool IsRenderTargetPass()
@@ -372,6 +410,10 @@ private:
     bool lastUsedCustomWorldMatrix = false;
     float32 globalTime = 0.f;
 
+    Vector<ReorderedPacket> reorderedPackets; // items are reused between frames to keep buffers allocated
+    uint32 reorderedPacketsCount = 0;
+    uint32 batchReorderingDepth = 0;
+
     uint32 VBO_STRIDE[BatchDescriptor2D::MAX_TEXTURE_STREAMS_COUNT + 1];
     uint32 vertexLayouts2d[BatchDescriptor2D::MAX_TEXTURE_STREAMS_COUNT + 1];
 
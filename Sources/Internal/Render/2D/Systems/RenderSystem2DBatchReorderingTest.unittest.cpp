@@ -0,0 +1,129 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Render/2D/Systems/RenderSystem2D.h"
+
+using namespace DAVA;
+
+namespace RenderSystem2DBatchReorderingTestDetails
+{
+using ReorderedPacket = RenderSystem2D::ReorderedPacket;
+
+ReorderedPacket MakeBatch(NMaterial* material, const Rect& bounds, uint32 vertexCount = 4)
+{
+    ReorderedPacket batch;
+    batch.packet.primitiveType = rhi::PRIMITIVE_TRIANGLELIST;
+    batch.material = material;
+    batch.clip = Rect(0.f, 0.f, -1.f, -1.f);
+    batch.bounds = bounds;
+    batch.vertexCount = vertexCount;
+    batch.indexCount = vertexCount / 2 * 3;
+    return batch;
+}
+
+// Collects batches into packets in the same way as RenderSystem2D does in batch reordering mode
+Vector<ReorderedPacket> CollectPackets(const Vector<ReorderedPacket>& batches)
+{
+    Vector<ReorderedPacket> packets;
+    for (const ReorderedPacket& batch : batches)
+    {
+        const uint32 packetsCount = static_cast<uint32>(packets.size());
+        const uint32 index = RenderSystem2D::FindReorderedPacket(packets.data(), packetsCount, batch);
+        if (index == packetsCount)
+        {
+            packets.push_back(batch);
+        }
+        else
+        {
+            ReorderedPacket& packet = packets[index];
+            packet.bounds = packet.bounds.Combine(batch.bounds);
+            packet.vertexCount += batch.vertexCount;
+            packet.indexCount += batch.indexCount;
+        }
+    }
+    return packets;
+}
+
+Vector<NMaterial*> GetMaterials(const Vector<ReorderedPacket>& packets)
+{
+    Vector<NMaterial*> materials;
+    for (const ReorderedPacket& packet : packets)
+    {
+        materials.push_back(packet.material);
+    }
+    return materials;
+}
+} // namespace RenderSystem2DBatchReorderingTestDetails
+
+DAVA_TESTCLASS (RenderSystem2DBatchReorderingTest)
+{
+    DAVA_TEST (NonOverlappingBatchesTest)
+    {
+        using namespace RenderSystem2DBatchReorderingTestDetails;
+
+        NMaterial* a = RenderSystem2D::DEFAULT_2D_COLOR_MATERIAL;
+        NMaterial* b = RenderSystem2D::DEFAULT_2D_TEXTURE_MATERIAL;
+
+        // interleaved materials in separate places of screen, like icons with captions in list
+        Vector<ReorderedPacket> batches;
+        for (uint32 i = 0; i < 4; ++i)
+        {
+            const float32 y = i * 100.f;
+            batches.push_back(MakeBatch(a, Rect(0.f, y, 50.f, 50.f)));
+            batches.push_back(MakeBatch(b, Rect(60.f, y, 200.f, 50.f)));
+        }
+
+        Vector<ReorderedPacket> packets = CollectPackets(batches);
+        TEST_VERIFY(packets.size() == 2);
+        TEST_VERIFY(GetMaterials(packets) == Vector<NMaterial*>({ a, b }));
+        TEST_VERIFY(packets[0].vertexCount == 16);
+        TEST_VERIFY(packets[1].vertexCount == 16);
+    }
+
+    DAVA_TEST (OverlappingBatchesTest)
+    {
+        using namespace RenderSystem2DBatchReorderingTestDetails;
+
+        NMaterial* a = RenderSystem2D::DEFAULT_2D_COLOR_MATERIAL;
+        NMaterial* b = RenderSystem2D::DEFAULT_2D_TEXTURE_MATERIAL;
+        NMaterial* c = RenderSystem2D::DEFAULT_2D_TEXTURE_ADDITIVE_MATERIAL;
+
+        // background, text over it and background again over text: draw order must be kept
+        Vector<NMaterial*> materials = GetMaterials(CollectPackets({
+        MakeBatch(a, Rect(0.f, 0.f, 100.f, 100.f)),
+        MakeBatch(b, Rect(10.f, 10.f, 50.f, 20.f)),
+        MakeBatch(a, Rect(20.f, 20.f, 50.f, 50.f)) }));
+        TEST_VERIFY(materials == Vector<NMaterial*>({ a, b, a }));
+
+        // batch is moved over non-overlapping packet, but not over overlapping one before it
+        materials = GetMaterials(CollectPackets({
+        MakeBatch(a, Rect(0.f, 0.f, 100.f, 100.f)),
+        MakeBatch(b, Rect(50.f, 50.f, 100.f, 100.f)),
+        MakeBatch(c, Rect(500.f, 500.f, 10.f, 10.f)),
+        MakeBatch(b, Rect(200.f, 200.f, 10.f, 10.f)),
+        MakeBatch(a, Rect(120.f, 120.f, 10.f, 10.f)) }));
+        TEST_VERIFY(materials == Vector<NMaterial*>({ a, b, c, a }));
+    }
+
+    DAVA_TEST (PacketStateTest)
+    {
+        using namespace RenderSystem2DBatchReorderingTestDetails;
+
+        NMaterial* a = RenderSystem2D::DEFAULT_2D_COLOR_MATERIAL;
+
+        // batches with other clip or vertex format aren't merged
+        ReorderedPacket clipped = MakeBatch(a, Rect(200.f, 0.f, 10.f, 10.f));
+        clipped.clip = Rect(200.f, 0.f, 5.f, 5.f);
+        ReorderedPacket textured = MakeBatch(a, Rect(400.f, 0.f, 10.f, 10.f));
+        textured.texCoordStreamCount = 2;
+        TEST_VERIFY(CollectPackets({ MakeBatch(a, Rect(0.f, 0.f, 10.f, 10.f)), clipped, textured }).size() == 3);
+
+        // full packet isn't merged into
+        Vector<ReorderedPacket> packets = CollectPackets({
+        MakeBatch(a, Rect(0.f, 0.f, 10.f, 10.f), 600),
+        MakeBatch(a, Rect(100.f, 0.f, 10.f, 10.f), 600),
+        MakeBatch(a, Rect(200.f, 0.f, 10.f, 10.f), 4) });
+        TEST_VERIFY(packets.size() == 2);
+        TEST_VERIFY(packets[0].vertexCount == 600);
+        TEST_VERIFY(packets[1].vertexCount == 604);
+    }
+};
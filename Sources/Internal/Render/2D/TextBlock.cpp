@@ -4,6 +4,9 @@
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
 #include "Render/2D/TextBlockSoftwareRender.h"
 #include "Render/2D/TextBlockGraphicRender.h"
+#include "Render/2D/TextBlockGlyphAtlasRender.h"
+#include "Render/2D/FontManager.h"
+#include "Render/2D/Private/TextBlockLayoutCache.h"
 #include "Render/2D/TextLayout.h"
 #include "Concurrency/LockGuard.h"
 #include "Utils/TextBox.h"
@@ -76,7 +79,6 @@ TextBlock::TextBlock()
     : scale(1.f, 1.f)
     , cacheFinalSize(0.f, 0.f)
     , cacheTextSize(0.f, 0.f)
-    , cachedLayoutData({ TextBlockDetail::INVALID_VECTOR, TextBlockDetail::INVALID_WIDTH })
     , renderSize(1.f)
     , fontSize(14.f)
     , cacheDx(0)
@@ -103,6 +105,8 @@ TextBlock::TextBlock()
 
     textBlockRender = NULL;
     needPrepareInternal = false;
+
+    ResetCachedLayoutData();
 }
 
 TextBlock::TextBlock(const TextBlock& src)
@@ -113,6 +117,7 @@ TextBlock::TextBlock(const TextBlock& src)
     , cacheSpriteOffset(src.cacheSpriteOffset)
     , cacheTextSize(src.cacheTextSize)
     , cachedLayoutData(src.cachedLayoutData)
+    , nextCachedLayoutDataIndex(src.nextCachedLayoutDataIndex)
     , renderSize(src.renderSize)
     , fontSize(src.fontSize)
     , cacheDx(src.cacheDx)
@@ -173,7 +178,14 @@ void TextBlock::SetFontInternal(Font* _font)
     switch (font->GetFontType())
     {
     case Font::TYPE_FT:
-        textBlockRender = new TextBlockSoftwareRender(this);
+        if (GetEngineContext()->fontManager->IsGlyphAtlasEnabled())
+        {
+            textBlockRender = new TextBlockGlyphAtlasRender(this);
+        }
+        else
+        {
+            textBlockRender = new TextBlockSoftwareRender(this);
+        }
         break;
     case Font::TYPE_GRAPHIC:
     case Font::TYPE_DISTANCE:
@@ -365,18 +377,22 @@ Vector2 TextBlock::GetPreferredSizeForWidth(float32 width)
     if (!font)
         return Vector2();
 
-    if (!NeedCalculateCacheParams() &&
-        cachedLayoutData.size != INVALID_VECTOR &&
-        cachedLayoutData.width == width)
+    if (!NeedCalculateCacheParams())
     {
-        return cachedLayoutData.size;
+        for (const CachedLayoutData& data : cachedLayoutData)
+        {
+            if (data.size != INVALID_VECTOR && data.width == width)
+            {
+                return data.size;
+            }
+        }
     }
 
+    Vector2 size;
     if (requestedSize.dx < 0.0f && requestedSize.dy < 0.0f && fittingType == 0)
     {
         CalculateCacheParamsIfNeed();
-        cachedLayoutData.size = cacheTextSize;
-        cachedLayoutData.width = width;
+        size = cacheTextSize;
     }
     else
     {
@@ -385,12 +401,15 @@ Vector2 TextBlock::GetPreferredSizeForWidth(float32 width)
         clone->rectSize = Vector2(width < 0.0f ? 99999.0f : width, 99999.0f);
         clone->fittingType = 0;
         clone->CalculateCacheParams();
-
-        cachedLayoutData.size = clone->cacheTextSize;
-        cachedLayoutData.width = width;
+        size = clone->cacheTextSize;
     }
 
-    return cachedLayoutData.size;
+    CachedLayoutData& data = cachedLayoutData[nextCachedLayoutDataIndex];
+    data.size = size;
+    data.width = width;
+    nextCachedLayoutDataIndex = (nextCachedLayoutDataIndex + 1) % CACHED_LAYOUT_DATA_COUNT;
+
+    return size;
 }
 
 Sprite* TextBlock::GetSprite()
@@ -406,8 +425,17 @@ void TextBlock::NeedPrepare(Texture* texture /*=NULL*/)
 {
     needCalculateCacheParams = true;
     needPrepareInternal = true;
-    cachedLayoutData.size = TextBlockDetail::INVALID_VECTOR;
-    cachedLayoutData.width = TextBlockDetail::INVALID_WIDTH;
+    ResetCachedLayoutData();
+}
+
+void TextBlock::ResetCachedLayoutData()
+{
+    for (CachedLayoutData& data : cachedLayoutData)
+    {
+        data.size = TextBlockDetail::INVALID_VECTOR;
+        data.width = TextBlockDetail::INVALID_WIDTH;
+    }
+    nextCachedLayoutDataIndex = 0;
 }
 
 void TextBlock::PrepareInternal()
@@ -423,6 +451,80 @@ void TextBlock::CalculateCacheParams()
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::UI_TEXTBLOCK_RECALC_PARAMS);
 
+    // Measured lines live in text box, which isn't cached
+    if (logicalText.empty() || font == nullptr || needMeasureLines)
+    {
+        CalculateLayout();
+        return;
+    }
+
+    VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+
+    TextBlockLayoutCache::Key key;
+    key.text = logicalText;
+    key.fontHash = font->GetHashCode();
+    key.renderSize = fontSize * scale.y;
+    key.rectSize = rectSize;
+    key.requestedSize = requestedSize;
+    key.physicalScale = Vector2(vcs->ConvertVirtualToPhysicalX(1.f), vcs->ConvertVirtualToPhysicalY(1.f));
+    key.align = align;
+    key.useRtlAlign = useRtlAlign;
+    key.fittingType = fittingType;
+    key.multiline = isMultilineEnabled;
+    key.multilineBySymbol = isMultilineBySymbolEnabled;
+    key.useBiDi = IsBiDiSupportEnabled() || IsForceBiDiSupportEnabled();
+    key.systemRtl = GetEngineContext()->uiControlSystem->IsRtl();
+
+    TextBlockLayoutCache* layoutCache = GetEngineContext()->fontManager->GetTextLayoutCache();
+    TextBlockLayoutCache::Layout layout;
+    if (layoutCache->Find(key, layout))
+    {
+        visualText = std::move(layout.visualText);
+        multilineStrings = std::move(layout.multilineStrings);
+        stringSizes = std::move(layout.stringSizes);
+        cacheFinalSize = layout.finalSize;
+        cacheSpriteOffset = layout.spriteOffset;
+        cacheTextSize = layout.textSize;
+        renderSize = layout.renderSize;
+        cacheDx = layout.dx;
+        cacheDy = layout.dy;
+        cacheW = layout.w;
+        cacheOx = layout.ox;
+        cacheOy = layout.oy;
+        visualAlign = layout.visualAlign;
+        fittingTypeUsed = layout.fittingTypeUsed;
+        visualTextCroped = layout.visualTextCroped;
+        cacheUseJustify = layout.useJustify;
+        treatMultilineAsSingleLine = layout.treatMultilineAsSingleLine;
+        isRtl = layout.isRtl;
+        return;
+    }
+
+    CalculateLayout();
+
+    layout.visualText = visualText;
+    layout.multilineStrings = multilineStrings;
+    layout.stringSizes = stringSizes;
+    layout.finalSize = cacheFinalSize;
+    layout.spriteOffset = cacheSpriteOffset;
+    layout.textSize = cacheTextSize;
+    layout.renderSize = renderSize;
+    layout.dx = cacheDx;
+    layout.dy = cacheDy;
+    layout.w = cacheW;
+    layout.ox = cacheOx;
+    layout.oy = cacheOy;
+    layout.visualAlign = visualAlign;
+    layout.fittingTypeUsed = fittingTypeUsed;
+    layout.visualTextCroped = visualTextCroped;
+    layout.useJustify = cacheUseJustify;
+    layout.treatMultilineAsSingleLine = treatMultilineAsSingleLine;
+    layout.isRtl = isRtl;
+    layoutCache->Add(key, layout);
+}
+
+void TextBlock::CalculateLayout()
+{
     stringSizes.clear();
     multilineStrings.clear();
 
@@ -1026,8 +1128,7 @@ void TextBlock::CalculateCacheParamsIfNeed()
     {
         needCalculateCacheParams = false;
         CalculateCacheParams();
-        cachedLayoutData.size = INVALID_VECTOR;
-        cachedLayoutData.width = INVALID_WIDTH;
+        ResetCachedLayoutData();
     }
 }
 
@@ -1055,6 +1156,14 @@ void TextBlock::Draw(const Color& textColor, const Vector2* offset /* = NULL*/)
     }
 }
 
+void TextBlock::DrawAligned(const UIGeometricData& geometricData, const Color& textColor)
+{
+    if (textBlockRender)
+    {
+        textBlockRender->DrawAligned(geometricData, textColor);
+    }
+}
+
 TextBlock* TextBlock::Clone()
 {
     TextBlock* block = new TextBlock();
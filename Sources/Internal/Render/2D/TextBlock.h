@@ -3,6 +3,7 @@
 #include "Base/BaseMath.h"
 #include "Base/BaseObject.h"
 #include "Base/BaseTypes.h"
+#include "Base/Array.h"
 #include "Render/2D/Font.h"
 #include "Render/2D/Sprite.h"
 #include "Render/RenderBase.h"
@@ -13,7 +14,9 @@ namespace DAVA
 class TextBlockRender;
 class TextBlockSoftwareRender;
 class TextBlockGraphicRender;
+class TextBlockGlyphAtlasRender;
 class TextBox;
+class UIGeometricData;
 
 /**
     \ingroup render_2d
@@ -98,6 +101,7 @@ public:
 
     void PreDraw();
     void Draw(const Color& textColor, const Vector2* offset = NULL);
+    void DrawAligned(const UIGeometricData& geometricData, const Color& textColor);
 
     TextBlock* Clone();
     void CopyDataFrom(TextBlock* block);
@@ -133,6 +137,12 @@ public:
         return needCalculateCacheParams;
     }
 
+    /**
+        Recalculate text layout if it was invalidated.
+        Different text blocks may be processed from different threads at the same time.
+    */
+    void CalculateCacheParamsIfNeed();
+
 private:
     static void RegisterTextBlock(TextBlock* textBlock);
     static void UnregisterTextBlock(TextBlock* textBlock);
@@ -146,7 +156,8 @@ private:
     void PrepareInternal();
 
     void CalculateCacheParams();
-    void CalculateCacheParamsIfNeed();
+    void CalculateLayout();
+    void ResetCachedLayoutData();
 
     void SetFontInternal(Font* _font);
 
@@ -158,11 +169,15 @@ private:
     Vector2 cacheFinalSize;
     Vector2 cacheSpriteOffset;
     Vector2 cacheTextSize;
-    struct
+    // Layout measures text for several widths (e.g. unconstrained and actual), so few last results are kept
+    static const uint32 CACHED_LAYOUT_DATA_COUNT = 4;
+    struct CachedLayoutData
     {
         Vector2 size;
         float32 width;
-    } cachedLayoutData;
+    };
+    Array<CachedLayoutData, CACHED_LAYOUT_DATA_COUNT> cachedLayoutData;
+    uint32 nextCachedLayoutDataIndex = 0;
 
     float32 renderSize;
     float32 fontSize;
@@ -204,6 +219,7 @@ private:
     friend class TextBlockRender;
     friend class TextBlockSoftwareRender;
     friend class TextBlockGraphicRender;
+    friend class TextBlockGlyphAtlasRender;
 
     TextBlockRender* textBlockRender = nullptr;
     TextBox* textBox = nullptr;
@@ -0,0 +1,228 @@
+#include "Render/2D/TextBlockGlyphAtlasRender.h"
+#include "Engine/Engine.h"
+#include "Render/2D/FontManager.h"
+#include "Render/2D/Private/FTGlyphAtlas.h"
+#include "Render/2D/Systems/RenderSystem2D.h"
+#include "Render/2D/Systems/VirtualCoordinatesSystem.h"
+#include "Render/2D/TextBlockGraphicRender.h"
+#include "UI/UIControlSystem.h"
+#include "UI/UIGeometricData.h"
+
+namespace DAVA
+{
+namespace TextBlockGlyphAtlasRenderDetails
+{
+const uint32 MAX_QUADS_PER_BATCH = 256;
+}
+
+TextBlockGlyphAtlasRender::TextBlockGlyphAtlasRender(TextBlock* textBlock)
+    : TextBlockRender(textBlock)
+    , ftFont(static_cast<FTFont*>(textBlock->font))
+{
+}
+
+TextBlockRender* TextBlockGlyphAtlasRender::Clone()
+{
+    TextBlockGlyphAtlasRender* result = new TextBlockGlyphAtlasRender(textBlock);
+    result->quads = quads;
+    result->usedShelves = usedShelves;
+    result->atlasGeneration = atlasGeneration;
+    result->hasMissingGlyphs = hasMissingGlyphs;
+    return result;
+}
+
+void TextBlockGlyphAtlasRender::Prepare()
+{
+    TextBlockRender::Prepare();
+
+    placements.clear();
+    quads.clear();
+    usedShelves.clear();
+    hasMissingGlyphs = false;
+
+    if (textBlock->visualText.empty())
+    {
+        return;
+    }
+
+    DrawText();
+
+    VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    FTGlyphAtlas* atlas = GetEngineContext()->fontManager->GetGlyphAtlas();
+    for (const FTFont::GlyphPlacement& placement : placements)
+    {
+        const FTGlyphAtlas::Glyph* glyph = atlas->GetGlyph(ftFont, textBlock->renderSize, placement.glyphIndex);
+        if (glyph == nullptr)
+        {
+            hasMissingGlyphs = true;
+            continue;
+        }
+        if (glyph->width == 0 || glyph->height == 0)
+        {
+            continue;
+        }
+
+        // Glyphs of this text must survive while the rest are added
+        atlas->TouchShelf(glyph->shelfIndex);
+        if (std::find(usedShelves.begin(), usedShelves.end(), glyph->shelfIndex) == usedShelves.end())
+        {
+            usedShelves.push_back(glyph->shelfIndex);
+        }
+
+        GlyphQuad quad;
+        quad.position.x = vcs->ConvertPhysicalToVirtualX(float32(placement.x + glyph->left));
+        quad.position.y = vcs->ConvertPhysicalToVirtualY(float32(placement.y - glyph->top));
+        quad.size.x = vcs->ConvertPhysicalToVirtualX(float32(glyph->width));
+        quad.size.y = vcs->ConvertPhysicalToVirtualY(float32(glyph->height));
+        quad.uvMin = glyph->uvMin;
+        quad.uvMax = glyph->uvMax;
+        quads.push_back(quad);
+    }
+    placements.clear();
+
+    atlasGeneration = atlas->GetGeneration();
+}
+
+void TextBlockGlyphAtlasRender::DrawAligned(const UIGeometricData& geometricData, const Color& textColor)
+{
+    using namespace TextBlockGlyphAtlasRenderDetails;
+
+    FTGlyphAtlas* atlas = GetEngineContext()->fontManager->GetGlyphAtlas();
+    if (atlasGeneration != atlas->GetGeneration())
+    {
+        if (hasMissingGlyphs || !atlas->AreShelvesValid(atlasGeneration, usedShelves))
+        {
+            // Glyphs of this text were evicted since last prepare, or glyphs which didn't fit may fit now
+            Prepare();
+        }
+        else
+        {
+            atlasGeneration = atlas->GetGeneration();
+        }
+    }
+
+    if (quads.empty())
+    {
+        return;
+    }
+
+    for (uint32 shelfIndex : usedShelves)
+    {
+        atlas->TouchShelf(shelfIndex);
+    }
+
+    // Same placement as UIControlBackground::DRAW_ALIGNED uses for text sprite of `cacheFinalSize` size
+    const Vector2& spriteSize = textBlock->cacheFinalSize;
+    const Rect& drawRect = geometricData.GetUnrotatedRect();
+    int32 align = textBlock->GetVisualAlign();
+
+    Vector2 position;
+    if (align & ALIGN_LEFT)
+    {
+        position.x = drawRect.x;
+    }
+    else if (align & ALIGN_RIGHT)
+    {
+        position.x = drawRect.x + drawRect.dx - spriteSize.x * geometricData.scale.x;
+    }
+    else
+    {
+        position.x = drawRect.x + ((drawRect.dx - spriteSize.x * geometricData.scale.x) * 0.5f);
+    }
+    if (align & ALIGN_TOP)
+    {
+        position.y = drawRect.y;
+    }
+    else if (align & ALIGN_BOTTOM)
+    {
+        position.y = drawRect.y + drawRect.dy - spriteSize.y * geometricData.scale.y;
+    }
+    else
+    {
+        position.y = drawRect.y + ((drawRect.dy - spriteSize.y * geometricData.scale.y) * 0.5f);
+    }
+
+    float32 sinA = 0.f;
+    float32 cosA = 1.f;
+    if (geometricData.angle != 0)
+    {
+        float32 tmpX = position.x;
+        position.x = (tmpX - geometricData.position.x) * geometricData.cosA + (geometricData.position.y - position.y) * geometricData.sinA + geometricData.position.x;
+        position.y = (tmpX - geometricData.position.x) * geometricData.sinA + (position.y - geometricData.position.y) * geometricData.cosA + geometricData.position.y;
+        sinA = std::sin(geometricData.angle);
+        cosA = std::cos(geometricData.angle);
+    }
+
+    uint32 quadsCount = static_cast<uint32>(quads.size());
+    vertices.resize(quadsCount * 8);
+    texCoords.resize(quadsCount * 8);
+    for (uint32 i = 0; i < quadsCount; ++i)
+    {
+        const GlyphQuad& quad = quads[i];
+        Vector2 topLeft = quad.position * geometricData.scale;
+        Vector2 bottomRight = (quad.position + quad.size) * geometricData.scale;
+        const Vector2 corners[4] = { topLeft, Vector2(bottomRight.x, topLeft.y), bottomRight, Vector2(topLeft.x, bottomRight.y) };
+        const Vector2 uvs[4] = { quad.uvMin, Vector2(quad.uvMax.x, quad.uvMin.y), quad.uvMax, Vector2(quad.uvMin.x, quad.uvMax.y) };
+
+        float32* vertex = vertices.data() + i * 8;
+        float32* texCoord = texCoords.data() + i * 8;
+        for (uint32 k = 0; k < 4; ++k)
+        {
+            vertex[k * 2] = corners[k].x * cosA - corners[k].y * sinA + position.x;
+            vertex[k * 2 + 1] = corners[k].x * sinA + corners[k].y * cosA + position.y;
+            texCoord[k * 2] = uvs[k].x;
+            texCoord[k * 2 + 1] = uvs[k].y;
+        }
+    }
+
+    Texture* texture = atlas->GetTexture();
+
+    // No world matrix, so batches of different text blocks are merged by RenderSystem2D
+    BatchDescriptor2D batch;
+    batch.material = RenderSystem2D::DEFAULT_2D_TEXTURE_ALPHA8_MATERIAL;
+    batch.singleColor = textColor;
+    batch.textureSetHandle = texture->singleTextureSet;
+    batch.samplerStateHandle = texture->samplerStateHandle;
+    batch.vertexStride = 2;
+    batch.texCoordStride = 2;
+    batch.indexPointer = TextBlockGraphicRender::GetSharedIndexBuffer();
+
+    uint32 maxQuadsPerBatch = Min(MAX_QUADS_PER_BATCH, TextBlockGraphicRender::GetSharedIndexBufferCapacity() / 6);
+    for (uint32 first = 0; first < quadsCount; first += maxQuadsPerBatch)
+    {
+        uint32 count = Min(maxQuadsPerBatch, quadsCount - first);
+        batch.vertexPointer = vertices.data() + first * 8;
+        batch.texCoordPointer[0] = texCoords.data() + first * 8;
+        batch.vertexCount = count * 4;
+        batch.indexCount = count * 6;
+        RenderSystem2D::Instance()->PushBatch(batch);
+    }
+}
+
+Font::StringMetrics TextBlockGlyphAtlasRender::DrawTextSL(const WideString& drawText, int32 x, int32 y, int32 w)
+{
+    return ftFont->DrawStringToGlyphs(textBlock->renderSize, placements,
+                                      -textBlock->cacheOx,
+                                      -textBlock->cacheOy,
+                                      0,
+                                      0,
+                                      drawText,
+                                      true);
+}
+
+Font::StringMetrics TextBlockGlyphAtlasRender::DrawTextML(const WideString& drawText, int32 x, int32 y, int32 w, int32 xOffset, uint32 yOffset, int32 lineSize)
+{
+    VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    int32 offsetX = -textBlock->cacheOx + int32(vcs->ConvertVirtualToPhysicalX(float32(xOffset)));
+    int32 offsetY = -textBlock->cacheOy + int32(vcs->ConvertVirtualToPhysicalY(float32(yOffset)));
+    if (textBlock->cacheUseJustify)
+    {
+        return ftFont->DrawStringToGlyphs(textBlock->renderSize, placements, offsetX, offsetY,
+                                          int32(std::ceil(vcs->ConvertVirtualToPhysicalX(float32(w)))),
+                                          int32(std::ceil(vcs->ConvertVirtualToPhysicalY(float32(lineSize)))),
+                                          drawText,
+                                          true);
+    }
+    return ftFont->DrawStringToGlyphs(textBlock->renderSize, placements, offsetX, offsetY, 0, 0, drawText, true);
+}
+};
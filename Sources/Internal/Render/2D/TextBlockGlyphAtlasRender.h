@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Render/2D/TextBlockRender.h"
+#include "Render/2D/FTFont.h"
+
+namespace DAVA
+{
+/**
+    Render of FreeType text with quads from shared FTGlyphAtlas.
+    Text change doesn't create texture, only glyphs missing in atlas are rasterized, and text of all controls
+    is drawn with the same texture and material, so RenderSystem2D merges it into few packets.
+*/
+class TextBlockGlyphAtlasRender : public TextBlockRender
+{
+public:
+    TextBlockGlyphAtlasRender(TextBlock*);
+
+    void Prepare() override;
+    TextBlockRender* Clone() override;
+    void DrawAligned(const UIGeometricData& geometricData, const Color& textColor) override;
+
+private:
+    Font::StringMetrics DrawTextSL(const WideString& drawText, int32 x, int32 y, int32 w) override;
+    Font::StringMetrics DrawTextML(const WideString& drawText, int32 x, int32 y, int32 w,
+                                   int32 xOffset, uint32 yOffset, int32 lineSize) override;
+
+    struct GlyphQuad
+    {
+        Vector2 position; // in virtual coordinates relative to text sprite rect
+        Vector2 size;
+        Vector2 uvMin;
+        Vector2 uvMax;
+    };
+
+    FTFont* ftFont = nullptr;
+    Vector<FTFont::GlyphPlacement> placements;
+    Vector<GlyphQuad> quads;
+    Vector<uint32> usedShelves;
+    uint32 atlasGeneration = 0;
+    bool hasMissingGlyphs = false;
+
+    Vector<float32> vertices;
+    Vector<float32> texCoords;
+};
+};
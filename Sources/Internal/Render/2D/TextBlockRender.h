@@ -8,6 +8,8 @@
 
 namespace DAVA
 {
+class UIGeometricData;
+
 class TextBlockRender : public BaseObject
 {
 public:
@@ -16,6 +18,8 @@ public:
 
     virtual void PreDraw(){};
     virtual void Draw(const Color& /*textColor*/, const Vector2* /*offset*/){};
+    /** Draw text that is not represented by sprite, placed same way as aligned sprite in `geometricData`. */
+    virtual void DrawAligned(const UIGeometricData& /*geometricData*/, const Color& /*textColor*/){};
 
     virtual void Prepare() = 0;
     virtual TextBlockRender* Clone() = 0;
@@ -1,12 +1,64 @@
 #include "Render/Image/ImageConvert.h"
 #include "Render/Image/ImageConverter.h"
 #include "Render/Image/Image.h"
+#include "Render/Image/Private/ImageConvertSimd.h"
 #include "Engine/Engine.h"
 #include "Functional/Function.h"
+#include "Job/JobManager.h"
 #include "Math/HalfFloat.h"
 
 namespace DAVA
 {
+namespace ImageConvertDetails
+{
+// Images smaller than this are converted in calling thread, bigger ones are split into chunks of rows for worker jobs
+const uint32 PARALLEL_MIN_PIXELS = 512 * 512;
+const uint32 CHUNK_PIXELS = 64 * 1024;
+
+using RowFunction = void (*)(const uint8* in, uint8* out, uint32 width);
+using DownscaleRowFunction = void (*)(const uint8* in0, const uint8* in1, uint8* out, uint32 outWidth);
+
+void ForEachRows(uint32 pixelsInRow, uint32 rowsCount, const Function<void(uint32, uint32)>& processRows)
+{
+    JobManager* jobManager = (uint64(pixelsInRow) * rowsCount >= PARALLEL_MIN_PIXELS) ? GetEngineContext()->jobManager : nullptr;
+    if (jobManager == nullptr)
+    {
+        processRows(0, rowsCount);
+        return;
+    }
+
+    jobManager->ParallelFor(rowsCount, Max(1u, CHUNK_PIXELS / pixelsInRow), processRows);
+}
+
+void ConvertRows(RowFunction rowFunction, const void* inData, uint32 width, uint32 height, uint32 inPitch, void* outData, uint32 outPitch)
+{
+    const uint8* readPtr = reinterpret_cast<const uint8*>(inData);
+    uint8* writePtr = reinterpret_cast<uint8*>(outData);
+
+    ForEachRows(width, height, [=](uint32 begin, uint32 end) {
+        for (uint32 y = begin; y < end; ++y)
+        {
+            rowFunction(readPtr + size_t(y) * inPitch, writePtr + size_t(y) * outPitch, width);
+        }
+    });
+}
+
+void DownscaleRows(DownscaleRowFunction rowFunction, const void* inData, uint32 inPitch, void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+{
+    const uint8* readPtr = reinterpret_cast<const uint8*>(inData);
+    uint8* writePtr = reinterpret_cast<uint8*>(outData);
+
+    // each output pixel is read from 2x2 input pixels
+    ForEachRows(outWidth * 4, outHeight, [=](uint32 begin, uint32 end) {
+        for (uint32 y = begin; y < end; ++y)
+        {
+            const uint8* readLine = readPtr + size_t(y) * 2 * inPitch;
+            rowFunction(readLine, readLine + inPitch, writePtr + size_t(y) * outPitch, outWidth);
+        }
+    });
+}
+}
+
 uint32 ChannelFloatToInt(float32 ch)
 {
     float32 clamped = Clamp(ch, 0.0f, 1.0f);
@@ -127,8 +179,7 @@ bool ConvertImageDirect(PixelFormat inFormat, PixelFormat outFormat,
     }
     else if (inFormat == FORMAT_RGB888 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<RGB888, uint32, ConvertRGB888toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows(&ImageConvertSimd::ConvertRGB888toRGBA8888, inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGB565 && outFormat == FORMAT_RGBA8888)
@@ -151,26 +202,22 @@ bool ConvertImageDirect(PixelFormat inFormat, PixelFormat outFormat,
     }
     else if (inFormat == FORMAT_BGR888 && outFormat == FORMAT_RGB888)
     {
-        ConvertDirect<BGR888, RGB888, ConvertBGR888toRGB888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows(&ImageConvertSimd::SwapRedBlueRGB888, inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_BGR888 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<BGR888, uint32, ConvertBGR888toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows(&ImageConvertSimd::ConvertBGR888toRGBA8888, inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_BGRA8888 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows(&ImageConvertSimd::SwapRedBlueRGBA8888, inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_RGB888)
     {
-        ConvertDirect<uint32, RGB888, ConvertRGBA8888toRGB888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows(&ImageConvertSimd::ConvertRGBA8888toRGB888, inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA16161616 && outFormat == FORMAT_RGBA8888)
@@ -272,14 +319,12 @@ void SwapRedBlueChannels(PixelFormat format, void* srcData, uint32 width, uint32
     {
     case FORMAT_RGB888:
     {
-        ConvertDirect<BGR888, RGB888, ConvertBGR888toRGB888> swap;
-        swap(srcData, width, height, pitch, dstData);
+        ImageConvertDetails::ConvertRows(&ImageConvertSimd::SwapRedBlueRGB888, srcData, width, height, pitch, dstData, pitch);
         return;
     }
     case FORMAT_RGBA8888:
     {
-        ConvertDirect<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888> swap;
-        swap(srcData, width, height, pitch, dstData);
+        ImageConvertDetails::ConvertRows(&ImageConvertSimd::SwapRedBlueRGBA8888, srcData, width, height, pitch, dstData, pitch);
         return;
     }
     case FORMAT_RGBA4444:
@@ -324,7 +369,18 @@ bool DownscaleTwiceBillinear(PixelFormat inFormat, PixelFormat outFormat,
                              const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
                              void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch, bool normalize)
 {
-    if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA8888))
+    // Row kernels average full 2x2 blocks, 1-pixel wide or high images are left for generic implementation
+    const bool fullBlocks = (inWidth >= outWidth * 2) && (inHeight >= outHeight * 2);
+
+    if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA8888) && !normalize && fullBlocks)
+    {
+        ImageConvertDetails::DownscaleRows(&ImageConvertSimd::DownscaleTwiceRGBA8888, inData, inPitch, outData, outWidth, outHeight, outPitch);
+    }
+    else if ((inFormat == FORMAT_A8) && (outFormat == FORMAT_A8) && fullBlocks)
+    {
+        ImageConvertDetails::DownscaleRows(&ImageConvertSimd::DownscaleTwiceA8, inData, inPitch, outData, outWidth, outHeight, outPitch);
+    }
+    else if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA8888))
     {
         if (normalize)
         {
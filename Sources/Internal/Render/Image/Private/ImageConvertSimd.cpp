@@ -0,0 +1,264 @@
+#include "Render/Image/Private/ImageConvertSimd.h"
+#include "Render/Image/ImageConvert.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_CONVERT_SSE2
+#include <emmintrin.h>
+#if defined(__SSSE3__) || defined(__AVX__)
+#define IMAGE_CONVERT_SSSE3
+#include <tmmintrin.h>
+#endif
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON) || defined(_M_ARM64)
+#define IMAGE_CONVERT_NEON
+#include <arm_neon.h>
+#endif
+
+namespace DAVA
+{
+namespace ImageConvertSimd
+{
+namespace ImageConvertSimdDetails
+{
+template <class TYPE_IN, class TYPE_OUT, typename CONVERT_FUNC>
+void ConvertTail(const uint8* in, uint8* out, uint32 x, uint32 width)
+{
+    CONVERT_FUNC func;
+    const TYPE_IN* readPtr = reinterpret_cast<const TYPE_IN*>(in) + x;
+    TYPE_OUT* writePtr = reinterpret_cast<TYPE_OUT*>(out) + x;
+    for (; x < width; ++x)
+    {
+        func(readPtr++, writePtr++);
+    }
+}
+
+template <class TYPE, typename UNPACK_FUNC, typename PACK_FUNC>
+void DownscaleTail(const uint8* in0, const uint8* in1, uint8* out, uint32 x, uint32 outWidth)
+{
+    UNPACK_FUNC unpackFunc;
+    PACK_FUNC packFunc;
+    const TYPE* readPtr0 = reinterpret_cast<const TYPE*>(in0) + x * 2;
+    const TYPE* readPtr1 = reinterpret_cast<const TYPE*>(in1) + x * 2;
+    TYPE* writePtr = reinterpret_cast<TYPE*>(out) + x;
+    for (; x < outWidth; ++x)
+    {
+        uint32 r00, r01, r10, r11;
+        uint32 g00, g01, g10, g11;
+        uint32 b00, b01, b10, b11;
+        uint32 a00, a01, a10, a11;
+
+        unpackFunc(readPtr0, r00, g00, b00, a00);
+        unpackFunc(readPtr0 + 1, r01, g01, b01, a01);
+        unpackFunc(readPtr1, r10, g10, b10, a10);
+        unpackFunc(readPtr1 + 1, r11, g11, b11, a11);
+
+        packFunc((r00 + r01 + r10 + r11) / 4, (g00 + g01 + g10 + g11) / 4, (b00 + b01 + b10 + b11) / 4, (a00 + a01 + a10 + a11) / 4, writePtr);
+
+        readPtr0 += 2;
+        readPtr1 += 2;
+        writePtr++;
+    }
+}
+}
+
+void SwapRedBlueRGBA8888(const uint8* in, uint8* out, uint32 width)
+{
+    using namespace ImageConvertSimdDetails;
+
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_SSE2)
+    const __m128i maskGA = _mm_set1_epi32(0xFF00FF00);
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x * 4));
+        __m128i rb = _mm_andnot_si128(maskGA, pixels);
+        __m128i swapped = _mm_or_si128(_mm_srli_epi32(rb, 16), _mm_slli_epi32(rb, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), _mm_or_si128(_mm_and_si128(pixels, maskGA), swapped));
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16x4_t pixels = vld4q_u8(in + x * 4);
+        uint8x16_t r = pixels.val[0];
+        pixels.val[0] = pixels.val[2];
+        pixels.val[2] = r;
+        vst4q_u8(out + x * 4, pixels);
+    }
+#endif
+    ConvertTail<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888>(in, out, x, width);
+}
+
+void SwapRedBlueRGB888(const uint8* in, uint8* out, uint32 width)
+{
+    using namespace ImageConvertSimdDetails;
+
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_SSSE3)
+    // 5 pixels per 16 bytes, 16th byte is written back unchanged
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+    for (; x + 6 <= width; x += 5)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 3), _mm_shuffle_epi8(pixels, shuffle));
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16x3_t pixels = vld3q_u8(in + x * 3);
+        uint8x16_t r = pixels.val[0];
+        pixels.val[0] = pixels.val[2];
+        pixels.val[2] = r;
+        vst3q_u8(out + x * 3, pixels);
+    }
+#endif
+    ConvertTail<BGR888, RGB888, ConvertBGR888toRGB888>(in, out, x, width);
+}
+
+void ConvertRGB888toRGBA8888(const uint8* in, uint8* out, uint32 width)
+{
+    using namespace ImageConvertSimdDetails;
+
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32(0xFF000000);
+    for (; x + 6 <= width; x += 4)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), alpha));
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16x3_t pixels = vld3q_u8(in + x * 3);
+        uint8x16x4_t outPixels = { { pixels.val[0], pixels.val[1], pixels.val[2], vdupq_n_u8(0xFF) } };
+        vst4q_u8(out + x * 4, outPixels);
+    }
+#endif
+    ConvertTail<RGB888, uint32, DAVA::ConvertRGB888toRGBA8888>(in, out, x, width);
+}
+
+void ConvertBGR888toRGBA8888(const uint8* in, uint8* out, uint32 width)
+{
+    using namespace ImageConvertSimdDetails;
+
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m128i alpha = _mm_set1_epi32(0xFF000000);
+    for (; x + 6 <= width; x += 4)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), alpha));
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16x3_t pixels = vld3q_u8(in + x * 3);
+        uint8x16x4_t outPixels = { { pixels.val[2], pixels.val[1], pixels.val[0], vdupq_n_u8(0xFF) } };
+        vst4q_u8(out + x * 4, outPixels);
+    }
+#endif
+    ConvertTail<BGR888, uint32, DAVA::ConvertBGR888toRGBA8888>(in, out, x, width);
+}
+
+void ConvertRGBA8888toRGB888(const uint8* in, uint8* out, uint32 width)
+{
+    using namespace ImageConvertSimdDetails;
+
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x * 4)), shuffle);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + x * 3), pixels);
+        uint32 last = static_cast<uint32>(_mm_cvtsi128_si32(_mm_srli_si128(pixels, 8)));
+        Memcpy(out + x * 3 + 8, &last, sizeof(last));
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16x4_t pixels = vld4q_u8(in + x * 4);
+        uint8x16x3_t outPixels = { { pixels.val[0], pixels.val[1], pixels.val[2] } };
+        vst3q_u8(out + x * 3, outPixels);
+    }
+#endif
+    ConvertTail<uint32, RGB888, DAVA::ConvertRGBA8888toRGB888>(in, out, x, width);
+}
+
+void DownscaleTwiceRGBA8888(const uint8* in0, const uint8* in1, uint8* out, uint32 outWidth)
+{
+    using namespace ImageConvertSimdDetails;
+
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_SSE2)
+    // channels of 2x2 block are summed in 16-bit lanes, so result is the same as (p00 + p01 + p10 + p11) / 4
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 4 <= outWidth; x += 4)
+    {
+        __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0 + x * 8));
+        __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0 + x * 8 + 16));
+        __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1 + x * 8));
+        __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1 + x * 8 + 16));
+
+        __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+        __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+        __m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+        __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+        __m128i h01 = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+        __m128i h23 = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+
+        __m128i result = _mm_packus_epi16(_mm_srli_epi16(h01, 2), _mm_srli_epi16(h23, 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), result);
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + 8 <= outWidth; x += 8)
+    {
+        uint8x16x4_t a = vld4q_u8(in0 + x * 8);
+        uint8x16x4_t b = vld4q_u8(in1 + x * 8);
+        uint8x8x4_t result;
+        for (uint32 c = 0; c < 4; ++c)
+        {
+            uint16x8_t sum = vpadalq_u8(vpaddlq_u8(a.val[c]), b.val[c]);
+            result.val[c] = vshrn_n_u16(sum, 2);
+        }
+        vst4_u8(out + x * 4, result);
+    }
+#endif
+    DownscaleTail<uint32, UnpackRGBA8888, PackRGBA8888>(in0, in1, out, x, outWidth);
+}
+
+void DownscaleTwiceA8(const uint8* in0, const uint8* in1, uint8* out, uint32 outWidth)
+{
+    using namespace ImageConvertSimdDetails;
+
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_SSE2)
+    const __m128i maskLow = _mm_set1_epi16(0x00FF);
+    for (; x + 16 <= outWidth; x += 16)
+    {
+        __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0 + x * 2));
+        __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0 + x * 2 + 16));
+        __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1 + x * 2));
+        __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1 + x * 2 + 16));
+
+        __m128i sum0 = _mm_add_epi16(_mm_add_epi16(_mm_and_si128(a0, maskLow), _mm_srli_epi16(a0, 8)),
+                                     _mm_add_epi16(_mm_and_si128(b0, maskLow), _mm_srli_epi16(b0, 8)));
+        __m128i sum1 = _mm_add_epi16(_mm_add_epi16(_mm_and_si128(a1, maskLow), _mm_srli_epi16(a1, 8)),
+                                     _mm_add_epi16(_mm_and_si128(b1, maskLow), _mm_srli_epi16(b1, 8)));
+
+        __m128i result = _mm_packus_epi16(_mm_srli_epi16(sum0, 2), _mm_srli_epi16(sum1, 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), result);
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + 8 <= outWidth; x += 8)
+    {
+        uint16x8_t sum = vpadalq_u8(vpaddlq_u8(vld1q_u8(in0 + x * 2)), vld1q_u8(in1 + x * 2));
+        vst1_u8(out + x, vshrn_n_u16(sum, 2));
+    }
+#endif
+    DownscaleTail<uint8, UnpackA8, PackA8>(in0, in1, out, x, outWidth);
+}
+}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+/**
+    Row kernels for the most used 8-bit conversions and 2x2 box downscales.
+    Kernels use SSE2/SSSE3 or NEON if target is compiled with them, otherwise (and for row tails) scalar functors
+    from ImageConvert.h are used, so results are bit-exact with them.
+    For conversions with equal pixel size `in` and `out` may point to the same row.
+*/
+namespace ImageConvertSimd
+{
+void SwapRedBlueRGBA8888(const uint8* in, uint8* out, uint32 width);
+void SwapRedBlueRGB888(const uint8* in, uint8* out, uint32 width);
+void ConvertRGB888toRGBA8888(const uint8* in, uint8* out, uint32 width);
+void ConvertBGR888toRGBA8888(const uint8* in, uint8* out, uint32 width);
+void ConvertRGBA8888toRGB888(const uint8* in, uint8* out, uint32 width);
+
+/** Average 2x2 pixel blocks of rows `in0` and `in1` into `outWidth` pixels of `out` */
+void DownscaleTwiceRGBA8888(const uint8* in0, const uint8* in1, uint8* out, uint32 outWidth);
+void DownscaleTwiceA8(const uint8* in0, const uint8* in1, uint8* out, uint32 outWidth);
+}
+}
@@ -453,6 +453,11 @@ void Update(Handle tex, const void* data, uint32 level, TextureFace face)
     return (*_Impl.impl_Texture_Update)(tex, data, level, face);
 }
 
+void UpdateRegion(Handle tex, const void* data, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height)
+{
+    return (*_Impl.impl_Texture_UpdateRegion)(tex, data, level, x, y, width, height);
+}
+
 bool NeedRestore(Handle tex)
 {
     return (*_Impl.impl_Texture_NeedRestore)(tex);
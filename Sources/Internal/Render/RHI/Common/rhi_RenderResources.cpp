@@ -582,6 +582,13 @@ void UpdateTexture(HTexture tex, const void* data, uint32 level, TextureFace fac
 
 //------------------------------------------------------------------------------
 
+void UpdateTextureRegion(HTexture tex, const void* data, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height)
+{
+    Texture::UpdateRegion(tex, data, level, x, y, width, height);
+}
+
+//------------------------------------------------------------------------------
+
 bool NeedRestoreTexture(HTexture tex)
 {
     return Texture::NeedRestore(tex);
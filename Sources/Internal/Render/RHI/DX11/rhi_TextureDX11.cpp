@@ -430,6 +430,34 @@ void dx11_Texture_Update(Handle tex, const void* data, uint32 level, TextureFace
     dx11_Texture_Unmap(tex);
 }
 
+void dx11_Texture_UpdateRegion(Handle tex, const void* data, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height)
+{
+    TextureDX11_t* self = TextureDX11Pool::Get(tex);
+    TextureFormat fmt = self->descriptor.format;
+    uint32 sz = TextureSize(fmt, width, height);
+
+    DVASSERT(!self->isMapped);
+    DVASSERT(self->arraySize == 1);
+
+    DAVA::Vector<uint8> swapped;
+    if (fmt == TEXTURE_FORMAT_R8G8B8A8 || fmt == TEXTURE_FORMAT_R4G4B4A4 || fmt == TEXTURE_FORMAT_R5G5B5A1)
+    {
+        swapped.resize(sz);
+        void* src = const_cast<void*>(data);
+        if (fmt == TEXTURE_FORMAT_R8G8B8A8)
+            _SwapRB8(src, swapped.data(), sz);
+        else if (fmt == TEXTURE_FORMAT_R4G4B4A4)
+            _SwapRB4(src, swapped.data(), sz);
+        else
+            _SwapRB5551(src, swapped.data(), sz);
+        data = swapped.data();
+    }
+
+    D3D11_BOX box = { x, y, 0, x + width, y + height, 1 };
+    DX11Command cmd(DX11Command::UPDATE_SUBRESOURCE, self->tex2d, level, &box, data, TextureStride(fmt, Size2i(width, height), 0), 0);
+    ExecDX11(&cmd, 1);
+}
+
 bool dx11_Texture_NeedRestore(Handle tex)
 {
     return false;
@@ -449,6 +477,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = &dx11_Texture_Map;
     dispatch->impl_Texture_Unmap = &dx11_Texture_Unmap;
     dispatch->impl_Texture_Update = &dx11_Texture_Update;
+    dispatch->impl_Texture_UpdateRegion = &dx11_Texture_UpdateRegion;
     dispatch->impl_Texture_NeedRestore = &dx11_Texture_NeedRestore;
 }
 
@@ -1433,6 +1433,53 @@ static void _DX9_ExecImmediateCommand(CommonImpl::ImmediateCommand* command)
         }
         break;
 
+        case DX9Command::UPDATE_TEXTURE_REGION:
+        {
+            IDirect3DTexture9* tex = *((IDirect3DTexture9**)(arg[0]));
+
+            if (tex)
+            {
+                UINT lev = UINT(arg[1]);
+                uint8* src = (uint8*)(arg[2]);
+                RECT rect = { LONG(arg[3]), LONG(arg[4]), LONG(arg[3] + arg[5]), LONG(arg[4] + arg[6]) };
+                rhi::TextureFormat format = static_cast<rhi::TextureFormat>(arg[7]);
+                unsigned rowSize = unsigned(arg[8]);
+                D3DLOCKED_RECT rc = {};
+                HRESULT hr = tex->LockRect(lev, &rc, &rect, 0);
+
+                if (SUCCEEDED(hr))
+                {
+                    for (unsigned row = 0; row != unsigned(arg[6]); ++row)
+                    {
+                        uint8* dst = (uint8*)(rc.pBits) + row * rc.Pitch;
+
+                        if (format == TEXTURE_FORMAT_R8G8B8A8)
+                            _SwapRB8(src, dst, rowSize);
+                        else if (format == TEXTURE_FORMAT_R4G4B4A4)
+                            _SwapRB4(src, dst, rowSize);
+                        else if (format == TEXTURE_FORMAT_R5G5B5A1)
+                            _SwapRB5551(src, dst, rowSize);
+                        else
+                            memcpy(dst, src, rowSize);
+
+                        src += rowSize;
+                    }
+
+                    cmd->retval = tex->UnlockRect(lev);
+                }
+                else
+                {
+                    CHECK_HR(hr);
+                    cmd->retval = hr;
+                }
+            }
+            else
+            {
+                cmd->retval = E_FAIL;
+            }
+        }
+        break;
+
         case DX9Command::READ_TEXTURE_LEVEL:
         {
             IDirect3DTexture9* tex = *((IDirect3DTexture9**)(arg[0]));
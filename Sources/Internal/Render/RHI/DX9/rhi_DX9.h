@@ -158,6 +158,7 @@ DX9Command
         GET_RENDERTARGET_DATA = 39,
         UPDATE_TEXTURE_LEVEL = 40,
         UPDATE_CUBETEXTURE_LEVEL = 41,
+        UPDATE_TEXTURE_REGION = 42,
 
         CREATE_VERTEX_SHADER = 51,
         CREATE_PIXEL_SHADER = 52,
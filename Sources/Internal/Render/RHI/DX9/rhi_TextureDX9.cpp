@@ -487,6 +487,27 @@ dx9_Texture_Update(Handle tex, const void* data, uint32 level, TextureFace face)
 
 //------------------------------------------------------------------------------
 
+static void
+dx9_Texture_UpdateRegion(Handle tex, const void* data, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height)
+{
+    TextureDX9_t* self = TextureDX9Pool::Get(tex);
+
+    DVASSERT(self->cubetex9 == nullptr);
+
+    TextureFormat format = self->CreationDesc().format;
+    IDirect3DTexture9** tex9 = (self->CreationDesc().isRenderTarget) ? &self->rt_tex9 : &self->tex9;
+    uint32 rowSize = TextureStride(format, Size2i(width, height), 0);
+    DX9Command cmd = { DX9Command::UPDATE_TEXTURE_REGION, { uint64_t(tex9), level, uint64(data), x, y, width, height, static_cast<uint64>(format), rowSize } };
+    ExecDX9(&cmd, 1, false);
+
+    if (cmd.retval)
+    {
+        Logger::Error("Failed to update texture region (0x%08X) : %s", cmd.retval, D3D9ErrorText(cmd.retval));
+    }
+}
+
+//------------------------------------------------------------------------------
+
 static bool dx9_Texture_NeedRestore(Handle tex)
 {
     TextureDX9_t* self = TextureDX9Pool::Get(tex);
@@ -509,6 +530,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = &dx9_Texture_Map;
     dispatch->impl_Texture_Unmap = &dx9_Texture_Unmap;
     dispatch->impl_Texture_Update = &dx9_Texture_Update;
+    dispatch->impl_Texture_UpdateRegion = &dx9_Texture_UpdateRegion;
     dispatch->impl_Texture_NeedRestore = &dx9_Texture_NeedRestore;
 }
 
@@ -145,6 +145,7 @@ struct GLCommand
         DELETE_TEXTURES,
         TEX_PARAMETER_I,
         TEX_IMAGE2D,
+        TEX_SUBIMAGE2D,
         GENERATE_MIPMAP,
         READ_PIXELS,
         PIXEL_STORE_I,
@@ -660,6 +660,37 @@ void gles2_Texture_Update(Handle tex, const void* data, uint32 level, TextureFac
 
 //------------------------------------------------------------------------------
 
+void gles2_Texture_UpdateRegion(Handle tex, const void* data, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height)
+{
+    TextureGLES2_t* self = TextureGLES2Pool::Get(tex);
+    GLint int_fmt;
+    GLint fmt;
+    GLenum type;
+    bool compressed;
+
+    DVASSERT(!self->isRenderBuffer);
+    DVASSERT(!self->isMapped);
+    DVASSERT(!self->isCubeMap);
+
+    GetGLTextureFormat(self->format, &int_fmt, &fmt, &type, &compressed);
+    DVASSERT(!compressed && self->format != TEXTURE_FORMAT_R4G4B4A4 && self->format != TEXTURE_FORMAT_R5G5B5A1, "Region update is not supported for texture format");
+
+    // region rows are tightly packed, so they aren't 4-byte aligned for narrow regions
+    GLCommand cmd[] =
+    {
+      { GLCommand::SET_ACTIVE_TEXTURE, { GL_TEXTURE0 + 0 } },
+      { GLCommand::BIND_TEXTURE, { GL_TEXTURE_2D, uint64(&(self->uid)) } },
+      { GLCommand::PIXEL_STORE_I, { GL_UNPACK_ALIGNMENT, 1 } },
+      { GLCommand::TEX_SUBIMAGE2D, { GL_TEXTURE_2D, uint64(level), uint64(x), uint64(y), uint64(width), uint64(height), uint64(fmt), type, reinterpret_cast<uint64>(data) } },
+      { GLCommand::PIXEL_STORE_I, { GL_UNPACK_ALIGNMENT, 4 } },
+      { GLCommand::RESTORE_TEXTURE0, {} }
+    };
+
+    ExecGL(cmd, countof(cmd));
+}
+
+//------------------------------------------------------------------------------
+
 bool gles2_Texture_NeedRestore(Handle tex)
 {
     TextureGLES2_t* self = TextureGLES2Pool::Get(tex);
@@ -821,6 +852,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = &gles2_Texture_Map;
     dispatch->impl_Texture_Unmap = &gles2_Texture_Unmap;
     dispatch->impl_Texture_Update = &gles2_Texture_Update;
+    dispatch->impl_Texture_UpdateRegion = &gles2_Texture_UpdateRegion;
     dispatch->impl_Texture_NeedRestore = &gles2_Texture_NeedRestore;
 }
 
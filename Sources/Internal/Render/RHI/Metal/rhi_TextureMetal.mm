@@ -623,6 +623,20 @@ void metal_Texture_Update(Handle tex, const void* data, uint32 level, TextureFac
 
 //------------------------------------------------------------------------------
 
+void metal_Texture_UpdateRegion(Handle tex, const void* data, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height)
+{
+    TextureMetal_t* self = TextureMetalPool::Get(tex);
+
+    DVASSERT(!self->is_cubemap);
+    DVASSERT(self->format != TEXTURE_FORMAT_R4G4B4A4 && self->format != TEXTURE_FORMAT_R5G5B5A1, "Region update is not supported for texture format");
+
+    MTLRegion rgn = MTLRegionMake2D(x, y, width, height);
+    uint32 stride = TextureStride(self->format, Size2i(width, height), 0);
+    [self->uid replaceRegion:rgn mipmapLevel:level withBytes:data bytesPerRow:stride];
+}
+
+//------------------------------------------------------------------------------
+
 static bool
 metal_Texture_NeedRestore(Handle tex)
 {
@@ -647,6 +661,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = &metal_Texture_Map;
     dispatch->impl_Texture_Unmap = &metal_Texture_Unmap;
     dispatch->impl_Texture_Update = &metal_Texture_Update;
+    dispatch->impl_Texture_UpdateRegion = &metal_Texture_UpdateRegion;
     dispatch->impl_Texture_NeedRestore = &metal_Texture_NeedRestore;
 }
 
@@ -251,6 +251,7 @@ void* MapTexture(HTexture tex, uint32 level = 0);
 void UnmapTexture(HTexture tex);
 
 void UpdateTexture(HTexture tex, const void* data, uint32 level, TextureFace face = TEXTURE_FACE_NONE);
+void UpdateTextureRegion(HTexture tex, const void* data, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height); // 2D uncompressed textures only, data rows are tightly packed
 
 bool NeedRestoreTexture(HTexture tex);
 
@@ -711,6 +711,13 @@ void Scene::Update(float32 timeElapsed)
         }
     }
 
+#if defined(__DAVAENGINE_PHYSICS_ENABLED__)
+    if (physicsSystem != nullptr)
+    {
+        physicsSystem->OnFrameEnd();
+    }
+#endif
+
     if (transformSingleComponent)
     {
         transformSingleComponent->Clear();
@@ -34,47 +34,42 @@ void UIDataBindingDependenciesManager::AddDependencies(int32 id, const Vector<vo
     DVASSERT(id != UNKNOWN_DEPENDENCY);
     DVASSERT(dirtyBindings.find(id) != dirtyBindings.end());
 
+    Vector<void*>& dependencies = bindingDependencies[id];
     for (void* d : data)
     {
-        auto it = dirtyMap.find(d);
-        if (it == dirtyMap.end())
-        {
-            dirtyMap[d] = Vector<int>();
-            it = dirtyMap.find(d);
-        }
-
-        bool haveToAddId = std::find(it->second.begin(), it->second.end(), id) == it->second.end();
+        Vector<int32>& ids = dirtyMap[d];
+        bool haveToAddId = std::find(ids.begin(), ids.end(), id) == ids.end();
         if (haveToAddId)
         {
-            it->second.push_back(id);
+            ids.push_back(id);
+            dependencies.push_back(d);
         }
     }
 }
 
 void UIDataBindingDependenciesManager::ReleaseDepencency(int32 index)
 {
-    for (auto mapIt = dirtyMap.begin(); mapIt != dirtyMap.end();)
+    auto depsIt = bindingDependencies.find(index);
+    if (depsIt != bindingDependencies.end())
     {
-        Vector<int>& v = mapIt->second;
-        auto it = std::find(v.begin(), v.end(), index);
-        bool haveToErase = false;
-        if (it != v.end())
+        for (void* d : depsIt->second)
         {
-            v.erase(it);
-            if (v.empty())
+            auto mapIt = dirtyMap.find(d);
+            if (mapIt != dirtyMap.end())
             {
-                haveToErase = true;
+                Vector<int32>& v = mapIt->second;
+                auto it = std::find(v.begin(), v.end(), index);
+                if (it != v.end())
+                {
+                    v.erase(it);
+                }
+                if (v.empty())
+                {
+                    dirtyMap.erase(mapIt);
+                }
             }
         }
-
-        if (haveToErase)
-        {
-            mapIt = dirtyMap.erase(mapIt);
-        }
-        else
-        {
-            ++mapIt;
-        }
+        bindingDependencies.erase(depsIt);
     }
 
     auto it = dirtyBindings.find(index);
@@ -91,7 +86,12 @@ void UIDataBindingDependenciesManager::SetDirty(void* data)
     {
         for (int32 id : it->second)
         {
-            dirtyBindings[id] = true;
+            bool& dirty = dirtyBindings[id];
+            if (!dirty)
+            {
+                dirty = true;
+                dirtyIds.push_back(id);
+            }
         }
     }
 }
@@ -104,9 +104,15 @@ bool UIDataBindingDependenciesManager::IsDirty(int32 index) const
 
 void UIDataBindingDependenciesManager::ResetDirties()
 {
-    for (auto& it : dirtyBindings)
+    // Only bindings marked since last reset are visited
+    for (int32 id : dirtyIds)
     {
-        it.second = false;
+        auto it = dirtyBindings.find(id);
+        if (it != dirtyBindings.end())
+        {
+            it->second = false;
+        }
     }
+    dirtyIds.clear();
 }
 }
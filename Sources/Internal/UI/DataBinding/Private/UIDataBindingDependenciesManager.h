@@ -23,6 +23,8 @@ public:
 private:
     UnorderedMap<int32, bool> dirtyBindings;
     UnorderedMap<void*, Vector<int32>> dirtyMap;
+    UnorderedMap<int32, Vector<void*>> bindingDependencies; // reverse of `dirtyMap`, to release binding without full scan
+    Vector<int32> dirtyIds;
     int32 nextId = 0;
 };
 }
@@ -222,6 +222,53 @@ DAVA_TESTCLASS (UIDataBindingTest)
         }
     }
 
+    DAVA_TEST (BindingListReuseCellsTest)
+    {
+        UIDataListComponent* listComp = list->GetOrCreateComponent<UIDataListComponent>();
+        listComp->SetCellPackage("~res:/UI/UIDataBinindingCell.yaml");
+        listComp->SetCellControlName("UIStaticText");
+        listComp->SetDataContainer("items");
+
+        UIDataBindingSystem* sys = GetEngineContext()->uiControlSystem->GetSystem<UIDataBindingSystem>();
+        sys->Process(0.0f);
+        sys->FinishProcess();
+
+        Vector<UIControl*> cells;
+        for (const RefPtr<UIControl>& c : list->GetChildren())
+        {
+            cells.push_back(c.Get());
+        }
+        TEST_VERIFY(cells.size() == data.items.size());
+
+        data.items.push_back(DataItem("i4"));
+        data.items[0].name = "i0";
+        sys->SetDataDirty(&data.items);
+        sys->Process(0.0f);
+        sys->FinishProcess();
+
+        // Existing cells are rebound to new items, only missing one is created
+        TEST_VERIFY(list->GetChildren().size() == data.items.size());
+        auto it = list->GetChildren().begin();
+        for (size_t i = 0; i < data.items.size(); i++)
+        {
+            if (i < cells.size())
+            {
+                TEST_VERIFY(it->Get() == cells[i]);
+            }
+            TEST_VERIFY((*it)->GetComponent<UITextComponent>()->GetText() == data.items[i].name);
+            ++it;
+        }
+
+        data.items.pop_back();
+        data.items[0].name = "i1";
+        sys->SetDataDirty(&data.items);
+        sys->Process(0.0f);
+        sys->FinishProcess();
+
+        TEST_VERIFY(list->GetChildren().size() == data.items.size());
+        TEST_VERIFY(list->GetChildren().front().Get() == cells[0]);
+    }
+
     DAVA_TEST (BindingChildFactoryTest)
     {
         UIDataChildFactoryComponent* factoryComp = list->GetOrCreateComponent<UIDataChildFactoryComponent>();
@@ -211,32 +211,23 @@ bool UIDataList::Process(UIDataBindingDependenciesManager* dependenciesManager)
 
         if (list)
         {
-            list->ImmediateClearCells();
+            if (expChanged)
+            {
+                list->ImmediateClearCells();
+            }
+            else
+            {
+                // Cells of the same prototype are kept and rebound to new data on refresh
+                list->Refresh();
+            }
         }
         else
         {
-            RemoveCreatedControls();
-            int32 index = 0;
-            for (Reflection::Field& field : data)
+            if (expChanged || !cellPrototype.Valid())
             {
-                if (cellPrototype.Valid())
-                {
-                    RefPtr<UIControl> cell = cellPrototype->SafeClone();
-                    UIDataSourceComponent* cellDataSourceComponent = cell->GetOrCreateComponent<UIDataSourceComponent>();
-                    cellDataSourceComponent->SetData(field.ref);
-
-                    if (editorMode)
-                    {
-                        UILayoutSourceRectComponent* sourceRect = cell->GetOrCreateComponent<UILayoutSourceRectComponent>();
-                        sourceRect->SetSize(cell->GetSize());
-                        sourceRect->SetPosition(cell->GetPosition());
-                    }
-
-                    component->GetControl()->AddControl(cell.Get());
-                    createdControls.push_back(cell);
-                }
-                index++;
+                RemoveCreatedControls();
             }
+            UpdateCreatedControls();
         }
     }
 
@@ -324,6 +315,44 @@ void UIDataList::OnCellSelected(UIList* forList, UIListCell* selectedCell)
     }
 }
 
+void UIDataList::UpdateCreatedControls()
+{
+    if (!cellPrototype.Valid())
+    {
+        return;
+    }
+
+    // Controls created for previous data are rebound to new items, only count difference is cloned or removed
+    size_t reusedCount = Min(createdControls.size(), data.size());
+    for (size_t i = 0; i < reusedCount; ++i)
+    {
+        createdControls[i]->GetOrCreateComponent<UIDataSourceComponent>()->SetData(data[i].ref);
+    }
+
+    for (size_t i = reusedCount; i < createdControls.size(); ++i)
+    {
+        createdControls[i]->RemoveFromParent();
+    }
+    createdControls.resize(reusedCount);
+
+    for (size_t i = reusedCount; i < data.size(); ++i)
+    {
+        RefPtr<UIControl> cell = cellPrototype->SafeClone();
+        UIDataSourceComponent* cellDataSourceComponent = cell->GetOrCreateComponent<UIDataSourceComponent>();
+        cellDataSourceComponent->SetData(data[i].ref);
+
+        if (editorMode)
+        {
+            UILayoutSourceRectComponent* sourceRect = cell->GetOrCreateComponent<UILayoutSourceRectComponent>();
+            sourceRect->SetSize(cell->GetSize());
+            sourceRect->SetPosition(cell->GetPosition());
+        }
+
+        component->GetControl()->AddControl(cell.Get());
+        createdControls.push_back(cell);
+    }
+}
+
 void UIDataList::RemoveCreatedControls()
 {
     for (RefPtr<UIControl>& control : createdControls)
@@ -34,6 +34,7 @@ private:
     float32 CellHeight(UIList* list, int32 index) override;
     void OnCellSelected(UIList* forList, UIListCell* selectedCell) override;
 
+    void UpdateCreatedControls();
     void RemoveCreatedControls();
 
     UIDataListComponent* component = nullptr;
@@ -13,7 +13,7 @@
 
 namespace DAVA
 {
-void Layouter::ApplyLayout(UIControl* control)
+uint32 Layouter::ApplyLayout(UIControl* control)
 {
     CollectControls(control, true);
 
@@ -22,10 +22,12 @@ void Layouter::ApplyLayout(UIControl* control)
 
     ApplySizesAndPositions();
 
+    uint32 controlsCount = static_cast<uint32>(layoutData.size());
     layoutData.clear();
+    return controlsCount;
 }
 
-void Layouter::ApplyLayoutNonRecursive(UIControl* control)
+uint32 Layouter::ApplyLayoutNonRecursive(UIControl* control)
 {
     CollectControls(control, false);
 
@@ -34,7 +36,9 @@ void Layouter::ApplyLayoutNonRecursive(UIControl* control)
 
     ApplyPositions();
 
+    uint32 controlsCount = static_cast<uint32>(layoutData.size());
     layoutData.clear();
+    return controlsCount;
 }
 
 void Layouter::CollectControls(UIControl* control, bool recursive)
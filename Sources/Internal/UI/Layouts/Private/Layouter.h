@@ -13,8 +13,9 @@ class LayoutFormula;
 class Layouter
 {
 public:
-    void ApplyLayout(UIControl* control);
-    void ApplyLayoutNonRecursive(UIControl* control);
+    /** Return number of processed controls. */
+    uint32 ApplyLayout(UIControl* control);
+    uint32 ApplyLayoutNonRecursive(UIControl* control);
 
     void CollectControls(UIControl* control, bool recursive);
     void CollectControlChildren(UIControl* control, int32 parentIndex, int32 index, bool recursive);
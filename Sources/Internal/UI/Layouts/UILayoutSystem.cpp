@@ -82,6 +82,8 @@ void UILayoutSystem::Process(float32 elapsedTime)
 
     DVASSERT(Thread::IsMainThread());
 
+    layoutedControlsCount = 0;
+
     if (!IsAutoupdatesEnabled())
         return;
 
@@ -225,14 +227,14 @@ void UILayoutSystem::ProcessControl(UIControl* control)
     if (layoutDirty || (orderDirty && HaveToLayoutAfterReorder(control)) || (positionDirty && control->GetParent() && control->GetParent()->GetComponent(Type::Instance<UILayoutSourceRectComponent>())))
     {
         UIControl* container = FindNotDependentOnChildrenControl(control);
-        sharedLayouter->ApplyLayout(container);
+        layoutedControlsCount += sharedLayouter->ApplyLayout(container);
 
         controlLayouted.Emit(container);
     }
     else if (positionDirty && HaveToLayoutAfterReposition(control))
     {
         UIControl* container = control->GetParent();
-        sharedLayouter->ApplyLayoutNonRecursive(container);
+        layoutedControlsCount += sharedLayouter->ApplyLayoutNonRecursive(container);
         controlLayouted.Emit(container);
     }
 }
@@ -333,6 +335,14 @@ void UILayoutSystem::ProcessControlHierarhy(UIControl* control)
 {
     ProcessControl(control);
 
+    // Only paths to controls with dirty flags have to be visited. Flag is reset after processing
+    // of control itself, because layout of control marks its changed children too.
+    if (!control->IsLayoutChildrenDirty())
+    {
+        return;
+    }
+    control->ResetLayoutChildrenDirty();
+
     // TODO: For now game has many places where changes in layouts can
     // change hierarchy of controls. In future client want fix this places,
     // after that this code should be replaced by simple for-each.
@@ -46,6 +46,9 @@ public:
 
     void ManualApplyLayout(UIControl* control); //DON'T USE IT!
 
+    /** Number of controls processed by layout algorithms during last frame. */
+    uint32 GetLayoutedControlsCount() const;
+
     Signal<UIControl*> controlLayouted;
     Signal<UIControl*, Vector2::eAxis, const LayoutFormula*> formulaProcessed;
     Signal<UIControl*, Vector2::eAxis, const LayoutFormula*> formulaRemoved;
@@ -74,6 +77,7 @@ private:
     bool autoupdatesEnabled = true;
     bool dirty = false;
     bool needUpdate = false;
+    uint32 layoutedControlsCount = 0;
     std::unique_ptr<class Layouter> sharedLayouter;
     RefPtr<UIScreen> currentScreen;
     RefPtr<UIControl> popupContainer;
@@ -97,6 +101,11 @@ inline void UILayoutSystem::SetDirty()
     dirty = true;
 }
 
+inline uint32 UILayoutSystem::GetLayoutedControlsCount() const
+{
+    return layoutedControlsCount;
+}
+
 inline void UILayoutSystem::CheckDirty()
 {
     needUpdate = dirty;
@@ -87,6 +87,11 @@ void UIRenderSystem::Render()
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::UI_RENDER_SYSTEM);
 
+    if (useBatchReordering)
+    {
+        renderSystem2D->BeginBatchReordering();
+    }
+
     if (currentScreen.Valid())
     {
         RenderControlHierarhy(currentScreen.Get(), baseGeometricData, nullptr);
@@ -97,6 +102,11 @@ void UIRenderSystem::Render()
         RenderControlHierarhy(popupContainer.Get(), baseGeometricData, nullptr);
     }
 
+    if (useBatchReordering)
+    {
+        renderSystem2D->EndBatchReordering();
+    }
+
     screenshoter->OnFrame();
 }
 
@@ -104,7 +114,17 @@ void UIRenderSystem::ForceRenderControl(UIControl* control)
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::UI_RENDER_SYSTEM);
 
+    if (useBatchReordering)
+    {
+        renderSystem2D->BeginBatchReordering();
+    }
+
     RenderControlHierarhy(control, baseGeometricData, nullptr);
+
+    if (useBatchReordering)
+    {
+        renderSystem2D->EndBatchReordering();
+    }
 }
 
 const UIGeometricData& UIRenderSystem::GetBaseGeometricData() const
@@ -139,6 +159,11 @@ void UIRenderSystem::SetUseClearPass(bool useClearPass)
     needClearMainPass = useClearPass;
 }
 
+void UIRenderSystem::SetUseBatchReordering(bool useBatchReordering_)
+{
+    useBatchReordering = useBatchReordering_;
+}
+
 void UIRenderSystem::SetCurrentScreen(const RefPtr<UIScreen>& _screen)
 {
     currentScreen = _screen;
@@ -311,11 +336,13 @@ void UIRenderSystem::RenderText(const UIControl* control, const UITextComponent*
 
         shadowBg->SetAlign(textBg->GetAlign());
         shadowBg->Draw(shadowGeomData);
+        textBlock->DrawAligned(shadowGeomData, shadowBg->GetDrawColor());
     }
 
     textBlock->Draw(textBg->GetDrawColor());
 
     textBg->Draw(textGeomData);
+    textBlock->DrawAligned(textGeomData, textBg->GetDrawColor());
      
 #if defined(LOCALIZATION_DEBUG)
     RenderTextDetails::DrawDebug(link, geometricData);
@@ -33,6 +33,9 @@ public:
     void SetClearColor(const Color& clearColor);
     void SetUseClearPass(bool useClearPass);
 
+    /** Allow RenderSystem2D to merge non-overlapping draws of the same texture and material out of hierarchy order. Enabled by default. */
+    void SetUseBatchReordering(bool useBatchReordering);
+
     void SetCurrentScreen(const RefPtr<UIScreen>& screen);
     void SetPopupContainer(const RefPtr<UIControl>& popupContainer);
 
@@ -67,5 +70,6 @@ private:
 
     Set<UIControl*> ui3DViews;
     bool needClearMainPass = true;
+    bool useBatchReordering = true;
 };
 }
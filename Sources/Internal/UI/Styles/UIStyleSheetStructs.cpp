@@ -101,6 +101,11 @@ bool UIStyleSheetClassSet::ResetTaggedClass(const FastName& tag)
     return false;
 }
 
+const Vector<UIStyleSheetClass>& UIStyleSheetClassSet::GetClasses() const
+{
+    return classes;
+}
+
 bool UIStyleSheetClassSet::RemoveAllClasses()
 {
     if (!classes.empty())
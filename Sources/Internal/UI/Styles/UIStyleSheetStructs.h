@@ -123,6 +123,8 @@ public:
     String GetClassesAsString() const;
     void SetClassesFromString(const String& classes);
 
+    const Vector<UIStyleSheetClass>& GetClasses() const;
+
 private:
     Vector<UIStyleSheetClass> classes;
 };
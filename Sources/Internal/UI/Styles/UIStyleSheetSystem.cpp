@@ -124,6 +124,7 @@ void UIStyleSheetSystem::Process(float32 elapsedTime)
     }
 
     globalStyleSheetDirty = false;
+    changedGlobalClasses.clear();
 }
 
 void UIStyleSheetSystem::ForceProcessControl(float32 elapsedTime, UIControl* control)
@@ -181,16 +182,19 @@ void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFr
         UIStyleSheetPropertySet cascadeProperties;
         const UIStyleSheetPropertySet localControlProperties = control->GetLocalPropertySet();
         const Vector<UIPriorityStyleSheet>& styleSheets = packageContext->GetSortedStyleSheets();
-        
+        packageContext->CollectStyleSheetCandidates(control->GetName(), control->GetClassName(), control->GetClassSet(), globalClasses, styleSheetCandidates);
+
 #if STYLESHEET_STATS
-        statsStyleSheetCount += styleSheets.size();
+        statsStyleSheetCount += styleSheetCandidates.size();
 #endif
 
         Array<const UIStyleSheetProperty*, UIStyleSheetPropertyDataBase::STYLE_SHEET_PROPERTY_COUNT> propertySources = {};
 
-        for (auto styleSheetIter = styleSheets.rbegin(); styleSheetIter != styleSheets.rend(); ++styleSheetIter)
+        // Candidates go in the same order as in reverse iteration over sorted style sheets
+        for (int32 styleSheetIndex : styleSheetCandidates)
         {
-            const UIStyleSheet* styleSheet = styleSheetIter->GetStyleSheet();
+            const UIPriorityStyleSheet& priorityStyleSheet = styleSheets[styleSheetIndex];
+            const UIStyleSheet* styleSheet = priorityStyleSheet.GetStyleSheet();
 
             if (StyleSheetMatchesControl(styleSheet, control))
             {
@@ -209,7 +213,7 @@ void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFr
 
                 if (debugData != nullptr)
                 {
-                    debugData->styleSheets.push_back(*styleSheetIter);
+                    debugData->styleSheets.push_back(priorityStyleSheet);
                 }
             }
         }
@@ -279,7 +283,7 @@ void UIStyleSheetSystem::AddGlobalClass(const FastName& clazz)
 {
     if (globalClasses.AddClass(clazz))
     {
-        SetGlobalStyleSheetDirty();
+        SetGlobalStyleSheetDirty(clazz);
     }
 }
 
@@ -287,7 +291,7 @@ void UIStyleSheetSystem::RemoveGlobalClass(const FastName& clazz)
 {
     if (globalClasses.RemoveClass(clazz))
     {
-        SetGlobalStyleSheetDirty();
+        SetGlobalStyleSheetDirty(clazz);
     }
 }
 
@@ -337,10 +341,23 @@ void UIStyleSheetSystem::DumpStats()
 void UIStyleSheetSystem::ProcessControlHierarhy(UIControl* control)
 {
     uint32 propIndex = UIStyleSheetPropertyDataBase::Instance()->GetStyleSheetVisiblePropertyIndex();
-    if ((control->IsVisible() || control->GetStyledPropertySet().test(propIndex))
-        && control->IsStyleSheetDirty())
+    const bool styleSheetVisible = control->IsVisible() || control->GetStyledPropertySet().test(propIndex);
+    if (styleSheetVisible && control->IsStyleSheetDirty())
+    {
+        ProcessControl(control);
+    }
+    else if (globalStyleSheetDirty && IsAffectedByGlobalClassesChange(control))
     {
-        ProcessControl(control, globalStyleSheetDirty);
+        if (styleSheetVisible)
+        {
+            // Children are checked separately below
+            ProcessControlImpl(control, 0, true, false, false, nullptr);
+        }
+        else
+        {
+            // Invisible control is kept dirty and restyled when it becomes visible
+            control->SetStyleSheetDirty();
+        }
     }
 
     for (const auto& child : control->GetChildren())
@@ -349,6 +366,24 @@ void UIStyleSheetSystem::ProcessControlHierarhy(UIControl* control)
     }
 }
 
+bool UIStyleSheetSystem::IsAffectedByGlobalClassesChange(UIControl* control) const
+{
+    RefPtr<UIControlPackageContext> packageContext = control->GetPackageContext();
+    if (!packageContext)
+    {
+        return false;
+    }
+
+    for (const FastName& clazz : changedGlobalClasses)
+    {
+        if (packageContext->HasStyleSheetsWithClass(clazz))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool UIStyleSheetSystem::StyleSheetMatchesControl(const UIStyleSheet* styleSheet, const UIControl* control)
 {
 #if STYLESHEET_STATS
@@ -425,16 +460,13 @@ void UIStyleSheetSystem::DoForAllPropertyInstances(UIControl* control, uint32 pr
     }
 }
 
-void UIStyleSheetSystem::SetGlobalStyleSheetDirty()
+void UIStyleSheetSystem::SetGlobalStyleSheetDirty(const FastName& changedClass)
 {
     globalStyleSheetDirty = true;
-    if (currentScreen.Valid())
-    {
-        currentScreen->SetStyleSheetDirty();
-    }
-    if (popupContainer.Valid())
+    if (std::find(changedGlobalClasses.begin(), changedGlobalClasses.end(), changedClass) == changedGlobalClasses.end())
     {
-        popupContainer->SetStyleSheetDirty();
+        changedGlobalClasses.push_back(changedClass);
     }
+    SetDirty();
 }
 }
@@ -66,16 +66,22 @@ private:
 
     void ProcessControlImpl(UIControl* control, int32 distanceFromDirty, bool styleSheetListChanged, bool recursively, bool dryRun, UIStyleSheetProcessDebugData* debugData);
     void ProcessControlHierarhy(UIControl* root);
+    bool IsAffectedByGlobalClassesChange(UIControl* control) const;
 
     bool StyleSheetMatchesControl(const UIStyleSheet* styleSheet, const UIControl* control);
     bool SelectorMatchesControl(const UIStyleSheetSelector& selector, const UIControl* control);
 
     template <typename CallbackType>
     void DoForAllPropertyInstances(UIControl* control, uint32 propertyIndex, const CallbackType& action);
-    /** Sets 'globalStyleSheetDirty' flag for next 'Process()' call. Flag will reset automatically. */
-    void SetGlobalStyleSheetDirty();
+    /**
+        Sets 'globalStyleSheetDirty' flag for next 'Process()' call. Flag will reset automatically.
+        Only controls with style sheets referring to changed classes are restyled.
+    */
+    void SetGlobalStyleSheetDirty(const FastName& changedClass);
 
     UIStyleSheetClassSet globalClasses;
+    Vector<FastName> changedGlobalClasses;
+    Vector<int32> styleSheetCandidates;
 
     uint64 statsTime = 0;
     int32 statsProcessedControls = 0;
@@ -5,7 +5,10 @@
 #include "Debug/ProfilerMarkerNames.h"
 #include "Engine/Engine.h"
 #include "Entity/Component.h"
+#include "Job/JobManager.h"
 #include "Render/2D/FontManager.h"
+#include "Render/2D/TextBlock.h"
+#include "Time/SystemTimer.h"
 #include "UI/Text/UITextComponent.h"
 #include "UI/UIControl.h"
 #include "UITextSystemLink.h"
@@ -13,6 +16,11 @@
 
 namespace DAVA
 {
+namespace UITextSystemDetails
+{
+const uint32 LAYOUT_CHUNK_SIZE = 4;
+}
+
 UITextSystem::~UITextSystem()
 {
     for (UITextComponent* component : components)
@@ -38,8 +46,52 @@ void UITextSystem::Process(float32 elapsedTime)
         if (component != nullptr && component->IsModified())
         {
             ApplyData(component);
+
+            TextBlock* textBlock = component->GetLink()->GetTextBlock();
+            if (textBlock->NeedCalculateCacheParams())
+            {
+                textBlocksToLayout.push_back(textBlock);
+            }
+        }
+    }
+
+    // Layouts are calculated here rather than on first access from layout or render systems
+    layoutedTextsCount = 0;
+    layoutTime = 0;
+    if (parallelLayoutEnabled && !textBlocksToLayout.empty())
+    {
+        CalculateLayouts();
+    }
+    textBlocksToLayout.clear();
+}
+
+void UITextSystem::CalculateLayouts()
+{
+    using namespace UITextSystemDetails;
+
+    int64 startTime = SystemTimer::GetUs();
+
+    uint32 textBlocksCount = static_cast<uint32>(textBlocksToLayout.size());
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager == nullptr)
+    {
+        for (TextBlock* textBlock : textBlocksToLayout)
+        {
+            textBlock->CalculateCacheParamsIfNeed();
         }
     }
+    else
+    {
+        jobManager->ParallelFor(textBlocksCount, LAYOUT_CHUNK_SIZE, [this](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i)
+            {
+                textBlocksToLayout[i]->CalculateCacheParamsIfNeed();
+            }
+        });
+    }
+
+    layoutedTextsCount = textBlocksCount;
+    layoutTime = SystemTimer::GetUs() - startTime;
 }
 
 void UITextSystem::ApplyData(UITextComponent* component)
@@ -9,6 +9,7 @@ namespace DAVA
 {
 class UIControl;
 class UITextComponent;
+class TextBlock;
 
 /** 
     Text component support system. 
@@ -35,10 +36,48 @@ public:
     /** Mark all components as modified, for forced refresh. */
     void InvalidateAll();
 
+    /**
+        Calculate layouts of modified texts from worker jobs during `Process`, instead of calculating them one by one
+        on first access. Enabled by default.
+    */
+    void SetParallelLayoutEnabled(bool enabled);
+    bool IsParallelLayoutEnabled() const;
+
+    /** Number of text layouts calculated by `Process` during last frame. */
+    uint32 GetLayoutedTextsCount() const;
+
+    /** Wall time spent by `Process` on text layouts during last frame, in microseconds. */
+    int64 GetLayoutTime() const;
+
 private:
     void AddLink(UITextComponent* component);
     void RemoveLink(UITextComponent* component);
+    void CalculateLayouts();
 
     Vector<UITextComponent*> components;
+    Vector<TextBlock*> textBlocksToLayout;
+    bool parallelLayoutEnabled = true;
+    uint32 layoutedTextsCount = 0;
+    int64 layoutTime = 0;
 };
+
+inline void UITextSystem::SetParallelLayoutEnabled(bool enabled)
+{
+    parallelLayoutEnabled = enabled;
+}
+
+inline bool UITextSystem::IsParallelLayoutEnabled() const
+{
+    return parallelLayoutEnabled;
+}
+
+inline uint32 UITextSystem::GetLayoutedTextsCount() const
+{
+    return layoutedTextsCount;
+}
+
+inline int64 UITextSystem::GetLayoutTime() const
+{
+    return layoutTime;
+}
 }
@@ -7,6 +7,8 @@
 #include <UI/UIControlSystem.h>
 #include <UI/UIPackageLoader.h>
 #include <UI/UIScreen.h>
+#include <Render/2D/FontManager.h>
+#include <Render/2D/Private/TextBlockLayoutCache.h>
 #include "Utils/UTF8Utils.h"
 
 #include "UnitTests/UnitTests.h"
@@ -205,4 +207,49 @@ DAVA_TESTCLASS (UITextSystemTest)
         UpdateSystem();
         TEST_VERIFY(copy->GetLink()->GetTextBlock()->GetText() == UTF8Utils::EncodeToWideString(str2));
     }
+
+    DAVA_TEST (ParallelLayoutTest)
+    {
+        const uint32 controlsCount = 32;
+        const Vector<String> texts = { "Lorem ipsum dolor sit amet", "Consectetur adipiscing elit", "Sed do eiusmod" };
+
+        UITextSystem* sys = GetEngineContext()->uiControlSystem->GetSystem<UITextSystem>();
+        TextBlockLayoutCache* layoutCache = GetEngineContext()->fontManager->GetTextLayoutCache();
+        layoutCache->Clear();
+
+        Vector<RefPtr<UIControl>> controls;
+        for (uint32 i = 0; i < controlsCount; ++i)
+        {
+            RefPtr<UIControl> control(new UIControl(Rect(0.f, 0.f, 100.f, 50.f)));
+            UITextComponent* text = control->GetOrCreateComponent<UITextComponent>();
+            text->SetText(texts[i % texts.size()]);
+            text->SetFontName("Korinna_18");
+            text->SetMultiline(UITextComponent::eTextMultiline::MULTILINE_ENABLED);
+            newControl->AddControl(control.Get());
+            controls.push_back(control);
+        }
+
+        UpdateSystem();
+
+        // All layouts are ready before layout and render systems, equal texts are laid out once
+        TEST_VERIFY(sys->GetLayoutedTextsCount() == controlsCount);
+        TEST_VERIFY(layoutCache->GetLayoutsCount() == texts.size());
+        for (uint32 i = 0; i < controlsCount; ++i)
+        {
+            TextBlock* textBlock = controls[i]->GetComponent<UITextComponent>()->GetLink()->GetTextBlock();
+            TEST_VERIFY(!textBlock->NeedCalculateCacheParams());
+
+            TextBlock* sameTextBlock = controls[i % texts.size()]->GetComponent<UITextComponent>()->GetLink()->GetTextBlock();
+            TEST_VERIFY(textBlock->GetTextSize() == sameTextBlock->GetTextSize());
+            TEST_VERIFY(textBlock->GetMultilineStrings() == sameTextBlock->GetMultilineStrings());
+        }
+
+        UpdateSystem();
+        TEST_VERIFY(sys->GetLayoutedTextsCount() == 0);
+
+        for (const RefPtr<UIControl>& control : controls)
+        {
+            newControl->RemoveControl(control.Get());
+        }
+    }
 };
@@ -90,6 +90,7 @@ UIControl::UIControl(const Rect& rect)
     , layoutDirty(true)
     , layoutPositionDirty(true)
     , layoutOrderDirty(true)
+    , layoutChildrenDirty(false)
     , inputEnabled(true)
 {
     StartControlTracking(this);
@@ -144,6 +145,11 @@ void UIControl::SetParent(UIControl* newParent)
         PropagateParentWithContext(newParent->packageContext ? newParent : newParent->parentWithContext);
 
         parent->RegisterInputProcessors(inputProcessorsCount);
+
+        if (layoutDirty || layoutPositionDirty || layoutOrderDirty || layoutChildrenDirty)
+        {
+            PropagateLayoutDirtyToParents();
+        }
     }
     else
     {
@@ -890,6 +896,7 @@ void UIControl::CopyDataFrom(UIControl* srcControl)
     layoutDirty = srcControl->layoutDirty;
     layoutPositionDirty = srcControl->layoutPositionDirty;
     layoutOrderDirty = srcControl->layoutOrderDirty;
+    layoutChildrenDirty = srcControl->layoutChildrenDirty;
     packageContext = srcControl->packageContext;
 
     eventDispatcher = nullptr;
@@ -2254,6 +2261,11 @@ void UIControl::SetClassesFromString(const String& classesStr)
     SetStyleSheetDirty();
 }
 
+const UIStyleSheetClassSet& UIControl::GetClassSet() const
+{
+    return classes;
+}
+
 const UIStyleSheetPropertySet& UIControl::GetLocalPropertySet() const
 {
     return localProperties;
@@ -2316,6 +2328,7 @@ void UIControl::ResetStyleSheetDirty()
 void UIControl::SetLayoutDirty()
 {
     layoutDirty = true;
+    PropagateLayoutDirtyToParents();
     if (scene)
     {
         scene->GetLayoutSystem()->SetDirty();
@@ -2336,6 +2349,7 @@ void UIControl::ResetLayoutDirty()
 void UIControl::SetLayoutPositionDirty()
 {
     layoutPositionDirty = true;
+    PropagateLayoutDirtyToParents();
     if (scene)
     {
         scene->GetLayoutSystem()->SetDirty();
@@ -2354,6 +2368,7 @@ void UIControl::ResetLayoutPositionDirty()
 void UIControl::SetLayoutOrderDirty()
 {
     layoutOrderDirty = true;
+    PropagateLayoutDirtyToParents();
 }
 
 void UIControl::ResetLayoutOrderDirty()
@@ -2361,6 +2376,20 @@ void UIControl::ResetLayoutOrderDirty()
     layoutOrderDirty = false;
 }
 
+void UIControl::ResetLayoutChildrenDirty()
+{
+    layoutChildrenDirty = false;
+}
+
+void UIControl::PropagateLayoutDirtyToParents()
+{
+    // Walk stops on first marked parent, all its parents are already marked
+    for (UIControl* p = parent; p != nullptr && !p->layoutChildrenDirty; p = p->parent)
+    {
+        p->layoutChildrenDirty = true;
+    }
+}
+
 void UIControl::SetPackageContext(const RefPtr<UIControlPackageContext>& newPackageContext)
 {
     if (packageContext != newPackageContext)
@@ -906,6 +906,7 @@ protected:
     bool layoutDirty : 1;
     bool layoutPositionDirty : 1;
     bool layoutOrderDirty : 1;
+    bool layoutChildrenDirty : 1;
 
     int32 inputProcessorsCount = 1;
 
@@ -1055,6 +1056,7 @@ public:
 
     String GetClassesAsString() const;
     void SetClassesFromString(const String& classes);
+    const UIStyleSheetClassSet& GetClassSet() const;
 
     const UIStyleSheetPropertySet& GetLocalPropertySet() const;
     void SetLocalPropertySet(const UIStyleSheetPropertySet& set);
@@ -1082,6 +1084,10 @@ public:
     void SetLayoutOrderDirty();
     void ResetLayoutOrderDirty();
 
+    /** Some of descendants have dirty layout flags. Is used by UILayoutSystem to skip clean subtrees. */
+    bool IsLayoutChildrenDirty() const;
+    void ResetLayoutChildrenDirty();
+
     RefPtr<UIControlPackageContext> GetPackageContext() const;
     const RefPtr<UIControlPackageContext>& GetLocalPackageContext() const;
     void SetPackageContext(const RefPtr<UIControlPackageContext>& packageContext);
@@ -1095,6 +1101,7 @@ private:
     UIControl* parentWithContext = nullptr;
 
     void PropagateParentWithContext(UIControl* newParentWithContext);
+    void PropagateLayoutDirtyToParents();
     /* Styles */
 
 public:
@@ -1238,4 +1245,9 @@ inline bool UIControl::IsLayoutOrderDirty() const
 {
     return layoutOrderDirty;
 }
+
+inline bool UIControl::IsLayoutChildrenDirty() const
+{
+    return layoutChildrenDirty;
+}
 };
@@ -1,5 +1,6 @@
 #include "UI/UIControlPackageContext.h"
 #include "UI/Styles/UIStyleSheet.h"
+#include "UI/Styles/UIStyleSheetStructs.h"
 
 namespace DAVA
 {
@@ -30,19 +31,114 @@ void UIControlPackageContext::AddStyleSheet(const UIPriorityStyleSheet& styleShe
 
 void UIControlPackageContext::RemoveAllStyleSheets()
 {
+    styleSheetsSorted = false;
     styleSheets.clear();
     maxStyleSheetHierarchyDepth = 0;
 }
 
 const Vector<UIPriorityStyleSheet>& UIControlPackageContext::GetSortedStyleSheets()
 {
-    if (!styleSheetsSorted)
+    SortStyleSheetsIfNeed();
+    return styleSheets;
+}
+
+void UIControlPackageContext::CollectStyleSheetCandidates(const FastName& name, const String& className, const UIStyleSheetClassSet& classes, const UIStyleSheetClassSet& globalClasses, Vector<int32>& candidates)
+{
+    SortStyleSheetsIfNeed();
+
+    candidates.clear();
+    candidates.insert(candidates.end(), notIndexedStyleSheets.begin(), notIndexedStyleSheets.end());
+
+    if (name.IsValid())
     {
-        std::sort(styleSheets.begin(), styleSheets.end());
-        styleSheetsSorted = true;
+        AppendCandidates(styleSheetsByName, name, candidates);
     }
 
-    return styleSheets;
+    auto classNameIt = styleSheetsByClassName.find(className);
+    if (classNameIt != styleSheetsByClassName.end())
+    {
+        candidates.insert(candidates.end(), classNameIt->second.begin(), classNameIt->second.end());
+    }
+
+    if (!styleSheetsByClass.empty())
+    {
+        for (const UIStyleSheetClass& clazz : classes.GetClasses())
+        {
+            AppendCandidates(styleSheetsByClass, clazz.clazz, candidates);
+        }
+        for (const UIStyleSheetClass& clazz : globalClasses.GetClasses())
+        {
+            AppendCandidates(styleSheetsByClass, clazz.clazz, candidates);
+        }
+    }
+
+    // Same style sheet can be found by several classes
+    std::sort(candidates.begin(), candidates.end(), std::greater<int32>());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
+bool UIControlPackageContext::HasStyleSheetsWithClass(const FastName& clazz)
+{
+    SortStyleSheetsIfNeed();
+    return referencedClasses.find(clazz) != referencedClasses.end();
+}
+
+void UIControlPackageContext::SortStyleSheetsIfNeed()
+{
+    if (styleSheetsSorted)
+    {
+        return;
+    }
+
+    std::sort(styleSheets.begin(), styleSheets.end());
+    styleSheetsSorted = true;
+
+    styleSheetsByName.clear();
+    styleSheetsByClass.clear();
+    styleSheetsByClassName.clear();
+    notIndexedStyleSheets.clear();
+    referencedClasses.clear();
+
+    for (int32 index = 0; index < static_cast<int32>(styleSheets.size()); ++index)
+    {
+        const UIStyleSheetSelectorChain& chain = styleSheets[index].GetStyleSheet()->GetSelectorChain();
+        for (const UIStyleSheetSelector& selector : chain)
+        {
+            referencedClasses.insert(selector.classes.begin(), selector.classes.end());
+        }
+
+        // Name is the most selective key, then class and then class name
+        auto rightmost = chain.rbegin();
+        if (rightmost == chain.rend())
+        {
+            notIndexedStyleSheets.push_back(index);
+        }
+        else if (rightmost->name.IsValid())
+        {
+            styleSheetsByName[rightmost->name].push_back(index);
+        }
+        else if (!rightmost->classes.empty())
+        {
+            styleSheetsByClass[rightmost->classes.front()].push_back(index);
+        }
+        else if (!rightmost->className.empty())
+        {
+            styleSheetsByClassName[rightmost->className].push_back(index);
+        }
+        else
+        {
+            notIndexedStyleSheets.push_back(index);
+        }
+    }
+}
+
+void UIControlPackageContext::AppendCandidates(const UnorderedMap<FastName, Vector<int32>>& map, const FastName& key, Vector<int32>& candidates) const
+{
+    auto it = map.find(key);
+    if (it != map.end())
+    {
+        candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+    }
 }
 
 int32 UIControlPackageContext::GetMaxStyleSheetHierarchyDepth() const
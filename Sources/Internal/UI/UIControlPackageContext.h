@@ -3,11 +3,13 @@
 
 #include "Base/BaseObject.h"
 #include "Base/BaseTypes.h"
+#include "Base/FastName.h"
 #include "UI/Styles/UIPriorityStyleSheet.h"
 
 namespace DAVA
 {
 class UIStyleSheet;
+class UIStyleSheetClassSet;
 
 class UIControlPackageContext :
 public BaseObject
@@ -21,10 +23,28 @@ public:
 
     const Vector<UIPriorityStyleSheet>& GetSortedStyleSheets();
 
+    /**
+        Collect indices in sorted style sheets list of style sheets which can match control with given name, class name
+        and classes. Style sheets are indexed by name, class or class name of rightmost selector in chain, so other ones
+        are skipped without matching. Indices are returned in descending order.
+    */
+    void CollectStyleSheetCandidates(const FastName& name, const String& className, const UIStyleSheetClassSet& classes, const UIStyleSheetClassSet& globalClasses, Vector<int32>& candidates);
+
+    /** Return true if some selector of style sheets refers to `clazz`. */
+    bool HasStyleSheetsWithClass(const FastName& clazz);
+
     int32 GetMaxStyleSheetHierarchyDepth() const;
 
 private:
+    void SortStyleSheetsIfNeed();
+    void AppendCandidates(const UnorderedMap<FastName, Vector<int32>>& map, const FastName& key, Vector<int32>& candidates) const;
+
     Vector<UIPriorityStyleSheet> styleSheets;
+    UnorderedMap<FastName, Vector<int32>> styleSheetsByName;
+    UnorderedMap<FastName, Vector<int32>> styleSheetsByClass;
+    UnorderedMap<String, Vector<int32>> styleSheetsByClassName;
+    Vector<int32> notIndexedStyleSheets;
+    Set<FastName> referencedClasses;
     bool styleSheetsSorted = false;
     int32 maxStyleSheetHierarchyDepth = 0;
 };